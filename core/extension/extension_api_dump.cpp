@@ -915,12 +915,9 @@ Dictionary NativeExtensionAPIDump::generate_extension_api() {
 
 void NativeExtensionAPIDump::generate_extension_json_file(const String &p_path) {
 	Dictionary api = generate_extension_api();
-	Ref<JSON> json;
-	json.instantiate();
 
-	String text = json->stringify(api, "\t", false);
 	Ref<FileAccess> fa = FileAccess::open(p_path, FileAccess::WRITE);
-	CharString cs = text.ascii();
-	fa->store_buffer((const uint8_t *)cs.ptr(), cs.length());
+	ERR_FAIL_COND_MSG(fa.is_null(), "Cannot open file '" + p_path + "'.");
+	JSON::stringify_to_file(fa, api, "\t", false);
 }
 #endif
@@ -377,6 +377,19 @@ uint64_t FileAccess::get_buffer(uint8_t *p_dst, uint64_t p_length) const {
 	return i;
 }
 
+const uint8_t *FileAccess::get_buffer_view(uint64_t p_length) {
+	const uint64_t position = get_position();
+	if (position + p_length > get_length()) {
+		return nullptr;
+	}
+
+	const uint8_t *view = map_region(position, p_length);
+	if (view) {
+		seek(position + p_length);
+	}
+	return view;
+}
+
 String FileAccess::get_as_utf8_string(bool p_skip_cr) const {
 	Vector<uint8_t> sourcef;
 	uint64_t len = get_length();
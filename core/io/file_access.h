@@ -110,6 +110,9 @@ public:
 	virtual real_t get_real() const;
 
 	virtual uint64_t get_buffer(uint8_t *p_dst, uint64_t p_length) const; ///< get an array of bytes
+
+	virtual const uint8_t *map_region(uint64_t p_offset, uint64_t p_length) const { return nullptr; } ///< read-only view valid until close, nullptr if it can't be mapped
+	const uint8_t *get_buffer_view(uint64_t p_length); ///< view of the next bytes, moving past them
 	virtual String get_line() const;
 	virtual String get_token() const;
 	virtual Vector<String> get_csv_line(const String &p_delim = ",") const;
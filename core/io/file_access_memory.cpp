@@ -132,6 +132,51 @@ uint8_t FileAccessMemory::get_8() const {
 	return ret;
 }
 
+// The words are copied at once instead of byte by byte like the default implementation,
+// which matters to the binary resource loader decoding from memory.
+
+uint16_t FileAccessMemory::get_16() const {
+	if (pos + sizeof(uint16_t) > length) {
+		return FileAccess::get_16();
+	}
+	uint16_t ret;
+	memcpy(&ret, &data[pos], sizeof(uint16_t));
+	pos += sizeof(uint16_t);
+#ifdef BIG_ENDIAN_ENABLED
+	return big_endian ? ret : BSWAP16(ret);
+#else
+	return big_endian ? BSWAP16(ret) : ret;
+#endif
+}
+
+uint32_t FileAccessMemory::get_32() const {
+	if (pos + sizeof(uint32_t) > length) {
+		return FileAccess::get_32();
+	}
+	uint32_t ret;
+	memcpy(&ret, &data[pos], sizeof(uint32_t));
+	pos += sizeof(uint32_t);
+#ifdef BIG_ENDIAN_ENABLED
+	return big_endian ? ret : BSWAP32(ret);
+#else
+	return big_endian ? BSWAP32(ret) : ret;
+#endif
+}
+
+uint64_t FileAccessMemory::get_64() const {
+	if (pos + sizeof(uint64_t) > length) {
+		return FileAccess::get_64();
+	}
+	uint64_t ret;
+	memcpy(&ret, &data[pos], sizeof(uint64_t));
+	pos += sizeof(uint64_t);
+#ifdef BIG_ENDIAN_ENABLED
+	return big_endian ? ret : BSWAP64(ret);
+#else
+	return big_endian ? BSWAP64(ret) : ret;
+#endif
+}
+
 uint64_t FileAccessMemory::get_buffer(uint8_t *p_dst, uint64_t p_length) const {
 	ERR_FAIL_COND_V(!p_dst && p_length > 0, -1);
 	ERR_FAIL_COND_V(!data, -1);
@@ -149,6 +194,14 @@ uint64_t FileAccessMemory::get_buffer(uint8_t *p_dst, uint64_t p_length) const {
 	return read;
 }
 
+const uint8_t *FileAccessMemory::map_region(uint64_t p_offset, uint64_t p_length) const {
+	ERR_FAIL_COND_V(!data, nullptr);
+	if (p_offset + p_length > length) {
+		return nullptr;
+	}
+	return &data[p_offset];
+}
+
 Error FileAccessMemory::get_error() const {
 	return pos >= length ? ERR_FILE_EOF : OK;
 }
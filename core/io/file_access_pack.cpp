@@ -36,6 +36,7 @@
 #include "core/version.h"
 
 #include <stdio.h>
+#include <zstd.h>
 
 Error PackedData::add_pack(const String &p_path, bool p_replace_files, uint64_t p_offset) {
 	for (int i = 0; i < sources.size(); i++) {
@@ -47,13 +48,15 @@ Error PackedData::add_pack(const String &p_path, bool p_replace_files, uint64_t
 	return ERR_FILE_UNRECOGNIZED;
 }
 
-void PackedData::add_path(const String &p_pkg_path, const String &p_path, uint64_t p_ofs, uint64_t p_size, const uint8_t *p_md5, PackSource *p_src, bool p_replace_files, bool p_encrypted) {
+void PackedData::add_path(const String &p_pkg_path, const String &p_path, uint64_t p_ofs, uint64_t p_size, const uint8_t *p_md5, PackSource *p_src, bool p_replace_files, bool p_encrypted, bool p_compressed, const ZSTD_DDict_s *p_dictionary) {
 	PathMD5 pmd5(p_path.md5_buffer());
 
 	bool exists = files.has(pmd5);
 
 	PackedFile pf;
 	pf.encrypted = p_encrypted;
+	pf.compressed = p_compressed;
+	pf.dictionary = p_dictionary;
 	pf.pack = p_pkg_path;
 	pf.offset = p_ofs;
 	pf.size = p_size;
@@ -200,7 +203,7 @@ bool PackedSourcePCK::try_open_pack(const String &p_path, bool p_replace_files,
 	uint32_t ver_minor = f->get_32();
 	f->get_32(); // patch number, not used for validation.
 
-	ERR_FAIL_COND_V_MSG(version != PACK_FORMAT_VERSION, false, "Pack version unsupported: " + itos(version) + ".");
+	ERR_FAIL_COND_V_MSG(version < PACK_FORMAT_VERSION_MIN || version > PACK_FORMAT_VERSION, false, "Pack version unsupported: " + itos(version) + ".");
 	ERR_FAIL_COND_V_MSG(ver_major > VERSION_MAJOR || (ver_major == VERSION_MAJOR && ver_minor > VERSION_MINOR), false, "Pack created with a newer version of the engine: " + itos(ver_major) + "." + itos(ver_minor) + ".");
 
 	uint32_t pack_flags = f->get_32();
@@ -208,12 +211,32 @@ bool PackedSourcePCK::try_open_pack(const String &p_path, bool p_replace_files,
 
 	bool enc_directory = (pack_flags & PACK_DIR_ENCRYPTED);
 
-	for (int i = 0; i < 16; i++) {
+	// Zero in version 2, where they are reserved.
+	uint64_t dictionary_ofs = f->get_64();
+	uint64_t dictionary_size = f->get_64();
+
+	for (int i = 0; i < 12; i++) {
 		//reserved
 		f->get_32();
 	}
 
 	int file_count = f->get_32();
+	uint64_t directory_pos = f->get_position();
+
+	// Shared by all the compressed files of the pack.
+	ZSTD_DDict *dictionary = nullptr;
+	if (dictionary_size > 0) {
+		ERR_FAIL_COND_V_MSG(dictionary_size > f->get_length(), false, "Invalid pack dictionary.");
+		Vector<uint8_t> dictionary_data;
+		dictionary_data.resize(dictionary_size);
+		f->seek(file_base + dictionary_ofs + p_offset);
+		ERR_FAIL_COND_V_MSG(f->get_buffer(dictionary_data.ptrw(), dictionary_size) != dictionary_size, false, "Can't read pack dictionary.");
+		f->seek(directory_pos);
+
+		dictionary = ZSTD_createDDict(dictionary_data.ptr(), dictionary_size);
+		ERR_FAIL_NULL_V_MSG(dictionary, false, "Invalid pack dictionary.");
+		dictionaries.push_back(dictionary);
+	}
 
 	if (enc_directory) {
 		Ref<FileAccessEncrypted> fae;
@@ -247,16 +270,25 @@ bool PackedSourcePCK::try_open_pack(const String &p_path, bool p_replace_files,
 		f->get_buffer(md5, 16);
 		uint32_t flags = f->get_32();
 
-		PackedData::get_singleton()->add_path(p_path, path, ofs + p_offset, size, md5, this, p_replace_files, (flags & PACK_FILE_ENCRYPTED));
+		PackedData::get_singleton()->add_path(p_path, path, ofs + p_offset, size, md5, this, p_replace_files, (flags & PACK_FILE_ENCRYPTED), (flags & PACK_FILE_COMPRESSED), dictionary);
 	}
 
 	return true;
 }
 
 Ref<FileAccess> PackedSourcePCK::get_file(const String &p_path, PackedData::PackedFile *p_file) {
+	if (p_file->compressed) {
+		return memnew(FileAccessPackCompressed(p_path, *p_file));
+	}
 	return memnew(FileAccessPack(p_path, *p_file));
 }
 
+PackedSourcePCK::~PackedSourcePCK() {
+	for (uint32_t i = 0; i < dictionaries.size(); i++) {
+		ZSTD_freeDDict(dictionaries[i]);
+	}
+}
+
 //////////////////////////////////////////////////////////////////
 
 Error FileAccessPack::_open(const String &p_path, int p_mode_flags) {
@@ -336,6 +368,16 @@ uint64_t FileAccessPack::get_buffer(uint8_t *p_dst, uint64_t p_length) const {
 	return to_read;
 }
 
+const uint8_t *FileAccessPack::map_region(uint64_t p_offset, uint64_t p_length) const {
+	ERR_FAIL_COND_V_MSG(f.is_null(), nullptr, "File must be opened before use.");
+	if (p_offset + p_length > pf.size) {
+		return nullptr;
+	}
+
+	// Encrypted entries are read through FileAccessEncrypted, which can't be mapped.
+	return f->map_region(off + p_offset, p_length);
+}
+
 void FileAccessPack::set_big_endian(bool p_big_endian) {
 	ERR_FAIL_COND_MSG(f.is_null(), "File must be opened before use.");
 
@@ -394,6 +436,235 @@ FileAccessPack::FileAccessPack(const String &p_path, const PackedData::PackedFil
 	eof = false;
 }
 
+//////////////////////////////////////////////////////////////////
+
+Error FileAccessPackCompressed::_open(const String &p_path, int p_mode_flags) {
+	ERR_FAIL_V(ERR_UNAVAILABLE);
+	return ERR_UNAVAILABLE;
+}
+
+void FileAccessPackCompressed::_decompress_frame(void *p_slot) {
+	FrameSlot *slot = (FrameSlot *)p_slot;
+	if (!slot->context) {
+		slot->context = ZSTD_createDCtx();
+	}
+
+	slot->data.resize(slot->size);
+	size_t ret;
+	if (slot->dictionary) {
+		ret = ZSTD_decompress_usingDDict(slot->context, slot->data.ptr(), slot->size, slot->src, slot->src_size, slot->dictionary);
+	} else {
+		ret = ZSTD_decompressDCtx(slot->context, slot->data.ptr(), slot->size, slot->src, slot->src_size);
+	}
+	slot->failed = ZSTD_isError(ret) || ret != slot->size;
+}
+
+void FileAccessPackCompressed::_wait_slot(FrameSlot &p_slot) const {
+	if (p_slot.task != WorkerThreadPool::INVALID_TASK_ID) {
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(p_slot.task);
+		p_slot.task = WorkerThreadPool::INVALID_TASK_ID;
+	}
+}
+
+void FileAccessPackCompressed::_start_frame(uint32_t p_frame, FrameSlot &p_slot, bool p_async) const {
+	const Frame &frame = frames[p_frame];
+	p_slot.frame = p_frame;
+	p_slot.size = MIN((uint64_t)frame_size, pf.size - (uint64_t)p_frame * frame_size);
+	p_slot.src_size = frame.compressed_size;
+	p_slot.dictionary = pf.dictionary;
+	p_slot.failed = false;
+
+	if (frames_data) {
+		p_slot.src = frames_data + frame.offset;
+	} else {
+		// The compressed data is read here, the file can only be used from one thread.
+		p_slot.compressed.resize(frame.compressed_size);
+		f->seek(frames_offset + frame.offset);
+		if (f->get_buffer(p_slot.compressed.ptr(), frame.compressed_size) != frame.compressed_size) {
+			p_slot.failed = true;
+			return;
+		}
+		p_slot.src = p_slot.compressed.ptr();
+	}
+
+	if (p_async) {
+		p_slot.task = WorkerThreadPool::get_singleton()->add_native_task(&FileAccessPackCompressed::_decompress_frame, &p_slot, true);
+	} else {
+		_decompress_frame(&p_slot);
+	}
+}
+
+bool FileAccessPackCompressed::_load_frame(uint32_t p_frame) const {
+	if (current_data && current_frame == p_frame) {
+		return true;
+	}
+	ERR_FAIL_UNSIGNED_INDEX_V(p_frame, frames.size(), false);
+
+	FrameSlot &slot = slots[p_frame % FRAME_SLOTS];
+	_wait_slot(slot);
+	if (slot.frame != p_frame) {
+		_start_frame(p_frame, slot, false);
+	}
+
+	const bool sequential = current_frame >= 0 && p_frame == current_frame + 1;
+	if (slot.failed) {
+		slot.frame = -1;
+		current_frame = -1;
+		current_data = nullptr;
+		ERR_FAIL_V_MSG(false, "Can't decompress pack-referenced file '" + String(pf.pack) + "'.");
+	}
+	current_frame = p_frame;
+	current_data = slot.data.ptr();
+	current_start = (uint64_t)p_frame * frame_size;
+	current_end = current_start + slot.size;
+
+	// The slot of the current frame is never one of the next ones.
+	if (sequential && WorkerThreadPool::get_singleton()->get_thread_count() > 0) {
+		for (uint32_t i = 1; i <= PREFETCH_FRAMES && p_frame + i < frames.size(); i++) {
+			const uint32_t next = p_frame + i;
+			FrameSlot &next_slot = slots[next % FRAME_SLOTS];
+			if (next_slot.frame == next) {
+				continue;
+			}
+			_wait_slot(next_slot);
+			_start_frame(next, next_slot, true);
+		}
+	}
+
+	return true;
+}
+
+bool FileAccessPackCompressed::is_open() const {
+	return f.is_valid() && f->is_open();
+}
+
+void FileAccessPackCompressed::seek(uint64_t p_position) {
+	ERR_FAIL_COND_MSG(f.is_null(), "File must be opened before use.");
+
+	eof = p_position > pf.size;
+	pos = p_position;
+}
+
+void FileAccessPackCompressed::seek_end(int64_t p_position) {
+	seek(pf.size + p_position);
+}
+
+uint64_t FileAccessPackCompressed::get_position() const {
+	return pos;
+}
+
+uint64_t FileAccessPackCompressed::get_length() const {
+	return pf.size;
+}
+
+bool FileAccessPackCompressed::eof_reached() const {
+	return eof;
+}
+
+uint8_t FileAccessPackCompressed::get_8() const {
+	ERR_FAIL_COND_V_MSG(f.is_null(), 0, "File must be opened before use.");
+	if (pos >= pf.size) {
+		eof = true;
+		return 0;
+	}
+
+	if (!current_data || pos < current_start || pos >= current_end) {
+		if (!_load_frame(pos / frame_size)) {
+			eof = true;
+			return 0;
+		}
+	}
+	return current_data[pos++ - current_start];
+}
+
+uint64_t FileAccessPackCompressed::get_buffer(uint8_t *p_dst, uint64_t p_length) const {
+	ERR_FAIL_COND_V_MSG(f.is_null(), -1, "File must be opened before use.");
+	ERR_FAIL_COND_V(!p_dst && p_length > 0, -1);
+
+	if (eof) {
+		return 0;
+	}
+
+	uint64_t to_read = p_length;
+	if (to_read + pos > pf.size) {
+		eof = true;
+		to_read = pos < pf.size ? pf.size - pos : 0;
+	}
+
+	uint64_t read = 0;
+	while (read < to_read) {
+		if (!current_data || pos < current_start || pos >= current_end) {
+			if (!_load_frame(pos / frame_size)) {
+				eof = true;
+				return read;
+			}
+		}
+		const uint64_t count = MIN(to_read - read, current_end - pos);
+		memcpy(p_dst + read, current_data + (pos - current_start), count);
+		read += count;
+		pos += count;
+	}
+
+	return read;
+}
+
+Error FileAccessPackCompressed::get_error() const {
+	if (eof) {
+		return ERR_FILE_EOF;
+	}
+	return OK;
+}
+
+void FileAccessPackCompressed::flush() {
+	ERR_FAIL();
+}
+
+void FileAccessPackCompressed::store_8(uint8_t p_dest) {
+	ERR_FAIL();
+}
+
+void FileAccessPackCompressed::store_buffer(const uint8_t *p_src, uint64_t p_length) {
+	ERR_FAIL();
+}
+
+bool FileAccessPackCompressed::file_exists(const String &p_name) {
+	return false;
+}
+
+FileAccessPackCompressed::FileAccessPackCompressed(const String &p_path, const PackedData::PackedFile &p_file) :
+		pf(p_file) {
+	ERR_FAIL_COND_MSG(pf.encrypted, "Can't open compressed and encrypted pack-referenced file '" + String(pf.pack) + "'.");
+	Ref<FileAccess> pack = FileAccess::open(pf.pack, FileAccess::READ);
+	ERR_FAIL_COND_MSG(pack.is_null(), "Can't open pack-referenced file '" + String(pf.pack) + "'.");
+
+	pack->seek(pf.offset);
+	frame_size = pack->get_32();
+	const uint32_t frame_count = pack->get_32();
+	ERR_FAIL_COND_MSG(frame_size == 0 || frame_count != (pf.size + frame_size - 1) / frame_size, "Invalid compressed pack-referenced file '" + String(pf.pack) + "'.");
+
+	frames.resize(frame_count);
+	uint64_t offset = 0;
+	for (uint32_t i = 0; i < frame_count; i++) {
+		frames[i].offset = offset;
+		frames[i].compressed_size = pack->get_32();
+		offset += frames[i].compressed_size;
+	}
+	frames_offset = pack->get_position();
+	ERR_FAIL_COND_MSG(frames_offset + offset > pack->get_length(), "Invalid compressed pack-referenced file '" + String(pf.pack) + "'.");
+
+	frames_data = pack->map_region(frames_offset, offset);
+	f = pack;
+}
+
+FileAccessPackCompressed::~FileAccessPackCompressed() {
+	for (uint32_t i = 0; i < FRAME_SLOTS; i++) {
+		_wait_slot(slots[i]);
+		if (slots[i].context) {
+			ZSTD_freeDCtx(slots[i].context);
+		}
+	}
+}
+
 //////////////////////////////////////////////////////////////////////////////////
 // DIR ACCESS
 //////////////////////////////////////////////////////////////////////////////////
@@ -33,25 +33,37 @@
 
 #include "core/io/dir_access.h"
 #include "core/io/file_access.h"
+#include "core/object/worker_thread_pool.h"
 #include "core/string/print_string.h"
 #include "core/templates/hash_set.h"
 #include "core/templates/list.h"
+#include "core/templates/local_vector.h"
 #include "core/templates/rb_map.h"
 
 // Godot's packed file magic header ("GDPC" in ASCII).
 #define PACK_HEADER_MAGIC 0x43504447
 // The current packed file format version number.
-#define PACK_FORMAT_VERSION 2
+#define PACK_FORMAT_VERSION 3
+// The oldest packed file format version number that can still be read.
+#define PACK_FORMAT_VERSION_MIN 2
 
 enum PackFlags {
 	PACK_DIR_ENCRYPTED = 1 << 0
 };
 
+// A compressed file is stored as independent zstd frames, so it can be read from any position and
+// its frames decompressed in parallel. The data starts with the uncompressed size of the frames
+// (the last one can be smaller) and their count as 32-bit integers, followed by the compressed size
+// of every frame as a 32-bit integer, then the frames. Since version 3, the pack can hold a raw
+// zstd dictionary shared by all its compressed files, located by the first reserved header fields.
 enum PackFileFlags {
-	PACK_FILE_ENCRYPTED = 1 << 0
+	PACK_FILE_ENCRYPTED = 1 << 0,
+	PACK_FILE_COMPRESSED = 1 << 1,
 };
 
 class PackSource;
+struct ZSTD_DCtx_s;
+struct ZSTD_DDict_s;
 
 class PackedData {
 	friend class FileAccessPack;
@@ -66,6 +78,8 @@ public:
 		uint8_t md5[16];
 		PackSource *src = nullptr;
 		bool encrypted;
+		bool compressed = false;
+		const ZSTD_DDict_s *dictionary = nullptr; // Owned by the source.
 	};
 
 private:
@@ -109,7 +123,7 @@ private:
 
 public:
 	void add_pack_source(PackSource *p_source);
-	void add_path(const String &p_pkg_path, const String &p_path, uint64_t p_ofs, uint64_t p_size, const uint8_t *p_md5, PackSource *p_src, bool p_replace_files, bool p_encrypted = false); // for PackSource
+	void add_path(const String &p_pkg_path, const String &p_path, uint64_t p_ofs, uint64_t p_size, const uint8_t *p_md5, PackSource *p_src, bool p_replace_files, bool p_encrypted = false, bool p_compressed = false, const ZSTD_DDict_s *p_dictionary = nullptr); // for PackSource
 
 	void set_disabled(bool p_disabled) { disabled = p_disabled; }
 	_FORCE_INLINE_ bool is_disabled() const { return disabled; }
@@ -135,9 +149,13 @@ public:
 };
 
 class PackedSourcePCK : public PackSource {
+	LocalVector<ZSTD_DDict_s *> dictionaries; // Of the packs, digested once for all their files.
+
 public:
 	virtual bool try_open_pack(const String &p_path, bool p_replace_files, uint64_t p_offset) override;
 	virtual Ref<FileAccess> get_file(const String &p_path, PackedData::PackedFile *p_file) override;
+
+	virtual ~PackedSourcePCK();
 };
 
 class FileAccessPack : public FileAccess {
@@ -166,6 +184,7 @@ public:
 	virtual uint8_t get_8() const override;
 
 	virtual uint64_t get_buffer(uint8_t *p_dst, uint64_t p_length) const override;
+	virtual const uint8_t *map_region(uint64_t p_offset, uint64_t p_length) const override;
 
 	virtual void set_big_endian(bool p_big_endian) override;
 
@@ -181,6 +200,83 @@ public:
 	FileAccessPack(const String &p_path, const PackedData::PackedFile &p_file);
 };
 
+class FileAccessPackCompressed : public FileAccess {
+	// Decompressed ahead on worker threads once reads are sequential.
+	static const uint32_t PREFETCH_FRAMES = 4;
+	static const uint32_t FRAME_SLOTS = PREFETCH_FRAMES + 1;
+
+	struct Frame {
+		uint64_t offset = 0; // Of the compressed data, from the first frame.
+		uint32_t compressed_size = 0;
+	};
+
+	struct FrameSlot {
+		int64_t frame = -1;
+		WorkerThreadPool::TaskID task = WorkerThreadPool::INVALID_TASK_ID;
+		const uint8_t *src = nullptr;
+		uint32_t src_size = 0;
+		LocalVector<uint8_t> compressed; // Holds the source when the pack can't be mapped.
+		LocalVector<uint8_t> data;
+		uint32_t size = 0;
+		const ZSTD_DDict_s *dictionary = nullptr;
+		ZSTD_DCtx_s *context = nullptr; // Created on first use.
+		bool failed = false;
+	};
+
+	PackedData::PackedFile pf;
+	mutable Ref<FileAccess> f; // Seeked when reading, to fetch the frames that can't be mapped.
+
+	uint32_t frame_size = 0;
+	LocalVector<Frame> frames;
+	uint64_t frames_offset = 0;
+	const uint8_t *frames_data = nullptr; // A view of the compressed frames, when the pack can be mapped.
+
+	mutable FrameSlot slots[FRAME_SLOTS];
+	mutable int64_t current_frame = -1;
+	mutable const uint8_t *current_data = nullptr;
+	mutable uint64_t current_start = 0;
+	mutable uint64_t current_end = 0;
+
+	mutable uint64_t pos = 0;
+	mutable bool eof = false;
+
+	static void _decompress_frame(void *p_slot);
+	void _wait_slot(FrameSlot &p_slot) const;
+	void _start_frame(uint32_t p_frame, FrameSlot &p_slot, bool p_async) const;
+	bool _load_frame(uint32_t p_frame) const;
+
+	virtual Error _open(const String &p_path, int p_mode_flags) override;
+	virtual uint64_t _get_modified_time(const String &p_file) override { return 0; }
+	virtual uint32_t _get_unix_permissions(const String &p_file) override { return 0; }
+	virtual Error _set_unix_permissions(const String &p_file, uint32_t p_permissions) override { return FAILED; }
+
+public:
+	virtual bool is_open() const override;
+
+	virtual void seek(uint64_t p_position) override;
+	virtual void seek_end(int64_t p_position = 0) override;
+	virtual uint64_t get_position() const override;
+	virtual uint64_t get_length() const override;
+
+	virtual bool eof_reached() const override;
+
+	virtual uint8_t get_8() const override;
+
+	virtual uint64_t get_buffer(uint8_t *p_dst, uint64_t p_length) const override;
+
+	virtual Error get_error() const override;
+
+	virtual void flush() override;
+	virtual void store_8(uint8_t p_dest) override;
+
+	virtual void store_buffer(const uint8_t *p_src, uint64_t p_length) override;
+
+	virtual bool file_exists(const String &p_name) override;
+
+	FileAccessPackCompressed(const String &p_path, const PackedData::PackedFile &p_file);
+	virtual ~FileAccessPackCompressed();
+};
+
 Ref<FileAccess> PackedData::try_open_path(const String &p_path) {
 	PathMD5 pmd5(p_path.md5_buffer());
 	HashMap<PathMD5, PackedFile, PathMD5>::Iterator E = files.find(pmd5);
@@ -45,107 +45,361 @@ const char *JSON::tk_name[TK_MAX] = {
 	"EOF",
 };
 
-String JSON::_make_indent(const String &p_indent, int p_size) {
-	String indent_text = "";
-	if (!p_indent.is_empty()) {
-		for (int i = 0; i < p_size; i++) {
-			indent_text += p_indent;
-		}
+void JSON::Writer::_flush() {
+	if (buffer.size()) {
+		file->store_buffer(buffer.ptr(), buffer.size());
+		buffer.clear();
+	}
+}
+
+void JSON::Writer::_write_indent(int p_size) {
+	for (int i = 0; i < p_size; i++) {
+		write(indent.get_data(), indent.length());
 	}
-	return indent_text;
 }
 
-String JSON::_stringify(const Variant &p_var, const String &p_indent, int p_cur_indent, bool p_sort_keys, HashSet<const void *> &p_markers, bool p_full_precision) {
-	String colon = ":";
-	String end_statement = "";
+void JSON::Writer::_write_ascii(const char32_t *p_str, int p_len) {
+	const uint32_t size = buffer.size();
+	buffer.resize(size + p_len);
+	uint8_t *dst = buffer.ptr() + size;
+	for (int i = 0; i < p_len; i++) {
+		dst[i] = p_str[i];
+	}
+}
+
+void JSON::Writer::_write_string(const String &p_string) {
+	// Same escapes as String::json_escape().
+	const char32_t *str = p_string.ptr();
+	const int len = p_string.length();
+	char utf8[4];
+
+	write("\"", 1);
+	int run_start = 0;
+	for (int i = 0; i < len; i++) {
+		const char32_t c = str[i];
+		const char *escape = nullptr;
+		switch (c) {
+			case '\\':
+				escape = "\\\\";
+				break;
+			case '\b':
+				escape = "\\b";
+				break;
+			case '\f':
+				escape = "\\f";
+				break;
+			case '\n':
+				escape = "\\n";
+				break;
+			case '\r':
+				escape = "\\r";
+				break;
+			case '\t':
+				escape = "\\t";
+				break;
+			case '\v':
+				escape = "\\v";
+				break;
+			case '"':
+				escape = "\\\"";
+				break;
+			default:
+				if (c <= 0x7f) {
+					continue; // Written with the run of ASCII characters.
+				}
+		}
 
-	if (!p_indent.is_empty()) {
-		colon += " ";
-		end_statement += "\n";
+		_write_ascii(str + run_start, i - run_start);
+		run_start = i + 1;
+
+		if (escape) {
+			write(escape, 2);
+		} else if (c <= 0x7ff) {
+			utf8[0] = 0xc0 | ((c >> 6) & 0x1f);
+			utf8[1] = 0x80 | (c & 0x3f);
+			write(utf8, 2);
+		} else if (c <= 0xffff) {
+			utf8[0] = 0xe0 | ((c >> 12) & 0x0f);
+			utf8[1] = 0x80 | ((c >> 6) & 0x3f);
+			utf8[2] = 0x80 | (c & 0x3f);
+			write(utf8, 3);
+		} else if (c <= 0x10ffff) {
+			utf8[0] = 0xf0 | ((c >> 18) & 0x07);
+			utf8[1] = 0x80 | ((c >> 12) & 0x3f);
+			utf8[2] = 0x80 | ((c >> 6) & 0x3f);
+			utf8[3] = 0x80 | (c & 0x3f);
+			write(utf8, 4);
+		} else {
+			// Invalid, let String report it.
+			CharString invalid = String(&c, 1).utf8();
+			write(invalid.get_data(), invalid.length());
+		}
 	}
+	// Most strings are ASCII without escapes, and are written here at once.
+	_write_ascii(str + run_start, len - run_start);
+	write("\"", 1);
+}
 
+void JSON::Writer::write_value(const Variant &p_var, int p_cur_indent) {
 	switch (p_var.get_type()) {
 		case Variant::NIL:
-			return "null";
+			write("null", 4);
+			break;
 		case Variant::BOOL:
-			return p_var.operator bool() ? "true" : "false";
-		case Variant::INT:
-			return itos(p_var);
+			if (p_var.operator bool()) {
+				write("true", 4);
+			} else {
+				write("false", 5);
+			}
+			break;
+		case Variant::INT: {
+			char digits[24];
+			int64_t num = p_var;
+			uint64_t abs_num = num < 0 ? 0 - uint64_t(num) : uint64_t(num);
+			int pos = sizeof(digits);
+			do {
+				digits[--pos] = '0' + abs_num % 10;
+				abs_num /= 10;
+			} while (abs_num);
+			if (num < 0) {
+				digits[--pos] = '-';
+			}
+			write(digits + pos, sizeof(digits) - pos);
+		} break;
 		case Variant::FLOAT: {
 			double num = p_var;
-			if (p_full_precision) {
+			CharString text;
+			if (full_precision) {
 				// Store unreliable digits (17) instead of just reliable
 				// digits (14) so that the value can be decoded exactly.
-				return String::num(num, 17 - (int)floor(log10(num)));
+				text = String::num(num, 17 - (int)floor(log10(num))).utf8();
 			} else {
 				// Store only reliable digits (14) by default.
-				return String::num(num, 14 - (int)floor(log10(num)));
+				text = String::num(num, 14 - (int)floor(log10(num))).utf8();
 			}
-		}
+			write(text.get_data(), text.length());
+		} break;
 		case Variant::PACKED_INT32_ARRAY:
 		case Variant::PACKED_INT64_ARRAY:
 		case Variant::PACKED_FLOAT32_ARRAY:
 		case Variant::PACKED_FLOAT64_ARRAY:
 		case Variant::PACKED_STRING_ARRAY:
 		case Variant::ARRAY: {
-			String s = "[";
-			s += end_statement;
 			Array a = p_var;
+			if (markers.has(a.id())) {
+				write("\"[...]\"", 7);
+				ERR_FAIL_MSG("Converting circular structure to JSON.");
+			}
+			markers.insert(a.id());
 
-			ERR_FAIL_COND_V_MSG(p_markers.has(a.id()), "\"[...]\"", "Converting circular structure to JSON.");
-			p_markers.insert(a.id());
-
+			write("[", 1);
+			if (indent.length()) {
+				write("\n", 1);
+			}
 			for (int i = 0; i < a.size(); i++) {
 				if (i > 0) {
-					s += ",";
-					s += end_statement;
+					write(",", 1);
+					if (indent.length()) {
+						write("\n", 1);
+					}
 				}
-				s += _make_indent(p_indent, p_cur_indent + 1) + _stringify(a[i], p_indent, p_cur_indent + 1, p_sort_keys, p_markers);
+				_write_indent(p_cur_indent + 1);
+				write_value(a[i], p_cur_indent + 1);
 			}
-			s += end_statement + _make_indent(p_indent, p_cur_indent) + "]";
-			p_markers.erase(a.id());
-			return s;
-		}
+			if (indent.length()) {
+				write("\n", 1);
+			}
+			_write_indent(p_cur_indent);
+			write("]", 1);
+
+			markers.erase(a.id());
+		} break;
 		case Variant::DICTIONARY: {
-			String s = "{";
-			s += end_statement;
 			Dictionary d = p_var;
-
-			ERR_FAIL_COND_V_MSG(p_markers.has(d.id()), "\"{...}\"", "Converting circular structure to JSON.");
-			p_markers.insert(d.id());
+			if (markers.has(d.id())) {
+				write("\"{...}\"", 7);
+				ERR_FAIL_MSG("Converting circular structure to JSON.");
+			}
+			markers.insert(d.id());
 
 			List<Variant> keys;
 			d.get_key_list(&keys);
 
-			if (p_sort_keys) {
+			if (sort_keys) {
 				keys.sort();
 			}
 
+			write("{", 1);
+			if (indent.length()) {
+				write("\n", 1);
+			}
 			bool first_key = true;
 			for (const Variant &E : keys) {
 				if (first_key) {
 					first_key = false;
 				} else {
-					s += ",";
-					s += end_statement;
+					write(",", 1);
+					if (indent.length()) {
+						write("\n", 1);
+					}
+				}
+				_write_indent(p_cur_indent + 1);
+				_write_string(String(E));
+				if (indent.length()) {
+					write(": ", 2);
+				} else {
+					write(":", 1);
 				}
-				s += _make_indent(p_indent, p_cur_indent + 1) + _stringify(String(E), p_indent, p_cur_indent + 1, p_sort_keys, p_markers);
-				s += colon;
-				s += _stringify(d[E], p_indent, p_cur_indent + 1, p_sort_keys, p_markers);
+				write_value(d[E], p_cur_indent + 1);
+			}
+			if (indent.length()) {
+				write("\n", 1);
 			}
+			_write_indent(p_cur_indent);
+			write("}", 1);
 
-			s += end_statement + _make_indent(p_indent, p_cur_indent) + "}";
-			p_markers.erase(d.id());
-			return s;
-		}
+			markers.erase(d.id());
+		} break;
 		default:
-			return "\"" + String(p_var).json_escape() + "\"";
+			_write_string(p_var);
+	}
+}
+
+void JSON::Writer::finish() {
+	if (file.is_valid()) {
+		_flush();
+	}
+}
+
+JSON::Writer::Writer(const Ref<FileAccess> &p_file, const String &p_indent, bool p_sort_keys, bool p_full_precision) :
+		file(p_file),
+		indent(p_indent.utf8()),
+		sort_keys(p_sort_keys),
+		full_precision(p_full_precision) {
+	if (file.is_valid()) {
+		buffer.reserve(CHUNK_SIZE);
 	}
 }
 
-Error JSON::_get_token(const char32_t *p_str, int &index, int p_len, Token &r_token, int &line, String &r_err_str) {
+// The parser reads UTF-32 strings and UTF-8 buffers. The buffers aren't null-terminated,
+// their end is read as a null character, like the end of a string.
+template <class C>
+static _FORCE_INLINE_ char32_t _get_char(const C *p_str, int p_index, int p_len) {
+	return p_index < p_len ? (char32_t)p_str[p_index] : 0;
+}
+
+static _FORCE_INLINE_ String _make_string(const char32_t *p_str, int p_len) {
+	return String(p_str, p_len);
+}
+
+static String _make_string(const uint8_t *p_str, int p_len) {
+	// Most strings are ASCII, they are copied without going through the UTF-8 decoder.
+	uint64_t high_bits = 0;
+	int i = 0;
+	for (; i + 8 <= p_len; i += 8) {
+		uint64_t word;
+		memcpy(&word, p_str + i, 8);
+		high_bits |= word;
+	}
+	for (; i < p_len; i++) {
+		high_bits |= p_str[i];
+	}
+	if (high_bits & 0x8080808080808080ULL) {
+		return String::utf8((const char *)p_str, p_len);
+	}
+
+	String str;
+	str.resize(p_len + 1);
+	char32_t *dst = str.ptrw();
+	for (i = 0; i < p_len; i++) {
+		dst[i] = p_str[i];
+	}
+	dst[p_len] = 0;
+	return str;
+}
+
+// Skips the characters of a string that need no decoding, up to a quote, a backslash or the end.
+static _FORCE_INLINE_ int _skip_string_chars(const char32_t *p_str, int p_index, int p_len, int &r_line) {
+	while (p_index < p_len) {
+		const char32_t c = p_str[p_index];
+		if (c == '"' || c == '\\' || c == 0) {
+			break;
+		}
+		if (c == '\n') {
+			r_line++;
+		}
+		p_index++;
+	}
+	return p_index;
+}
+
+// Same for UTF-8, checking 8 bytes at once. All the characters looked for are ASCII,
+// which never appears in the multi-byte sequences.
+static int _skip_string_chars(const uint8_t *p_str, int p_index, int p_len, int &r_line) {
+#define HAS_ZERO_BYTE(m_v) (((m_v)-0x0101010101010101ULL) & ~(m_v)&0x8080808080808080ULL)
+	while (true) {
+		while (p_index + 8 <= p_len) {
+			uint64_t word;
+			memcpy(&word, p_str + p_index, 8);
+			if (HAS_ZERO_BYTE(word ^ 0x2222222222222222ULL) || HAS_ZERO_BYTE(word ^ 0x5c5c5c5c5c5c5c5cULL) || HAS_ZERO_BYTE(word ^ 0x0a0a0a0a0a0a0a0aULL) || HAS_ZERO_BYTE(word)) {
+				break;
+			}
+			p_index += 8;
+		}
+
+		// Up to the character found in the word, and back to the words after a new line.
+		bool new_line = false;
+		while (p_index < p_len && !new_line) {
+			const uint8_t c = p_str[p_index];
+			if (c == '"' || c == '\\' || c == 0) {
+				return p_index;
+			}
+			new_line = c == '\n';
+			p_index++;
+		}
+		if (!new_line) {
+			return p_index;
+		}
+		r_line++;
+	}
+#undef HAS_ZERO_BYTE
+}
+
+static _FORCE_INLINE_ double _parse_number(const char32_t *p_str, int &r_index, int p_len) {
+	const char32_t *rptr;
+	double number = String::to_float(&p_str[r_index], &rptr);
+	r_index += (rptr - &p_str[r_index]);
+	return number;
+}
+
+static double _parse_number(const uint8_t *p_str, int &r_index, int p_len) {
+	// Copied to be null-terminated, with the characters any number can have.
+	int end = r_index;
+	while (end < p_len && (is_digit(p_str[end]) || p_str[end] == '-' || p_str[end] == '+' || p_str[end] == '.' || p_str[end] == 'e' || p_str[end] == 'E')) {
+		end++;
+	}
+
+	const int len = end - r_index;
+	char short_text[64];
+	CharString long_text;
+	char *text = short_text;
+	if (len >= 64) {
+		long_text.resize(len + 1);
+		text = long_text.ptrw();
+	}
+	memcpy(text, p_str + r_index, len);
+	text[len] = 0;
+
+	const char *rptr;
+	double number = String::to_float(text, &rptr);
+	r_index += (rptr - text);
+	return number;
+}
+
+template <class C>
+Error JSON::_get_token(const C *p_str, int &index, int p_len, Token &r_token, int &line, String &r_err_str) {
 	while (p_len > 0) {
-		switch (p_str[index]) {
+		switch (_get_char(p_str, index, p_len)) {
 			case '\n': {
 				line++;
 				index++;
@@ -189,42 +443,86 @@ Error JSON::_get_token(const char32_t *p_str, int &index, int p_len, Token &r_to
 				index++;
 				String str;
 				while (true) {
-					if (p_str[index] == 0) {
+					// The characters up to the next escape or quote are decoded at once.
+					int run_start = index;
+					index = _skip_string_chars(p_str, index, p_len, line);
+					if (index > run_start) {
+						str += _make_string(p_str + run_start, index - run_start);
+					}
+
+					if (_get_char(p_str, index, p_len) == 0) {
 						r_err_str = "Unterminated String";
 						return ERR_PARSE_ERROR;
 					} else if (p_str[index] == '"') {
 						index++;
 						break;
-					} else if (p_str[index] == '\\') {
-						//escaped characters...
-						index++;
-						char32_t next = p_str[index];
-						if (next == 0) {
-							r_err_str = "Unterminated String";
-							return ERR_PARSE_ERROR;
-						}
-						char32_t res = 0;
-
-						switch (next) {
-							case 'b':
-								res = 8;
-								break;
-							case 't':
-								res = 9;
-								break;
-							case 'n':
-								res = 10;
-								break;
-							case 'f':
-								res = 12;
-								break;
-							case 'r':
-								res = 13;
-								break;
-							case 'u': {
-								// hex number
+					}
+
+					//escaped characters...
+					index++;
+					char32_t next = _get_char(p_str, index, p_len);
+					if (next == 0) {
+						r_err_str = "Unterminated String";
+						return ERR_PARSE_ERROR;
+					}
+					char32_t res = 0;
+
+					switch (next) {
+						case 'b':
+							res = 8;
+							break;
+						case 't':
+							res = 9;
+							break;
+						case 'n':
+							res = 10;
+							break;
+						case 'f':
+							res = 12;
+							break;
+						case 'r':
+							res = 13;
+							break;
+						case 'u': {
+							// hex number
+							for (int j = 0; j < 4; j++) {
+								char32_t c = _get_char(p_str, index + j + 1, p_len);
+								if (c == 0) {
+									r_err_str = "Unterminated String";
+									return ERR_PARSE_ERROR;
+								}
+								if (!is_hex_digit(c)) {
+									r_err_str = "Malformed hex constant in string";
+									return ERR_PARSE_ERROR;
+								}
+								char32_t v;
+								if (is_digit(c)) {
+									v = c - '0';
+								} else if (c >= 'a' && c <= 'f') {
+									v = c - 'a';
+									v += 10;
+								} else if (c >= 'A' && c <= 'F') {
+									v = c - 'A';
+									v += 10;
+								} else {
+									ERR_PRINT("Bug parsing hex constant.");
+									v = 0;
+								}
+
+								res <<= 4;
+								res |= v;
+							}
+							index += 4; //will add at the end anyway
+
+							if ((res & 0xfffffc00) == 0xd800) {
+								if (_get_char(p_str, index + 1, p_len) != '\\' || _get_char(p_str, index + 2, p_len) != 'u') {
+									r_err_str = "Invalid UTF-16 sequence in string, unpaired lead surrogate";
+									return ERR_PARSE_ERROR;
+								}
+								index += 2;
+								char32_t trail = 0;
 								for (int j = 0; j < 4; j++) {
-									char32_t c = p_str[index + j + 1];
+									char32_t c = _get_char(p_str, index + j + 1, p_len);
 									if (c == 0) {
 										r_err_str = "Unterminated String";
 										return ERR_PARSE_ERROR;
@@ -247,71 +545,32 @@ Error JSON::_get_token(const char32_t *p_str, int &index, int p_len, Token &r_to
 										v = 0;
 									}
 
-									res <<= 4;
-									res |= v;
+									trail <<= 4;
+									trail |= v;
 								}
-								index += 4; //will add at the end anyway
-
-								if ((res & 0xfffffc00) == 0xd800) {
-									if (p_str[index + 1] != '\\' || p_str[index + 2] != 'u') {
-										r_err_str = "Invalid UTF-16 sequence in string, unpaired lead surrogate";
-										return ERR_PARSE_ERROR;
-									}
-									index += 2;
-									char32_t trail = 0;
-									for (int j = 0; j < 4; j++) {
-										char32_t c = p_str[index + j + 1];
-										if (c == 0) {
-											r_err_str = "Unterminated String";
-											return ERR_PARSE_ERROR;
-										}
-										if (!is_hex_digit(c)) {
-											r_err_str = "Malformed hex constant in string";
-											return ERR_PARSE_ERROR;
-										}
-										char32_t v;
-										if (is_digit(c)) {
-											v = c - '0';
-										} else if (c >= 'a' && c <= 'f') {
-											v = c - 'a';
-											v += 10;
-										} else if (c >= 'A' && c <= 'F') {
-											v = c - 'A';
-											v += 10;
-										} else {
-											ERR_PRINT("Bug parsing hex constant.");
-											v = 0;
-										}
-
-										trail <<= 4;
-										trail |= v;
-									}
-									if ((trail & 0xfffffc00) == 0xdc00) {
-										res = (res << 10UL) + trail - ((0xd800 << 10UL) + 0xdc00 - 0x10000);
-										index += 4; //will add at the end anyway
-									} else {
-										r_err_str = "Invalid UTF-16 sequence in string, unpaired lead surrogate";
-										return ERR_PARSE_ERROR;
-									}
-								} else if ((res & 0xfffffc00) == 0xdc00) {
-									r_err_str = "Invalid UTF-16 sequence in string, unpaired trail surrogate";
+								if ((trail & 0xfffffc00) == 0xdc00) {
+									res = (res << 10UL) + trail - ((0xd800 << 10UL) + 0xdc00 - 0x10000);
+									index += 4; //will add at the end anyway
+								} else {
+									r_err_str = "Invalid UTF-16 sequence in string, unpaired lead surrogate";
 									return ERR_PARSE_ERROR;
 								}
-
-							} break;
-							default: {
-								res = next;
-							} break;
-						}
-
-						str += res;
-
-					} else {
-						if (p_str[index] == '\n') {
-							line++;
-						}
-						str += p_str[index];
+							} else if ((res & 0xfffffc00) == 0xdc00) {
+								r_err_str = "Invalid UTF-16 sequence in string, unpaired trail surrogate";
+								return ERR_PARSE_ERROR;
+							}
+
+						} break;
+						default: {
+							// Only ASCII can be escaped in UTF-8, the other bytes are decoded with the next run.
+							if (next > 0x7f) {
+								continue;
+							}
+							res = next;
+						} break;
 					}
+
+					str += res;
 					index++;
 				}
 
@@ -321,30 +580,26 @@ Error JSON::_get_token(const char32_t *p_str, int &index, int p_len, Token &r_to
 
 			} break;
 			default: {
-				if (p_str[index] <= 32) {
+				const char32_t c = p_str[index];
+				if (c <= 32) {
 					index++;
 					break;
 				}
 
-				if (p_str[index] == '-' || is_digit(p_str[index])) {
+				if (c == '-' || is_digit(c)) {
 					//a number
-					const char32_t *rptr;
-					double number = String::to_float(&p_str[index], &rptr);
-					index += (rptr - &p_str[index]);
 					r_token.type = TK_NUMBER;
-					r_token.value = number;
+					r_token.value = _parse_number(p_str, index, p_len);
 					return OK;
 
-				} else if (is_ascii_char(p_str[index])) {
-					String id;
-
-					while (is_ascii_char(p_str[index])) {
-						id += p_str[index];
+				} else if (is_ascii_char(c)) {
+					int id_start = index;
+					while (is_ascii_char(_get_char(p_str, index, p_len))) {
 						index++;
 					}
 
 					r_token.type = TK_IDENTIFIER;
-					r_token.value = id;
+					r_token.value = _make_string(p_str + id_start, index - id_start);
 					return OK;
 				} else {
 					r_err_str = "Unexpected character.";
@@ -357,7 +612,8 @@ Error JSON::_get_token(const char32_t *p_str, int &index, int p_len, Token &r_to
 	return ERR_PARSE_ERROR;
 }
 
-Error JSON::_parse_value(Variant &value, Token &token, const char32_t *p_str, int &index, int p_len, int &line, String &r_err_str) {
+template <class C>
+Error JSON::_parse_value(Variant &value, Token &token, const C *p_str, int &index, int p_len, int &line, String &r_err_str) {
 	if (token.type == TK_CURLY_BRACKET_OPEN) {
 		Dictionary d;
 		Error err = _parse_object(d, p_str, index, p_len, line, r_err_str);
@@ -396,7 +652,8 @@ Error JSON::_parse_value(Variant &value, Token &token, const char32_t *p_str, in
 	return OK;
 }
 
-Error JSON::_parse_array(Array &array, const char32_t *p_str, int &index, int p_len, int &line, String &r_err_str) {
+template <class C>
+Error JSON::_parse_array(Array &array, const C *p_str, int &index, int p_len, int &line, String &r_err_str) {
 	Token token;
 	bool need_comma = false;
 
@@ -434,7 +691,8 @@ Error JSON::_parse_array(Array &array, const char32_t *p_str, int &index, int p_
 	return ERR_PARSE_ERROR;
 }
 
-Error JSON::_parse_object(Dictionary &object, const char32_t *p_str, int &index, int p_len, int &line, String &r_err_str) {
+template <class C>
+Error JSON::_parse_object(Dictionary &object, const C *p_str, int &index, int p_len, int &line, String &r_err_str) {
 	bool at_key = true;
 	String key;
 	Token token;
@@ -497,25 +755,23 @@ Error JSON::_parse_object(Dictionary &object, const char32_t *p_str, int &index,
 	return ERR_PARSE_ERROR;
 }
 
-Error JSON::_parse_string(const String &p_json, Variant &r_ret, String &r_err_str, int &r_err_line) {
-	const char32_t *str = p_json.ptr();
+template <class C>
+Error JSON::_parse_data(const C *p_str, int p_len, Variant &r_ret, String &r_err_str, int &r_err_line) {
 	int idx = 0;
-	int len = p_json.length();
 	Token token;
 	r_err_line = 0;
-	String aux_key;
 
-	Error err = _get_token(str, idx, len, token, r_err_line, r_err_str);
+	Error err = _get_token(p_str, idx, p_len, token, r_err_line, r_err_str);
 	if (err) {
 		return err;
 	}
 
-	err = _parse_value(r_ret, token, str, idx, len, r_err_line, r_err_str);
+	err = _parse_value(r_ret, token, p_str, idx, p_len, r_err_line, r_err_str);
 
 	// Check if EOF is reached
 	// or it's a type of the next token.
-	if (err == OK && idx < len) {
-		err = _get_token(str, idx, len, token, r_err_line, r_err_str);
+	if (err == OK && idx < p_len) {
+		err = _get_token(p_str, idx, p_len, token, r_err_line, r_err_str);
 
 		if (err || token.type != TK_EOF) {
 			r_err_str = "Expected 'EOF'";
@@ -529,12 +785,38 @@ Error JSON::_parse_string(const String &p_json, Variant &r_ret, String &r_err_st
 }
 
 String JSON::stringify(const Variant &p_var, const String &p_indent, bool p_sort_keys, bool p_full_precision) {
-	HashSet<const void *> markers;
-	return _stringify(p_var, p_indent, 0, p_sort_keys, markers, p_full_precision);
+	Writer writer(Ref<FileAccess>(), p_indent, p_sort_keys, p_full_precision);
+	writer.write_value(p_var, 0);
+	const LocalVector<uint8_t> &buffer = writer.get_buffer();
+	return String::utf8((const char *)buffer.ptr(), buffer.size());
+}
+
+Error JSON::stringify_to_file(const Ref<FileAccess> &p_file, const Variant &p_var, const String &p_indent, bool p_sort_keys, bool p_full_precision) {
+	ERR_FAIL_COND_V(p_file.is_null(), ERR_INVALID_PARAMETER);
+	Writer writer(p_file, p_indent, p_sort_keys, p_full_precision);
+	writer.write_value(p_var, 0);
+	writer.finish();
+	return p_file->get_error() == ERR_FILE_CANT_WRITE ? ERR_FILE_CANT_WRITE : OK;
 }
 
 Error JSON::parse(const String &p_json_string) {
-	Error err = _parse_string(p_json_string, data, err_str, err_line);
+	Error err = _parse_data(p_json_string.ptr(), p_json_string.length(), data, err_str, err_line);
+	if (err == Error::OK) {
+		err_line = 0;
+	}
+	return err;
+}
+
+Error JSON::parse_utf8(const Vector<uint8_t> &p_json_buffer) {
+	const uint8_t *str = p_json_buffer.ptr();
+	int len = p_json_buffer.size();
+	if (len >= 3 && str[0] == 0xef && str[1] == 0xbb && str[2] == 0xbf) {
+		// Skip the byte order mark.
+		str += 3;
+		len -= 3;
+	}
+
+	Error err = _parse_data(str, len, data, err_str, err_line);
 	if (err == Error::OK) {
 		err_line = 0;
 	}
@@ -544,6 +826,7 @@ Error JSON::parse(const String &p_json_string) {
 void JSON::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("stringify", "data", "indent", "sort_keys", "full_precision"), &JSON::stringify, DEFVAL(""), DEFVAL(true), DEFVAL(false));
 	ClassDB::bind_method(D_METHOD("parse", "json_string"), &JSON::parse);
+	ClassDB::bind_method(D_METHOD("parse_utf8", "json_buffer"), &JSON::parse_utf8);
 
 	ClassDB::bind_method(D_METHOD("get_data"), &JSON::get_data);
 	ClassDB::bind_method(D_METHOD("get_error_line"), &JSON::get_error_line);
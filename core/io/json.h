@@ -31,7 +31,9 @@
 #ifndef JSON_H
 #define JSON_H
 
+#include "core/io/file_access.h"
 #include "core/object/ref_counted.h"
+#include "core/templates/local_vector.h"
 #include "core/variant/variant.h"
 
 class JSON : public RefCounted {
@@ -63,26 +65,64 @@ class JSON : public RefCounted {
 		Variant value;
 	};
 
+	// Encodes straight to UTF-8 and flushes files in chunks.
+	class Writer {
+		static const uint32_t CHUNK_SIZE = 65536;
+
+		Ref<FileAccess> file;
+		LocalVector<uint8_t> buffer;
+		CharString indent;
+		bool sort_keys = true;
+		bool full_precision = false;
+		HashSet<const void *> markers;
+
+		void _flush();
+		void _write_indent(int p_size);
+		void _write_ascii(const char32_t *p_str, int p_len);
+		void _write_string(const String &p_string);
+
+	public:
+		_FORCE_INLINE_ void write(const char *p_str, uint32_t p_len) {
+			const uint32_t size = buffer.size();
+			buffer.resize(size + p_len);
+			memcpy(buffer.ptr() + size, p_str, p_len);
+			if (file.is_valid() && buffer.size() >= CHUNK_SIZE) {
+				_flush();
+			}
+		}
+		void write_value(const Variant &p_var, int p_cur_indent);
+		void finish();
+
+		_FORCE_INLINE_ const LocalVector<uint8_t> &get_buffer() const { return buffer; }
+
+		Writer(const Ref<FileAccess> &p_file, const String &p_indent, bool p_sort_keys, bool p_full_precision);
+	};
+
 	Variant data;
 	String err_str;
 	int err_line = 0;
 
 	static const char *tk_name[];
 
-	static String _make_indent(const String &p_indent, int p_size);
-	static String _stringify(const Variant &p_var, const String &p_indent, int p_cur_indent, bool p_sort_keys, HashSet<const void *> &p_markers, bool p_full_precision = false);
-	static Error _get_token(const char32_t *p_str, int &index, int p_len, Token &r_token, int &line, String &r_err_str);
-	static Error _parse_value(Variant &value, Token &token, const char32_t *p_str, int &index, int p_len, int &line, String &r_err_str);
-	static Error _parse_array(Array &array, const char32_t *p_str, int &index, int p_len, int &line, String &r_err_str);
-	static Error _parse_object(Dictionary &object, const char32_t *p_str, int &index, int p_len, int &line, String &r_err_str);
-	static Error _parse_string(const String &p_json, Variant &r_ret, String &r_err_str, int &r_err_line);
+	template <class C>
+	static Error _get_token(const C *p_str, int &index, int p_len, Token &r_token, int &line, String &r_err_str);
+	template <class C>
+	static Error _parse_value(Variant &value, Token &token, const C *p_str, int &index, int p_len, int &line, String &r_err_str);
+	template <class C>
+	static Error _parse_array(Array &array, const C *p_str, int &index, int p_len, int &line, String &r_err_str);
+	template <class C>
+	static Error _parse_object(Dictionary &object, const C *p_str, int &index, int p_len, int &line, String &r_err_str);
+	template <class C>
+	static Error _parse_data(const C *p_str, int p_len, Variant &r_ret, String &r_err_str, int &r_err_line);
 
 protected:
 	static void _bind_methods();
 
 public:
 	String stringify(const Variant &p_var, const String &p_indent = "", bool p_sort_keys = true, bool p_full_precision = false);
+	static Error stringify_to_file(const Ref<FileAccess> &p_file, const Variant &p_var, const String &p_indent = "", bool p_sort_keys = true, bool p_full_precision = false);
 	Error parse(const String &p_json_string);
+	Error parse_utf8(const Vector<uint8_t> &p_json_buffer);
 
 	inline Variant get_data() const { return data; }
 	inline int get_error_line() const { return err_line; }
@@ -58,6 +58,43 @@ ObjectID EncodedObjectAsID::get_object_id() const {
 #define ENCODE_MASK 0xFF
 #define ENCODE_FLAG_64 1 << 16
 #define ENCODE_FLAG_OBJECT_AS_ID 1 << 16
+#define ENCODE_FLAG_STRING_NAME_INDEX 1 << 16
+
+void StringNameTable::add(const StringName &p_name) {
+	if (names.size() < MAX_NAMES) {
+		indices.insert(p_name, names.size());
+		names.push_back(p_name);
+	}
+}
+
+void StringNameTable::truncate(uint32_t p_size) {
+	for (uint32_t i = p_size; i < names.size(); i++) {
+		indices.erase(names[i]);
+	}
+	if (p_size < names.size()) {
+		names.resize(p_size);
+	}
+}
+
+void StringNameTable::clear() {
+	names.clear();
+	indices.clear();
+}
+
+// Copies p_count values of p_value_size bytes, which are stored in little-endian in the encoded data.
+static void _copy_little_endian(uint8_t *p_dst, const uint8_t *p_src, int p_count, int p_value_size) {
+#ifdef BIG_ENDIAN_ENABLED
+	for (int i = 0; i < p_count; i++) {
+		for (int j = 0; j < p_value_size; j++) {
+			p_dst[j] = p_src[p_value_size - 1 - j];
+		}
+		p_dst += p_value_size;
+		p_src += p_value_size;
+	}
+#else
+	memcpy(p_dst, p_src, p_count * p_value_size);
+#endif
+}
 
 static Error _decode_string(const uint8_t *&buf, int &len, int *r_len, String &r_string) {
 	ERR_FAIL_COND_V(len < 4, ERR_INVALID_DATA);
@@ -94,7 +131,7 @@ static Error _decode_string(const uint8_t *&buf, int &len, int *r_len, String &r
 	return OK;
 }
 
-Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int *r_len, bool p_allow_objects, int p_depth) {
+static Error _decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int *r_len, bool p_allow_objects, StringNameTable *r_names, int p_depth) {
 	ERR_FAIL_COND_V_MSG(p_depth > Variant::MAX_RECURSION_DEPTH, ERR_OUT_OF_MEMORY, "Variant is too deep. Bailing.");
 	const uint8_t *buf = p_buffer;
 	int len = p_len;
@@ -539,12 +576,28 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 			}
 		} break;
 		case Variant::STRING_NAME: {
+			if (type & ENCODE_FLAG_STRING_NAME_INDEX) {
+				ERR_FAIL_COND_V_MSG(!r_names, ERR_INVALID_DATA, "StringName encoded as an index, but there is no table to decode it.");
+				ERR_FAIL_COND_V(len < 4, ERR_INVALID_DATA);
+				const StringName *name = r_names->get(decode_uint32(buf));
+				ERR_FAIL_COND_V(!name, ERR_INVALID_DATA);
+				r_variant = *name;
+				if (r_len) {
+					(*r_len) += 4;
+				}
+				break;
+			}
+
 			String str;
 			Error err = _decode_string(buf, len, r_len, str);
 			if (err) {
 				return err;
 			}
-			r_variant = StringName(str);
+			StringName name = str;
+			if (r_names) {
+				r_names->add(name);
+			}
+			r_variant = name;
 
 		} break;
 
@@ -659,7 +712,7 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 
 						Variant value;
 						int used;
-						err = decode_variant(value, buf, len, &used, p_allow_objects, p_depth + 1);
+						err = _decode_variant(value, buf, len, &used, p_allow_objects, r_names, p_depth + 1);
 						if (err) {
 							return err;
 						}
@@ -720,7 +773,7 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 				Variant key, value;
 
 				int used;
-				Error err = decode_variant(key, buf, len, &used, p_allow_objects, p_depth + 1);
+				Error err = _decode_variant(key, buf, len, &used, p_allow_objects, r_names, p_depth + 1);
 				ERR_FAIL_COND_V_MSG(err != OK, err, "Error when trying to decode Variant.");
 
 				buf += used;
@@ -729,7 +782,7 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 					(*r_len) += used;
 				}
 
-				err = decode_variant(value, buf, len, &used, p_allow_objects, p_depth + 1);
+				err = _decode_variant(value, buf, len, &used, p_allow_objects, r_names, p_depth + 1);
 				ERR_FAIL_COND_V_MSG(err != OK, err, "Error when trying to decode Variant.");
 
 				buf += used;
@@ -762,7 +815,7 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 			for (int i = 0; i < count; i++) {
 				int used = 0;
 				Variant v;
-				Error err = decode_variant(v, buf, len, &used, p_allow_objects, p_depth + 1);
+				Error err = _decode_variant(v, buf, len, &used, p_allow_objects, r_names, p_depth + 1);
 				ERR_FAIL_COND_V_MSG(err != OK, err, "Error when trying to decode Variant.");
 				buf += used;
 				len -= used;
@@ -788,10 +841,7 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 
 			if (count) {
 				data.resize(count);
-				uint8_t *w = data.ptrw();
-				for (int32_t i = 0; i < count; i++) {
-					w[i] = buf[i];
-				}
+				memcpy(data.ptrw(), buf, count);
 			}
 
 			r_variant = data;
@@ -815,12 +865,8 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 			Vector<int32_t> data;
 
 			if (count) {
-				//const int*rbuf=(const int*)buf;
 				data.resize(count);
-				int32_t *w = data.ptrw();
-				for (int32_t i = 0; i < count; i++) {
-					w[i] = decode_uint32(&buf[i * 4]);
-				}
+				_copy_little_endian((uint8_t *)data.ptrw(), buf, count, 4);
 			}
 			r_variant = Variant(data);
 			if (r_len) {
@@ -839,12 +885,8 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 			Vector<int64_t> data;
 
 			if (count) {
-				//const int*rbuf=(const int*)buf;
 				data.resize(count);
-				int64_t *w = data.ptrw();
-				for (int64_t i = 0; i < count; i++) {
-					w[i] = decode_uint64(&buf[i * 8]);
-				}
+				_copy_little_endian((uint8_t *)data.ptrw(), buf, count, 8);
 			}
 			r_variant = Variant(data);
 			if (r_len) {
@@ -863,12 +905,8 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 			Vector<float> data;
 
 			if (count) {
-				//const float*rbuf=(const float*)buf;
 				data.resize(count);
-				float *w = data.ptrw();
-				for (int32_t i = 0; i < count; i++) {
-					w[i] = decode_float(&buf[i * 4]);
-				}
+				_copy_little_endian((uint8_t *)data.ptrw(), buf, count, 4);
 			}
 			r_variant = data;
 
@@ -889,10 +927,7 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 
 			if (count) {
 				data.resize(count);
-				double *w = data.ptrw();
-				for (int64_t i = 0; i < count; i++) {
-					w[i] = decode_double(&buf[i * 8]);
-				}
+				_copy_little_endian((uint8_t *)data.ptrw(), buf, count, 8);
 			}
 			r_variant = data;
 
@@ -946,10 +981,14 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 					varray.resize(count);
 					Vector2 *w = varray.ptrw();
 
+#ifdef REAL_T_IS_DOUBLE
+					_copy_little_endian((uint8_t *)w, buf, count * 2, sizeof(double));
+#else
 					for (int32_t i = 0; i < count; i++) {
 						w[i].x = decode_double(buf + i * sizeof(double) * 2 + sizeof(double) * 0);
 						w[i].y = decode_double(buf + i * sizeof(double) * 2 + sizeof(double) * 1);
 					}
+#endif
 
 					int adv = sizeof(double) * 2 * count;
 
@@ -971,10 +1010,14 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 					varray.resize(count);
 					Vector2 *w = varray.ptrw();
 
+#ifdef REAL_T_IS_DOUBLE
 					for (int32_t i = 0; i < count; i++) {
 						w[i].x = decode_float(buf + i * sizeof(float) * 2 + sizeof(float) * 0);
 						w[i].y = decode_float(buf + i * sizeof(float) * 2 + sizeof(float) * 1);
 					}
+#else
+					_copy_little_endian((uint8_t *)w, buf, count * 2, sizeof(float));
+#endif
 
 					int adv = sizeof(float) * 2 * count;
 
@@ -1006,11 +1049,15 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 					varray.resize(count);
 					Vector3 *w = varray.ptrw();
 
+#ifdef REAL_T_IS_DOUBLE
+					_copy_little_endian((uint8_t *)w, buf, count * 3, sizeof(double));
+#else
 					for (int32_t i = 0; i < count; i++) {
 						w[i].x = decode_double(buf + i * sizeof(double) * 3 + sizeof(double) * 0);
 						w[i].y = decode_double(buf + i * sizeof(double) * 3 + sizeof(double) * 1);
 						w[i].z = decode_double(buf + i * sizeof(double) * 3 + sizeof(double) * 2);
 					}
+#endif
 
 					int adv = sizeof(double) * 3 * count;
 
@@ -1032,11 +1079,15 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 					varray.resize(count);
 					Vector3 *w = varray.ptrw();
 
+#ifdef REAL_T_IS_DOUBLE
 					for (int32_t i = 0; i < count; i++) {
 						w[i].x = decode_float(buf + i * sizeof(float) * 3 + sizeof(float) * 0);
 						w[i].y = decode_float(buf + i * sizeof(float) * 3 + sizeof(float) * 1);
 						w[i].z = decode_float(buf + i * sizeof(float) * 3 + sizeof(float) * 2);
 					}
+#else
+					_copy_little_endian((uint8_t *)w, buf, count * 3, sizeof(float));
+#endif
 
 					int adv = sizeof(float) * 3 * count;
 
@@ -1067,15 +1118,8 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 
 			if (count) {
 				carray.resize(count);
-				Color *w = carray.ptrw();
-
-				for (int32_t i = 0; i < count; i++) {
-					// Colors should always be in single-precision.
-					w[i].r = decode_float(buf + i * 4 * 4 + 4 * 0);
-					w[i].g = decode_float(buf + i * 4 * 4 + 4 * 1);
-					w[i].b = decode_float(buf + i * 4 * 4 + 4 * 2);
-					w[i].a = decode_float(buf + i * 4 * 4 + 4 * 3);
-				}
+				// Colors should always be in single-precision.
+				_copy_little_endian((uint8_t *)carray.ptrw(), buf, count * 4, 4);
 
 				int adv = 4 * 4 * count;
 
@@ -1095,32 +1139,90 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 	return OK;
 }
 
-static void _encode_string(const String &p_string, uint8_t *&buf, int &r_len) {
-	CharString utf8 = p_string.utf8();
+Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int *r_len, bool p_allow_objects, int p_depth) {
+	return _decode_variant(r_variant, p_buffer, p_len, r_len, p_allow_objects, nullptr, p_depth);
+}
 
-	if (buf) {
-		encode_uint32(utf8.length(), buf);
-		buf += 4;
-		memcpy(buf, utf8.get_data(), utf8.length());
-		buf += utf8.length();
+Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int *r_len, bool p_allow_objects, StringNameTable *r_names) {
+	return _decode_variant(r_variant, p_buffer, p_len, r_len, p_allow_objects, r_names, 0);
+}
+
+// Where encode_variant() writes the variant: a buffer big enough for it, no buffer to only compute its size,
+// or a growable buffer it is appended to in a single pass, up to max_len bytes.
+struct EncodeTarget {
+	uint8_t *buffer = nullptr;
+	LocalVector<uint8_t> *growable = nullptr;
+	StringNameTable *names = nullptr;
+	int len = 0;
+	int max_len = INT_MAX;
+	bool overflowed = false;
+
+	// Returns where to write the next p_size bytes, or nullptr when only computing the size or past max_len.
+	_FORCE_INLINE_ uint8_t *advance(int p_size) {
+		uint8_t *w = nullptr;
+		if (growable) {
+			if (unlikely(overflowed || p_size > max_len - len)) {
+				overflowed = true;
+			} else {
+				const uint32_t pos = growable->size();
+				growable->resize(pos + p_size);
+				w = growable->ptr() + pos;
+			}
+		} else if (buffer) {
+			w = buffer + len;
+		}
+		len += p_size;
+		return w;
+	}
+
+	_FORCE_INLINE_ void pad() {
+		if (len % 4) {
+			const int pad = 4 - len % 4;
+			uint8_t *w = advance(pad);
+			if (w) {
+				memset(w, 0, pad);
+			}
+		}
 	}
+};
 
-	r_len += 4 + utf8.length();
-	while (r_len % 4) {
-		r_len++; //pad
+static void _encode_string(const String &p_string, EncodeTarget &r_target) {
+	const char32_t *str = p_string.ptr();
+	const int length = p_string.length();
+
+	bool ascii = true;
+	for (int i = 0; i < length; i++) {
+		if (str[i] > 0x7f) {
+			ascii = false;
+			break;
+		}
+	}
+
+	if (ascii) {
+		// Written directly, without converting the string first.
+		uint8_t *buf = r_target.advance(4 + length);
+		if (buf) {
+			encode_uint32(length, buf);
+			for (int i = 0; i < length; i++) {
+				buf[4 + i] = str[i];
+			}
+		}
+	} else {
+		CharString utf8 = p_string.utf8();
+		uint8_t *buf = r_target.advance(4 + utf8.length());
 		if (buf) {
-			*(buf++) = 0;
+			encode_uint32(utf8.length(), buf);
+			memcpy(buf + 4, utf8.get_data(), utf8.length());
 		}
 	}
+	r_target.pad();
 }
 
-Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bool p_full_objects, int p_depth) {
+static Error _encode_variant(const Variant &p_variant, EncodeTarget &r_target, bool p_full_objects, int p_depth) {
 	ERR_FAIL_COND_V_MSG(p_depth > Variant::MAX_RECURSION_DEPTH, ERR_OUT_OF_MEMORY, "Potential infinite recursion detected. Bailing.");
-	uint8_t *buf = r_buffer;
-
-	r_len = 0;
 
 	uint32_t flags = 0;
+	uint32_t string_name_index = 0;
 
 	switch (p_variant.get_type()) {
 		case Variant::INT: {
@@ -1141,10 +1243,10 @@ Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bo
 			Object *obj = p_variant.get_validated_object();
 			if (!obj) {
 				// Object is invalid, send a nullptr instead.
+				uint8_t *buf = r_target.advance(4);
 				if (buf) {
 					encode_uint32(Variant::NIL, buf);
 				}
-				r_len += 4;
 				return OK;
 			}
 
@@ -1152,6 +1254,15 @@ Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bo
 				flags |= ENCODE_FLAG_OBJECT_AS_ID;
 			}
 		} break;
+		case Variant::STRING_NAME: {
+			if (r_target.names) {
+				const uint32_t *index = r_target.names->find(p_variant);
+				if (index) {
+					flags |= ENCODE_FLAG_STRING_NAME_INDEX;
+					string_name_index = *index;
+				}
+			}
+		} break;
 #ifdef REAL_T_IS_DOUBLE
 		case Variant::VECTOR2:
 		case Variant::VECTOR3:
@@ -1171,59 +1282,53 @@ Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bo
 		} // nothing to do at this stage
 	}
 
+	uint8_t *buf = r_target.advance(4);
 	if (buf) {
 		encode_uint32(p_variant.get_type() | flags, buf);
-		buf += 4;
 	}
-	r_len += 4;
 
 	switch (p_variant.get_type()) {
 		case Variant::NIL: {
 			//nothing to do
 		} break;
 		case Variant::BOOL: {
+			buf = r_target.advance(4);
 			if (buf) {
 				encode_uint32(p_variant.operator bool(), buf);
 			}
 
-			r_len += 4;
-
 		} break;
 		case Variant::INT: {
 			if (flags & ENCODE_FLAG_64) {
 				//64 bits
+				buf = r_target.advance(8);
 				if (buf) {
 					encode_uint64(p_variant.operator int64_t(), buf);
 				}
-
-				r_len += 8;
 			} else {
+				buf = r_target.advance(4);
 				if (buf) {
 					encode_uint32(p_variant.operator int32_t(), buf);
 				}
-
-				r_len += 4;
 			}
 		} break;
 		case Variant::FLOAT: {
 			if (flags & ENCODE_FLAG_64) {
+				buf = r_target.advance(8);
 				if (buf) {
 					encode_double(p_variant.operator double(), buf);
 				}
-
-				r_len += 8;
-
 			} else {
+				buf = r_target.advance(4);
 				if (buf) {
 					encode_float(p_variant.operator float(), buf);
 				}
-
-				r_len += 4;
 			}
 
 		} break;
 		case Variant::NODE_PATH: {
 			NodePath np = p_variant;
+			buf = r_target.advance(12);
 			if (buf) {
 				encode_uint32(uint32_t(np.get_name_count()) | 0x80000000, buf); //for compatibility with the old format
 				encode_uint32(np.get_subname_count(), buf + 4);
@@ -1233,70 +1338,60 @@ Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bo
 				}
 
 				encode_uint32(np_flags, buf + 8);
-
-				buf += 12;
 			}
 
-			r_len += 12;
-
 			int total = np.get_name_count() + np.get_subname_count();
 
 			for (int i = 0; i < total; i++) {
-				String str;
-
 				if (i < np.get_name_count()) {
-					str = np.get_name(i);
+					_encode_string(np.get_name(i), r_target);
 				} else {
-					str = np.get_subname(i - np.get_name_count());
+					_encode_string(np.get_subname(i - np.get_name_count()), r_target);
 				}
+			}
 
-				CharString utf8 = str.utf8();
-
-				int pad = 0;
-
-				if (utf8.length() % 4) {
-					pad = 4 - utf8.length() % 4;
-				}
+		} break;
+		case Variant::STRING: {
+			_encode_string(p_variant, r_target);
 
+		} break;
+		case Variant::STRING_NAME: {
+			if (flags & ENCODE_FLAG_STRING_NAME_INDEX) {
+				buf = r_target.advance(4);
 				if (buf) {
-					encode_uint32(utf8.length(), buf);
-					buf += 4;
-					memcpy(buf, utf8.get_data(), utf8.length());
-					buf += pad + utf8.length();
+					encode_uint32(string_name_index, buf);
 				}
-
-				r_len += 4 + utf8.length() + pad;
+				break;
 			}
 
-		} break;
-		case Variant::STRING:
-		case Variant::STRING_NAME: {
-			_encode_string(p_variant, buf, r_len);
+			_encode_string(p_variant, r_target);
+			if (r_target.names) {
+				r_target.names->add(p_variant);
+			}
 
 		} break;
 
 		// math types
 		case Variant::VECTOR2: {
+			buf = r_target.advance(2 * sizeof(real_t));
 			if (buf) {
 				Vector2 v2 = p_variant;
 				encode_real(v2.x, &buf[0]);
 				encode_real(v2.y, &buf[sizeof(real_t)]);
 			}
 
-			r_len += 2 * sizeof(real_t);
-
 		} break;
 		case Variant::VECTOR2I: {
+			buf = r_target.advance(2 * 4);
 			if (buf) {
 				Vector2i v2 = p_variant;
 				encode_uint32(v2.x, &buf[0]);
 				encode_uint32(v2.y, &buf[4]);
 			}
 
-			r_len += 2 * 4;
-
 		} break;
 		case Variant::RECT2: {
+			buf = r_target.advance(4 * sizeof(real_t));
 			if (buf) {
 				Rect2 r2 = p_variant;
 				encode_real(r2.position.x, &buf[0]);
@@ -1304,10 +1399,10 @@ Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bo
 				encode_real(r2.size.x, &buf[sizeof(real_t) * 2]);
 				encode_real(r2.size.y, &buf[sizeof(real_t) * 3]);
 			}
-			r_len += 4 * sizeof(real_t);
 
 		} break;
 		case Variant::RECT2I: {
+			buf = r_target.advance(4 * 4);
 			if (buf) {
 				Rect2i r2 = p_variant;
 				encode_uint32(r2.position.x, &buf[0]);
@@ -1315,10 +1410,10 @@ Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bo
 				encode_uint32(r2.size.x, &buf[8]);
 				encode_uint32(r2.size.y, &buf[12]);
 			}
-			r_len += 4 * 4;
 
 		} break;
 		case Variant::VECTOR3: {
+			buf = r_target.advance(3 * sizeof(real_t));
 			if (buf) {
 				Vector3 v3 = p_variant;
 				encode_real(v3.x, &buf[0]);
@@ -1326,10 +1421,9 @@ Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bo
 				encode_real(v3.z, &buf[sizeof(real_t) * 2]);
 			}
 
-			r_len += 3 * sizeof(real_t);
-
 		} break;
 		case Variant::VECTOR3I: {
+			buf = r_target.advance(3 * 4);
 			if (buf) {
 				Vector3i v3 = p_variant;
 				encode_uint32(v3.x, &buf[0]);
@@ -1337,10 +1431,9 @@ Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bo
 				encode_uint32(v3.z, &buf[8]);
 			}
 
-			r_len += 3 * 4;
-
 		} break;
 		case Variant::TRANSFORM2D: {
+			buf = r_target.advance(6 * sizeof(real_t));
 			if (buf) {
 				Transform2D val = p_variant;
 				for (int i = 0; i < 3; i++) {
@@ -1350,10 +1443,9 @@ Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bo
 				}
 			}
 
-			r_len += 6 * sizeof(real_t);
-
 		} break;
 		case Variant::VECTOR4: {
+			buf = r_target.advance(4 * sizeof(real_t));
 			if (buf) {
 				Vector4 v4 = p_variant;
 				encode_real(v4.x, &buf[0]);
@@ -1362,10 +1454,9 @@ Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bo
 				encode_real(v4.w, &buf[sizeof(real_t) * 3]);
 			}
 
-			r_len += 4 * sizeof(real_t);
-
 		} break;
 		case Variant::VECTOR4I: {
+			buf = r_target.advance(4 * 4);
 			if (buf) {
 				Vector4i v4 = p_variant;
 				encode_uint32(v4.x, &buf[0]);
@@ -1374,10 +1465,9 @@ Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bo
 				encode_uint32(v4.w, &buf[12]);
 			}
 
-			r_len += 4 * 4;
-
 		} break;
 		case Variant::PLANE: {
+			buf = r_target.advance(4 * sizeof(real_t));
 			if (buf) {
 				Plane p = p_variant;
 				encode_real(p.normal.x, &buf[0]);
@@ -1386,10 +1476,9 @@ Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bo
 				encode_real(p.d, &buf[sizeof(real_t) * 3]);
 			}
 
-			r_len += 4 * sizeof(real_t);
-
 		} break;
 		case Variant::QUATERNION: {
+			buf = r_target.advance(4 * sizeof(real_t));
 			if (buf) {
 				Quaternion q = p_variant;
 				encode_real(q.x, &buf[0]);
@@ -1398,10 +1487,9 @@ Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bo
 				encode_real(q.w, &buf[sizeof(real_t) * 3]);
 			}
 
-			r_len += 4 * sizeof(real_t);
-
 		} break;
 		case Variant::AABB: {
+			buf = r_target.advance(6 * sizeof(real_t));
 			if (buf) {
 				AABB aabb = p_variant;
 				encode_real(aabb.position.x, &buf[0]);
@@ -1412,10 +1500,9 @@ Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bo
 				encode_real(aabb.size.z, &buf[sizeof(real_t) * 5]);
 			}
 
-			r_len += 6 * sizeof(real_t);
-
 		} break;
 		case Variant::BASIS: {
+			buf = r_target.advance(9 * sizeof(real_t));
 			if (buf) {
 				Basis val = p_variant;
 				for (int i = 0; i < 3; i++) {
@@ -1425,10 +1512,9 @@ Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bo
 				}
 			}
 
-			r_len += 9 * sizeof(real_t);
-
 		} break;
 		case Variant::TRANSFORM3D: {
+			buf = r_target.advance(12 * sizeof(real_t));
 			if (buf) {
 				Transform3D val = p_variant;
 				for (int i = 0; i < 3; i++) {
@@ -1442,10 +1528,9 @@ Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bo
 				encode_real(val.origin.z, &buf[sizeof(real_t) * 11]);
 			}
 
-			r_len += 12 * sizeof(real_t);
-
 		} break;
 		case Variant::PROJECTION: {
+			buf = r_target.advance(16 * sizeof(real_t));
 			if (buf) {
 				Projection val = p_variant;
 				for (int i = 0; i < 4; i++) {
@@ -1455,12 +1540,11 @@ Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bo
 				}
 			}
 
-			r_len += 16 * sizeof(real_t);
-
 		} break;
 
 		// misc types
 		case Variant::COLOR: {
+			buf = r_target.advance(4 * 4); // Colors should always be in single-precision.
 			if (buf) {
 				Color c = p_variant;
 				encode_float(c.r, &buf[0]);
@@ -1469,28 +1553,25 @@ Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bo
 				encode_float(c.a, &buf[12]);
 			}
 
-			r_len += 4 * 4; // Colors should always be in single-precision.
-
 		} break;
 		case Variant::RID: {
-			RID rid = p_variant;
-
+			buf = r_target.advance(8);
 			if (buf) {
+				RID rid = p_variant;
 				encode_uint64(rid.get_id(), buf);
 			}
-			r_len += 8;
 		} break;
 		case Variant::OBJECT: {
 			if (p_full_objects) {
 				Object *obj = p_variant;
 				if (!obj) {
+					buf = r_target.advance(4);
 					if (buf) {
 						encode_uint32(0, buf);
 					}
-					r_len += 4;
 
 				} else {
-					_encode_string(obj->get_class(), buf, r_len);
+					_encode_string(obj->get_class(), r_target);
 
 					List<PropertyInfo> props;
 					obj->get_property_list(&props);
@@ -1503,31 +1584,28 @@ Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bo
 						pc++;
 					}
 
+					buf = r_target.advance(4);
 					if (buf) {
 						encode_uint32(pc, buf);
-						buf += 4;
 					}
 
-					r_len += 4;
-
 					for (const PropertyInfo &E : props) {
 						if (!(E.usage & PROPERTY_USAGE_STORAGE)) {
 							continue;
 						}
 
-						_encode_string(E.name, buf, r_len);
+						_encode_string(E.name, r_target);
+						if (r_target.overflowed) {
+							return ERR_OUT_OF_MEMORY;
+						}
 
-						int len;
-						Error err = encode_variant(obj->get(E.name), buf, len, p_full_objects, p_depth + 1);
+						Error err = _encode_variant(obj->get(E.name), r_target, p_full_objects, p_depth + 1);
 						ERR_FAIL_COND_V(err, err);
-						ERR_FAIL_COND_V(len % 4, ERR_BUG);
-						r_len += len;
-						if (buf) {
-							buf += len;
-						}
+						ERR_FAIL_COND_V(r_target.len % 4, ERR_BUG);
 					}
 				}
 			} else {
+				buf = r_target.advance(8);
 				if (buf) {
 					Object *obj = p_variant.get_validated_object();
 					ObjectID id;
@@ -1537,8 +1615,6 @@ Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bo
 
 					encode_uint64(id, buf);
 				}
-
-				r_len += 8;
 			}
 
 		} break;
@@ -1547,65 +1623,54 @@ Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bo
 		case Variant::SIGNAL: {
 			Signal signal = p_variant;
 
-			_encode_string(signal.get_name(), buf, r_len);
+			_encode_string(signal.get_name(), r_target);
 
+			buf = r_target.advance(8);
 			if (buf) {
 				encode_uint64(signal.get_object_id(), buf);
 			}
-			r_len += 8;
 		} break;
 		case Variant::DICTIONARY: {
 			Dictionary d = p_variant;
 
+			buf = r_target.advance(4);
 			if (buf) {
 				encode_uint32(uint32_t(d.size()), buf);
-				buf += 4;
 			}
-			r_len += 4;
 
 			List<Variant> keys;
 			d.get_key_list(&keys);
 
 			for (const Variant &E : keys) {
-				int len;
-				Error err = encode_variant(E, buf, len, p_full_objects, p_depth + 1);
-				ERR_FAIL_COND_V(err, err);
-				ERR_FAIL_COND_V(len % 4, ERR_BUG);
-				r_len += len;
-				if (buf) {
-					buf += len;
+				if (r_target.overflowed) {
+					return ERR_OUT_OF_MEMORY; // Stop as soon as the size limit is reached.
 				}
+				Error err = _encode_variant(E, r_target, p_full_objects, p_depth + 1);
+				ERR_FAIL_COND_V(err, err);
+				ERR_FAIL_COND_V(r_target.len % 4, ERR_BUG);
 				Variant *v = d.getptr(E);
 				ERR_FAIL_COND_V(!v, ERR_BUG);
-				err = encode_variant(*v, buf, len, p_full_objects, p_depth + 1);
+				err = _encode_variant(*v, r_target, p_full_objects, p_depth + 1);
 				ERR_FAIL_COND_V(err, err);
-				ERR_FAIL_COND_V(len % 4, ERR_BUG);
-				r_len += len;
-				if (buf) {
-					buf += len;
-				}
+				ERR_FAIL_COND_V(r_target.len % 4, ERR_BUG);
 			}
 
 		} break;
 		case Variant::ARRAY: {
 			Array v = p_variant;
 
+			buf = r_target.advance(4);
 			if (buf) {
 				encode_uint32(uint32_t(v.size()), buf);
-				buf += 4;
 			}
 
-			r_len += 4;
-
 			for (int i = 0; i < v.size(); i++) {
-				int len;
-				Error err = encode_variant(v.get(i), buf, len, p_full_objects, p_depth + 1);
-				ERR_FAIL_COND_V(err, err);
-				ERR_FAIL_COND_V(len % 4, ERR_BUG);
-				r_len += len;
-				if (buf) {
-					buf += len;
+				if (r_target.overflowed) {
+					return ERR_OUT_OF_MEMORY;
 				}
+				Error err = _encode_variant(v.get(i), r_target, p_full_objects, p_depth + 1);
+				ERR_FAIL_COND_V(err, err);
+				ERR_FAIL_COND_V(r_target.len % 4, ERR_BUG);
 			}
 
 		} break;
@@ -1613,23 +1678,13 @@ Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bo
 		case Variant::PACKED_BYTE_ARRAY: {
 			Vector<uint8_t> data = p_variant;
 			int datalen = data.size();
-			int datasize = sizeof(uint8_t);
 
+			buf = r_target.advance(4 + datalen);
 			if (buf) {
 				encode_uint32(datalen, buf);
-				buf += 4;
-				const uint8_t *r = data.ptr();
-				memcpy(buf, &r[0], datalen * datasize);
-				buf += datalen * datasize;
-			}
-
-			r_len += 4 + datalen * datasize;
-			while (r_len % 4) {
-				r_len++;
-				if (buf) {
-					*(buf++) = 0;
-				}
+				memcpy(buf + 4, data.ptr(), datalen);
 			}
+			r_target.pad();
 
 		} break;
 		case Variant::PACKED_INT32_ARRAY: {
@@ -1637,97 +1692,67 @@ Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bo
 			int datalen = data.size();
 			int datasize = sizeof(int32_t);
 
+			buf = r_target.advance(4 + datalen * datasize);
 			if (buf) {
 				encode_uint32(datalen, buf);
-				buf += 4;
-				const int32_t *r = data.ptr();
-				for (int32_t i = 0; i < datalen; i++) {
-					encode_uint32(r[i], &buf[i * datasize]);
-				}
+				_copy_little_endian(buf + 4, (const uint8_t *)data.ptr(), datalen, datasize);
 			}
 
-			r_len += 4 + datalen * datasize;
-
 		} break;
 		case Variant::PACKED_INT64_ARRAY: {
 			Vector<int64_t> data = p_variant;
 			int datalen = data.size();
 			int datasize = sizeof(int64_t);
 
+			buf = r_target.advance(4 + datalen * datasize);
 			if (buf) {
 				encode_uint32(datalen, buf);
-				buf += 4;
-				const int64_t *r = data.ptr();
-				for (int64_t i = 0; i < datalen; i++) {
-					encode_uint64(r[i], &buf[i * datasize]);
-				}
+				_copy_little_endian(buf + 4, (const uint8_t *)data.ptr(), datalen, datasize);
 			}
 
-			r_len += 4 + datalen * datasize;
-
 		} break;
 		case Variant::PACKED_FLOAT32_ARRAY: {
 			Vector<float> data = p_variant;
 			int datalen = data.size();
 			int datasize = sizeof(float);
 
+			buf = r_target.advance(4 + datalen * datasize);
 			if (buf) {
 				encode_uint32(datalen, buf);
-				buf += 4;
-				const float *r = data.ptr();
-				for (int i = 0; i < datalen; i++) {
-					encode_float(r[i], &buf[i * datasize]);
-				}
+				_copy_little_endian(buf + 4, (const uint8_t *)data.ptr(), datalen, datasize);
 			}
 
-			r_len += 4 + datalen * datasize;
-
 		} break;
 		case Variant::PACKED_FLOAT64_ARRAY: {
 			Vector<double> data = p_variant;
 			int datalen = data.size();
 			int datasize = sizeof(double);
 
+			buf = r_target.advance(4 + datalen * datasize);
 			if (buf) {
 				encode_uint32(datalen, buf);
-				buf += 4;
-				const double *r = data.ptr();
-				for (int i = 0; i < datalen; i++) {
-					encode_double(r[i], &buf[i * datasize]);
-				}
+				_copy_little_endian(buf + 4, (const uint8_t *)data.ptr(), datalen, datasize);
 			}
 
-			r_len += 4 + datalen * datasize;
-
 		} break;
 		case Variant::PACKED_STRING_ARRAY: {
 			Vector<String> data = p_variant;
 			int len = data.size();
 
+			buf = r_target.advance(4);
 			if (buf) {
 				encode_uint32(len, buf);
-				buf += 4;
 			}
 
-			r_len += 4;
-
 			for (int i = 0; i < len; i++) {
-				CharString utf8 = data.get(i).utf8();
+				CharString utf8 = data[i].utf8();
 
+				buf = r_target.advance(4 + utf8.length() + 1);
 				if (buf) {
 					encode_uint32(utf8.length() + 1, buf);
-					buf += 4;
-					memcpy(buf, utf8.get_data(), utf8.length() + 1);
-					buf += utf8.length() + 1;
-				}
-
-				r_len += 4 + utf8.length() + 1;
-				while (r_len % 4) {
-					r_len++; //pad
-					if (buf) {
-						*(buf++) = 0;
-					}
+					memcpy(buf + 4, utf8.get_data(), utf8.length() + 1);
 				}
+				r_target.pad();
 			}
 
 		} break;
@@ -1735,76 +1760,34 @@ Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bo
 			Vector<Vector2> data = p_variant;
 			int len = data.size();
 
+			buf = r_target.advance(4 + sizeof(real_t) * 2 * len);
 			if (buf) {
 				encode_uint32(len, buf);
-				buf += 4;
+				_copy_little_endian(buf + 4, (const uint8_t *)data.ptr(), len * 2, sizeof(real_t));
 			}
 
-			r_len += 4;
-
-			if (buf) {
-				for (int i = 0; i < len; i++) {
-					Vector2 v = data.get(i);
-
-					encode_real(v.x, &buf[0]);
-					encode_real(v.y, &buf[sizeof(real_t)]);
-					buf += sizeof(real_t) * 2;
-				}
-			}
-
-			r_len += sizeof(real_t) * 2 * len;
-
 		} break;
 		case Variant::PACKED_VECTOR3_ARRAY: {
 			Vector<Vector3> data = p_variant;
 			int len = data.size();
 
+			buf = r_target.advance(4 + sizeof(real_t) * 3 * len);
 			if (buf) {
 				encode_uint32(len, buf);
-				buf += 4;
+				_copy_little_endian(buf + 4, (const uint8_t *)data.ptr(), len * 3, sizeof(real_t));
 			}
 
-			r_len += 4;
-
-			if (buf) {
-				for (int i = 0; i < len; i++) {
-					Vector3 v = data.get(i);
-
-					encode_real(v.x, &buf[0]);
-					encode_real(v.y, &buf[sizeof(real_t)]);
-					encode_real(v.z, &buf[sizeof(real_t) * 2]);
-					buf += sizeof(real_t) * 3;
-				}
-			}
-
-			r_len += sizeof(real_t) * 3 * len;
-
 		} break;
 		case Variant::PACKED_COLOR_ARRAY: {
 			Vector<Color> data = p_variant;
 			int len = data.size();
 
+			buf = r_target.advance(4 + 4 * 4 * len); // Colors should always be in single-precision.
 			if (buf) {
 				encode_uint32(len, buf);
-				buf += 4;
-			}
-
-			r_len += 4;
-
-			if (buf) {
-				for (int i = 0; i < len; i++) {
-					Color c = data.get(i);
-
-					encode_float(c.r, &buf[0]);
-					encode_float(c.g, &buf[4]);
-					encode_float(c.b, &buf[8]);
-					encode_float(c.a, &buf[12]);
-					buf += 4 * 4; // Colors should always be in single-precision.
-				}
+				_copy_little_endian(buf + 4, (const uint8_t *)data.ptr(), len * 4, 4);
 			}
 
-			r_len += 4 * 4 * len;
-
 		} break;
 		default: {
 			ERR_FAIL_V(ERR_BUG);
@@ -1813,3 +1796,33 @@ Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bo
 
 	return OK;
 }
+
+Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bool p_full_objects, int p_depth) {
+	EncodeTarget target;
+	target.buffer = r_buffer;
+	Error err = _encode_variant(p_variant, target, p_full_objects, p_depth);
+	r_len = target.len;
+	return err;
+}
+
+Error encode_variant(const Variant &p_variant, LocalVector<uint8_t> &r_buffer, bool p_full_objects, StringNameTable *r_names, int p_max_len) {
+	const uint32_t buffer_size = r_buffer.size();
+	const uint32_t names_size = r_names ? r_names->size() : 0;
+
+	EncodeTarget target;
+	target.growable = &r_buffer;
+	target.names = r_names;
+	target.max_len = p_max_len;
+	Error err = _encode_variant(p_variant, target, p_full_objects, 0);
+	if (target.overflowed) {
+		err = ERR_OUT_OF_MEMORY;
+	}
+	if (err != OK) {
+		// Nothing was encoded, so the other end must not know about the new names either.
+		r_buffer.resize(buffer_size);
+		if (r_names) {
+			r_names->truncate(names_size);
+		}
+	}
+	return err;
+}
@@ -33,6 +33,8 @@
 
 #include "core/math/math_defs.h"
 #include "core/object/ref_counted.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/local_vector.h"
 #include "core/typedefs.h"
 #include "core/variant/variant.h"
 
@@ -212,7 +214,34 @@ public:
 	EncodedObjectAsID() {}
 };
 
+/**
+ * The StringNames encoded or decoded on one connection. Each name is encoded in full the first
+ * time, and as its index in the table afterwards, so both ends must see the same variants in
+ * the same order: only use it on reliable and ordered transports.
+ */
+class StringNameTable {
+	LocalVector<StringName> names;
+	HashMap<StringName, uint32_t> indices;
+
+public:
+	static const uint32_t MAX_NAMES = 65536;
+
+	_FORCE_INLINE_ const uint32_t *find(const StringName &p_name) const { return indices.getptr(p_name); }
+	_FORCE_INLINE_ const StringName *get(uint32_t p_index) const { return p_index < names.size() ? &names[p_index] : nullptr; }
+	_FORCE_INLINE_ uint32_t size() const { return names.size(); }
+
+	void add(const StringName &p_name);
+	void truncate(uint32_t p_size);
+	void clear();
+};
+
 Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int *r_len = nullptr, bool p_allow_objects = false, int p_depth = 0);
 Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bool p_full_objects = false, int p_depth = 0);
 
+// Appends the variant to r_buffer in a single pass. The buffer grows as needed, so it can be reused between calls.
+// Fails with ERR_OUT_OF_MEMORY, without growing the buffer further, once the variant takes more than p_max_len bytes.
+Error encode_variant(const Variant &p_variant, LocalVector<uint8_t> &r_buffer, bool p_full_objects = false, StringNameTable *r_names = nullptr, int p_max_len = INT_MAX);
+// Decodes a variant encoded with the same StringNameTable on the other end, if r_names is not null.
+Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int *r_len, bool p_allow_objects, StringNameTable *r_names);
+
 #endif // MARSHALLS_H
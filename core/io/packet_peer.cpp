@@ -39,13 +39,23 @@ void PacketPeer::set_encode_buffer_max_size(int p_max_size) {
 	ERR_FAIL_COND_MSG(p_max_size < 1024, "Max encode buffer must be at least 1024 bytes");
 	ERR_FAIL_COND_MSG(p_max_size > 256 * 1024 * 1024, "Max encode buffer cannot exceed 256 MiB");
 	encode_buffer_max_size = next_power_of_2(p_max_size);
-	encode_buffer.clear();
+	encode_buffer.reset();
 }
 
 int PacketPeer::get_encode_buffer_max_size() const {
 	return encode_buffer_max_size;
 }
 
+void PacketPeer::set_intern_string_names(bool p_enabled) {
+	intern_string_names = p_enabled;
+	sent_string_names.clear();
+	received_string_names.clear();
+}
+
+bool PacketPeer::is_intern_string_names_enabled() const {
+	return intern_string_names;
+}
+
 Error PacketPeer::get_packet_buffer(Vector<uint8_t> &r_buffer) {
 	const uint8_t *buffer;
 	int buffer_size;
@@ -85,32 +95,25 @@ Error PacketPeer::get_var(Variant &r_variant, bool p_allow_objects) {
 		return err;
 	}
 
-	return decode_variant(r_variant, buffer, buffer_size, nullptr, p_allow_objects);
+	return decode_variant(r_variant, buffer, buffer_size, nullptr, p_allow_objects, intern_string_names ? &received_string_names : nullptr);
 }
 
 Error PacketPeer::put_var(const Variant &p_packet, bool p_full_objects) {
-	int len;
-	Error err = encode_variant(p_packet, nullptr, len, p_full_objects); // compute len first
-	if (err) {
-		return err;
-	}
-
-	if (len == 0) {
-		return OK;
-	}
+	StringNameTable *names = intern_string_names ? &sent_string_names : nullptr;
+	const uint32_t names_size = names ? names->size() : 0;
 
-	ERR_FAIL_COND_V_MSG(len > encode_buffer_max_size, ERR_OUT_OF_MEMORY, "Failed to encode variant, encode size is bigger then encode_buffer_max_size. Consider raising it via 'set_encode_buffer_max_size'.");
-
-	if (unlikely(encode_buffer.size() < len)) {
-		encode_buffer.resize(0); // Avoid realloc
-		encode_buffer.resize(next_power_of_2(len));
-	}
-
-	uint8_t *w = encode_buffer.ptrw();
-	err = encode_variant(p_packet, w, len, p_full_objects);
+	// Encoded in a single pass, in a buffer reused by all the packets. The encoding stops before the buffer grows past the limit.
+	encode_buffer.clear();
+	Error err = encode_variant(p_packet, encode_buffer, p_full_objects, names, encode_buffer_max_size);
+	ERR_FAIL_COND_V_MSG(err == ERR_OUT_OF_MEMORY, err, "Failed to encode variant, encode size is bigger then encode_buffer_max_size. Consider raising it via 'set_encode_buffer_max_size'.");
 	ERR_FAIL_COND_V_MSG(err != OK, err, "Error when trying to encode Variant.");
 
-	return put_packet(w, len);
+	err = put_packet(encode_buffer.ptr(), encode_buffer.size());
+	if (err != OK && names) {
+		// The other end will not receive the names of this packet.
+		names->truncate(names_size);
+	}
+	return err;
 }
 
 Variant PacketPeer::_bnd_get_var(bool p_allow_objects) {
@@ -147,7 +150,11 @@ void PacketPeer::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("get_encode_buffer_max_size"), &PacketPeer::get_encode_buffer_max_size);
 	ClassDB::bind_method(D_METHOD("set_encode_buffer_max_size", "max_size"), &PacketPeer::set_encode_buffer_max_size);
 
+	ClassDB::bind_method(D_METHOD("set_intern_string_names", "enabled"), &PacketPeer::set_intern_string_names);
+	ClassDB::bind_method(D_METHOD("is_intern_string_names_enabled"), &PacketPeer::is_intern_string_names_enabled);
+
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "encode_buffer_max_size"), "set_encode_buffer_max_size", "get_encode_buffer_max_size");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "intern_string_names"), "set_intern_string_names", "is_intern_string_names_enabled");
 }
 
 /***************/
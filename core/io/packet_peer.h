@@ -31,6 +31,7 @@
 #ifndef PACKET_PEER_H
 #define PACKET_PEER_H
 
+#include "core/io/marshalls.h"
 #include "core/io/stream_peer.h"
 #include "core/object/class_db.h"
 #include "core/templates/ring_buffer.h"
@@ -53,7 +54,11 @@ class PacketPeer : public RefCounted {
 	mutable Error last_get_error = OK;
 
 	int encode_buffer_max_size = 8 * 1024 * 1024;
-	Vector<uint8_t> encode_buffer;
+	LocalVector<uint8_t> encode_buffer;
+
+	bool intern_string_names = false;
+	StringNameTable sent_string_names;
+	StringNameTable received_string_names;
 
 public:
 	virtual int get_available_packet_count() const = 0;
@@ -73,6 +78,9 @@ public:
 	void set_encode_buffer_max_size(int p_max_size);
 	int get_encode_buffer_max_size() const;
 
+	void set_intern_string_names(bool p_enabled);
+	bool is_intern_string_names_enabled() const;
+
 	PacketPeer() {}
 	~PacketPeer() {}
 };
@@ -31,11 +31,15 @@
 #include "pck_packer.h"
 
 #include "core/crypto/crypto_core.h"
+#include "core/io/compression.h"
 #include "core/io/file_access.h"
 #include "core/io/file_access_encrypted.h"
 #include "core/io/file_access_pack.h" // PACK_HEADER_MAGIC, PACK_FORMAT_VERSION
+#include "core/io/marshalls.h"
 #include "core/version.h"
 
+#include <zstd.h>
+
 static int _get_pad(int p_alignment, int p_n) {
 	int rest = p_n % p_alignment;
 	int pad = 0;
@@ -48,7 +52,7 @@ static int _get_pad(int p_alignment, int p_n) {
 
 void PCKPacker::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("pck_start", "pck_name", "alignment", "key", "encrypt_directory"), &PCKPacker::pck_start, DEFVAL(32), DEFVAL("0000000000000000000000000000000000000000000000000000000000000000"), DEFVAL(false));
-	ClassDB::bind_method(D_METHOD("add_file", "pck_path", "source_path", "encrypt"), &PCKPacker::add_file, DEFVAL(false));
+	ClassDB::bind_method(D_METHOD("add_file", "pck_path", "source_path", "encrypt", "compress"), &PCKPacker::add_file, DEFVAL(false), DEFVAL(false));
 	ClassDB::bind_method(D_METHOD("flush", "verbose"), &PCKPacker::flush, DEFVAL(false));
 }
 
@@ -101,12 +105,14 @@ Error PCKPacker::pck_start(const String &p_file, int p_alignment, const String &
 	file->store_32(pack_flags); // flags
 
 	files.clear();
-	ofs = 0;
+	dictionary.clear();
 
 	return OK;
 }
 
-Error PCKPacker::add_file(const String &p_file, const String &p_src, bool p_encrypt) {
+Error PCKPacker::add_file(const String &p_file, const String &p_src, bool p_encrypt, bool p_compress) {
+	ERR_FAIL_COND_V_MSG(p_encrypt && p_compress, ERR_INVALID_PARAMETER, "A file can't be both encrypted and compressed.");
+
 	Ref<FileAccess> f = FileAccess::open(p_src, FileAccess::READ);
 	if (f.is_null()) {
 		return ERR_FILE_CANT_OPEN;
@@ -115,7 +121,6 @@ Error PCKPacker::add_file(const String &p_file, const String &p_src, bool p_encr
 	File pf;
 	pf.path = p_file;
 	pf.src_path = p_src;
-	pf.ofs = ofs;
 	pf.size = f->get_length();
 
 	Vector<uint8_t> data = FileAccess::get_file_as_array(p_src);
@@ -128,38 +133,22 @@ Error PCKPacker::add_file(const String &p_file, const String &p_src, bool p_encr
 		}
 	}
 	pf.encrypted = p_encrypt;
-
-	uint64_t _size = pf.size;
-	if (p_encrypt) { // Add encryption overhead.
-		if (_size % 16) { // Pad to encryption block size.
-			_size += 16 - (_size % 16);
-		}
-		_size += 16; // hash
-		_size += 8; // data size
-		_size += 16; // iv
+	pf.compressed = p_compress;
+
+	if (p_compress && dictionary.size() < (int)DICTIONARY_MAX_SIZE) {
+		// Small files benefit the most from the dictionary, and they are often alike at their start (headers, text formats).
+		int sample_size = MIN(data.size(), (int)MIN(DICTIONARY_SAMPLE_SIZE, DICTIONARY_MAX_SIZE - dictionary.size()));
+		int dictionary_size = dictionary.size();
+		dictionary.resize(dictionary_size + sample_size);
+		memcpy(dictionary.ptrw() + dictionary_size, data.ptr(), sample_size);
 	}
 
-	int pad = _get_pad(alignment, ofs + _size);
-	ofs = ofs + _size + pad;
-
 	files.push_back(pf);
 
 	return OK;
 }
 
-Error PCKPacker::flush(bool p_verbose) {
-	ERR_FAIL_COND_V_MSG(file.is_null(), ERR_INVALID_PARAMETER, "File must be opened before use.");
-
-	int64_t file_base_ofs = file->get_position();
-	file->store_64(0); // files base
-
-	for (int i = 0; i < 16; i++) {
-		file->store_32(0); // reserved
-	}
-
-	// write the index
-	file->store_32(files.size());
-
+Error PCKPacker::_store_directory() {
 	Ref<FileAccessEncrypted> fae;
 	Ref<FileAccess> fhead = file;
 
@@ -191,6 +180,9 @@ Error PCKPacker::flush(bool p_verbose) {
 		if (files[i].encrypted) {
 			flags |= PACK_FILE_ENCRYPTED;
 		}
+		if (files[i].compressed) {
+			flags |= PACK_FILE_COMPRESSED;
+		}
 		fhead->store_32(flags);
 	}
 
@@ -199,43 +191,141 @@ Error PCKPacker::flush(bool p_verbose) {
 		fae.unref();
 	}
 
+	return OK;
+}
+
+Error PCKPacker::_store_compressed(const File &p_file, ZSTD_CCtx_s *p_context, const ZSTD_CDict_s *p_dictionary, bool &r_compressed) {
+	Vector<uint8_t> data = FileAccess::get_file_as_array(p_file.src_path);
+	ERR_FAIL_COND_V((uint64_t)data.size() != p_file.size, ERR_FILE_CANT_READ);
+
+	// Every frame is compressed on its own, so they can be decompressed in any order.
+	const uint32_t frame_count = (p_file.size + COMPRESSION_FRAME_SIZE - 1) / COMPRESSION_FRAME_SIZE;
+	LocalVector<uint32_t> frame_sizes;
+	frame_sizes.resize(frame_count);
+	LocalVector<uint8_t> frames;
+	for (uint32_t i = 0; i < frame_count; i++) {
+		const uint8_t *src = data.ptr() + (uint64_t)i * COMPRESSION_FRAME_SIZE;
+		const size_t src_size = MIN((uint64_t)COMPRESSION_FRAME_SIZE, p_file.size - (uint64_t)i * COMPRESSION_FRAME_SIZE);
+		const size_t bound = ZSTD_compressBound(src_size);
+		const uint32_t frames_size = frames.size();
+		frames.resize(frames_size + bound);
+
+		size_t ret;
+		if (p_dictionary) {
+			ret = ZSTD_compress_usingCDict(p_context, frames.ptr() + frames_size, bound, src, src_size, p_dictionary);
+		} else {
+			ret = ZSTD_compressCCtx(p_context, frames.ptr() + frames_size, bound, src, src_size, Compression::zstd_level);
+		}
+		ERR_FAIL_COND_V_MSG(ZSTD_isError(ret), ERR_BUG, "Can't compress file: " + p_file.src_path + ".");
+		frames.resize(frames_size + ret);
+		frame_sizes[i] = ret;
+	}
+
+	// Files that don't get smaller (already compressed formats, mostly) are stored as they are.
+	r_compressed = 8 + frame_count * 4 + (uint64_t)frames.size() < p_file.size;
+	if (!r_compressed) {
+		file->store_buffer(data.ptr(), data.size());
+		return OK;
+	}
+
+	file->store_32(COMPRESSION_FRAME_SIZE);
+	file->store_32(frame_count);
+	for (uint32_t i = 0; i < frame_count; i++) {
+		file->store_32(frame_sizes[i]);
+	}
+	file->store_buffer(frames.ptr(), frames.size());
+
+	return OK;
+}
+
+Error PCKPacker::flush(bool p_verbose) {
+	ERR_FAIL_COND_V_MSG(file.is_null(), ERR_INVALID_PARAMETER, "File must be opened before use.");
+
+	int64_t file_base_ofs = file->get_position();
+	file->store_64(0); // files base
+	file->store_64(0); // dictionary offset
+	file->store_64(0); // dictionary size
+
+	for (int i = 0; i < 12; i++) {
+		file->store_32(0); // reserved
+	}
+
+	// write the index
+	file->store_32(files.size());
+
+	// The offsets of the files are only known once they are written, then the index is written again, it keeps its size.
+	int64_t directory_ofs = file->get_position();
+	Error err = _store_directory();
+	ERR_FAIL_COND_V(err != OK, err);
+
 	int header_padding = _get_pad(alignment, file->get_position());
 	for (int i = 0; i < header_padding; i++) {
 		file->store_8(Math::rand() % 256);
 	}
 
 	int64_t file_base = file->get_position();
-	file->seek(file_base_ofs);
-	file->store_64(file_base); // update files base
-	file->seek(file_base);
+
+	// A raw dictionary starting like a formatted one would be read as such.
+	if (dictionary.size() < 4 || decode_uint32(dictionary.ptr()) == ZSTD_MAGIC_DICTIONARY) {
+		dictionary.clear();
+	}
+
+	uint64_t dictionary_ofs = 0;
+	if (!dictionary.is_empty()) {
+		dictionary_ofs = file->get_position() - file_base;
+		file->store_buffer(dictionary.ptr(), dictionary.size());
+
+		int pad = _get_pad(alignment, file->get_position());
+		for (int j = 0; j < pad; j++) {
+			file->store_8(Math::rand() % 256);
+		}
+	}
+
+	ZSTD_CCtx *cctx = ZSTD_createCCtx();
+	ZSTD_CDict *cdict = nullptr;
+	if (!dictionary.is_empty()) {
+		cdict = ZSTD_createCDict(dictionary.ptr(), dictionary.size(), Compression::zstd_level);
+	}
 
 	const uint32_t buf_max = 65536;
 	uint8_t *buf = memnew_arr(uint8_t, buf_max);
 
 	int count = 0;
 	for (int i = 0; i < files.size(); i++) {
-		Ref<FileAccess> src = FileAccess::open(files[i].src_path, FileAccess::READ);
-		uint64_t to_write = files[i].size;
-
-		Ref<FileAccess> ftmp = file;
-		if (files[i].encrypted) {
-			fae.instantiate();
-			ERR_FAIL_COND_V(fae.is_null(), ERR_CANT_CREATE);
+		files.write[i].ofs = file->get_position() - file_base;
 
-			Error err = fae->open_and_parse(file, key, FileAccessEncrypted::MODE_WRITE_AES256, false);
-			ERR_FAIL_COND_V(err != OK, ERR_CANT_CREATE);
-			ftmp = fae;
-		}
+		if (files[i].compressed) {
+			bool compressed = false;
+			err = _store_compressed(files[i], cctx, cdict, compressed);
+			if (err != OK) {
+				break;
+			}
+			files.write[i].compressed = compressed;
+		} else {
+			Ref<FileAccess> src = FileAccess::open(files[i].src_path, FileAccess::READ);
+			uint64_t to_write = files[i].size;
+
+			Ref<FileAccessEncrypted> fae;
+			Ref<FileAccess> ftmp = file;
+			if (files[i].encrypted) {
+				fae.instantiate();
+				ERR_FAIL_COND_V(fae.is_null(), ERR_CANT_CREATE);
+
+				err = fae->open_and_parse(file, key, FileAccessEncrypted::MODE_WRITE_AES256, false);
+				ERR_FAIL_COND_V(err != OK, ERR_CANT_CREATE);
+				ftmp = fae;
+			}
 
-		while (to_write > 0) {
-			uint64_t read = src->get_buffer(buf, MIN(to_write, buf_max));
-			ftmp->store_buffer(buf, read);
-			to_write -= read;
-		}
+			while (to_write > 0) {
+				uint64_t read = src->get_buffer(buf, MIN(to_write, buf_max));
+				ftmp->store_buffer(buf, read);
+				to_write -= read;
+			}
 
-		if (fae.is_valid()) {
-			ftmp.unref();
-			fae.unref();
+			if (fae.is_valid()) {
+				ftmp.unref();
+				fae.unref();
+			}
 		}
 
 		int pad = _get_pad(alignment, file->get_position());
@@ -254,8 +344,21 @@ Error PCKPacker::flush(bool p_verbose) {
 		printf("\n");
 	}
 
-	file.unref();
+	ZSTD_freeCDict(cdict);
+	ZSTD_freeCCtx(cctx);
 	memdelete_arr(buf);
+	ERR_FAIL_COND_V(err != OK, err);
+
+	file->seek(file_base_ofs);
+	file->store_64(file_base); // update files base
+	file->store_64(dictionary_ofs);
+	file->store_64(dictionary.size());
+
+	file->seek(directory_ofs);
+	err = _store_directory();
+	ERR_FAIL_COND_V(err != OK, err);
+
+	file.unref();
 
 	return OK;
 }
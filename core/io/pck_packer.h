@@ -34,32 +34,42 @@
 #include "core/object/ref_counted.h"
 
 class FileAccess;
+struct ZSTD_CCtx_s;
+struct ZSTD_CDict_s;
 
 class PCKPacker : public RefCounted {
 	GDCLASS(PCKPacker, RefCounted);
 
 	Ref<FileAccess> file;
 	int alignment = 0;
-	uint64_t ofs = 0;
 
 	Vector<uint8_t> key;
 	bool enc_dir = false;
 
 	static void _bind_methods();
 
+	static const uint32_t COMPRESSION_FRAME_SIZE = 65536;
+	static const uint32_t DICTIONARY_SAMPLE_SIZE = 4096;
+	static const uint32_t DICTIONARY_MAX_SIZE = 112 * 1024;
+
 	struct File {
 		String path;
 		String src_path;
 		uint64_t ofs = 0;
 		uint64_t size = 0;
 		bool encrypted = false;
+		bool compressed = false;
 		Vector<uint8_t> md5;
 	};
 	Vector<File> files;
+	Vector<uint8_t> dictionary;
+
+	Error _store_directory();
+	Error _store_compressed(const File &p_file, ZSTD_CCtx_s *p_context, const ZSTD_CDict_s *p_dictionary, bool &r_compressed);
 
 public:
 	Error pck_start(const String &p_file, int p_alignment = 32, const String &p_key = "0000000000000000000000000000000000000000000000000000000000000000", bool p_encrypt_directory = false);
-	Error add_file(const String &p_file, const String &p_src, bool p_encrypt = false);
+	Error add_file(const String &p_file, const String &p_src, bool p_encrypt = false, bool p_compress = false);
 	Error flush(bool p_verbose = false);
 
 	PCKPacker() {}
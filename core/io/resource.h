@@ -153,8 +153,19 @@ public:
 class ResourceCache {
 	friend class Resource;
 	friend class ResourceLoader; //need the lock
-	static Mutex lock;
-	static HashMap<String, Resource *> resources;
+
+	// Sharded by path hash, so threads using different resources rarely wait on each other.
+	static const uint32_t SHARD_COUNT = 64;
+
+	struct Shard {
+		RWLock lock;
+		HashMap<String, Resource *> resources;
+		// Paths claimed by an in-flight load.
+		HashMap<String, uint32_t> loading;
+	};
+
+	static Mutex lock; // Guards the translation remapped list.
+	static Shard shards[SHARD_COUNT];
 #ifdef TOOLS_ENABLED
 	static HashMap<String, HashMap<String, String>> resource_path_cache; // Each tscn has a set of resource paths and IDs.
 	static RWLock path_cache_lock;
@@ -163,6 +174,15 @@ class ResourceCache {
 	static void clear();
 	friend void register_core_types();
 
+	_FORCE_INLINE_ static Shard &_get_shard(const String &p_path) {
+		return shards[p_path.hash() & (SHARD_COUNT - 1)];
+	}
+
+	static void _erase(const String &p_path, Resource *p_resource);
+	static void _claim_load(const String &p_path);
+	static void _release_load(const String &p_path);
+	static Ref<Resource> _get_loaded_ref(const String &p_path);
+
 public:
 	static void reload_externals();
 	static bool has(const String &p_path);
@@ -84,6 +84,7 @@ enum {
 	VARIANT_VECTOR4 = 50,
 	VARIANT_VECTOR4I = 51,
 	VARIANT_PROJECTION = 52,
+	VARIANT_DATA_BLOCK = 60,
 	OBJECT_EMPTY = 0,
 	OBJECT_EXTERNAL_RESOURCE = 1,
 	OBJECT_INTERNAL_RESOURCE = 2,
@@ -91,11 +92,19 @@ enum {
 	// Version 2: added 64 bits support for float and int.
 	// Version 3: changed nodepath encoding.
 	// Version 4: new string ID for ext/subresources, breaks forward compat.
-	FORMAT_VERSION = 4,
+	// Version 5: property schemas and data blocks, sub-resources loaded when first referenced.
+	FORMAT_VERSION = 5,
 	FORMAT_VERSION_CAN_RENAME_DEPS = 1,
 	FORMAT_VERSION_NO_NODEPATH_PROPERTY = 3,
+	FORMAT_VERSION_DATA_BLOCKS = 5,
 };
 
+// The values of a property are stored in a column when at least this many resources share the property schema.
+static const uint32_t MIN_COLUMN_ROWS = 8;
+// Packed arrays of at least this many bytes are stored in the data blocks.
+static const uint64_t MIN_DATA_BLOCK_SIZE = 4096;
+static const uint64_t DATA_BLOCK_ALIGNMENT = 16;
+
 void ResourceLoaderBinary::_advance_padding(uint32_t p_len) {
 	uint32_t extra = 4 - (p_len % 4);
 	if (extra < 4) {
@@ -401,6 +410,13 @@ Error ResourceLoaderBinary::parse_variant(Variant &r_v) {
 					if (using_named_scene_ids) { // New format.
 						ERR_FAIL_INDEX_V((int)index, internal_resources.size(), ERR_PARSE_ERROR);
 						path = internal_resources[index].path;
+
+						if (ver_format >= FORMAT_VERSION_DATA_BLOCKS && (int)index < internal_resources.size() - 1 && !internal_index_cache.has(path)) {
+							Error err = _load_internal_resource(index);
+							if (err != OK) {
+								return err;
+							}
+						}
 					} else {
 						path += res_path + "::" + itos(index);
 					}
@@ -446,9 +462,10 @@ Error ResourceLoaderBinary::parse_variant(Variant &r_v) {
 					} else {
 						if (external_resources[erindex].cache.is_null()) {
 							//cache not here yet, wait for it?
-							if (use_sub_threads) {
+							if (external_resources[erindex].requested) {
 								Error err;
 								external_resources.write[erindex].cache = ResourceLoader::load_threaded_get(external_resources[erindex].path, &err);
+								external_resources.write[erindex].requested = false;
 
 								if (err != OK || external_resources[erindex].cache.is_null()) {
 									if (!ResourceLoader::get_abort_on_missing_resources()) {
@@ -473,6 +490,10 @@ Error ResourceLoaderBinary::parse_variant(Variant &r_v) {
 		case VARIANT_CALLABLE: {
 			r_v = Callable();
 		} break;
+		case VARIANT_DATA_BLOCK: {
+			Error err = _parse_data_block(f->get_64(), r_v);
+			ERR_FAIL_COND_V(err != OK, err);
+		} break;
 		case VARIANT_SIGNAL: {
 			r_v = Signal();
 		} break;
@@ -702,6 +723,7 @@ Error ResourceLoaderBinary::load() {
 
 		} else {
 			Error err = ResourceLoader::load_threaded_request(path, external_resources[i].type, use_sub_threads, ResourceFormatLoader::CACHE_MODE_REUSE, local_path);
+			external_resources.write[i].requested = err == OK;
 			if (err != OK) {
 				if (!ResourceLoader::get_abort_on_missing_resources()) {
 					ResourceLoader::notify_dependency_error(local_path, path, external_resources[i].type);
@@ -713,161 +735,325 @@ Error ResourceLoaderBinary::load() {
 		}
 	}
 
-	for (int i = 0; i < internal_resources.size(); i++) {
-		bool main = i == (internal_resources.size() - 1);
+	if (internal_resources.is_empty()) {
+		return ERR_FILE_EOF;
+	}
+
+	for (int i = 0; i < internal_resources.size() - 1; i++) {
+		String path = internal_resources[i].path;
+		if (path.begins_with("local://")) {
+			path = path.replace_first("local://", "");
+			internal_resources.write[i].id = path;
+			internal_resources.write[i].path = res_path + "::" + path;
+		}
+	}
 
-		//maybe it is loaded already
-		String path;
-		String id;
+	file = f;
+	file_length = f->get_length();
+	file_data = f->map_region(0, file_length);
 
-		if (!main) {
-			path = internal_resources[i].path;
+	Error err = OK;
+	if (ver_format >= FORMAT_VERSION_DATA_BLOCKS) {
+		// The sub-resources are loaded by parse_variant() when first referenced, the ones that are never referenced
+		// (e.g. because the resource referencing them was in the cache already) aren't read at all.
+		err = _load_internal_resource(internal_resources.size() - 1);
+	} else {
+		for (int i = 0; i < internal_resources.size() && err == OK; i++) {
+			err = _load_internal_resource(i);
+		}
+	}
 
-			if (path.begins_with("local://")) {
-				path = path.replace_first("local://", "");
-				id = path;
-				path = res_path + "::" + path;
+	f.unref();
+	file.unref();
+	file_data = nullptr;
+	if (err != OK) {
+		return err;
+	}
 
-				internal_resources.write[i].path = path; // Update path.
-			}
+	_get_requested_external_resources();
+	resource->set_as_translation_remapped(translation_remapped);
+	error = OK;
+	return OK;
+}
 
-			if (cache_mode == ResourceFormatLoader::CACHE_MODE_REUSE && ResourceCache::has(path)) {
-				Ref<Resource> cached = ResourceCache::get_ref(path);
-				if (cached.is_valid()) {
-					//already loaded, don't do anything
-					error = OK;
-					internal_index_cache[path] = cached;
-					continue;
-				}
-			}
-		} else {
-			if (cache_mode != ResourceFormatLoader::CACHE_MODE_IGNORE && !ResourceCache::has(res_path)) {
-				path = res_path;
+Error ResourceLoaderBinary::_load_internal_resource(int p_index) {
+	const bool main = p_index == internal_resources.size() - 1;
+
+	//maybe it is loaded already
+	String path;
+
+	if (!main) {
+		path = internal_resources[p_index].path;
+
+		if (cache_mode == ResourceFormatLoader::CACHE_MODE_REUSE && ResourceCache::has(path)) {
+			Ref<Resource> cached = ResourceCache::get_ref(path);
+			if (cached.is_valid()) {
+				//already loaded, don't do anything
+				internal_index_cache[path] = cached;
+				return OK;
 			}
 		}
+	} else {
+		if (cache_mode != ResourceFormatLoader::CACHE_MODE_IGNORE && !ResourceCache::has(res_path)) {
+			path = res_path;
+		}
+	}
+
+	uint64_t offset = internal_resources[p_index].offset;
+	// The resources are stored in order, the last one is followed by the data blocks or the end marker.
+	uint64_t end = main ? (data_blocks_offset ? data_blocks_offset : file_length) : internal_resources[p_index + 1].offset;
 
-		uint64_t offset = internal_resources[i].offset;
+	// This can be called while parsing another resource, which continues afterwards.
+	Ref<FileAccess> parent = f;
+	const uint64_t parent_position = parent == file ? file->get_position() : 0;
 
+	if (_open_resource_data(offset, end)) {
+		f = resource_data_readers[resource_depth]->access;
+	} else {
+		f = file;
 		f->seek(offset);
+	}
 
-		String t = get_unicode_string();
+	// The file is restored even when parsing fails, so later reads don't come from the resource data.
+	resource_depth++;
+	Ref<Resource> res;
+	Error err = _parse_internal_resource(path, internal_resources[p_index].id, main, res);
+	resource_depth--;
+	f = parent;
+	if (parent == file) {
+		file->seek(parent_position);
+	}
+	if (err != OK) {
+		return err;
+	}
 
-		Ref<Resource> res;
+#ifdef TOOLS_ENABLED
+	res->set_edited(false);
+#endif
 
-		if (cache_mode == ResourceFormatLoader::CACHE_MODE_REPLACE && ResourceCache::has(path)) {
-			//use the existing one
-			Ref<Resource> cached = ResourceCache::get_ref(path);
-			if (cached->get_class() == t) {
-				cached->reset_state();
-				res = cached;
-			}
-		}
+	loaded_internal_resources++;
+	if (progress) {
+		*progress = loaded_internal_resources / float(internal_resources.size());
+	}
 
-		MissingResource *missing_resource = nullptr;
+	resource_cache.push_back(res);
 
-		if (res.is_null()) {
-			//did not replace
+	if (main) {
+		resource = res;
+	}
 
-			Object *obj = ClassDB::instantiate(t);
-			if (!obj) {
-				if (ResourceLoader::is_creating_missing_resources_if_class_unavailable_enabled()) {
-					//create a missing resource
-					missing_resource = memnew(MissingResource);
-					missing_resource->set_original_class(t);
-					missing_resource->set_recording_properties(true);
-					obj = missing_resource;
-				} else {
-					error = ERR_FILE_CORRUPT;
-					ERR_FAIL_V_MSG(ERR_FILE_CORRUPT, local_path + ":Resource of unrecognized type in file: " + t + ".");
-				}
-			}
+	return OK;
+}
+
+Error ResourceLoaderBinary::_parse_internal_resource(const String &p_path, const String &p_id, bool p_main, Ref<Resource> &r_res) {
+	String t = get_unicode_string();
+
+	if (cache_mode == ResourceFormatLoader::CACHE_MODE_REPLACE && ResourceCache::has(p_path)) {
+		//use the existing one
+		Ref<Resource> cached = ResourceCache::get_ref(p_path);
+		if (cached->get_class() == t) {
+			cached->reset_state();
+			r_res = cached;
+		}
+	}
+
+	MissingResource *missing_resource = nullptr;
 
-			Resource *r = Object::cast_to<Resource>(obj);
-			if (!r) {
-				String obj_class = obj->get_class();
+	if (r_res.is_null()) {
+		//did not replace
+
+		Object *obj = ClassDB::instantiate(t);
+		if (!obj) {
+			if (ResourceLoader::is_creating_missing_resources_if_class_unavailable_enabled()) {
+				//create a missing resource
+				missing_resource = memnew(MissingResource);
+				missing_resource->set_original_class(t);
+				missing_resource->set_recording_properties(true);
+				obj = missing_resource;
+			} else {
 				error = ERR_FILE_CORRUPT;
-				memdelete(obj); //bye
-				ERR_FAIL_V_MSG(ERR_FILE_CORRUPT, local_path + ":Resource type in resource field not a resource, type is: " + obj_class + ".");
+				ERR_FAIL_V_MSG(ERR_FILE_CORRUPT, local_path + ":Resource of unrecognized type in file: " + t + ".");
 			}
+		}
 
-			res = Ref<Resource>(r);
-			if (!path.is_empty() && cache_mode != ResourceFormatLoader::CACHE_MODE_IGNORE) {
-				r->set_path(path, cache_mode == ResourceFormatLoader::CACHE_MODE_REPLACE); //if got here because the resource with same path has different type, replace it
-			}
-			r->set_scene_unique_id(id);
+		Resource *r = Object::cast_to<Resource>(obj);
+		if (!r) {
+			String obj_class = obj->get_class();
+			error = ERR_FILE_CORRUPT;
+			memdelete(obj); //bye
+			ERR_FAIL_V_MSG(ERR_FILE_CORRUPT, local_path + ":Resource type in resource field not a resource, type is: " + obj_class + ".");
 		}
 
-		if (!main) {
-			internal_index_cache[path] = res;
+		r_res = Ref<Resource>(r);
+		if (!p_path.is_empty() && cache_mode != ResourceFormatLoader::CACHE_MODE_IGNORE) {
+			r->set_path(p_path, cache_mode == ResourceFormatLoader::CACHE_MODE_REPLACE); //if got here because the resource with same path has different type, replace it
 		}
+		r->set_scene_unique_id(p_id);
+	}
 
-		int pc = f->get_32();
+	if (!p_main) {
+		internal_index_cache[p_path] = r_res;
+	}
 
-		//set properties
+	const PropertySchema *schema = nullptr;
+	uint32_t row = 0;
+	int pc = 0;
 
-		Dictionary missing_resource_properties;
+	if (ver_format >= FORMAT_VERSION_DATA_BLOCKS) {
+		uint32_t schema_index = f->get_32();
+		row = f->get_32();
+		if (schema_index >= property_schemas.size()) {
+			error = ERR_FILE_CORRUPT;
+			ERR_FAIL_V(ERR_FILE_CORRUPT);
+		}
+		schema = &property_schemas[schema_index];
+		pc = schema->properties.size();
+	} else {
+		pc = f->get_32();
+	}
 
-		for (int j = 0; j < pc; j++) {
-			StringName name = _get_string();
+	//set properties
 
-			if (name == StringName()) {
-				error = ERR_FILE_CORRUPT;
-				ERR_FAIL_V(ERR_FILE_CORRUPT);
-			}
+	Dictionary missing_resource_properties;
 
-			Variant value;
+	for (int j = 0; j < pc; j++) {
+		StringName name;
+		Variant value;
 
-			error = parse_variant(value);
-			if (error) {
-				return error;
+		if (schema) {
+			const PropertySchema::Property &property = schema->properties[j];
+			name = property.name;
+			if (property.column_stride) {
+				error = _parse_data_block(property.column_offset + uint64_t(row) * property.column_stride, value);
+			} else {
+				error = parse_variant(value);
+			}
+		} else {
+			name = _get_string();
+			if (name != StringName()) {
+				error = parse_variant(value);
 			}
+		}
+
+		if (name == StringName()) {
+			error = ERR_FILE_CORRUPT;
+			ERR_FAIL_V(ERR_FILE_CORRUPT);
+		}
 
-			bool set_valid = true;
-			if (value.get_type() == Variant::OBJECT && missing_resource != nullptr) {
-				// If the property being set is a missing resource (and the parent is not),
-				// then setting it will most likely not work.
-				// Instead, save it as metadata.
+		if (error) {
+			return error;
+		}
 
-				Ref<MissingResource> mr = value;
-				if (mr.is_valid()) {
-					missing_resource_properties[name] = mr;
-					set_valid = false;
-				}
-			}
+		bool set_valid = true;
+		if (value.get_type() == Variant::OBJECT && missing_resource != nullptr) {
+			// If the property being set is a missing resource (and the parent is not),
+			// then setting it will most likely not work.
+			// Instead, save it as metadata.
 
-			if (set_valid) {
-				res->set(name, value);
+			Ref<MissingResource> mr = value;
+			if (mr.is_valid()) {
+				missing_resource_properties[name] = mr;
+				set_valid = false;
 			}
 		}
 
-		if (missing_resource) {
-			missing_resource->set_recording_properties(false);
+		if (set_valid) {
+			r_res->set(name, value);
 		}
+	}
+
+	if (missing_resource) {
+		missing_resource->set_recording_properties(false);
+	}
+
+	if (!missing_resource_properties.is_empty()) {
+		r_res->set_meta(META_MISSING_RESOURCES, missing_resource_properties);
+	}
+
+	return OK;
+}
 
-		if (!missing_resource_properties.is_empty()) {
-			res->set_meta(META_MISSING_RESOURCES, missing_resource_properties);
+bool ResourceLoaderBinary::_open_resource_data(uint64_t p_offset, uint64_t p_end) {
+	if (p_end <= p_offset || p_end > file_length) {
+		return false;
+	}
+	const uint64_t size = p_end - p_offset;
+
+	if (resource_depth == resource_data_readers.size()) {
+		ResourceDataReader *reader = memnew(ResourceDataReader);
+		reader->access.instantiate();
+		resource_data_readers.push_back(reader);
+	}
+	ResourceDataReader *reader = resource_data_readers[resource_depth];
+
+	const uint8_t *data = nullptr;
+	if (file_data) {
+		data = file_data + p_offset;
+	} else if (size <= MAX_BUFFERED_RESOURCE_SIZE) {
+		// Larger resources are mostly made of packed arrays, which are read at once anyway.
+		reader->buffer.resize(size);
+		file->seek(p_offset);
+		if (file->get_buffer(reader->buffer.ptr(), size) != size) {
+			return false;
 		}
+		data = reader->buffer.ptr();
+	} else {
+		return false;
+	}
 
-#ifdef TOOLS_ENABLED
-		res->set_edited(false);
-#endif
+	reader->access->open_custom(data, size);
+	reader->access->set_big_endian(file->is_big_endian());
+	reader->access->real_is_double = file->real_is_double;
+	return true;
+}
 
-		if (progress) {
-			*progress = (i + 1) / float(internal_resources.size());
+Error ResourceLoaderBinary::_parse_data_block(uint64_t p_offset, Variant &r_v) {
+	ERR_FAIL_COND_V(data_blocks_offset == 0 || parsing_data_block, ERR_FILE_CORRUPT);
+	const uint64_t position = data_blocks_offset + p_offset;
+	ERR_FAIL_COND_V(position >= file_length, ERR_FILE_CORRUPT);
+
+	// The blocks only hold values without objects, so no other resource is parsed meanwhile.
+	Ref<FileAccess> parent = f;
+	uint64_t parent_position = 0;
+	if (file_data) {
+		if (data_block_access.is_null()) {
+			data_block_access.instantiate();
 		}
+		data_block_access->open_custom(file_data + position, file_length - position);
+		data_block_access->set_big_endian(file->is_big_endian());
+		data_block_access->real_is_double = file->real_is_double;
+		f = data_block_access;
+	} else {
+		parent_position = file->get_position();
+		f = file;
+		f->seek(position);
+	}
 
-		resource_cache.push_back(res);
+	parsing_data_block = true;
+	Error err = parse_variant(r_v);
+	parsing_data_block = false;
 
-		if (main) {
-			f.unref();
-			resource = res;
-			resource->set_as_translation_remapped(translation_remapped);
-			error = OK;
-			return OK;
+	f = parent;
+	if (!file_data) {
+		file->seek(parent_position);
+	}
+	return err;
+}
+
+void ResourceLoaderBinary::_get_requested_external_resources() {
+	// The dependencies no property referenced were never retrieved, which they must be for their loads to be released.
+	for (int i = 0; i < external_resources.size(); i++) {
+		if (external_resources[i].requested) {
+			external_resources.write[i].cache = ResourceLoader::load_threaded_get(external_resources[i].path);
+			external_resources.write[i].requested = false;
 		}
 	}
+}
 
-	return ERR_FILE_EOF;
+ResourceLoaderBinary::~ResourceLoaderBinary() {
+	for (uint32_t i = 0; i < resource_data_readers.size(); i++) {
+		memdelete(resource_data_readers[i]);
+	}
 }
 
 void ResourceLoaderBinary::set_translation_remapped(bool p_remapped) {
@@ -1013,7 +1199,13 @@ void ResourceLoaderBinary::open(Ref<FileAccess> p_f, bool p_no_resources, bool p
 		uid = ResourceUID::INVALID_ID;
 	}
 
-	for (int i = 0; i < ResourceFormatSaverBinaryInstance::RESERVED_FIELDS; i++) {
+	int reserved_fields = ResourceFormatSaverBinaryInstance::RESERVED_FIELDS;
+	if (ver_format >= FORMAT_VERSION_DATA_BLOCKS) {
+		data_blocks_offset = f->get_64();
+		reserved_fields -= 2;
+	}
+
+	for (int i = 0; i < reserved_fields; i++) {
 		f->get_32(); //skip a few reserved fields
 	}
 
@@ -1062,6 +1254,25 @@ void ResourceLoaderBinary::open(Ref<FileAccess> p_f, bool p_no_resources, bool p
 
 	print_bl("int resources: " + itos(int_resources_size));
 
+	if (ver_format >= FORMAT_VERSION_DATA_BLOCKS) {
+		uint32_t schema_count = f->get_32();
+		property_schemas.resize(schema_count);
+		for (uint32_t i = 0; i < schema_count && !f->eof_reached(); i++) {
+			PropertySchema &schema = property_schemas[i];
+			schema.properties.resize(f->get_32());
+			for (uint32_t j = 0; j < schema.properties.size() && !f->eof_reached(); j++) {
+				PropertySchema::Property &property = schema.properties[j];
+				property.name = _get_string();
+				property.column_stride = f->get_32();
+				if (property.column_stride) {
+					property.column_offset = f->get_64();
+				}
+			}
+		}
+
+		print_bl("property schemas: " + itos(schema_count));
+	}
+
 	if (f->eof_reached()) {
 		error = ERR_FILE_CORRUPT;
 		f.unref();
@@ -1295,7 +1506,17 @@ Error ResourceFormatLoaderBinary::rename_dependencies(const String &p_path, cons
 	fw->store_32(flags);
 	fw->store_64(uid_data);
 
-	for (int i = 0; i < ResourceFormatSaverBinaryInstance::RESERVED_FIELDS; i++) {
+	int reserved_fields = ResourceFormatSaverBinaryInstance::RESERVED_FIELDS;
+	uint64_t data_blocks_ofs_pos = 0;
+	uint64_t data_blocks_ofs = 0;
+	if (ver_format >= FORMAT_VERSION_DATA_BLOCKS) {
+		data_blocks_ofs_pos = f->get_position();
+		data_blocks_ofs = f->get_64();
+		fw->store_64(0);
+		reserved_fields -= 2;
+	}
+
+	for (int i = 0; i < reserved_fields; i++) {
 		fw->store_32(0); // reserved
 		f->get_32();
 	}
@@ -1368,6 +1589,17 @@ Error ResourceFormatLoaderBinary::rename_dependencies(const String &p_path, cons
 	}
 
 	//rest of file
+	if (data_blocks_ofs) {
+		// Keep the data blocks aligned, the padding is added to the end of the last resource.
+		while (f->get_position() < data_blocks_ofs && !f->eof_reached()) {
+			fw->store_8(f->get_8());
+		}
+		while (fw->get_position() % DATA_BLOCK_ALIGNMENT) {
+			fw->store_8(0);
+		}
+		data_blocks_ofs = fw->get_position();
+	}
+
 	uint8_t b = f->get_8();
 	while (!f->eof_reached()) {
 		fw->store_8(b);
@@ -1380,6 +1612,11 @@ Error ResourceFormatLoaderBinary::rename_dependencies(const String &p_path, cons
 	fw->seek(md_ofs);
 	fw->store_64(importmd_ofs + size_diff);
 
+	if (data_blocks_ofs) {
+		fw->seek(data_blocks_ofs_pos);
+		fw->store_64(data_blocks_ofs);
+	}
+
 	if (!all_ok) {
 		return ERR_CANT_CREATE;
 	}
@@ -1449,7 +1686,110 @@ void ResourceFormatSaverBinaryInstance::_pad_buffer(Ref<FileAccess> f, int p_byt
 	}
 }
 
-void ResourceFormatSaverBinaryInstance::write_variant(Ref<FileAccess> f, const Variant &p_property, HashMap<Ref<Resource>, int> &resource_map, HashMap<Ref<Resource>, int> &external_resources, HashMap<StringName, int> &string_map, const PropertyInfo &p_hint) {
+static void _pad_to(Ref<FileAccess> f, uint64_t p_position) {
+	while (f->get_position() < p_position) {
+		f->store_8(0);
+	}
+}
+
+bool ResourceFormatSaverBinaryInstance::_get_fixed_encoding(const Variant &p_value, bool p_big_endian, uint32_t &r_code, uint32_t &r_size) {
+	switch (p_value.get_type()) {
+		case Variant::NIL:
+		case Variant::BOOL:
+		case Variant::INT:
+		case Variant::FLOAT:
+		case Variant::VECTOR2:
+		case Variant::VECTOR2I:
+		case Variant::RECT2:
+		case Variant::RECT2I:
+		case Variant::VECTOR3:
+		case Variant::VECTOR3I:
+		case Variant::VECTOR4:
+		case Variant::VECTOR4I:
+		case Variant::PLANE:
+		case Variant::QUATERNION:
+		case Variant::AABB:
+		case Variant::BASIS:
+		case Variant::TRANSFORM2D:
+		case Variant::TRANSFORM3D:
+		case Variant::PROJECTION:
+		case Variant::COLOR: {
+		} break;
+		default: {
+			return false;
+		}
+	}
+
+	// Ints and floats pick the 32 or 64 bits encoding from the value, so the encoding is checked and not only the type.
+	uint8_t buffer[256];
+	Ref<FileAccessMemory> encoding;
+	encoding.instantiate();
+	encoding->open_custom(buffer, sizeof(buffer));
+	encoding->set_big_endian(p_big_endian);
+
+	HashMap<Ref<Resource>, int> resource_map;
+	HashMap<Ref<Resource>, int> external_resources;
+	HashMap<StringName, int> string_map;
+	write_variant(encoding, p_value, resource_map, external_resources, string_map);
+
+	r_size = encoding->get_position();
+	encoding->seek(0);
+	r_code = encoding->get_32();
+	return true;
+}
+
+bool ResourceFormatSaverBinaryInstance::DataBlocks::add(Ref<FileAccess> f, const Variant &p_value) {
+	uint64_t data_size = 0;
+	switch (p_value.get_type()) {
+		case Variant::PACKED_BYTE_ARRAY: {
+			data_size = PackedByteArray(p_value).size();
+		} break;
+		case Variant::PACKED_INT32_ARRAY: {
+			data_size = PackedInt32Array(p_value).size() * sizeof(int32_t);
+		} break;
+		case Variant::PACKED_INT64_ARRAY: {
+			data_size = PackedInt64Array(p_value).size() * sizeof(int64_t);
+		} break;
+		case Variant::PACKED_FLOAT32_ARRAY: {
+			data_size = PackedFloat32Array(p_value).size() * sizeof(float);
+		} break;
+		case Variant::PACKED_FLOAT64_ARRAY: {
+			data_size = PackedFloat64Array(p_value).size() * sizeof(double);
+		} break;
+		case Variant::PACKED_VECTOR2_ARRAY: {
+			data_size = PackedVector2Array(p_value).size() * 2 * sizeof(real_t);
+		} break;
+		case Variant::PACKED_VECTOR3_ARRAY: {
+			data_size = PackedVector3Array(p_value).size() * 3 * sizeof(real_t);
+		} break;
+		case Variant::PACKED_COLOR_ARRAY: {
+			data_size = PackedColorArray(p_value).size() * 4 * sizeof(float);
+		} break;
+		default: {
+			return false;
+		}
+	}
+
+	if (data_size < MIN_DATA_BLOCK_SIZE) {
+		return false;
+	}
+
+	// The block holds the array as written by write_variant(), the data after the type and the length is aligned.
+	const uint64_t offset = ((size + 8 + DATA_BLOCK_ALIGNMENT - 1) & ~(DATA_BLOCK_ALIGNMENT - 1)) - 8;
+	arrays.push_back(p_value);
+	array_offsets.push_back(offset);
+	size = offset + 8 + data_size + (4 - data_size % 4) % 4;
+
+	f->store_32(VARIANT_DATA_BLOCK);
+	f->store_64(offset);
+	return true;
+}
+
+void ResourceFormatSaverBinaryInstance::write_variant(Ref<FileAccess> f, const Variant &p_property, HashMap<Ref<Resource>, int> &resource_map, HashMap<Ref<Resource>, int> &external_resources, HashMap<StringName, int> &string_map, const PropertyInfo &p_hint, DataBlocks *p_data_blocks) {
+	if (p_data_blocks && p_data_blocks->add(f, p_property)) {
+		return;
+	}
+
 	switch (p_property.get_type()) {
 		case Variant::NIL: {
 			f->store_32(VARIANT_NIL);
@@ -1737,8 +2077,8 @@ void ResourceFormatSaverBinaryInstance::write_variant(Ref<FileAccess> f, const V
 			d.get_key_list(&keys);
 
 			for (const Variant &E : keys) {
-				write_variant(f, E, resource_map, external_resources, string_map);
-				write_variant(f, d[E], resource_map, external_resources, string_map);
+				write_variant(f, E, resource_map, external_resources, string_map, PropertyInfo(), p_data_blocks);
+				write_variant(f, d[E], resource_map, external_resources, string_map, PropertyInfo(), p_data_blocks);
 			}
 
 		} break;
@@ -1747,7 +2087,7 @@ void ResourceFormatSaverBinaryInstance::write_variant(Ref<FileAccess> f, const V
 			Array a = p_property;
 			f->store_32(uint32_t(a.size()));
 			for (int i = 0; i < a.size(); i++) {
-				write_variant(f, a[i], resource_map, external_resources, string_map);
+				write_variant(f, a[i], resource_map, external_resources, string_map, PropertyInfo(), p_data_blocks);
 			}
 
 		} break;
@@ -2041,7 +2381,9 @@ Error ResourceFormatSaverBinaryInstance::save(const String &p_path, const Ref<Re
 	}
 	ResourceUID::ID uid = ResourceSaver::get_resource_id_for_path(p_path, true);
 	f->store_64(uid);
-	for (int i = 0; i < ResourceFormatSaverBinaryInstance::RESERVED_FIELDS; i++) {
+	uint64_t data_blocks_ofs_pos = f->get_position();
+	f->store_64(0); // offset to data blocks
+	for (int i = 0; i < ResourceFormatSaverBinaryInstance::RESERVED_FIELDS - 2; i++) {
 		f->store_32(0); // reserved
 	}
 
@@ -2174,18 +2516,126 @@ Error ResourceFormatSaverBinaryInstance::save(const String &p_path, const Ref<Re
 		resource_map[r] = res_index++;
 	}
 
+	// Resources with the same properties share a schema, the values of a property that have the same fixed size
+	// encoding in all the resources of a schema are stored in a column in the data blocks.
+	LocalVector<PropertySchema> schemas;
+	{
+		HashMap<String, int> schema_map;
+		for (ResourceData &rd : resources) {
+			String key;
+			for (uint32_t i = 0; i < rd.properties.size(); i++) {
+				key += itos(rd.properties[i].name_idx) + ",";
+			}
+
+			int *schema_index = schema_map.getptr(key);
+			if (!schema_index) {
+				PropertySchema schema;
+				for (uint32_t i = 0; i < rd.properties.size(); i++) {
+					schema.name_indices.push_back(rd.properties[i].name_idx);
+				}
+				schema_index = &schema_map.insert(key, schemas.size())->value;
+				schemas.push_back(schema);
+			}
+
+			PropertySchema &schema = schemas[*schema_index];
+			rd.schema = *schema_index;
+			rd.row = schema.rows.size();
+			schema.rows.push_back(&rd);
+		}
+	}
+
+	DataBlocks data_blocks;
+	for (uint32_t s = 0; s < schemas.size(); s++) {
+		PropertySchema &schema = schemas[s];
+		schema.column_strides.resize(schema.name_indices.size());
+		schema.column_offsets.resize(schema.name_indices.size());
+		for (uint32_t i = 0; i < schema.name_indices.size(); i++) {
+			uint32_t code = 0;
+			uint32_t stride = 0;
+			if (schema.rows.size() >= MIN_COLUMN_ROWS) {
+				for (uint32_t j = 0; j < schema.rows.size(); j++) {
+					const ResourceData *rd = schema.rows[j];
+					uint32_t row_code = 0;
+					uint32_t row_size = 0;
+					if (!_get_fixed_encoding(rd->properties[i].value, big_endian, row_code, row_size) || (stride && (row_code != code || row_size != stride))) {
+						stride = 0;
+						break;
+					}
+					code = row_code;
+					stride = row_size;
+				}
+			}
+
+			schema.column_strides[i] = stride;
+			schema.column_offsets[i] = 0;
+			if (stride) {
+				data_blocks.size = (data_blocks.size + DATA_BLOCK_ALIGNMENT - 1) & ~(DATA_BLOCK_ALIGNMENT - 1);
+				schema.column_offsets[i] = data_blocks.size;
+				data_blocks.size += uint64_t(stride) * schema.rows.size();
+			}
+		}
+	}
+
+	// save property schema table
+	f->store_32(schemas.size());
+	for (uint32_t s = 0; s < schemas.size(); s++) {
+		const PropertySchema &schema = schemas[s];
+		f->store_32(schema.name_indices.size());
+		for (uint32_t i = 0; i < schema.name_indices.size(); i++) {
+			f->store_32(schema.name_indices[i]);
+			f->store_32(schema.column_strides[i]);
+			if (schema.column_strides[i]) {
+				f->store_64(schema.column_offsets[i]);
+			}
+		}
+	}
+
 	Vector<uint64_t> ofs_table;
 
 	//now actually save the resources
 	for (const ResourceData &rd : resources) {
 		ofs_table.push_back(f->get_position());
 		save_unicode_string(f, rd.type);
-		f->store_32(rd.properties.size());
+		f->store_32(rd.schema);
+		f->store_32(rd.row);
+
+		const PropertySchema &schema = schemas[rd.schema];
+		for (uint32_t i = 0; i < rd.properties.size(); i++) {
+			if (!schema.column_strides[i]) {
+				const Property &p = rd.properties[i];
+				write_variant(f, p.value, resource_map, external_resources, string_map, p.pi, &data_blocks);
+			}
+		}
+	}
+
+	if (data_blocks.size) {
+		// Aligned in the file, so they are aligned when the file is mapped.
+		_pad_to(f, (f->get_position() + DATA_BLOCK_ALIGNMENT - 1) & ~(DATA_BLOCK_ALIGNMENT - 1));
+		uint64_t data_blocks_ofs = f->get_position();
+
+		for (uint32_t s = 0; s < schemas.size(); s++) {
+			const PropertySchema &schema = schemas[s];
+			for (uint32_t i = 0; i < schema.name_indices.size(); i++) {
+				if (!schema.column_strides[i]) {
+					continue;
+				}
+				_pad_to(f, data_blocks_ofs + schema.column_offsets[i]);
+				for (uint32_t j = 0; j < schema.rows.size(); j++) {
+					const Property &p = schema.rows[j]->properties[i];
+					write_variant(f, p.value, resource_map, external_resources, string_map, p.pi);
+				}
+				ERR_FAIL_COND_V(f->get_position() != data_blocks_ofs + schema.column_offsets[i] + uint64_t(schema.column_strides[i]) * schema.rows.size(), ERR_BUG);
+			}
+		}
 
-		for (const Property &p : rd.properties) {
-			f->store_32(p.name_idx);
-			write_variant(f, p.value, resource_map, external_resources, string_map, p.pi);
+		for (uint32_t i = 0; i < data_blocks.arrays.size(); i++) {
+			_pad_to(f, data_blocks_ofs + data_blocks.array_offsets[i]);
+			write_variant(f, data_blocks.arrays[i], resource_map, external_resources, string_map);
 		}
+		ERR_FAIL_COND_V(f->get_position() != data_blocks_ofs + data_blocks.size, ERR_BUG);
+
+		f->seek(data_blocks_ofs_pos);
+		f->store_64(data_blocks_ofs);
 	}
 
 	for (int i = 0; i < ofs_table.size(); i++) {
@@ -32,6 +32,7 @@
 #define RESOURCE_FORMAT_BINARY_H
 
 #include "core/io/file_access.h"
+#include "core/io/file_access_memory.h"
 #include "core/io/resource_loader.h"
 #include "core/io/resource_saver.h"
 
@@ -61,6 +62,7 @@ class ResourceLoaderBinary {
 		String type;
 		ResourceUID::ID uid = ResourceUID::INVALID_ID;
 		Ref<Resource> cache;
+		bool requested = false; // Loading on another thread, not retrieved yet.
 	};
 
 	bool using_named_scene_ids = false;
@@ -71,11 +73,47 @@ class ResourceLoaderBinary {
 
 	struct IntResource {
 		String path;
+		String id;
 		uint64_t offset;
 	};
 
 	Vector<IntResource> internal_resources;
 	HashMap<String, Ref<Resource>> internal_index_cache;
+	int loaded_internal_resources = 0;
+
+	// Properties shared by several resources, whose fixed size values can be stored in a column.
+	struct PropertySchema {
+		struct Property {
+			StringName name;
+			uint32_t column_stride = 0; // 0 when the values are stored with the resources.
+			uint64_t column_offset = 0;
+		};
+		LocalVector<Property> properties;
+	};
+
+	LocalVector<PropertySchema> property_schemas;
+	uint64_t data_blocks_offset = 0;
+
+	// Internal resources are decoded from memory, mapped or read into a buffer.
+	// Sub-resources can be parsed while parsing another one, so there's a reader per level.
+	struct ResourceDataReader {
+		LocalVector<uint8_t> buffer;
+		Ref<FileAccessMemory> access;
+	};
+
+	static const uint64_t MAX_BUFFERED_RESOURCE_SIZE = 65536;
+	Ref<FileAccess> file;
+	uint64_t file_length = 0;
+	const uint8_t *file_data = nullptr;
+	LocalVector<ResourceDataReader *> resource_data_readers;
+	uint32_t resource_depth = 0;
+	Ref<FileAccessMemory> data_block_access;
+	bool parsing_data_block = false;
+
+	bool _open_resource_data(uint64_t p_offset, uint64_t p_end);
+	Error _load_internal_resource(int p_index);
+	Error _parse_internal_resource(const String &p_path, const String &p_id, bool p_main, Ref<Resource> &r_res);
+	Error _parse_data_block(uint64_t p_offset, Variant &r_v);
 
 	String get_unicode_string();
 	void _advance_padding(uint32_t p_len);
@@ -88,6 +126,7 @@ class ResourceLoaderBinary {
 	friend class ResourceFormatLoaderBinary;
 
 	Error parse_variant(Variant &r_v);
+	void _get_requested_external_resources();
 
 	HashMap<String, Ref<Resource>> dependency_cache;
 
@@ -104,6 +143,7 @@ public:
 	void get_classes_used(Ref<FileAccess> p_f, HashSet<StringName> *p_classes);
 
 	ResourceLoaderBinary() {}
+	~ResourceLoaderBinary();
 };
 
 class ResourceFormatLoaderBinary : public ResourceFormatLoader {
@@ -152,15 +192,34 @@ class ResourceFormatSaverBinaryInstance {
 
 	struct ResourceData {
 		String type;
-		List<Property> properties;
+		LocalVector<Property> properties;
+		int schema = 0;
+		uint32_t row = 0;
+	};
+
+	struct PropertySchema {
+		LocalVector<int> name_indices;
+		LocalVector<const ResourceData *> rows;
+		LocalVector<uint32_t> column_strides; // 0 for the properties stored with the resources.
+		LocalVector<uint64_t> column_offsets;
 	};
 
 	static void _pad_buffer(Ref<FileAccess> f, int p_bytes);
+	static bool _get_fixed_encoding(const Variant &p_value, bool p_big_endian, uint32_t &r_code, uint32_t &r_size);
 	void _find_resources(const Variant &p_variant, bool p_main = false);
 	static void save_unicode_string(Ref<FileAccess> f, const String &p_string, bool p_bit_on_len = false);
 	int get_string_index(const String &p_string);
 
 public:
+	// Large packed arrays are moved to the data blocks at the end of the file, aligned for a direct copy.
+	struct DataBlocks {
+		uint64_t size = 0;
+		LocalVector<Variant> arrays;
+		LocalVector<uint64_t> array_offsets;
+
+		bool add(Ref<FileAccess> f, const Variant &p_value);
+	};
+
 	enum {
 		FORMAT_FLAG_NAMED_SCENE_IDS = 1,
 		FORMAT_FLAG_UIDS = 2,
@@ -170,7 +229,7 @@ public:
 		RESERVED_FIELDS = 11
 	};
 	Error save(const String &p_path, const Ref<Resource> &p_resource, uint32_t p_flags = 0);
-	static void write_variant(Ref<FileAccess> f, const Variant &p_property, HashMap<Ref<Resource>, int> &resource_map, HashMap<Ref<Resource>, int> &external_resources, HashMap<StringName, int> &string_map, const PropertyInfo &p_hint = PropertyInfo());
+	static void write_variant(Ref<FileAccess> f, const Variant &p_property, HashMap<Ref<Resource>, int> &resource_map, HashMap<Ref<Resource>, int> &external_resources, HashMap<StringName, int> &string_map, const PropertyInfo &p_hint = PropertyInfo(), DataBlocks *p_data_blocks = nullptr);
 };
 
 class ResourceFormatSaverBinary : public ResourceFormatSaver {
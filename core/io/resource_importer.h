@@ -139,6 +139,9 @@ public:
 
 	virtual Error import(const String &p_source_file, const String &p_save_path, const HashMap<StringName, Variant> &p_options, List<String> *r_platform_variants, List<String> *r_gen_files = nullptr, Variant *r_metadata = nullptr) = 0;
 	virtual bool can_import_threaded() const { return true; }
+	// True when the result of `import` only depends on the source file, the options (and the files
+	// they point to) and `get_import_settings_string`, so it can be reused from the artifact cache.
+	virtual bool can_import_from_cache() const { return false; }
 	virtual void import_threaded_begin() {}
 	virtual void import_threaded_end() {}
 
@@ -231,12 +231,17 @@ Ref<Resource> ResourceLoader::_load(const String &p_path, const String &p_origin
 
 void ResourceLoader::_thread_load_function(void *p_userdata) {
 	ThreadLoadTask &load_task = *(ThreadLoadTask *)p_userdata;
-	load_task.loader_id = Thread::get_caller_id();
 
-	if (load_task.semaphore) {
-		//this is an actual thread, so wait for Ok from semaphore
-		thread_load_semaphore->wait(); //wait until its ok to start loading
+	thread_load_mutex->lock();
+	if (load_task.started) {
+		// A thread that needed this resource already loaded it by itself.
+		thread_load_mutex->unlock();
+		return;
 	}
+	load_task.started = true;
+	load_task.loader_id = Thread::get_caller_id();
+	thread_load_mutex->unlock();
+
 	load_task.resource = _load(load_task.remapped_path, load_task.remapped_path != load_task.local_path ? load_task.local_path : String(), load_task.type_hint, load_task.cache_mode, &load_task.error, load_task.use_sub_threads, &load_task.progress);
 
 	load_task.progress = 1.0; //it was fully loaded at this point, so force progress to 1.0
@@ -247,23 +252,6 @@ void ResourceLoader::_thread_load_function(void *p_userdata) {
 	} else {
 		load_task.status = THREAD_LOAD_LOADED;
 	}
-	if (load_task.semaphore) {
-		if (load_task.start_next && thread_waiting_count > 0) {
-			thread_waiting_count--;
-			//thread loading count remains constant, this ends but another one begins
-			thread_load_semaphore->post();
-		} else {
-			thread_loading_count--; //no threads waiting, just reduce loading count
-		}
-
-		print_lt("END: load count: " + itos(thread_loading_count) + " / wait count: " + itos(thread_waiting_count) + " / suspended count: " + itos(thread_suspended_count) + " / active: " + itos(thread_loading_count - thread_suspended_count));
-
-		for (int i = 0; i < load_task.poll_requests; i++) {
-			load_task.semaphore->post();
-		}
-		memdelete(load_task.semaphore);
-		load_task.semaphore = nullptr;
-	}
 
 	if (load_task.resource.is_valid()) {
 		load_task.resource->set_path(load_task.local_path);
@@ -283,11 +271,47 @@ void ResourceLoader::_thread_load_function(void *p_userdata) {
 #endif
 
 		if (_loaded_callback) {
-			_loaded_callback(load_task.resource, load_task.local_path);
+			LoadedCallback callback;
+			callback.resource = load_task.resource;
+			callback.path = load_task.local_path;
+			pending_loaded_callbacks.push_back(callback);
 		}
 	}
 
+	// The resource is complete, it can be returned from the cache without waiting for this task.
+	ResourceCache::_release_load(load_task.local_path);
+
+	print_lt("END: " + load_task.local_path + " / waiting threads: " + itos(load_task.poll_requests));
+
+	if (load_task.semaphore) {
+		for (int i = 0; i < load_task.poll_requests; i++) {
+			load_task.semaphore->post();
+		}
+		load_task.poll_requests = 0;
+	}
+
 	thread_load_mutex->unlock();
+
+	if (Thread::get_caller_id() == Thread::get_main_id()) {
+		flush_loaded_callbacks();
+	}
+}
+
+void ResourceLoader::flush_loaded_callbacks() {
+	thread_load_mutex->lock();
+	if (pending_loaded_callbacks.is_empty()) {
+		thread_load_mutex->unlock();
+		return;
+	}
+	LocalVector<LoadedCallback> callbacks = pending_loaded_callbacks;
+	pending_loaded_callbacks.clear();
+	thread_load_mutex->unlock();
+
+	if (_loaded_callback) {
+		for (uint32_t i = 0; i < callbacks.size(); i++) {
+			_loaded_callback(callbacks[i].resource, callbacks[i].path);
+		}
+	}
 }
 
 static String _validate_local_path(const String &p_path) {
@@ -366,26 +390,20 @@ Error ResourceLoader::load_threaded_request(const String &p_path, const String &
 			thread_load_tasks[p_source_resource].sub_tasks.insert(local_path);
 		}
 
+		if (load_task.resource.is_null()) {
+			ResourceCache::_claim_load(local_path);
+		}
+
 		thread_load_tasks[local_path] = load_task;
 	}
 
 	ThreadLoadTask &load_task = thread_load_tasks[local_path];
 
-	if (load_task.resource.is_null()) { //needs to be loaded in thread
-
-		load_task.semaphore = memnew(Semaphore);
-		if (thread_loading_count < thread_load_max) {
-			thread_loading_count++;
-			thread_load_semaphore->post(); //we have free threads, so allow one
-		} else {
-			thread_waiting_count++;
-		}
-
-		print_lt("REQUEST: load count: " + itos(thread_loading_count) + " / wait count: " + itos(thread_waiting_count) + " / suspended count: " + itos(thread_suspended_count) + " / active: " + itos(thread_loading_count - thread_suspended_count));
+	if (load_task.resource.is_null() && WorkerThreadPool::get_singleton()->get_thread_count() > 0) {
+		// Without worker threads, the load runs on the first thread that gets it.
+		print_lt("REQUEST: " + local_path);
 
-		load_task.thread = memnew(Thread);
-		load_task.thread->start(_thread_load_function, &thread_load_tasks[local_path]);
-		load_task.loader_id = load_task.thread->get_id();
+		load_task.task_id = WorkerThreadPool::get_singleton()->add_native_task(&ResourceLoader::_thread_load_function, &load_task, true, "Load resource: " + local_path);
 	}
 
 	thread_load_mutex->unlock();
@@ -449,40 +467,37 @@ Ref<Resource> ResourceLoader::load_threaded_get(const String &p_path, Error *r_e
 
 	ThreadLoadTask &load_task = thread_load_tasks[local_path];
 
-	//semaphore still exists, meaning it's still loading, request poll
-	Semaphore *semaphore = load_task.semaphore;
-	if (semaphore) {
-		load_task.poll_requests++;
+	while (load_task.status == THREAD_LOAD_IN_PROGRESS) {
+		if (!load_task.started) {
+			// No thread picked the load yet, so run it here instead of blocking this thread.
+			// This is what keeps a worker loading a dependency from waiting on a task queued behind it.
+			thread_load_mutex->unlock();
+			_thread_load_function(&load_task);
+			thread_load_mutex->lock();
+			continue;
+		}
 
-		{
-			// As we got a semaphore, this means we are going to have to wait
-			// until the sub-resource is done loading
-			//
-			// As this thread will become 'blocked' we should "exchange" its
-			// active status with a waiting one, to ensure load continues.
-			//
-			// This ensures loading is never blocked and that is also within
-			// the maximum number of active threads.
-
-			if (thread_waiting_count > 0) {
-				thread_waiting_count--;
-				thread_loading_count++;
-				thread_load_semaphore->post();
-
-				load_task.start_next = false; //do not start next since we are doing it here
+		if (load_task.loader_id == Thread::get_caller_id()) {
+			thread_load_mutex->unlock();
+			if (r_error) {
+				*r_error = ERR_INVALID_PARAMETER;
 			}
+			ERR_FAIL_V_MSG(Ref<Resource>(), "Attempted to wait for a resource being loaded by this same thread, cyclic reference?");
+		}
 
-			thread_suspended_count++;
-
-			print_lt("GET: load count: " + itos(thread_loading_count) + " / wait count: " + itos(thread_waiting_count) + " / suspended count: " + itos(thread_suspended_count) + " / active: " + itos(thread_loading_count - thread_suspended_count));
+		// Another thread is loading it, wait until it's done.
+		if (!load_task.semaphore) {
+			load_task.semaphore = memnew(Semaphore);
 		}
+		Semaphore *semaphore = load_task.semaphore;
+		load_task.poll_requests++;
+
+		print_lt("GET: waiting for " + local_path);
 
 		thread_load_mutex->unlock();
 		semaphore->wait();
 		thread_load_mutex->lock();
 
-		thread_suspended_count--;
-
 		if (!thread_load_tasks.has(local_path)) { //may have been erased during unlock and this was always an invalid call
 			thread_load_mutex->unlock();
 			if (r_error) {
@@ -497,18 +512,32 @@ Ref<Resource> ResourceLoader::load_threaded_get(const String &p_path, Error *r_e
 		*r_error = load_task.error;
 	}
 
+	if (load_task.requests == 1 && load_task.task_id != WorkerThreadPool::INVALID_TASK_ID) {
+		// The pool task must be waited for to be released, even when another thread ran the load.
+		// The request is still held meanwhile, so the task can't be erased under this thread.
+		WorkerThreadPool::TaskID task_id = load_task.task_id;
+		load_task.task_id = WorkerThreadPool::INVALID_TASK_ID;
+		thread_load_mutex->unlock();
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(task_id);
+		thread_load_mutex->lock();
+	}
+
 	load_task.requests--;
 
 	if (load_task.requests == 0) {
-		if (load_task.thread) { //thread may not have been used
-			load_task.thread->wait_to_finish();
-			memdelete(load_task.thread);
+		if (load_task.semaphore) {
+			memdelete(load_task.semaphore);
 		}
 		thread_load_tasks.erase(local_path);
 	}
 
 	thread_load_mutex->unlock();
 
+	if (Thread::get_caller_id() == Thread::get_main_id()) {
+		// The loaded callback runs before the resource is handed out, without waiting for the message queue.
+		flush_loaded_callbacks();
+	}
+
 	return resource;
 }
 
@@ -520,6 +549,15 @@ Ref<Resource> ResourceLoader::load(const String &p_path, const String &p_type_hi
 	String local_path = _validate_local_path(p_path);
 
 	if (p_cache_mode != ResourceFormatLoader::CACHE_MODE_IGNORE) {
+		// Cached and not being loaded, this doesn't need the loader lock.
+		Ref<Resource> cached = ResourceCache::_get_loaded_ref(local_path);
+		if (cached.is_valid()) {
+			if (r_error) {
+				*r_error = OK;
+			}
+			return cached;
+		}
+
 		thread_load_mutex->lock();
 
 		//Is it already being loaded? poll until done
@@ -561,6 +599,7 @@ Ref<Resource> ResourceLoader::load(const String &p_path, const String &p_type_hi
 		load_task.cache_mode = p_cache_mode; //ignore
 		load_task.loader_id = Thread::get_caller_id();
 
+		ResourceCache::_claim_load(local_path);
 		thread_load_tasks[local_path] = load_task;
 
 		thread_load_mutex->unlock();
@@ -1033,16 +1072,11 @@ void ResourceLoader::remove_custom_loaders() {
 
 void ResourceLoader::initialize() {
 	thread_load_mutex = memnew(Mutex);
-	thread_load_max = OS::get_singleton()->get_processor_count();
-	thread_loading_count = 0;
-	thread_waiting_count = 0;
-	thread_suspended_count = 0;
-	thread_load_semaphore = memnew(Semaphore);
 }
 
 void ResourceLoader::finalize() {
+	pending_loaded_callbacks.clear();
 	memdelete(thread_load_mutex);
-	memdelete(thread_load_semaphore);
 }
 
 ResourceLoadErrorNotify ResourceLoader::err_notify = nullptr;
@@ -1057,12 +1091,7 @@ bool ResourceLoader::timestamp_on_load = false;
 
 Mutex *ResourceLoader::thread_load_mutex = nullptr;
 HashMap<String, ResourceLoader::ThreadLoadTask> ResourceLoader::thread_load_tasks;
-Semaphore *ResourceLoader::thread_load_semaphore = nullptr;
-
-int ResourceLoader::thread_loading_count = 0;
-int ResourceLoader::thread_waiting_count = 0;
-int ResourceLoader::thread_suspended_count = 0;
-int ResourceLoader::thread_load_max = 0;
+LocalVector<ResourceLoader::LoadedCallback> ResourceLoader::pending_loaded_callbacks;
 
 SelfList<Resource>::List ResourceLoader::remapped_list;
 HashMap<String, Vector<String>> ResourceLoader::translation_remaps;
@@ -34,8 +34,10 @@
 #include "core/io/resource.h"
 #include "core/object/gdvirtual.gen.inc"
 #include "core/object/script_language.h"
+#include "core/object/worker_thread_pool.h"
 #include "core/os/semaphore.h"
 #include "core/os/thread.h"
+#include "core/templates/local_vector.h"
 
 class ResourceFormatLoader : public RefCounted {
 	GDCLASS(ResourceFormatLoader, RefCounted);
@@ -131,7 +133,7 @@ private:
 	static Ref<ResourceFormatLoader> _find_custom_resource_format_loader(String path);
 
 	struct ThreadLoadTask {
-		Thread *thread = nullptr;
+		WorkerThreadPool::TaskID task_id = WorkerThreadPool::INVALID_TASK_ID;
 		Thread::ID loader_id = 0;
 		Semaphore *semaphore = nullptr;
 		String local_path;
@@ -144,20 +146,22 @@ private:
 		Ref<Resource> resource;
 		bool xl_remapped = false;
 		bool use_sub_threads = false;
-		bool start_next = true;
+		bool started = false; // A waiter runs the load itself if nobody started it.
 		int requests = 0;
 		int poll_requests = 0;
 		HashSet<String> sub_tasks;
 	};
 
+	struct LoadedCallback {
+		Ref<Resource> resource;
+		String path;
+	};
+
 	static void _thread_load_function(void *p_userdata);
 	static Mutex *thread_load_mutex;
 	static HashMap<String, ThreadLoadTask> thread_load_tasks;
-	static Semaphore *thread_load_semaphore;
-	static int thread_waiting_count;
-	static int thread_loading_count;
-	static int thread_suspended_count;
-	static int thread_load_max;
+	// The loaded callback may touch the editor, so the loads finished on other threads queue it for the main loop.
+	static LocalVector<LoadedCallback> pending_loaded_callbacks;
 
 	static float _dependency_get_progress(const String &p_path);
 
@@ -219,6 +223,8 @@ public:
 	static void clear_translation_remaps();
 
 	static void set_load_callback(ResourceLoadedCallback p_callback);
+	// Runs the loaded callback for the loads finished on other threads. Called by the main loop every frame.
+	static void flush_loaded_callbacks();
 	static ResourceLoaderImport import;
 
 	static bool add_custom_resource_format_loader(String script_path);
@@ -53,6 +53,8 @@ void AStar3D::add_point(int64_t p_id, const Vector3 &p_pos, real_t p_weight_scal
 	bool p_exists = points.lookup(p_id, found_pt);
 
 	if (!p_exists) {
+		_unfreeze();
+
 		Point *pt = memnew(Point);
 		pt->id = p_id;
 		pt->pos = p_pos;
@@ -65,6 +67,10 @@ void AStar3D::add_point(int64_t p_id, const Vector3 &p_pos, real_t p_weight_scal
 	} else {
 		found_pt->pos = p_pos;
 		found_pt->weight_scale = p_weight_scale;
+		if (frozen) {
+			frozen_point_data[found_pt->frozen_index].pos = p_pos;
+			frozen_point_data[found_pt->frozen_index].weight_scale = p_weight_scale;
+		}
 	}
 }
 
@@ -82,6 +88,9 @@ void AStar3D::set_point_position(int64_t p_id, const Vector3 &p_pos) {
 	ERR_FAIL_COND_MSG(!p_exists, vformat("Can't set point's position. Point with id: %d doesn't exist.", p_id));
 
 	p->pos = p_pos;
+	if (frozen) {
+		frozen_point_data[p->frozen_index].pos = p_pos;
+	}
 }
 
 real_t AStar3D::get_point_weight_scale(int64_t p_id) const {
@@ -99,6 +108,9 @@ void AStar3D::set_point_weight_scale(int64_t p_id, real_t p_weight_scale) {
 	ERR_FAIL_COND_MSG(p_weight_scale < 0.0, vformat("Can't set point's weight scale less than 0.0: %f.", p_weight_scale));
 
 	p->weight_scale = p_weight_scale;
+	if (frozen) {
+		frozen_point_data[p->frozen_index].weight_scale = p_weight_scale;
+	}
 }
 
 void AStar3D::remove_point(int64_t p_id) {
@@ -106,6 +118,8 @@ void AStar3D::remove_point(int64_t p_id) {
 	bool p_exists = points.lookup(p_id, p);
 	ERR_FAIL_COND_MSG(!p_exists, vformat("Can't remove point. Point with id: %d doesn't exist.", p_id));
 
+	_unfreeze();
+
 	for (OAHashMap<int64_t, Point *>::Iterator it = p->neighbours.iter(); it.valid; it = p->neighbours.next_iter(it)) {
 		Segment s(p_id, (*it.key));
 		segments.erase(s);
@@ -138,6 +152,8 @@ void AStar3D::connect_points(int64_t p_id, int64_t p_with_id, bool bidirectional
 	bool to_exists = points.lookup(p_with_id, b);
 	ERR_FAIL_COND_MSG(!to_exists, vformat("Can't connect points. Point with id: %d doesn't exist.", p_with_id));
 
+	_unfreeze();
+
 	a->neighbours.set(b->id, b);
 
 	if (bidirectional) {
@@ -174,6 +190,8 @@ void AStar3D::disconnect_points(int64_t p_id, int64_t p_with_id, bool bidirectio
 	bool b_exists = points.lookup(p_with_id, b);
 	ERR_FAIL_COND_MSG(!b_exists, vformat("Can't disconnect points. Point with id: %d doesn't exist.", p_with_id));
 
+	_unfreeze();
+
 	Segment s(p_id, p_with_id);
 	int remove_direction = bidirectional ? (int)Segment::BIDIRECTIONAL : (int)s.direction;
 
@@ -242,6 +260,7 @@ bool AStar3D::are_points_connected(int64_t p_id, int64_t p_with_id, bool bidirec
 }
 
 void AStar3D::clear() {
+	_unfreeze();
 	last_free_id = 0;
 	for (OAHashMap<int64_t, Point *>::Iterator it = points.iter(); it.valid; it = points.next_iter(it)) {
 		memdelete(*(it.value));
@@ -250,6 +269,60 @@ void AStar3D::clear() {
 	points.clear();
 }
 
+void AStar3D::freeze() {
+	_unfreeze();
+
+	const uint32_t point_count = points.get_num_elements();
+	frozen_points.resize(point_count);
+	frozen_point_data.resize(point_count);
+	frozen_states.resize(point_count);
+
+	uint32_t index = 0;
+	uint32_t neighbour_count = 0;
+	for (OAHashMap<int64_t, Point *>::Iterator it = points.iter(); it.valid; it = points.next_iter(it)) {
+		Point *p = *(it.value);
+		p->frozen_index = index;
+		frozen_points[index] = p;
+		frozen_point_data[index].id = p->id;
+		frozen_point_data[index].pos = p->pos;
+		frozen_point_data[index].weight_scale = p->weight_scale;
+		frozen_point_data[index].enabled = p->enabled;
+		neighbour_count += p->neighbours.get_num_elements();
+		index++;
+	}
+
+	frozen_neighbour_offsets.resize(point_count + 1);
+	frozen_neighbours.resize(neighbour_count);
+	uint32_t offset = 0;
+	for (uint32_t i = 0; i < point_count; i++) {
+		frozen_neighbour_offsets[i] = offset;
+		const OAHashMap<int64_t, Point *> &neighbours = frozen_points[i]->neighbours;
+		for (OAHashMap<int64_t, Point *>::Iterator it = neighbours.iter(); it.valid; it = neighbours.next_iter(it)) {
+			frozen_neighbours[offset++] = (*it.value)->frozen_index;
+		}
+	}
+	frozen_neighbour_offsets[point_count] = offset;
+
+	frozen = true;
+}
+
+bool AStar3D::is_frozen() const {
+	return frozen;
+}
+
+void AStar3D::_unfreeze() {
+	if (!frozen) {
+		return;
+	}
+	frozen = false;
+	frozen_points.clear();
+	frozen_point_data.clear();
+	frozen_neighbour_offsets.clear();
+	frozen_neighbours.clear();
+	frozen_states.clear();
+	frozen_open_list.clear();
+}
+
 int64_t AStar3D::get_point_count() const {
 	return points.get_num_elements();
 }
@@ -318,7 +391,154 @@ Vector3 AStar3D::get_closest_position_in_segment(const Vector3 &p_point) const {
 	return closest_point;
 }
 
+bool AStar3D::_frozen_is_better(uint32_t p_a, uint32_t p_b) const {
+	const FrozenState &a = frozen_states[p_a];
+	const FrozenState &b = frozen_states[p_b];
+	if (a.f_score != b.f_score) {
+		return a.f_score < b.f_score;
+	}
+	return a.g_score > b.g_score; // If the f_costs are the same then prioritize the points that are further away from the start.
+}
+
+void AStar3D::_frozen_sift_up(uint32_t p_heap_index) {
+	const uint32_t point = frozen_open_list[p_heap_index];
+	while (p_heap_index > 0) {
+		const uint32_t parent_index = (p_heap_index - 1) / 2;
+		const uint32_t parent = frozen_open_list[parent_index];
+		if (!_frozen_is_better(point, parent)) {
+			break;
+		}
+		frozen_open_list[p_heap_index] = parent;
+		frozen_states[parent].heap_index = p_heap_index;
+		p_heap_index = parent_index;
+	}
+	frozen_open_list[p_heap_index] = point;
+	frozen_states[point].heap_index = p_heap_index;
+}
+
+void AStar3D::_frozen_sift_down(uint32_t p_heap_index) {
+	const uint32_t point = frozen_open_list[p_heap_index];
+	const uint32_t size = frozen_open_list.size();
+	while (true) {
+		uint32_t child_index = p_heap_index * 2 + 1;
+		if (child_index >= size) {
+			break;
+		}
+		if (child_index + 1 < size && _frozen_is_better(frozen_open_list[child_index + 1], frozen_open_list[child_index])) {
+			child_index++;
+		}
+		const uint32_t child = frozen_open_list[child_index];
+		if (!_frozen_is_better(child, point)) {
+			break;
+		}
+		frozen_open_list[p_heap_index] = child;
+		frozen_states[child].heap_index = p_heap_index;
+		p_heap_index = child_index;
+	}
+	frozen_open_list[p_heap_index] = point;
+	frozen_states[point].heap_index = p_heap_index;
+}
+
+// Same search as `_solve`, on the frozen graph. The costs are still asked to the owner, so the
+// overrides of `_compute_cost` and `_estimate_cost` (from AStar3D or AStar2D) are respected.
+template <class T>
+bool AStar3D::_solve_frozen(T *p_owner, Point *begin_point, Point *end_point) {
+	pass++;
+
+	if (!end_point->enabled) {
+		return false;
+	}
+
+	const uint32_t begin = begin_point->frozen_index;
+	const uint32_t end = end_point->frozen_index;
+	const int64_t end_id = end_point->id;
+
+	frozen_open_list.clear();
+
+	FrozenState &begin_state = frozen_states[begin];
+	begin_state.g_score = 0;
+	frozen_cost_from = begin;
+	frozen_cost_to = end;
+	begin_state.f_score = p_owner->_estimate_cost(begin_point->id, end_id);
+	begin_state.open_pass = pass;
+	frozen_open_list.push_back(begin);
+	_frozen_sift_up(0);
+
+	bool found_route = false;
+
+	while (!frozen_open_list.is_empty()) {
+		const uint32_t p = frozen_open_list[0]; // The currently processed point.
+
+		if (p == end) {
+			found_route = true;
+			break;
+		}
+
+		// Remove the current point from the open list.
+		const uint32_t last = frozen_open_list[frozen_open_list.size() - 1];
+		frozen_open_list.resize(frozen_open_list.size() - 1);
+		if (!frozen_open_list.is_empty()) {
+			frozen_open_list[0] = last;
+			_frozen_sift_down(0);
+		}
+
+		FrozenState &p_state = frozen_states[p];
+		p_state.closed_pass = pass; // Mark the point as closed.
+		const int64_t p_id = frozen_point_data[p].id;
+
+		const uint32_t neighbours_end = frozen_neighbour_offsets[p + 1];
+		for (uint32_t i = frozen_neighbour_offsets[p]; i < neighbours_end; i++) {
+			const uint32_t e = frozen_neighbours[i]; // The neighbour point.
+			const FrozenPoint &e_point = frozen_point_data[e];
+			FrozenState &e_state = frozen_states[e];
+
+			if (!e_point.enabled || e_state.closed_pass == pass) {
+				continue;
+			}
+
+			frozen_cost_from = p;
+			frozen_cost_to = e;
+			real_t tentative_g_score = p_state.g_score + p_owner->_compute_cost(p_id, e_point.id) * e_point.weight_scale;
+
+			bool new_point = false;
+
+			if (e_state.open_pass != pass) { // The point wasn't inside the open list.
+				e_state.open_pass = pass;
+				new_point = true;
+			} else if (tentative_g_score >= e_state.g_score) { // The new path is worse than the previous.
+				continue;
+			}
+
+			e_state.prev_point = p;
+			e_state.g_score = tentative_g_score;
+			frozen_cost_from = e;
+			frozen_cost_to = end;
+			e_state.f_score = e_state.g_score + p_owner->_estimate_cost(e_point.id, end_id);
+
+			if (new_point) {
+				frozen_open_list.push_back(e);
+				_frozen_sift_up(frozen_open_list.size() - 1);
+			} else {
+				_frozen_sift_up(e_state.heap_index);
+			}
+		}
+	}
+
+	if (found_route) {
+		// Link the points of the route, which is all the path reconstruction reads.
+		for (uint32_t p = end; p != begin; p = frozen_states[p].prev_point) {
+			frozen_points[p]->prev_point = frozen_points[frozen_states[p].prev_point];
+		}
+	}
+
+	return found_route;
+}
+
 bool AStar3D::_solve(Point *begin_point, Point *end_point) {
+	if (frozen) {
+		return _solve_frozen(this, begin_point, end_point);
+	}
+
 	pass++;
 
 	if (!end_point->enabled) {
@@ -385,6 +605,9 @@ real_t AStar3D::_estimate_cost(int64_t p_from_id, int64_t p_to_id) {
 	if (GDVIRTUAL_CALL(_estimate_cost, p_from_id, p_to_id, scost)) {
 		return scost;
 	}
+	if (_get_frozen_cost(p_from_id, p_to_id, scost)) {
+		return scost;
+	}
 
 	Point *from_point;
 	bool from_exists = points.lookup(p_from_id, from_point);
@@ -402,6 +625,9 @@ real_t AStar3D::_compute_cost(int64_t p_from_id, int64_t p_to_id) {
 	if (GDVIRTUAL_CALL(_compute_cost, p_from_id, p_to_id, scost)) {
 		return scost;
 	}
+	if (_get_frozen_cost(p_from_id, p_to_id, scost)) {
+		return scost;
+	}
 
 	Point *from_point;
 	bool from_exists = points.lookup(p_from_id, from_point);
@@ -518,6 +744,9 @@ void AStar3D::set_point_disabled(int64_t p_id, bool p_disabled) {
 	ERR_FAIL_COND_MSG(!p_exists, vformat("Can't set if point is disabled. Point with id: %d doesn't exist.", p_id));
 
 	p->enabled = !p_disabled;
+	if (frozen) {
+		frozen_point_data[p->frozen_index].enabled = !p_disabled;
+	}
 }
 
 bool AStar3D::is_point_disabled(int64_t p_id) const {
@@ -552,6 +781,9 @@ void AStar3D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("reserve_space", "num_nodes"), &AStar3D::reserve_space);
 	ClassDB::bind_method(D_METHOD("clear"), &AStar3D::clear);
 
+	ClassDB::bind_method(D_METHOD("freeze"), &AStar3D::freeze);
+	ClassDB::bind_method(D_METHOD("is_frozen"), &AStar3D::is_frozen);
+
 	ClassDB::bind_method(D_METHOD("get_closest_point", "to_position", "include_disabled"), &AStar3D::get_closest_point, DEFVAL(false));
 	ClassDB::bind_method(D_METHOD("get_closest_position_in_segment", "to_position"), &AStar3D::get_closest_position_in_segment);
 
@@ -645,6 +877,14 @@ void AStar2D::reserve_space(int64_t p_num_nodes) {
 	astar.reserve_space(p_num_nodes);
 }
 
+void AStar2D::freeze() {
+	astar.freeze();
+}
+
+bool AStar2D::is_frozen() const {
+	return astar.is_frozen();
+}
+
 int64_t AStar2D::get_closest_point(const Vector2 &p_point, bool p_include_disabled) const {
 	return astar.get_closest_point(Vector3(p_point.x, p_point.y, 0), p_include_disabled);
 }
@@ -659,6 +899,9 @@ real_t AStar2D::_estimate_cost(int64_t p_from_id, int64_t p_to_id) {
 	if (GDVIRTUAL_CALL(_estimate_cost, p_from_id, p_to_id, scost)) {
 		return scost;
 	}
+	if (astar._get_frozen_cost(p_from_id, p_to_id, scost)) {
+		return scost;
+	}
 
 	AStar3D::Point *from_point;
 	bool from_exists = astar.points.lookup(p_from_id, from_point);
@@ -676,6 +919,9 @@ real_t AStar2D::_compute_cost(int64_t p_from_id, int64_t p_to_id) {
 	if (GDVIRTUAL_CALL(_compute_cost, p_from_id, p_to_id, scost)) {
 		return scost;
 	}
+	if (astar._get_frozen_cost(p_from_id, p_to_id, scost)) {
+		return scost;
+	}
 
 	AStar3D::Point *from_point;
 	bool from_exists = astar.points.lookup(p_from_id, from_point);
@@ -786,6 +1032,10 @@ Vector<int64_t> AStar2D::get_id_path(int64_t p_from_id, int64_t p_to_id) {
 }
 
 bool AStar2D::_solve(AStar3D::Point *begin_point, AStar3D::Point *end_point) {
+	if (astar.frozen) {
+		return astar._solve_frozen(this, begin_point, end_point);
+	}
+
 	astar.pass++;
 
 	if (!end_point->enabled) {
@@ -871,6 +1121,9 @@ void AStar2D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("reserve_space", "num_nodes"), &AStar2D::reserve_space);
 	ClassDB::bind_method(D_METHOD("clear"), &AStar2D::clear);
 
+	ClassDB::bind_method(D_METHOD("freeze"), &AStar2D::freeze);
+	ClassDB::bind_method(D_METHOD("is_frozen"), &AStar2D::is_frozen);
+
 	ClassDB::bind_method(D_METHOD("get_closest_point", "to_position", "include_disabled"), &AStar2D::get_closest_point, DEFVAL(false));
 	ClassDB::bind_method(D_METHOD("get_closest_position_in_segment", "to_position"), &AStar2D::get_closest_position_in_segment);
 
@@ -34,6 +34,7 @@
 #include "core/object/gdvirtual.gen.inc"
 #include "core/object/ref_counted.h"
 #include "core/object/script_language.h"
+#include "core/templates/local_vector.h"
 #include "core/templates/oa_hash_map.h"
 
 /**
@@ -61,6 +62,9 @@ class AStar3D : public RefCounted {
 		real_t f_score = 0;
 		uint64_t open_pass = 0;
 		uint64_t closed_pass = 0;
+
+		// Index in the frozen graph.
+		uint32_t frozen_index = 0;
 	};
 
 	struct SortPoints {
@@ -111,6 +115,47 @@ class AStar3D : public RefCounted {
 	OAHashMap<int64_t, Point *> points;
 	HashSet<Segment, Segment> segments;
 
+	struct FrozenPoint {
+		int64_t id = 0;
+		Vector3 pos;
+		real_t weight_scale = 0;
+		bool enabled = false;
+	};
+
+	struct FrozenState {
+		real_t g_score = 0;
+		real_t f_score = 0;
+		uint32_t prev_point = 0;
+		uint32_t heap_index = 0;
+		uint64_t open_pass = 0;
+		uint64_t closed_pass = 0;
+	};
+
+	// Compact copy of the graph built by freeze(), with dense point indices.
+	bool frozen = false;
+	LocalVector<Point *> frozen_points;
+	LocalVector<FrozenPoint> frozen_point_data;
+	LocalVector<uint32_t> frozen_neighbour_offsets;
+	LocalVector<uint32_t> frozen_neighbours;
+	LocalVector<FrozenState> frozen_states;
+	LocalVector<uint32_t> frozen_open_list;
+	uint32_t frozen_cost_from = 0;
+	uint32_t frozen_cost_to = 0;
+
+	void _unfreeze();
+	_FORCE_INLINE_ bool _get_frozen_cost(int64_t p_from_id, int64_t p_to_id, real_t &r_cost) const {
+		if (!frozen || frozen_point_data[frozen_cost_from].id != p_from_id || frozen_point_data[frozen_cost_to].id != p_to_id) {
+			return false;
+		}
+		r_cost = frozen_point_data[frozen_cost_from].pos.distance_to(frozen_point_data[frozen_cost_to].pos);
+		return true;
+	}
+	_FORCE_INLINE_ bool _frozen_is_better(uint32_t p_a, uint32_t p_b) const;
+	void _frozen_sift_up(uint32_t p_heap_index);
+	void _frozen_sift_down(uint32_t p_heap_index);
+	template <class T>
+	bool _solve_frozen(T *p_owner, Point *begin_point, Point *end_point);
+
 	bool _solve(Point *begin_point, Point *end_point);
 
 protected:
@@ -147,6 +192,9 @@ public:
 	void reserve_space(int64_t p_num_nodes);
 	void clear();
 
+	void freeze();
+	bool is_frozen() const;
+
 	int64_t get_closest_point(const Vector3 &p_point, bool p_include_disabled = false) const;
 	Vector3 get_closest_position_in_segment(const Vector3 &p_point) const;
 
@@ -159,6 +207,7 @@ public:
 
 class AStar2D : public RefCounted {
 	GDCLASS(AStar2D, RefCounted);
+	friend class AStar3D;
 	AStar3D astar;
 
 	bool _solve(AStar3D::Point *begin_point, AStar3D::Point *end_point);
@@ -197,6 +246,9 @@ public:
 	void reserve_space(int64_t p_num_nodes);
 	void clear();
 
+	void freeze();
+	bool is_frozen() const;
+
 	int64_t get_closest_point(const Vector2 &p_point, bool p_include_disabled = false) const;
 	Vector2 get_closest_position_in_segment(const Vector2 &p_point) const;
 
@@ -0,0 +1,801 @@
+/*************************************************************************/
+/*  a_star_grid_2d.cpp                                                   */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2022 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2022 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "a_star_grid_2d.h"
+
+#include "core/templates/sort_array.h"
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+// Index of the lowest and highest set bit of a non-zero word.
+static _FORCE_INLINE_ int32_t lowest_bit(uint64_t p_word) {
+#if defined(__GNUC__)
+	return __builtin_ctzll(p_word);
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_ARM64))
+	unsigned long index;
+	_BitScanForward64(&index, p_word);
+	return index;
+#else
+	int32_t index = 0;
+	while (!(p_word & 1)) {
+		p_word >>= 1;
+		index++;
+	}
+	return index;
+#endif
+}
+
+static _FORCE_INLINE_ int32_t highest_bit(uint64_t p_word) {
+#if defined(__GNUC__)
+	return 63 - __builtin_clzll(p_word);
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_ARM64))
+	unsigned long index;
+	_BitScanReverse64(&index, p_word);
+	return index;
+#else
+	int32_t index = 0;
+	while (p_word >>= 1) {
+		index++;
+	}
+	return index;
+#endif
+}
+
+static real_t heuristic_euclidian(const Vector2i &p_from, const Vector2i &p_to) {
+	real_t dx = (real_t)ABS(p_to.x - p_from.x);
+	real_t dy = (real_t)ABS(p_to.y - p_from.y);
+	return (real_t)Math::sqrt(dx * dx + dy * dy);
+}
+
+static real_t heuristic_manhattan(const Vector2i &p_from, const Vector2i &p_to) {
+	real_t dx = (real_t)ABS(p_to.x - p_from.x);
+	real_t dy = (real_t)ABS(p_to.y - p_from.y);
+	return dx + dy;
+}
+
+static real_t heuristic_octile(const Vector2i &p_from, const Vector2i &p_to) {
+	real_t dx = (real_t)ABS(p_to.x - p_from.x);
+	real_t dy = (real_t)ABS(p_to.y - p_from.y);
+	real_t F = Math_SQRT2 - 1;
+	return (dx < dy) ? F * dx + dy : F * dy + dx;
+}
+
+static real_t heuristic_chebyshev(const Vector2i &p_from, const Vector2i &p_to) {
+	real_t dx = (real_t)ABS(p_to.x - p_from.x);
+	real_t dy = (real_t)ABS(p_to.y - p_from.y);
+	return MAX(dx, dy);
+}
+
+static real_t (*heuristics[AStarGrid2D::HEURISTIC_MAX])(const Vector2i &, const Vector2i &) = { heuristic_euclidian, heuristic_manhattan, heuristic_octile, heuristic_chebyshev };
+
+static const Vector2i directions[8] = {
+	Vector2i(1, 0),
+	Vector2i(-1, 0),
+	Vector2i(0, 1),
+	Vector2i(0, -1),
+	Vector2i(1, 1),
+	Vector2i(-1, 1),
+	Vector2i(1, -1),
+	Vector2i(-1, -1),
+};
+
+void AStarGrid2D::set_size(const Vector2i &p_size) {
+	ERR_FAIL_COND(p_size.x < 0 || p_size.y < 0);
+	if (p_size != size) {
+		size = p_size;
+		dirty = true;
+	}
+}
+
+Vector2i AStarGrid2D::get_size() const {
+	return size;
+}
+
+void AStarGrid2D::set_offset(const Vector2 &p_offset) {
+	offset = p_offset;
+}
+
+Vector2 AStarGrid2D::get_offset() const {
+	return offset;
+}
+
+void AStarGrid2D::set_cell_size(const Vector2 &p_cell_size) {
+	cell_size = p_cell_size;
+}
+
+Vector2 AStarGrid2D::get_cell_size() const {
+	return cell_size;
+}
+
+// Clears the bits from `p_from` to `p_to` (excluded) of a line.
+static void clear_bits(uint64_t *p_line, uint32_t p_from, uint32_t p_to) {
+	while (p_from < p_to) {
+		const uint32_t word = p_from >> 6;
+		const uint32_t bit = p_from & 63;
+		const uint32_t count = MIN(64 - bit, p_to - p_from);
+		const uint64_t bits = count == 64 ? ~uint64_t(0) : ((uint64_t(1) << count) - 1) << bit;
+		p_line[word] &= ~bits;
+		p_from += count;
+	}
+}
+
+void AStarGrid2D::update() {
+	// Everything is solid first, then the cells inside the grid are cleared, leaving the padding solid.
+	row_words = (uint32_t(size.x) + 2 + 63) / 64;
+	column_words = (uint32_t(size.y) + 2 + 63) / 64;
+
+	solid_mask.resize(row_words * (uint32_t(size.y) + 2));
+	for (uint32_t i = 0; i < solid_mask.size(); i++) {
+		solid_mask[i] = ~uint64_t(0);
+	}
+	for (int32_t y = 0; y < size.y; y++) {
+		clear_bits(&solid_mask[uint32_t(y + 1) * row_words], 1, uint32_t(size.x) + 1);
+	}
+
+	solid_mask_transposed.resize(column_words * (uint32_t(size.x) + 2));
+	for (uint32_t i = 0; i < solid_mask_transposed.size(); i++) {
+		solid_mask_transposed[i] = ~uint64_t(0);
+	}
+	for (int32_t x = 0; x < size.x; x++) {
+		clear_bits(&solid_mask_transposed[uint32_t(x + 1) * column_words], 1, uint32_t(size.y) + 1);
+	}
+
+	cell_states.clear();
+	cell_states.resize(uint32_t(size.x) * uint32_t(size.y));
+	open_list.clear();
+	pass = 0;
+
+	dirty = false;
+}
+
+bool AStarGrid2D::is_dirty() const {
+	return dirty;
+}
+
+bool AStarGrid2D::is_in_bounds(int p_x, int p_y) const {
+	return p_x >= 0 && p_x < size.x && p_y >= 0 && p_y < size.y;
+}
+
+bool AStarGrid2D::is_in_boundsv(const Vector2i &p_id) const {
+	return is_in_bounds(p_id.x, p_id.y);
+}
+
+void AStarGrid2D::set_jumping_enabled(bool p_enabled) {
+	jumping_enabled = p_enabled;
+}
+
+bool AStarGrid2D::is_jumping_enabled() const {
+	return jumping_enabled;
+}
+
+void AStarGrid2D::set_diagonal_mode(DiagonalMode p_diagonal_mode) {
+	ERR_FAIL_INDEX((int)p_diagonal_mode, (int)DIAGONAL_MODE_MAX);
+	diagonal_mode = p_diagonal_mode;
+}
+
+AStarGrid2D::DiagonalMode AStarGrid2D::get_diagonal_mode() const {
+	return diagonal_mode;
+}
+
+void AStarGrid2D::set_default_heuristic(Heuristic p_heuristic) {
+	ERR_FAIL_INDEX((int)p_heuristic, (int)HEURISTIC_MAX);
+	default_heuristic = p_heuristic;
+}
+
+AStarGrid2D::Heuristic AStarGrid2D::get_default_heuristic() const {
+	return default_heuristic;
+}
+
+void AStarGrid2D::set_point_solid(const Vector2i &p_id, bool p_solid) {
+	ERR_FAIL_COND_MSG(dirty, "Grid is not initialized. Call the update method.");
+	ERR_FAIL_COND_MSG(!is_in_boundsv(p_id), vformat("Can't set if point is solid. Point out of bounds (%s/%s, %s/%s).", p_id.x, size.width, p_id.y, size.height));
+	const uint32_t row_bit = uint32_t(p_id.x + 1);
+	const uint32_t column_bit = uint32_t(p_id.y + 1);
+	uint64_t &row_word = solid_mask[uint32_t(p_id.y + 1) * row_words + (row_bit >> 6)];
+	uint64_t &column_word = solid_mask_transposed[uint32_t(p_id.x + 1) * column_words + (column_bit >> 6)];
+	if (p_solid) {
+		row_word |= uint64_t(1) << (row_bit & 63);
+		column_word |= uint64_t(1) << (column_bit & 63);
+	} else {
+		row_word &= ~(uint64_t(1) << (row_bit & 63));
+		column_word &= ~(uint64_t(1) << (column_bit & 63));
+	}
+}
+
+bool AStarGrid2D::is_point_solid(const Vector2i &p_id) const {
+	ERR_FAIL_COND_V_MSG(dirty, false, "Grid is not initialized. Call the update method.");
+	ERR_FAIL_COND_V_MSG(!is_in_boundsv(p_id), false, vformat("Can't get if point is solid. Point out of bounds (%s/%s, %s/%s).", p_id.x, size.width, p_id.y, size.height));
+	return !_is_walkable(p_id.x, p_id.y);
+}
+
+bool AStarGrid2D::_can_move(int32_t p_x, int32_t p_y, int32_t p_dx, int32_t p_dy) const {
+	if (!_is_walkable(p_x + p_dx, p_y + p_dy)) {
+		return false;
+	}
+	if (p_dx == 0 || p_dy == 0) {
+		return true;
+	}
+
+	switch (diagonal_mode) {
+		case DIAGONAL_MODE_ALWAYS:
+			return true;
+		case DIAGONAL_MODE_NEVER:
+			return false;
+		case DIAGONAL_MODE_AT_LEAST_ONE_WALKABLE:
+			return _is_walkable(p_x + p_dx, p_y) || _is_walkable(p_x, p_y + p_dy);
+		case DIAGONAL_MODE_ONLY_IF_NO_OBSTACLES:
+			return _is_walkable(p_x + p_dx, p_y) && _is_walkable(p_x, p_y + p_dy);
+		default:
+			return false;
+	}
+}
+
+uint32_t AStarGrid2D::_get_neighbours(uint32_t p_cell, Vector2i *r_directions) const {
+	const Vector2i id = _get_cell_id(p_cell);
+	uint32_t count = 0;
+	for (uint32_t i = 0; i < 8; i++) {
+		if (_can_move(id.x, id.y, directions[i].x, directions[i].y)) {
+			r_directions[count++] = directions[i];
+		}
+	}
+	return count;
+}
+
+// The pruning rules below (and the ones in `_jump`) follow the Jump Point Search variants of
+// PathFinding.js, one for each diagonal mode. The directions are relative to the cell,
+// and the ones that lead to a solid cell are discarded by `_jump`.
+uint32_t AStarGrid2D::_get_jump_directions(uint32_t p_cell, Vector2i *r_directions) const {
+	const uint32_t prev_cell = cell_states[p_cell].prev_cell;
+	if (prev_cell == NO_CELL) {
+		return _get_neighbours(p_cell, r_directions);
+	}
+
+	const Vector2i id = _get_cell_id(p_cell);
+	const Vector2i prev_id = _get_cell_id(prev_cell);
+	const int32_t x = id.x;
+	const int32_t y = id.y;
+	const int32_t dx = SIGN(x - prev_id.x);
+	const int32_t dy = SIGN(y - prev_id.y);
+	uint32_t count = 0;
+
+#define ADD_DIRECTION(m_dx, m_dy) r_directions[count++] = Vector2i(m_dx, m_dy)
+
+	switch (diagonal_mode) {
+		case DIAGONAL_MODE_ALWAYS: {
+			if (dx != 0 && dy != 0) {
+				ADD_DIRECTION(0, dy);
+				ADD_DIRECTION(dx, 0);
+				ADD_DIRECTION(dx, dy);
+				if (!_is_walkable(x - dx, y)) {
+					ADD_DIRECTION(-dx, dy);
+				}
+				if (!_is_walkable(x, y - dy)) {
+					ADD_DIRECTION(dx, -dy);
+				}
+			} else if (dx != 0) {
+				ADD_DIRECTION(dx, 0);
+				if (!_is_walkable(x, y + 1)) {
+					ADD_DIRECTION(dx, 1);
+				}
+				if (!_is_walkable(x, y - 1)) {
+					ADD_DIRECTION(dx, -1);
+				}
+			} else {
+				ADD_DIRECTION(0, dy);
+				if (!_is_walkable(x + 1, y)) {
+					ADD_DIRECTION(1, dy);
+				}
+				if (!_is_walkable(x - 1, y)) {
+					ADD_DIRECTION(-1, dy);
+				}
+			}
+		} break;
+		case DIAGONAL_MODE_AT_LEAST_ONE_WALKABLE: {
+			if (dx != 0 && dy != 0) {
+				const bool vertical_walkable = _is_walkable(x, y + dy);
+				const bool horizontal_walkable = _is_walkable(x + dx, y);
+				ADD_DIRECTION(0, dy);
+				ADD_DIRECTION(dx, 0);
+				if (vertical_walkable || horizontal_walkable) {
+					ADD_DIRECTION(dx, dy);
+				}
+				if (!_is_walkable(x - dx, y) && vertical_walkable) {
+					ADD_DIRECTION(-dx, dy);
+				}
+				if (!_is_walkable(x, y - dy) && horizontal_walkable) {
+					ADD_DIRECTION(dx, -dy);
+				}
+			} else if (dx != 0) {
+				if (_is_walkable(x + dx, y)) {
+					ADD_DIRECTION(dx, 0);
+					if (!_is_walkable(x, y + 1)) {
+						ADD_DIRECTION(dx, 1);
+					}
+					if (!_is_walkable(x, y - 1)) {
+						ADD_DIRECTION(dx, -1);
+					}
+				}
+			} else {
+				if (_is_walkable(x, y + dy)) {
+					ADD_DIRECTION(0, dy);
+					if (!_is_walkable(x + 1, y)) {
+						ADD_DIRECTION(1, dy);
+					}
+					if (!_is_walkable(x - 1, y)) {
+						ADD_DIRECTION(-1, dy);
+					}
+				}
+			}
+		} break;
+		case DIAGONAL_MODE_ONLY_IF_NO_OBSTACLES: {
+			if (dx != 0 && dy != 0) {
+				const bool vertical_walkable = _is_walkable(x, y + dy);
+				const bool horizontal_walkable = _is_walkable(x + dx, y);
+				ADD_DIRECTION(0, dy);
+				ADD_DIRECTION(dx, 0);
+				if (vertical_walkable && horizontal_walkable) {
+					ADD_DIRECTION(dx, dy);
+				}
+			} else if (dx != 0) {
+				const bool next_walkable = _is_walkable(x + dx, y);
+				const bool top_walkable = _is_walkable(x, y + 1);
+				const bool bottom_walkable = _is_walkable(x, y - 1);
+				if (next_walkable) {
+					ADD_DIRECTION(dx, 0);
+					if (top_walkable) {
+						ADD_DIRECTION(dx, 1);
+					}
+					if (bottom_walkable) {
+						ADD_DIRECTION(dx, -1);
+					}
+				}
+				ADD_DIRECTION(0, 1);
+				ADD_DIRECTION(0, -1);
+			} else {
+				const bool next_walkable = _is_walkable(x, y + dy);
+				const bool right_walkable = _is_walkable(x + 1, y);
+				const bool left_walkable = _is_walkable(x - 1, y);
+				if (next_walkable) {
+					ADD_DIRECTION(0, dy);
+					if (right_walkable) {
+						ADD_DIRECTION(1, dy);
+					}
+					if (left_walkable) {
+						ADD_DIRECTION(-1, dy);
+					}
+				}
+				ADD_DIRECTION(1, 0);
+				ADD_DIRECTION(-1, 0);
+			}
+		} break;
+		case DIAGONAL_MODE_NEVER: {
+			if (dx != 0) {
+				ADD_DIRECTION(0, -1);
+				ADD_DIRECTION(0, 1);
+				ADD_DIRECTION(dx, 0);
+			} else {
+				ADD_DIRECTION(-1, 0);
+				ADD_DIRECTION(1, 0);
+				ADD_DIRECTION(0, dy);
+			}
+		} break;
+		default:
+			break;
+	}
+
+#undef ADD_DIRECTION
+
+	return count;
+}
+
+// Returns the first cell from `p_from` in the direction along the line of the mask (a row of
+// `solid_mask` or a column of `solid_mask_transposed`) that is a jump point for a straight move,
+// or of the first solid cell, with `r_blocked` set, when it comes first. The rules are the ones of `_jump` for straight moves,
+// evaluated on the 64 cells of a word at once against the words of the two neighbour lines.
+int32_t AStarGrid2D::_scan_line(const LocalVector<uint64_t> &p_mask, uint32_t p_line_words, int32_t p_line, int32_t p_from, int32_t p_direction, bool &r_blocked) const {
+	const uint64_t *line = &p_mask[uint32_t(p_line + 1) * p_line_words];
+	const uint64_t *before = line - p_line_words;
+	const uint64_t *after = line + p_line_words;
+	const bool corner_rule = diagonal_mode == DIAGONAL_MODE_ALWAYS || diagonal_mode == DIAGONAL_MODE_AT_LEAST_ONE_WALKABLE;
+
+	const uint32_t from = uint32_t(p_from + 1);
+	int32_t word = int32_t(from >> 6);
+	// Limits the first word to the bits from the start in the direction.
+	uint64_t range = p_direction > 0 ? ~uint64_t(0) << (from & 63) : ~uint64_t(0) >> (63 - (from & 63));
+
+	while (true) {
+		const uint64_t solid = line[word];
+		uint64_t neighbours_ahead[2];
+		uint64_t neighbours_behind[2];
+		uint64_t neighbours[2] = { before[word], after[word] };
+		const uint64_t *neighbour_lines[2] = { before, after };
+		for (int i = 0; i < 2; i++) {
+			// The previous and next bits of the neighbour line, shifted in from the adjacent words (solid outside the line).
+			const uint64_t prev_word = word > 0 ? neighbour_lines[i][word - 1] : ~uint64_t(0);
+			const uint64_t next_word = uint32_t(word + 1) < p_line_words ? neighbour_lines[i][word + 1] : ~uint64_t(0);
+			const uint64_t prev_bits = (neighbours[i] << 1) | (prev_word >> 63);
+			const uint64_t next_bits = (neighbours[i] >> 1) | (next_word << 63);
+			neighbours_ahead[i] = p_direction > 0 ? next_bits : prev_bits;
+			neighbours_behind[i] = p_direction > 0 ? prev_bits : next_bits;
+		}
+
+		uint64_t forced;
+		if (corner_rule) {
+			// The neighbour is solid, and the cell ahead of it is walkable.
+			forced = (neighbours[0] & ~neighbours_ahead[0]) | (neighbours[1] & ~neighbours_ahead[1]);
+		} else {
+			// The neighbour is walkable, and the cell behind it is solid.
+			forced = (~neighbours[0] & neighbours_behind[0]) | (~neighbours[1] & neighbours_behind[1]);
+		}
+
+		const uint64_t stops = (solid | forced) & range;
+		if (stops) {
+			const int32_t bit = p_direction > 0 ? lowest_bit(stops) : highest_bit(stops);
+			r_blocked = solid & (uint64_t(1) << bit);
+			return word * 64 + bit - 1;
+		}
+
+		// The padding is solid, so a stop is always found before leaving the line.
+		word += p_direction;
+		range = ~uint64_t(0);
+	}
+}
+
+uint32_t AStarGrid2D::_jump_straight(int32_t p_x, int32_t p_y, int32_t p_dx, int32_t p_dy) const {
+	bool blocked = false;
+	if (p_dy == 0) {
+		const int32_t found = _scan_line(solid_mask, row_words, p_y, p_x, p_dx, blocked);
+		if (end_id.y == p_y && (end_id.x - p_x) * p_dx >= 0 && (found - end_id.x) * p_dx >= 0) {
+			return end_cell; // The end is reached before the stop.
+		}
+		return blocked ? NO_CELL : _get_cell(found, p_y);
+	} else {
+		const int32_t found = _scan_line(solid_mask_transposed, column_words, p_x, p_y, p_dy, blocked);
+		if (end_id.x == p_x && (end_id.y - p_y) * p_dy >= 0 && (found - end_id.y) * p_dy >= 0) {
+			return end_cell;
+		}
+		return blocked ? NO_CELL : _get_cell(p_x, found);
+	}
+}
+
+// Steps from the cell at (p_x - p_dx, p_y - p_dy) in the direction until a jump point, and returns it,
+// or `NO_CELL` when the direction is blocked before one. The straight moves are scanned a word at a
+// time, the diagonal ones (and the vertical ones without diagonals, which look for horizontal jump
+// points on the way) step one cell at a time and scan the straight moves from each cell.
+uint32_t AStarGrid2D::_jump(int32_t p_x, int32_t p_y, int32_t p_dx, int32_t p_dy) const {
+	if (p_dy == 0 || (p_dx == 0 && diagonal_mode != DIAGONAL_MODE_NEVER)) {
+		return _jump_straight(p_x, p_y, p_dx, p_dy);
+	}
+
+	int32_t x = p_x;
+	int32_t y = p_y;
+	const int32_t dx = p_dx;
+	const int32_t dy = p_dy;
+
+	while (true) {
+		if (!_is_walkable(x, y)) {
+			return NO_CELL;
+		}
+
+		const uint32_t cell = _get_cell(x, y);
+		if (cell == end_cell) {
+			return cell;
+		}
+
+		switch (diagonal_mode) {
+			case DIAGONAL_MODE_ALWAYS:
+			case DIAGONAL_MODE_AT_LEAST_ONE_WALKABLE: {
+				if ((_is_walkable(x - dx, y + dy) && !_is_walkable(x - dx, y)) || (_is_walkable(x + dx, y - dy) && !_is_walkable(x, y - dy))) {
+					return cell;
+				}
+				if (_jump_straight(x + dx, y, dx, 0) != NO_CELL || _jump_straight(x, y + dy, 0, dy) != NO_CELL) {
+					return cell;
+				}
+				if (diagonal_mode == DIAGONAL_MODE_AT_LEAST_ONE_WALKABLE && !_is_walkable(x + dx, y) && !_is_walkable(x, y + dy)) {
+					return NO_CELL;
+				}
+			} break;
+			case DIAGONAL_MODE_ONLY_IF_NO_OBSTACLES: {
+				if (_jump_straight(x + dx, y, dx, 0) != NO_CELL || _jump_straight(x, y + dy, 0, dy) != NO_CELL) {
+					return cell;
+				}
+				if (!_is_walkable(x + dx, y) || !_is_walkable(x, y + dy)) {
+					return NO_CELL;
+				}
+			} break;
+			case DIAGONAL_MODE_NEVER: {
+				if ((_is_walkable(x - 1, y) && !_is_walkable(x - 1, y - dy)) || (_is_walkable(x + 1, y) && !_is_walkable(x + 1, y - dy))) {
+					return cell;
+				}
+				if (_jump_straight(x + 1, y, 1, 0) != NO_CELL || _jump_straight(x - 1, y, -1, 0) != NO_CELL) {
+					return cell;
+				}
+			} break;
+			default:
+				return NO_CELL;
+		}
+
+		x += dx;
+		y += dy;
+	}
+}
+
+void AStarGrid2D::_push_open(uint32_t p_cell, uint32_t p_prev_cell, real_t p_g_score) {
+	CellState &state = cell_states[p_cell];
+	if (state.closed_pass == pass) {
+		return;
+	}
+	if (state.open_pass == pass && p_g_score >= state.g_score) { // The new path is worse than the previous.
+		return;
+	}
+
+	state.open_pass = pass;
+	state.prev_cell = p_prev_cell;
+	state.g_score = p_g_score;
+
+	OpenEntry entry;
+	entry.g_score = p_g_score;
+	entry.f_score = p_g_score + _estimate_cost(_get_cell_id(p_cell), end_id);
+	entry.cell = p_cell;
+
+	SortArray<OpenEntry, SortOpenEntries> sorter;
+	open_list.push_back(entry);
+	sorter.push_heap(0, open_list.size() - 1, 0, entry, open_list.ptr());
+}
+
+bool AStarGrid2D::_solve(uint32_t p_begin_cell, uint32_t p_end_cell) {
+	pass++;
+	if (pass == 0) { // The pass wrapped around, so the old stamps could be mistaken for the new ones.
+		for (uint32_t i = 0; i < cell_states.size(); i++) {
+			cell_states[i].open_pass = 0;
+			cell_states[i].closed_pass = 0;
+		}
+		pass = 1;
+	}
+
+	const Vector2i end_id_local = _get_cell_id(p_end_cell);
+	if (!_is_walkable(end_id_local.x, end_id_local.y)) {
+		return false;
+	}
+
+	end_cell = p_end_cell;
+	end_id = end_id_local;
+	open_list.clear();
+
+	SortArray<OpenEntry, SortOpenEntries> sorter;
+	_push_open(p_begin_cell, NO_CELL, 0);
+
+	Vector2i neighbour_directions[8];
+
+	while (!open_list.is_empty()) {
+		const OpenEntry entry = open_list[0]; // The currently processed cell.
+		sorter.pop_heap(0, open_list.size(), open_list.ptr()); // Remove the current cell from the open list.
+		open_list.resize(open_list.size() - 1);
+
+		CellState &state = cell_states[entry.cell];
+		if (state.closed_pass == pass || entry.g_score > state.g_score) { // Already expanded with a better score.
+			continue;
+		}
+		if (entry.cell == p_end_cell) {
+			return true;
+		}
+		state.closed_pass = pass; // Mark the cell as closed.
+
+		const Vector2i id = _get_cell_id(entry.cell);
+		const uint32_t neighbour_count = jumping_enabled ? _get_jump_directions(entry.cell, neighbour_directions) : _get_neighbours(entry.cell, neighbour_directions);
+
+		for (uint32_t i = 0; i < neighbour_count; i++) {
+			const Vector2i &direction = neighbour_directions[i];
+			uint32_t next_cell;
+			if (jumping_enabled) {
+				next_cell = _jump(id.x + direction.x, id.y + direction.y, direction.x, direction.y);
+				if (next_cell == NO_CELL) {
+					continue;
+				}
+			} else {
+				next_cell = _get_cell(id.x + direction.x, id.y + direction.y);
+			}
+			if (cell_states[next_cell].closed_pass == pass) {
+				continue;
+			}
+
+			_push_open(next_cell, entry.cell, entry.g_score + _compute_cost(id, _get_cell_id(next_cell)));
+		}
+	}
+
+	return false;
+}
+
+void AStarGrid2D::_get_cell_path(uint32_t p_begin_cell, uint32_t p_end_cell, LocalVector<uint32_t> &r_path) const {
+	r_path.clear();
+
+	// The jump points are on a straight line from their previous cell, so the cells between them are stepped through.
+	uint32_t cell = p_end_cell;
+	r_path.push_back(cell);
+	while (cell != p_begin_cell) {
+		const uint32_t prev_cell = cell_states[cell].prev_cell;
+		const Vector2i id = _get_cell_id(cell);
+		const Vector2i prev_id = _get_cell_id(prev_cell);
+		const int32_t dx = SIGN(prev_id.x - id.x);
+		const int32_t dy = SIGN(prev_id.y - id.y);
+		Vector2i step = id;
+		while (step != prev_id) {
+			step.x += dx;
+			step.y += dy;
+			r_path.push_back(_get_cell(step.x, step.y));
+		}
+		cell = prev_cell;
+	}
+
+	// Reverse to get the path from the begin cell.
+	for (uint32_t i = 0; i < r_path.size() / 2; i++) {
+		SWAP(r_path[i], r_path[r_path.size() - i - 1]);
+	}
+}
+
+real_t AStarGrid2D::_estimate_cost(const Vector2i &p_from_id, const Vector2i &p_to_id) {
+	real_t scost;
+	if (GDVIRTUAL_CALL(_estimate_cost, p_from_id, p_to_id, scost)) {
+		return scost;
+	}
+	return heuristics[default_heuristic](p_from_id, p_to_id);
+}
+
+real_t AStarGrid2D::_compute_cost(const Vector2i &p_from_id, const Vector2i &p_to_id) {
+	real_t scost;
+	if (GDVIRTUAL_CALL(_compute_cost, p_from_id, p_to_id, scost)) {
+		return scost;
+	}
+	return heuristics[default_heuristic](p_from_id, p_to_id);
+}
+
+void AStarGrid2D::clear() {
+	size = Vector2i();
+	solid_mask.clear();
+	solid_mask_transposed.clear();
+	row_words = 0;
+	column_words = 0;
+	cell_states.clear();
+	open_list.clear();
+	pass = 0;
+	dirty = false;
+}
+
+Vector<Vector2> AStarGrid2D::get_point_path(const Vector2i &p_from_id, const Vector2i &p_to_id) {
+	ERR_FAIL_COND_V_MSG(dirty, Vector<Vector2>(), "Grid is not initialized. Call the update method.");
+	ERR_FAIL_COND_V_MSG(!is_in_boundsv(p_from_id), Vector<Vector2>(), vformat("Can't get id path. Point out of bounds (%s/%s, %s/%s)", p_from_id.x, size.width, p_from_id.y, size.height));
+	ERR_FAIL_COND_V_MSG(!is_in_boundsv(p_to_id), Vector<Vector2>(), vformat("Can't get id path. Point out of bounds (%s/%s, %s/%s)", p_to_id.x, size.width, p_to_id.y, size.height));
+
+	const uint32_t begin_cell = _get_cell(p_from_id.x, p_from_id.y);
+	const uint32_t end_cell_id = _get_cell(p_to_id.x, p_to_id.y);
+
+	if (begin_cell == end_cell_id) {
+		Vector<Vector2> ret;
+		ret.push_back(offset + Vector2(p_from_id) * cell_size);
+		return ret;
+	}
+
+	bool found_route = _solve(begin_cell, end_cell_id);
+	if (!found_route) {
+		return Vector<Vector2>();
+	}
+
+	LocalVector<uint32_t> cell_path;
+	_get_cell_path(begin_cell, end_cell_id, cell_path);
+
+	Vector<Vector2> path;
+	path.resize(cell_path.size());
+	Vector2 *w = path.ptrw();
+	for (uint32_t i = 0; i < cell_path.size(); i++) {
+		w[i] = offset + Vector2(_get_cell_id(cell_path[i])) * cell_size;
+	}
+
+	return path;
+}
+
+TypedArray<Vector2i> AStarGrid2D::get_id_path(const Vector2i &p_from_id, const Vector2i &p_to_id) {
+	ERR_FAIL_COND_V_MSG(dirty, TypedArray<Vector2i>(), "Grid is not initialized. Call the update method.");
+	ERR_FAIL_COND_V_MSG(!is_in_boundsv(p_from_id), TypedArray<Vector2i>(), vformat("Can't get id path. Point out of bounds (%s/%s, %s/%s)", p_from_id.x, size.width, p_from_id.y, size.height));
+	ERR_FAIL_COND_V_MSG(!is_in_boundsv(p_to_id), TypedArray<Vector2i>(), vformat("Can't get id path. Point out of bounds (%s/%s, %s/%s)", p_to_id.x, size.width, p_to_id.y, size.height));
+
+	const uint32_t begin_cell = _get_cell(p_from_id.x, p_from_id.y);
+	const uint32_t end_cell_id = _get_cell(p_to_id.x, p_to_id.y);
+
+	if (begin_cell == end_cell_id) {
+		TypedArray<Vector2i> ret;
+		ret.push_back(p_from_id);
+		return ret;
+	}
+
+	bool found_route = _solve(begin_cell, end_cell_id);
+	if (!found_route) {
+		return TypedArray<Vector2i>();
+	}
+
+	LocalVector<uint32_t> cell_path;
+	_get_cell_path(begin_cell, end_cell_id, cell_path);
+
+	TypedArray<Vector2i> path;
+	path.resize(cell_path.size());
+	for (uint32_t i = 0; i < cell_path.size(); i++) {
+		path[i] = _get_cell_id(cell_path[i]);
+	}
+
+	return path;
+}
+
+void AStarGrid2D::_bind_methods() {
+	ClassDB::bind_method(D_METHOD("set_size", "size"), &AStarGrid2D::set_size);
+	ClassDB::bind_method(D_METHOD("get_size"), &AStarGrid2D::get_size);
+	ClassDB::bind_method(D_METHOD("set_offset", "offset"), &AStarGrid2D::set_offset);
+	ClassDB::bind_method(D_METHOD("get_offset"), &AStarGrid2D::get_offset);
+	ClassDB::bind_method(D_METHOD("set_cell_size", "cell_size"), &AStarGrid2D::set_cell_size);
+	ClassDB::bind_method(D_METHOD("get_cell_size"), &AStarGrid2D::get_cell_size);
+	ClassDB::bind_method(D_METHOD("is_in_bounds", "x", "y"), &AStarGrid2D::is_in_bounds);
+	ClassDB::bind_method(D_METHOD("is_in_boundsv", "id"), &AStarGrid2D::is_in_boundsv);
+	ClassDB::bind_method(D_METHOD("is_dirty"), &AStarGrid2D::is_dirty);
+	ClassDB::bind_method(D_METHOD("update"), &AStarGrid2D::update);
+	ClassDB::bind_method(D_METHOD("set_jumping_enabled", "enabled"), &AStarGrid2D::set_jumping_enabled);
+	ClassDB::bind_method(D_METHOD("is_jumping_enabled"), &AStarGrid2D::is_jumping_enabled);
+	ClassDB::bind_method(D_METHOD("set_diagonal_mode", "mode"), &AStarGrid2D::set_diagonal_mode);
+	ClassDB::bind_method(D_METHOD("get_diagonal_mode"), &AStarGrid2D::get_diagonal_mode);
+	ClassDB::bind_method(D_METHOD("set_default_heuristic", "heuristic"), &AStarGrid2D::set_default_heuristic);
+	ClassDB::bind_method(D_METHOD("get_default_heuristic"), &AStarGrid2D::get_default_heuristic);
+	ClassDB::bind_method(D_METHOD("set_point_solid", "id", "solid"), &AStarGrid2D::set_point_solid, DEFVAL(true));
+	ClassDB::bind_method(D_METHOD("is_point_solid", "id"), &AStarGrid2D::is_point_solid);
+	ClassDB::bind_method(D_METHOD("clear"), &AStarGrid2D::clear);
+
+	ClassDB::bind_method(D_METHOD("get_point_path", "from_id", "to_id"), &AStarGrid2D::get_point_path);
+	ClassDB::bind_method(D_METHOD("get_id_path", "from_id", "to_id"), &AStarGrid2D::get_id_path);
+
+	GDVIRTUAL_BIND(_estimate_cost, "from_id", "to_id")
+	GDVIRTUAL_BIND(_compute_cost, "from_id", "to_id")
+
+	ADD_PROPERTY(PropertyInfo(Variant::VECTOR2I, "size"), "set_size", "get_size");
+	ADD_PROPERTY(PropertyInfo(Variant::VECTOR2, "offset"), "set_offset", "get_offset");
+	ADD_PROPERTY(PropertyInfo(Variant::VECTOR2, "cell_size"), "set_cell_size", "get_cell_size");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "jumping_enabled"), "set_jumping_enabled", "is_jumping_enabled");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "default_heuristic", PROPERTY_HINT_ENUM, "Euclidean,Manhattan,Octile,Chebyshev"), "set_default_heuristic", "get_default_heuristic");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "diagonal_mode", PROPERTY_HINT_ENUM, "Always,Never,At Least One Walkable,Only If No Obstacles"), "set_diagonal_mode", "get_diagonal_mode");
+
+	BIND_ENUM_CONSTANT(HEURISTIC_EUCLIDEAN);
+	BIND_ENUM_CONSTANT(HEURISTIC_MANHATTAN);
+	BIND_ENUM_CONSTANT(HEURISTIC_OCTILE);
+	BIND_ENUM_CONSTANT(HEURISTIC_CHEBYSHEV);
+	BIND_ENUM_CONSTANT(HEURISTIC_MAX);
+
+	BIND_ENUM_CONSTANT(DIAGONAL_MODE_ALWAYS);
+	BIND_ENUM_CONSTANT(DIAGONAL_MODE_NEVER);
+	BIND_ENUM_CONSTANT(DIAGONAL_MODE_AT_LEAST_ONE_WALKABLE);
+	BIND_ENUM_CONSTANT(DIAGONAL_MODE_ONLY_IF_NO_OBSTACLES);
+	BIND_ENUM_CONSTANT(DIAGONAL_MODE_MAX);
+}
@@ -0,0 +1,186 @@
+/*************************************************************************/
+/*  a_star_grid_2d.h                                                     */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2022 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2022 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef A_STAR_GRID_2D_H
+#define A_STAR_GRID_2D_H
+
+#include "core/object/gdvirtual.gen.inc"
+#include "core/object/ref_counted.h"
+#include "core/object/script_language.h"
+#include "core/templates/local_vector.h"
+#include "core/variant/typed_array.h"
+
+/**
+	A* pathfinding on a dense grid.
+
+	The cells are stored in flat arrays indexed by `y * width + x`, with one bit per cell
+	for the solid ones, and the search state is stamped with the search pass so nothing is
+	cleared or allocated between the searches. With jumping enabled, the search expands
+	jump points (Jump Point Search) instead of every cell, which skips the open areas.
+*/
+
+class AStarGrid2D : public RefCounted {
+	GDCLASS(AStarGrid2D, RefCounted);
+
+public:
+	enum Heuristic {
+		HEURISTIC_EUCLIDEAN,
+		HEURISTIC_MANHATTAN,
+		HEURISTIC_OCTILE,
+		HEURISTIC_CHEBYSHEV,
+		HEURISTIC_MAX,
+	};
+
+	enum DiagonalMode {
+		DIAGONAL_MODE_ALWAYS,
+		DIAGONAL_MODE_NEVER,
+		DIAGONAL_MODE_AT_LEAST_ONE_WALKABLE,
+		DIAGONAL_MODE_ONLY_IF_NO_OBSTACLES,
+		DIAGONAL_MODE_MAX,
+	};
+
+private:
+	static const uint32_t NO_CELL = UINT32_MAX;
+
+	Vector2i size;
+	Vector2 offset;
+	Vector2 cell_size = Vector2(1, 1);
+	bool dirty = false;
+
+	bool jumping_enabled = false;
+	Heuristic default_heuristic = HEURISTIC_EUCLIDEAN;
+	DiagonalMode diagonal_mode = DIAGONAL_MODE_ALWAYS;
+
+	// Solid cells bitset, by rows and by columns, with a solid border so jumps don't check bounds.
+	LocalVector<uint64_t> solid_mask;
+	LocalVector<uint64_t> solid_mask_transposed;
+	uint32_t row_words = 0;
+	uint32_t column_words = 0;
+
+	struct CellState {
+		real_t g_score = 0;
+		uint32_t prev_cell = NO_CELL;
+		uint32_t open_pass = 0;
+		uint32_t closed_pass = 0;
+	};
+
+	// Cells are pushed again when their score improves, outdated entries are skipped.
+	struct OpenEntry {
+		real_t f_score = 0;
+		real_t g_score = 0;
+		uint32_t cell = 0;
+	};
+
+	struct SortOpenEntries {
+		_FORCE_INLINE_ bool operator()(const OpenEntry &A, const OpenEntry &B) const { // Returns true when A is worse than B.
+			if (A.f_score != B.f_score) {
+				return A.f_score > B.f_score;
+			}
+			return A.g_score < B.g_score; // If the f_costs are the same then prioritize the cells that are further away from the start.
+		}
+	};
+
+	LocalVector<CellState> cell_states;
+	LocalVector<OpenEntry> open_list;
+	uint32_t pass = 0;
+	uint32_t end_cell = NO_CELL;
+	Vector2i end_id;
+
+	_FORCE_INLINE_ uint32_t _get_cell(int32_t p_x, int32_t p_y) const {
+		return uint32_t(p_y) * uint32_t(size.x) + uint32_t(p_x);
+	}
+	_FORCE_INLINE_ Vector2i _get_cell_id(uint32_t p_cell) const {
+		return Vector2i(p_cell % uint32_t(size.x), p_cell / uint32_t(size.x));
+	}
+	// Accepts one (solid) cell outside the grid on each side.
+	_FORCE_INLINE_ bool _is_walkable(int32_t p_x, int32_t p_y) const {
+		const uint32_t bit = uint32_t(p_x + 1);
+		return !(solid_mask[uint32_t(p_y + 1) * row_words + (bit >> 6)] & (uint64_t(1) << (bit & 63)));
+	}
+
+	bool _can_move(int32_t p_x, int32_t p_y, int32_t p_dx, int32_t p_dy) const;
+	uint32_t _get_neighbours(uint32_t p_cell, Vector2i *r_directions) const;
+	uint32_t _get_jump_directions(uint32_t p_cell, Vector2i *r_directions) const;
+	int32_t _scan_line(const LocalVector<uint64_t> &p_mask, uint32_t p_line_words, int32_t p_line, int32_t p_from, int32_t p_direction, bool &r_blocked) const;
+	uint32_t _jump_straight(int32_t p_x, int32_t p_y, int32_t p_dx, int32_t p_dy) const;
+	uint32_t _jump(int32_t p_x, int32_t p_y, int32_t p_dx, int32_t p_dy) const;
+	void _push_open(uint32_t p_cell, uint32_t p_prev_cell, real_t p_g_score);
+	bool _solve(uint32_t p_begin_cell, uint32_t p_end_cell);
+	void _get_cell_path(uint32_t p_begin_cell, uint32_t p_end_cell, LocalVector<uint32_t> &r_path) const;
+
+protected:
+	static void _bind_methods();
+
+	virtual real_t _estimate_cost(const Vector2i &p_from_id, const Vector2i &p_to_id);
+	virtual real_t _compute_cost(const Vector2i &p_from_id, const Vector2i &p_to_id);
+
+	GDVIRTUAL2RC(real_t, _estimate_cost, Vector2i, Vector2i)
+	GDVIRTUAL2RC(real_t, _compute_cost, Vector2i, Vector2i)
+
+public:
+	void set_size(const Vector2i &p_size);
+	Vector2i get_size() const;
+
+	void set_offset(const Vector2 &p_offset);
+	Vector2 get_offset() const;
+
+	void set_cell_size(const Vector2 &p_cell_size);
+	Vector2 get_cell_size() const;
+
+	void update();
+	bool is_dirty() const;
+
+	bool is_in_bounds(int p_x, int p_y) const;
+	bool is_in_boundsv(const Vector2i &p_id) const;
+
+	void set_jumping_enabled(bool p_enabled);
+	bool is_jumping_enabled() const;
+
+	void set_diagonal_mode(DiagonalMode p_diagonal_mode);
+	DiagonalMode get_diagonal_mode() const;
+
+	void set_default_heuristic(Heuristic p_heuristic);
+	Heuristic get_default_heuristic() const;
+
+	void set_point_solid(const Vector2i &p_id, bool p_solid = true);
+	bool is_point_solid(const Vector2i &p_id) const;
+
+	void clear();
+
+	Vector<Vector2> get_point_path(const Vector2i &p_from, const Vector2i &p_to);
+	TypedArray<Vector2i> get_id_path(const Vector2i &p_from, const Vector2i &p_to);
+
+	AStarGrid2D() {}
+};
+
+VARIANT_ENUM_CAST(AStarGrid2D::DiagonalMode);
+VARIANT_ENUM_CAST(AStarGrid2D::Heuristic);
+
+#endif // A_STAR_GRID_2D_H
@@ -35,39 +35,57 @@
 #include "core/os/keyboard.h"
 #include "core/string/string_buffer.h"
 
-char32_t VariantParser::StreamFile::get_char() {
-	return f->get_8();
+char32_t VariantParser::Stream::_fill_readahead() {
+	if (eof) {
+		return 0;
+	}
+
+	readahead_pointer = 0;
+	readahead_filled = _read_buffer(readahead_buffer, READAHEAD_SIZE);
+	if (readahead_filled == 0) {
+		// Like files, the end is only reported after trying to read past it.
+		eof = true;
+		return 0;
+	}
+	return readahead_buffer[readahead_pointer++];
+}
+
+uint32_t VariantParser::StreamFile::_read_buffer(char32_t *p_buffer, uint32_t p_num_chars) {
+	ERR_FAIL_COND_V(f.is_null(), 0);
+
+	// Read the bytes at the start of the buffer, then widen them in place from the end, so each
+	// byte is read before the character being written over it.
+	uint8_t *bytes = reinterpret_cast<uint8_t *>(p_buffer);
+	uint32_t num_read = f->get_buffer(bytes, p_num_chars);
+	for (int64_t i = int64_t(num_read) - 1; i >= 0; i--) {
+		p_buffer[i] = bytes[i];
+	}
+	return num_read;
 }
 
 bool VariantParser::StreamFile::is_utf8() const {
 	return true;
 }
 
-bool VariantParser::StreamFile::is_eof() const {
-	return f->eof_reached();
+uint64_t VariantParser::StreamFile::get_position() const {
+	ERR_FAIL_COND_V(f.is_null(), 0);
+	return f->get_position() - _get_readahead_remaining();
 }
 
-char32_t VariantParser::StreamString::get_char() {
-	if (pos > s.length()) {
-		return 0;
-	} else if (pos == s.length()) {
-		// You need to try to read again when you have reached the end for EOF to be reported,
-		// so this works the same as files (like StreamFile does)
-		pos++;
+uint32_t VariantParser::StreamString::_read_buffer(char32_t *p_buffer, uint32_t p_num_chars) {
+	int num_read = MIN(int(p_num_chars), s.length() - pos);
+	if (num_read <= 0) {
 		return 0;
-	} else {
-		return s[pos++];
 	}
+	memcpy(p_buffer, s.ptr() + pos, num_read * sizeof(char32_t));
+	pos += num_read;
+	return num_read;
 }
 
 bool VariantParser::StreamString::is_utf8() const {
 	return false;
 }
 
-bool VariantParser::StreamString::is_eof() const {
-	return pos > s.length();
-}
-
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 const char *VariantParser::tk_name[TK_MAX] = {
@@ -101,6 +119,125 @@ static double stor_fix(const String &p_str) {
 	return -1;
 }
 
+// Reads the number starting with `p_char`, a digit or '-', and leaves the next character in `saved`.
+// The common numbers, with up to 15 digits and a small exponent, are converted while they are read,
+// as `String::to_float` and `String::to_int` would (their result is exact then), the others by them.
+static void _read_number(VariantParser::Stream *p_stream, char32_t p_char, bool &r_is_float, int64_t &r_integer, double &r_real) {
+	static const double powers_of_10[] = {
+		1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10,
+		1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+	};
+
+	StringBuffer<> num;
+#define READING_SIGN 0
+#define READING_INT 1
+#define READING_DEC 2
+#define READING_EXP 3
+#define READING_DONE 4
+	int reading = READING_INT;
+
+	bool negative = false;
+	if (p_char == '-') {
+		num += '-';
+		negative = true;
+		p_char = p_stream->get_char();
+	}
+
+	char32_t c = p_char;
+	bool exp_sign = false;
+	bool exp_beg = false;
+	bool exp_found = false;
+	bool exp_negative = false;
+	bool is_float = false;
+
+	uint64_t mantissa = 0;
+	int mantissa_digits = 0;
+	int decimals = 0;
+	int exponent = 0;
+	int exponent_digits = 0;
+
+	while (true) {
+		switch (reading) {
+			case READING_INT: {
+				if (is_digit(c)) {
+					mantissa = mantissa * 10 + (c - '0');
+					mantissa_digits++;
+				} else if (c == '.') {
+					reading = READING_DEC;
+					is_float = true;
+				} else if (c == 'e') {
+					reading = READING_EXP;
+					exp_found = true;
+					is_float = true;
+				} else {
+					reading = READING_DONE;
+				}
+
+			} break;
+			case READING_DEC: {
+				if (is_digit(c)) {
+					mantissa = mantissa * 10 + (c - '0');
+					mantissa_digits++;
+					decimals++;
+				} else if (c == 'e') {
+					reading = READING_EXP;
+					exp_found = true;
+				} else {
+					reading = READING_DONE;
+				}
+
+			} break;
+			case READING_EXP: {
+				if (is_digit(c)) {
+					exp_beg = true;
+					if (exponent_digits < 5) {
+						exponent = exponent * 10 + (c - '0');
+					}
+					exponent_digits++;
+
+				} else if ((c == '-' || c == '+') && !exp_sign && !exp_beg) {
+					exp_sign = true;
+					exp_negative = c == '-';
+
+				} else {
+					reading = READING_DONE;
+				}
+			} break;
+		}
+
+		if (reading == READING_DONE) {
+			break;
+		}
+		num += c;
+		c = p_stream->get_char();
+	}
+
+	p_stream->saved = c;
+	r_is_float = is_float;
+
+	if (!is_float) {
+		if (mantissa_digits <= 18) {
+			r_integer = negative ? -int64_t(mantissa) : int64_t(mantissa);
+		} else {
+			r_integer = num.as_int();
+		}
+		return;
+	}
+
+	// An exponent without digits makes `String::to_float` ignore the decimal point too, leave it to it.
+	const bool exponent_valid = !exp_found || (exp_beg && exponent_digits <= 4);
+	if (mantissa_digits > 0 && mantissa_digits <= 15 && exponent_valid) {
+		const int power = (exp_negative ? -exponent : exponent) - decimals;
+		if (power >= -22 && power <= 22) {
+			double value = double(mantissa);
+			value = power < 0 ? value / powers_of_10[-power] : value * powers_of_10[power];
+			r_real = negative ? -value : value;
+			return;
+		}
+	}
+	r_real = num.as_double();
+}
+
 Error VariantParser::get_token(Stream *p_stream, Token &r_token, int &line, String &r_err_str) {
 	bool string_name = false;
 
@@ -217,7 +354,11 @@ Error VariantParser::get_token(Stream *p_stream, Token &r_token, int &line, Stri
 				[[fallthrough]];
 			}
 			case '"': {
-				String str;
+				// In UTF-8 streams the characters are bytes, which are only decoded at the end if
+				// there is any outside of ASCII.
+				StringBuffer<> str;
+				const bool utf8 = p_stream->is_utf8();
+				char32_t non_ascii = 0;
 				char32_t prev = 0;
 				while (true) {
 					char32_t ch = p_stream->get_char();
@@ -320,7 +461,16 @@ Error VariantParser::get_token(Stream *p_stream, Token &r_token, int &line, Stri
 							r_token.type = TK_ERROR;
 							return ERR_PARSE_ERROR;
 						}
-						str += res;
+						if (utf8 && res >= 0x80) {
+							// Store the escaped character as bytes too, so it's decoded with the others.
+							CharString bytes = String::chr(res).utf8();
+							for (int i = 0; i < bytes.length(); i++) {
+								str += uint8_t(bytes[i]);
+							}
+						} else {
+							str += res;
+						}
+						non_ascii |= res & ~char32_t(0x7f);
 					} else {
 						if (prev != 0) {
 							r_err_str = "Invalid UTF-16 sequence in string, unpaired lead surrogate";
@@ -331,6 +481,7 @@ Error VariantParser::get_token(Stream *p_stream, Token &r_token, int &line, Stri
 							line++;
 						}
 						str += ch;
+						non_ascii |= ch & ~char32_t(0x7f);
 					}
 				}
 				if (prev != 0) {
@@ -339,15 +490,16 @@ Error VariantParser::get_token(Stream *p_stream, Token &r_token, int &line, Stri
 					return ERR_PARSE_ERROR;
 				}
 
-				if (p_stream->is_utf8()) {
-					str.parse_utf8(str.ascii(true).get_data());
+				String string = str.as_string();
+				if (utf8 && non_ascii) {
+					string.parse_utf8(string.ascii(true).get_data());
 				}
 				if (string_name) {
 					r_token.type = TK_STRING_NAME;
-					r_token.value = StringName(str);
+					r_token.value = StringName(string);
 				} else {
 					r_token.type = TK_STRING;
-					r_token.value = str;
+					r_token.value = string;
 				}
 				return OK;
 
@@ -359,78 +511,16 @@ Error VariantParser::get_token(Stream *p_stream, Token &r_token, int &line, Stri
 
 				if (cchar == '-' || (cchar >= '0' && cchar <= '9')) {
 					//a number
-
-					StringBuffer<> num;
-#define READING_SIGN 0
-#define READING_INT 1
-#define READING_DEC 2
-#define READING_EXP 3
-#define READING_DONE 4
-					int reading = READING_INT;
-
-					if (cchar == '-') {
-						num += '-';
-						cchar = p_stream->get_char();
-					}
-
-					char32_t c = cchar;
-					bool exp_sign = false;
-					bool exp_beg = false;
 					bool is_float = false;
-
-					while (true) {
-						switch (reading) {
-							case READING_INT: {
-								if (is_digit(c)) {
-									//pass
-								} else if (c == '.') {
-									reading = READING_DEC;
-									is_float = true;
-								} else if (c == 'e') {
-									reading = READING_EXP;
-									is_float = true;
-								} else {
-									reading = READING_DONE;
-								}
-
-							} break;
-							case READING_DEC: {
-								if (is_digit(c)) {
-								} else if (c == 'e') {
-									reading = READING_EXP;
-								} else {
-									reading = READING_DONE;
-								}
-
-							} break;
-							case READING_EXP: {
-								if (is_digit(c)) {
-									exp_beg = true;
-
-								} else if ((c == '-' || c == '+') && !exp_sign && !exp_beg) {
-									exp_sign = true;
-
-								} else {
-									reading = READING_DONE;
-								}
-							} break;
-						}
-
-						if (reading == READING_DONE) {
-							break;
-						}
-						num += c;
-						c = p_stream->get_char();
-					}
-
-					p_stream->saved = c;
+					int64_t integer = 0;
+					double real = 0;
+					_read_number(p_stream, cchar, is_float, integer, real);
 
 					r_token.type = TK_NUMBER;
-
 					if (is_float) {
-						r_token.value = num.as_double();
+						r_token.value = real;
 					} else {
-						r_token.value = num.as_int();
+						r_token.value = integer;
 					}
 					return OK;
 				} else if (is_ascii_char(cchar) || is_underscore(cchar)) {
@@ -500,6 +590,10 @@ Error VariantParser::_parse_construct(Stream *p_stream, Vector<T> &r_construct,
 		return ERR_PARSE_ERROR;
 	}
 
+	// The values are written in place, growing the array by doubling it, and it is trimmed at the end.
+	int count = r_construct.size();
+	T *w = r_construct.ptrw();
+
 	bool first = true;
 	while (true) {
 		if (!first) {
@@ -513,33 +607,84 @@ Error VariantParser::_parse_construct(Stream *p_stream, Vector<T> &r_construct,
 				return ERR_PARSE_ERROR;
 			}
 		}
-		get_token(p_stream, token, line, r_err_str);
 
-		if (first && token.type == TK_PARENTHESIS_CLOSE) {
-			break;
-		} else if (token.type != TK_NUMBER) {
-			bool valid = false;
-			if (token.type == TK_IDENTIFIER) {
-				double real = stor_fix(token.value);
-				if (real != -1) {
-					token.type = TK_NUMBER;
-					token.value = real;
-					valid = true;
-				}
+		// Read the numbers directly, without making a token for them.
+		char32_t c = p_stream->saved;
+		p_stream->saved = 0;
+		while (true) {
+			if (c == 0) {
+				c = p_stream->get_char();
 			}
-			if (!valid) {
-				r_err_str = "Expected float in constructor";
-				return ERR_PARSE_ERROR;
+			if (c == '\n') {
+				line++;
+			} else if (c > 32 || c == 0) {
+				break;
+			}
+			c = 0;
+		}
+
+		T value;
+		if (c == 0) {
+			r_err_str = "Expected float in constructor";
+			return ERR_PARSE_ERROR;
+		} else if (c == '-' || is_digit(c)) {
+			bool is_float = false;
+			int64_t integer = 0;
+			double real = 0;
+			_read_number(p_stream, c, is_float, integer, real);
+			value = is_float ? T(real) : T(integer);
+		} else {
+			p_stream->saved = c;
+			get_token(p_stream, token, line, r_err_str);
+
+			if (first && token.type == TK_PARENTHESIS_CLOSE) {
+				break;
+			} else if (token.type != TK_NUMBER) {
+				bool valid = false;
+				if (token.type == TK_IDENTIFIER) {
+					double real = stor_fix(token.value);
+					if (real != -1) {
+						token.type = TK_NUMBER;
+						token.value = real;
+						valid = true;
+					}
+				}
+				if (!valid) {
+					r_err_str = "Expected float in constructor";
+					return ERR_PARSE_ERROR;
+				}
 			}
+			value = token.value;
 		}
 
-		r_construct.push_back(token.value);
+		if (count == r_construct.size()) {
+			r_construct.resize(MAX(count * 2, 4));
+			w = r_construct.ptrw();
+		}
+		w[count++] = value;
 		first = false;
 	}
 
+	r_construct.resize(count);
 	return OK;
 }
 
+// Most identifiers are tested against many of the type names before they're found, so compare
+// the lengths first, which doesn't need to scan the names like `String::operator==` does.
+template <int N>
+static _FORCE_INLINE_ bool _is_identifier(const String &p_id, const char (&p_name)[N]) {
+	if (p_id.length() != N - 1) {
+		return false;
+	}
+	const char32_t *id = p_id.ptr();
+	for (int i = 0; i < N - 1; i++) {
+		if (id[i] != char32_t(p_name[i])) {
+			return false;
+		}
+	}
+	return true;
+}
+
 Error VariantParser::parse_value(Token &token, Variant &value, Stream *p_stream, int &line, String &r_err_str, ResourceParser *p_res_parser) {
 	if (token.type == TK_CURLY_BRACKET_OPEN) {
 		Dictionary d;
@@ -559,19 +704,19 @@ Error VariantParser::parse_value(Token &token, Variant &value, Stream *p_stream,
 		return OK;
 	} else if (token.type == TK_IDENTIFIER) {
 		String id = token.value;
-		if (id == "true") {
+		if (_is_identifier(id, "true")) {
 			value = true;
-		} else if (id == "false") {
+		} else if (_is_identifier(id, "false")) {
 			value = false;
-		} else if (id == "null" || id == "nil") {
+		} else if (_is_identifier(id, "null") || _is_identifier(id, "nil")) {
 			value = Variant();
-		} else if (id == "inf") {
+		} else if (_is_identifier(id, "inf")) {
 			value = INFINITY;
-		} else if (id == "inf_neg") {
+		} else if (_is_identifier(id, "inf_neg")) {
 			value = -INFINITY;
-		} else if (id == "nan") {
+		} else if (_is_identifier(id, "nan")) {
 			value = NAN;
-		} else if (id == "Vector2") {
+		} else if (_is_identifier(id, "Vector2")) {
 			Vector<real_t> args;
 			Error err = _parse_construct<real_t>(p_stream, args, line, r_err_str);
 			if (err) {
@@ -584,7 +729,7 @@ Error VariantParser::parse_value(Token &token, Variant &value, Stream *p_stream,
 			}
 
 			value = Vector2(args[0], args[1]);
-		} else if (id == "Vector2i") {
+		} else if (_is_identifier(id, "Vector2i")) {
 			Vector<int32_t> args;
 			Error err = _parse_construct<int32_t>(p_stream, args, line, r_err_str);
 			if (err) {
@@ -597,7 +742,7 @@ Error VariantParser::parse_value(Token &token, Variant &value, Stream *p_stream,
 			}
 
 			value = Vector2i(args[0], args[1]);
-		} else if (id == "Rect2") {
+		} else if (_is_identifier(id, "Rect2")) {
 			Vector<real_t> args;
 			Error err = _parse_construct<real_t>(p_stream, args, line, r_err_str);
 			if (err) {
@@ -610,7 +755,7 @@ Error VariantParser::parse_value(Token &token, Variant &value, Stream *p_stream,
 			}
 
 			value = Rect2(args[0], args[1], args[2], args[3]);
-		} else if (id == "Rect2i") {
+		} else if (_is_identifier(id, "Rect2i")) {
 			Vector<int32_t> args;
 			Error err = _parse_construct<int32_t>(p_stream, args, line, r_err_str);
 			if (err) {
@@ -623,7 +768,7 @@ Error VariantParser::parse_value(Token &token, Variant &value, Stream *p_stream,
 			}
 
 			value = Rect2i(args[0], args[1], args[2], args[3]);
-		} else if (id == "Vector3") {
+		} else if (_is_identifier(id, "Vector3")) {
 			Vector<real_t> args;
 			Error err = _parse_construct<real_t>(p_stream, args, line, r_err_str);
 			if (err) {
@@ -636,7 +781,7 @@ Error VariantParser::parse_value(Token &token, Variant &value, Stream *p_stream,
 			}
 
 			value = Vector3(args[0], args[1], args[2]);
-		} else if (id == "Vector3i") {
+		} else if (_is_identifier(id, "Vector3i")) {
 			Vector<int32_t> args;
 			Error err = _parse_construct<int32_t>(p_stream, args, line, r_err_str);
 			if (err) {
@@ -649,7 +794,7 @@ Error VariantParser::parse_value(Token &token, Variant &value, Stream *p_stream,
 			}
 
 			value = Vector3i(args[0], args[1], args[2]);
-		} else if (id == "Vector4") {
+		} else if (_is_identifier(id, "Vector4")) {
 			Vector<real_t> args;
 			Error err = _parse_construct<real_t>(p_stream, args, line, r_err_str);
 			if (err) {
@@ -662,7 +807,7 @@ Error VariantParser::parse_value(Token &token, Variant &value, Stream *p_stream,
 			}
 
 			value = Vector4(args[0], args[1], args[2], args[3]);
-		} else if (id == "Vector4i") {
+		} else if (_is_identifier(id, "Vector4i")) {
 			Vector<int32_t> args;
 			Error err = _parse_construct<int32_t>(p_stream, args, line, r_err_str);
 			if (err) {
@@ -675,7 +820,7 @@ Error VariantParser::parse_value(Token &token, Variant &value, Stream *p_stream,
 			}
 
 			value = Vector4i(args[0], args[1], args[2], args[3]);
-		} else if (id == "Transform2D" || id == "Matrix32") { //compatibility
+		} else if (_is_identifier(id, "Transform2D") || _is_identifier(id, "Matrix32")) { //compatibility
 			Vector<real_t> args;
 			Error err = _parse_construct<real_t>(p_stream, args, line, r_err_str);
 			if (err) {
@@ -692,7 +837,7 @@ Error VariantParser::parse_value(Token &token, Variant &value, Stream *p_stream,
 			m[1] = Vector2(args[2], args[3]);
 			m[2] = Vector2(args[4], args[5]);
 			value = m;
-		} else if (id == "Plane") {
+		} else if (_is_identifier(id, "Plane")) {
 			Vector<real_t> args;
 			Error err = _parse_construct<real_t>(p_stream, args, line, r_err_str);
 			if (err) {
@@ -705,7 +850,7 @@ Error VariantParser::parse_value(Token &token, Variant &value, Stream *p_stream,
 			}
 
 			value = Plane(args[0], args[1], args[2], args[3]);
-		} else if (id == "Quaternion" || id == "Quat") { // "Quat" kept for compatibility
+		} else if (_is_identifier(id, "Quaternion") || _is_identifier(id, "Quat")) { // "Quat" kept for compatibility
 			Vector<real_t> args;
 			Error err = _parse_construct<real_t>(p_stream, args, line, r_err_str);
 			if (err) {
@@ -718,7 +863,7 @@ Error VariantParser::parse_value(Token &token, Variant &value, Stream *p_stream,
 			}
 
 			value = Quaternion(args[0], args[1], args[2], args[3]);
-		} else if (id == "AABB" || id == "Rect3") {
+		} else if (_is_identifier(id, "AABB") || _is_identifier(id, "Rect3")) {
 			Vector<real_t> args;
 			Error err = _parse_construct<real_t>(p_stream, args, line, r_err_str);
 			if (err) {
@@ -731,7 +876,7 @@ Error VariantParser::parse_value(Token &token, Variant &value, Stream *p_stream,
 			}
 
 			value = AABB(Vector3(args[0], args[1], args[2]), Vector3(args[3], args[4], args[5]));
-		} else if (id == "Basis" || id == "Matrix3") { //compatibility
+		} else if (_is_identifier(id, "Basis") || _is_identifier(id, "Matrix3")) { //compatibility
 			Vector<real_t> args;
 			Error err = _parse_construct<real_t>(p_stream, args, line, r_err_str);
 			if (err) {
@@ -744,7 +889,7 @@ Error VariantParser::parse_value(Token &token, Variant &value, Stream *p_stream,
 			}
 
 			value = Basis(args[0], args[1], args[2], args[3], args[4], args[5], args[6], args[7], args[8]);
-		} else if (id == "Transform3D" || id == "Transform") { // "Transform" kept for compatibility with Godot <4.
+		} else if (_is_identifier(id, "Transform3D") || _is_identifier(id, "Transform")) { // "Transform" kept for compatibility with Godot <4.
 			Vector<real_t> args;
 			Error err = _parse_construct<real_t>(p_stream, args, line, r_err_str);
 			if (err) {
@@ -757,7 +902,7 @@ Error VariantParser::parse_value(Token &token, Variant &value, Stream *p_stream,
 			}
 
 			value = Transform3D(Basis(args[0], args[1], args[2], args[3], args[4], args[5], args[6], args[7], args[8]), Vector3(args[9], args[10], args[11]));
-		} else if (id == "Projection") { // "Transform" kept for compatibility with Godot <4.
+		} else if (_is_identifier(id, "Projection")) { // "Transform" kept for compatibility with Godot <4.
 			Vector<real_t> args;
 			Error err = _parse_construct<real_t>(p_stream, args, line, r_err_str);
 			if (err) {
@@ -770,7 +915,7 @@ Error VariantParser::parse_value(Token &token, Variant &value, Stream *p_stream,
 			}
 
 			value = Projection(Vector4(args[0], args[1], args[2], args[3]), Vector4(args[4], args[5], args[6], args[7]), Vector4(args[8], args[9], args[10], args[11]), Vector4(args[12], args[13], args[14], args[15]));
-		} else if (id == "Color") {
+		} else if (_is_identifier(id, "Color")) {
 			Vector<float> args;
 			Error err = _parse_construct<float>(p_stream, args, line, r_err_str);
 			if (err) {
@@ -783,7 +928,7 @@ Error VariantParser::parse_value(Token &token, Variant &value, Stream *p_stream,
 			}
 
 			value = Color(args[0], args[1], args[2], args[3]);
-		} else if (id == "NodePath") {
+		} else if (_is_identifier(id, "NodePath")) {
 			get_token(p_stream, token, line, r_err_str);
 			if (token.type != TK_PARENTHESIS_OPEN) {
 				r_err_str = "Expected '('";
@@ -803,7 +948,7 @@ Error VariantParser::parse_value(Token &token, Variant &value, Stream *p_stream,
 				r_err_str = "Expected ')'";
 				return ERR_PARSE_ERROR;
 			}
-		} else if (id == "RID") {
+		} else if (_is_identifier(id, "RID")) {
 			get_token(p_stream, token, line, r_err_str);
 			if (token.type != TK_PARENTHESIS_OPEN) {
 				r_err_str = "Expected '('";
@@ -823,7 +968,7 @@ Error VariantParser::parse_value(Token &token, Variant &value, Stream *p_stream,
 				r_err_str = "Expected ')'";
 				return ERR_PARSE_ERROR;
 			}
-		} else if (id == "Object") {
+		} else if (_is_identifier(id, "Object")) {
 			get_token(p_stream, token, line, r_err_str);
 			if (token.type != TK_PARENTHESIS_OPEN) {
 				r_err_str = "Expected '('";
@@ -919,14 +1064,14 @@ Error VariantParser::parse_value(Token &token, Variant &value, Stream *p_stream,
 					at_key = true;
 				}
 			}
-		} else if (id == "Resource" || id == "SubResource" || id == "ExtResource") {
+		} else if (_is_identifier(id, "Resource") || _is_identifier(id, "SubResource") || _is_identifier(id, "ExtResource")) {
 			get_token(p_stream, token, line, r_err_str);
 			if (token.type != TK_PARENTHESIS_OPEN) {
 				r_err_str = "Expected '('";
 				return ERR_PARSE_ERROR;
 			}
 
-			if (p_res_parser && id == "Resource" && p_res_parser->func) {
+			if (p_res_parser && _is_identifier(id, "Resource") && p_res_parser->func) {
 				Ref<Resource> res;
 				Error err = p_res_parser->func(p_res_parser->userdata, p_stream, res, line, r_err_str);
 				if (err) {
@@ -934,7 +1079,7 @@ Error VariantParser::parse_value(Token &token, Variant &value, Stream *p_stream,
 				}
 
 				value = res;
-			} else if (p_res_parser && id == "ExtResource" && p_res_parser->ext_func) {
+			} else if (p_res_parser && _is_identifier(id, "ExtResource") && p_res_parser->ext_func) {
 				Ref<Resource> res;
 				Error err = p_res_parser->ext_func(p_res_parser->userdata, p_stream, res, line, r_err_str);
 				if (err) {
@@ -942,7 +1087,7 @@ Error VariantParser::parse_value(Token &token, Variant &value, Stream *p_stream,
 				}
 
 				value = res;
-			} else if (p_res_parser && id == "SubResource" && p_res_parser->sub_func) {
+			} else if (p_res_parser && _is_identifier(id, "SubResource") && p_res_parser->sub_func) {
 				Ref<Resource> res;
 				Error err = p_res_parser->sub_func(p_res_parser->userdata, p_stream, res, line, r_err_str);
 				if (err) {
@@ -972,97 +1117,47 @@ Error VariantParser::parse_value(Token &token, Variant &value, Stream *p_stream,
 					return ERR_PARSE_ERROR;
 				}
 			}
-		} else if (id == "PackedByteArray" || id == "PoolByteArray" || id == "ByteArray") {
+		} else if (_is_identifier(id, "PackedByteArray") || _is_identifier(id, "PoolByteArray") || _is_identifier(id, "ByteArray")) {
 			Vector<uint8_t> args;
 			Error err = _parse_construct<uint8_t>(p_stream, args, line, r_err_str);
 			if (err) {
 				return err;
 			}
 
-			Vector<uint8_t> arr;
-			{
-				int len = args.size();
-				arr.resize(len);
-				uint8_t *w = arr.ptrw();
-				for (int i = 0; i < len; i++) {
-					w[i] = args[i];
-				}
-			}
-
-			value = arr;
-		} else if (id == "PackedInt32Array" || id == "PackedIntArray" || id == "PoolIntArray" || id == "IntArray") {
+			value = args;
+		} else if (_is_identifier(id, "PackedInt32Array") || _is_identifier(id, "PackedIntArray") || _is_identifier(id, "PoolIntArray") || _is_identifier(id, "IntArray")) {
 			Vector<int32_t> args;
 			Error err = _parse_construct<int32_t>(p_stream, args, line, r_err_str);
 			if (err) {
 				return err;
 			}
 
-			Vector<int32_t> arr;
-			{
-				int32_t len = args.size();
-				arr.resize(len);
-				int32_t *w = arr.ptrw();
-				for (int32_t i = 0; i < len; i++) {
-					w[i] = int32_t(args[i]);
-				}
-			}
-
-			value = arr;
-		} else if (id == "PackedInt64Array") {
+			value = args;
+		} else if (_is_identifier(id, "PackedInt64Array")) {
 			Vector<int64_t> args;
 			Error err = _parse_construct<int64_t>(p_stream, args, line, r_err_str);
 			if (err) {
 				return err;
 			}
 
-			Vector<int64_t> arr;
-			{
-				int64_t len = args.size();
-				arr.resize(len);
-				int64_t *w = arr.ptrw();
-				for (int64_t i = 0; i < len; i++) {
-					w[i] = int64_t(args[i]);
-				}
-			}
-
-			value = arr;
-		} else if (id == "PackedFloat32Array" || id == "PackedRealArray" || id == "PoolRealArray" || id == "FloatArray") {
+			value = args;
+		} else if (_is_identifier(id, "PackedFloat32Array") || _is_identifier(id, "PackedRealArray") || _is_identifier(id, "PoolRealArray") || _is_identifier(id, "FloatArray")) {
 			Vector<float> args;
 			Error err = _parse_construct<float>(p_stream, args, line, r_err_str);
 			if (err) {
 				return err;
 			}
 
-			Vector<float> arr;
-			{
-				int len = args.size();
-				arr.resize(len);
-				float *w = arr.ptrw();
-				for (int i = 0; i < len; i++) {
-					w[i] = args[i];
-				}
-			}
-
-			value = arr;
-		} else if (id == "PackedFloat64Array") {
+			value = args;
+		} else if (_is_identifier(id, "PackedFloat64Array")) {
 			Vector<double> args;
 			Error err = _parse_construct<double>(p_stream, args, line, r_err_str);
 			if (err) {
 				return err;
 			}
 
-			Vector<double> arr;
-			{
-				int len = args.size();
-				arr.resize(len);
-				double *w = arr.ptrw();
-				for (int i = 0; i < len; i++) {
-					w[i] = args[i];
-				}
-			}
-
-			value = arr;
-		} else if (id == "PackedStringArray" || id == "PoolStringArray" || id == "StringArray") {
+			value = args;
+		} else if (_is_identifier(id, "PackedStringArray") || _is_identifier(id, "PoolStringArray") || _is_identifier(id, "StringArray")) {
 			get_token(p_stream, token, line, r_err_str);
 			if (token.type != TK_PARENTHESIS_OPEN) {
 				r_err_str = "Expected '('";
@@ -1097,18 +1192,8 @@ Error VariantParser::parse_value(Token &token, Variant &value, Stream *p_stream,
 				cs.push_back(token.value);
 			}
 
-			Vector<String> arr;
-			{
-				int len = cs.size();
-				arr.resize(len);
-				String *w = arr.ptrw();
-				for (int i = 0; i < len; i++) {
-					w[i] = cs[i];
-				}
-			}
-
-			value = arr;
-		} else if (id == "PackedVector2Array" || id == "PoolVector2Array" || id == "Vector2Array") {
+			value = cs;
+		} else if (_is_identifier(id, "PackedVector2Array") || _is_identifier(id, "PoolVector2Array") || _is_identifier(id, "Vector2Array")) {
 			Vector<real_t> args;
 			Error err = _parse_construct<real_t>(p_stream, args, line, r_err_str);
 			if (err) {
@@ -1126,7 +1211,7 @@ Error VariantParser::parse_value(Token &token, Variant &value, Stream *p_stream,
 			}
 
 			value = arr;
-		} else if (id == "PackedVector3Array" || id == "PoolVector3Array" || id == "Vector3Array") {
+		} else if (_is_identifier(id, "PackedVector3Array") || _is_identifier(id, "PoolVector3Array") || _is_identifier(id, "Vector3Array")) {
 			Vector<real_t> args;
 			Error err = _parse_construct<real_t>(p_stream, args, line, r_err_str);
 			if (err) {
@@ -1144,7 +1229,7 @@ Error VariantParser::parse_value(Token &token, Variant &value, Stream *p_stream,
 			}
 
 			value = arr;
-		} else if (id == "PackedColorArray" || id == "PoolColorArray" || id == "ColorArray") {
+		} else if (_is_identifier(id, "PackedColorArray") || _is_identifier(id, "PoolColorArray") || _is_identifier(id, "ColorArray")) {
 			Vector<float> args;
 			Error err = _parse_construct<float>(p_stream, args, line, r_err_str);
 			if (err) {
@@ -1418,7 +1503,7 @@ Error VariantParser::parse_tag(Stream *p_stream, int &line, String &r_err_str, T
 Error VariantParser::parse_tag_assign_eof(Stream *p_stream, int &line, String &r_err_str, Tag &r_tag, String &r_assign, Variant &r_value, ResourceParser *p_res_parser, bool p_simple_tag) {
 	//assign..
 	r_assign = "";
-	String what;
+	StringBuffer<> what;
 
 	while (true) {
 		char32_t c;
@@ -1470,12 +1555,13 @@ Error VariantParser::parse_tag_assign_eof(Stream *p_stream, int &line, String &r
 					return ERR_INVALID_DATA;
 				}
 
-				what = tk.value;
+				what = StringBuffer<>();
+				what += String(tk.value);
 
 			} else if (c != '=') {
-				what += String::chr(c);
+				what += c;
 			} else {
-				r_assign = what;
+				r_assign = what.as_string();
 				Token token;
 				get_token(p_stream, token, line, r_err_str);
 				Error err = parse_value(token, r_value, p_stream, line, r_err_str, p_res_parser);
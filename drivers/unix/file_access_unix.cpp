@@ -41,6 +41,7 @@
 #include <errno.h>
 
 #if defined(UNIX_ENABLED)
+#include <sys/mman.h>
 #include <unistd.h>
 #endif
 
@@ -150,6 +151,15 @@ void FileAccessUnix::_close() {
 		return;
 	}
 
+#if defined(UNIX_ENABLED)
+	if (mapped_address) {
+		munmap(mapped_address, mapped_length);
+	}
+#endif
+	mapped_address = nullptr;
+	mapped_length = 0;
+	map_failed = false;
+
 	fclose(f);
 	f = nullptr;
 
@@ -245,6 +255,44 @@ uint64_t FileAccessUnix::get_buffer(uint8_t *p_dst, uint64_t p_length) const {
 	return read;
 }
 
+const uint8_t *FileAccessUnix::map_region(uint64_t p_offset, uint64_t p_length) const {
+	ERR_FAIL_COND_V_MSG(!f, nullptr, "File must be opened before use.");
+
+#if defined(UNIX_ENABLED)
+	// A file that is written could change under the mapping.
+	if (flags != READ || p_length == 0 || map_failed) {
+		return nullptr;
+	}
+
+	if (!mapped_address) {
+		// Map the whole file once, so repeated views don't add mappings.
+		const uint64_t length = get_length();
+		if (length == 0 || length != (size_t)length) {
+			map_failed = true; // Empty, or doesn't fit in the address space.
+			return nullptr;
+		}
+
+		void *address = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fileno(f), 0);
+		if (address == MAP_FAILED) {
+			map_failed = true;
+			return nullptr;
+		}
+
+		mapped_address = address;
+		mapped_length = length;
+	}
+
+	// Reading past the end of the mapping faults.
+	if (p_offset > mapped_length || p_length > mapped_length - p_offset) {
+		return nullptr;
+	}
+
+	return (const uint8_t *)mapped_address + p_offset;
+#else
+	return nullptr;
+#endif
+}
+
 Error FileAccessUnix::get_error() const {
 	return last_error;
 }
@@ -49,6 +49,11 @@ class FileAccessUnix : public FileAccess {
 	String path;
 	String path_src;
 
+	// Whole file, mapped on the first map_region() call.
+	mutable void *mapped_address = nullptr;
+	mutable size_t mapped_length = 0;
+	mutable bool map_failed = false;
+
 	void _close();
 
 public:
@@ -69,6 +74,7 @@ public:
 
 	virtual uint8_t get_8() const override; ///< get a byte
 	virtual uint64_t get_buffer(uint8_t *p_dst, uint64_t p_length) const override;
+	virtual const uint8_t *map_region(uint64_t p_offset, uint64_t p_length) const override;
 
 	virtual Error get_error() const override; ///< get last error
 
@@ -38,7 +38,9 @@
 #include "core/io/resource_saver.h"
 #include "core/object/worker_thread_pool.h"
 #include "core/os/os.h"
+#include "core/templates/local_vector.h"
 #include "core/variant/variant_parser.h"
+#include "core/version.h"
 #include "editor/editor_node.h"
 #include "editor/editor_paths.h"
 #include "editor/editor_resource_preview.h"
@@ -1909,14 +1911,27 @@ void EditorFileSystem::_reimport_file(const String &p_file, const HashMap<String
 
 	//finally, perform import!!
 	String base_path = ResourceFormatImporter::get_singleton()->get_import_base_path(p_file);
+	String source_md5 = FileAccess::get_md5(p_file);
+
+	String cache_key;
+	if (importer->can_import_from_cache() && bool(GLOBAL_GET("editor/import/use_artifact_cache"))) {
+		cache_key = _get_import_cache_key(p_file, source_md5, importer, opts, params);
+	}
 
 	List<String> import_variants;
 	List<String> gen_files;
 	Variant metadata;
-	Error err = importer->import(p_file, base_path, params, &import_variants, &gen_files, &metadata);
+	Error err = OK;
+	bool from_cache = !cache_key.is_empty() && _load_import_from_cache(cache_key, base_path, import_variants, metadata);
+	if (from_cache) {
+		import_stats.from_cache.increment();
+	} else {
+		err = importer->import(p_file, base_path, params, &import_variants, &gen_files, &metadata);
+		import_stats.imported.increment();
 
-	if (err != OK) {
-		ERR_PRINT("Error importing '" + p_file + "'.");
+		if (err != OK) {
+			ERR_PRINT("Error importing '" + p_file + "'.");
+		}
 	}
 
 	//as import is complete, save the .import file
@@ -2009,12 +2024,17 @@ void EditorFileSystem::_reimport_file(const String &p_file, const HashMap<String
 		}
 	}
 
+	// Generated files are written outside of the import folder, so those imports are not cached.
+	if (!cache_key.is_empty() && !from_cache && err == OK && gen_files.is_empty() && !dest_paths.is_empty()) {
+		_store_import_in_cache(cache_key, dest_paths, import_variants, metadata);
+	}
+
 	// Store the md5's of the various files. These are stored separately so that the .import files can be version controlled.
 	{
 		Ref<FileAccess> md5s = FileAccess::open(base_path + ".md5", FileAccess::WRITE);
 		ERR_FAIL_COND_MSG(md5s.is_null(), "Cannot open MD5 file '" + base_path + ".md5'.");
 
-		md5s->store_line("source_md5=\"" + FileAccess::get_md5(p_file) + "\"");
+		md5s->store_line("source_md5=\"" + source_md5 + "\"");
 		if (dest_paths.size()) {
 			md5s->store_line("dest_md5=\"" + FileAccess::get_multiple_md5(dest_paths) + "\"\n");
 		}
@@ -2048,6 +2068,113 @@ void EditorFileSystem::_reimport_file(const String &p_file, const HashMap<String
 	EditorResourcePreview::get_singleton()->check_for_invalidation(p_file);
 }
 
+String EditorFileSystem::_get_import_cache_path(const String &p_key) const {
+	return EditorPaths::get_singleton()->get_cache_dir().plus_file("import_artifacts").plus_file(p_key);
+}
+
+String EditorFileSystem::_get_import_cache_key(const String &p_file, const String &p_source_md5, const Ref<ResourceImporter> &p_importer, const List<ResourceImporter::ImportOption> &p_options, const HashMap<StringName, Variant> &p_params) const {
+	// The imported files can contain the source path, so it is part of the key along with everything the importer reads.
+	String key = String(VERSION_FULL_BUILD) + "\n" + p_file + "\n" + p_source_md5 + "\n";
+	key += p_importer->get_importer_name() + "\n" + itos(p_importer->get_format_version()) + "\n" + p_importer->get_import_settings_string() + "\n";
+
+	for (const ResourceImporter::ImportOption &E : p_options) {
+		const Variant &value = p_params[E.option.name];
+		String text;
+		VariantWriter::write_to_string(value, text);
+		key += String(E.option.name) + "=" + text + "\n";
+
+		// Options can point to other files (such as normal maps), whose contents matter too.
+		if (value.get_type() == Variant::STRING) {
+			String path = value;
+			if (path.begins_with("res://") && FileAccess::exists(path)) {
+				key += FileAccess::get_md5(path) + "\n";
+			}
+		}
+	}
+
+	return key.sha256_text();
+}
+
+static void _remove_import_cache_dir(const String &p_dir) {
+	Ref<DirAccess> da = DirAccess::open(p_dir);
+	if (da.is_valid()) {
+		da->erase_contents_recursive();
+		da->remove(p_dir);
+	}
+}
+
+bool EditorFileSystem::_load_import_from_cache(const String &p_key, const String &p_base_path, List<String> &r_import_variants, Variant &r_metadata) const {
+	String cache_path = _get_import_cache_path(p_key);
+
+	Ref<ConfigFile> cf;
+	cf.instantiate();
+	if (cf->load(cache_path.plus_file("artifact.cfg")) != OK) {
+		return false;
+	}
+
+	Vector<String> files = cf->get_value("artifact", "files", Vector<String>());
+	if (files.is_empty()) {
+		return false;
+	}
+
+	Ref<DirAccess> da = DirAccess::create(DirAccess::ACCESS_FILESYSTEM);
+	String dest_dir = ProjectSettings::get_singleton()->globalize_path(p_base_path.get_base_dir());
+	for (int i = 0; i < files.size(); i++) {
+		if (da->copy(cache_path.plus_file(files[i]), dest_dir.plus_file(files[i])) != OK) {
+			return false;
+		}
+	}
+
+	Vector<String> variants = cf->get_value("artifact", "variants", Vector<String>());
+	r_import_variants.clear();
+	for (int i = 0; i < variants.size(); i++) {
+		r_import_variants.push_back(variants[i]);
+	}
+	r_metadata = cf->get_value("artifact", "metadata", Variant());
+	return true;
+}
+
+void EditorFileSystem::_store_import_in_cache(const String &p_key, const Vector<String> &p_dest_paths, const List<String> &p_import_variants, const Variant &p_metadata) const {
+	String cache_path = _get_import_cache_path(p_key);
+
+	Ref<DirAccess> da = DirAccess::create(DirAccess::ACCESS_FILESYSTEM);
+	if (da->dir_exists(cache_path)) {
+		return;
+	}
+
+	// Written to a temporary folder first and renamed at the end, so other threads and editor instances
+	// only ever see complete entries.
+	String temp_path = cache_path + ".tmp" + itos(OS::get_singleton()->get_process_id()) + "_" + itos(Thread::get_caller_id());
+	Error err = da->make_dir_recursive(temp_path);
+	ERR_FAIL_COND_MSG(err != OK, "Cannot create import cache folder '" + temp_path + "'.");
+
+	Vector<String> files;
+	for (int i = 0; i < p_dest_paths.size(); i++) {
+		String file = p_dest_paths[i].get_file();
+		if (da->copy(ProjectSettings::get_singleton()->globalize_path(p_dest_paths[i]), temp_path.plus_file(file)) != OK) {
+			_remove_import_cache_dir(temp_path);
+			return;
+		}
+		files.push_back(file);
+	}
+
+	Vector<String> variants;
+	for (const String &E : p_import_variants) {
+		variants.push_back(E);
+	}
+
+	Ref<ConfigFile> cf;
+	cf.instantiate();
+	cf->set_value("artifact", "files", files);
+	cf->set_value("artifact", "variants", variants);
+	cf->set_value("artifact", "metadata", p_metadata);
+
+	if (cf->save(temp_path.plus_file("artifact.cfg")) != OK || da->rename(temp_path, cache_path) != OK) {
+		// Another thread or editor instance may have stored the same entry meanwhile.
+		_remove_import_cache_dir(temp_path);
+	}
+}
+
 void EditorFileSystem::_find_group_files(EditorFileSystemDirectory *efd, HashMap<String, Vector<String>> &group_files, HashSet<String> &groups_to_reimport) {
 	int fc = efd->files.size();
 	const EditorFileSystemDirectory::FileInfo *const *files = efd->files.ptr();
@@ -2070,8 +2197,9 @@ void EditorFileSystem::reimport_file_with_custom_parameters(const String &p_file
 }
 
 void EditorFileSystem::_reimport_thread(uint32_t p_index, ImportThreadData *p_import_data) {
-	p_import_data->max_index = MAX(p_import_data->reimport_from + int(p_index), p_import_data->max_index);
-	_reimport_file(p_import_data->reimport_files[p_import_data->reimport_from + p_index].path);
+	p_import_data->max_index.exchange_if_greater(p_index);
+	_reimport_file(p_import_data->reimport_files[p_import_data->threaded_files[p_index]].path);
+	p_import_data->imported.increment();
 }
 
 void EditorFileSystem::reimport_files(const Vector<String> &p_files) {
@@ -2120,47 +2248,86 @@ void EditorFileSystem::reimport_files(const Vector<String> &p_files) {
 
 	bool use_threads = GLOBAL_GET("editor/import/use_multiple_threads");
 
+	uint64_t start_time = OS::get_singleton()->get_ticks_usec();
+	import_stats.imported.set(0);
+	import_stats.from_cache.set(0);
+	int threaded_count = 0;
+
+	// Files only depend on files with a lower import order (scenes on the textures and meshes they use), so
+	// each order is imported as one batch: first the files whose importers can't run on threads, alone on
+	// this thread, then the other ones on the worker threads, with all their importers at once.
 	int from = 0;
-	for (int i = 0; i < reimport_files.size(); i++) {
-		if (use_threads && reimport_files[i].threaded) {
-			if (i + 1 == reimport_files.size() || reimport_files[i + 1].importer != reimport_files[from].importer) {
-				if (from - i == 0) {
-					//single file, do not use threads
-					pr.step(reimport_files[i].path.get_file(), i);
-					_reimport_file(reimport_files[i].path);
-				} else {
-					Ref<ResourceImporter> importer = ResourceFormatImporter::get_singleton()->get_importer_by_name(reimport_files[from].importer);
-					ERR_CONTINUE(!importer.is_valid());
-
-					importer->import_threaded_begin();
-
-					ImportThreadData data;
-					data.max_index = from;
-					data.reimport_from = from;
-					data.reimport_files = reimport_files.ptr();
-
-					WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &EditorFileSystem::_reimport_thread, &data, i - from + 1, -1, false, vformat(TTR("Import resources of type: %s"), reimport_files[from].importer));
-					int current_index = from - 1;
-					do {
-						if (current_index < data.max_index) {
-							current_index = data.max_index;
-							pr.step(reimport_files[current_index].path.get_file(), current_index);
-						}
-						OS::get_singleton()->delay_usec(1);
-					} while (!WorkerThreadPool::get_singleton()->is_group_task_completed(group_task));
+	while (from < reimport_files.size()) {
+		int to = from + 1;
+		while (to < reimport_files.size() && reimport_files[to].order == reimport_files[from].order) {
+			to++;
+		}
+
+		LocalVector<int> threaded_files;
+		LocalVector<int> serial_files;
+		Vector<Ref<ResourceImporter>> threaded_importers;
+		for (int i = from; i < to; i++) {
+			if (use_threads && reimport_files[i].threaded) {
+				// Sorted by importer within the same order.
+				if (threaded_importers.is_empty() || threaded_importers[threaded_importers.size() - 1]->get_importer_name() != reimport_files[i].importer) {
+					Ref<ResourceImporter> importer = ResourceFormatImporter::get_singleton()->get_importer_by_name(reimport_files[i].importer);
+					if (importer.is_valid()) {
+						threaded_importers.push_back(importer);
+					}
+				}
+				if (!threaded_importers.is_empty() && threaded_importers[threaded_importers.size() - 1]->get_importer_name() == reimport_files[i].importer) {
+					threaded_files.push_back(i);
+					continue;
+				}
+			}
+			serial_files.push_back(i);
+		}
 
-					WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+		if (threaded_files.size() == 1) {
+			// Single file, do not use threads, and import the whole order in its sorted order.
+			threaded_files.clear();
+			threaded_importers.clear();
+			serial_files.clear();
+			for (int i = from; i < to; i++) {
+				serial_files.push_back(i);
+			}
+		}
 
-					importer->import_threaded_end();
-				}
+		for (uint32_t i = 0; i < serial_files.size(); i++) {
+			const String &path = reimport_files[serial_files[i]].path;
+			pr.step(path.get_file(), from + i);
+			_reimport_file(path);
+		}
 
-				from = i + 1;
+		if (threaded_files.size()) {
+			for (int i = 0; i < threaded_importers.size(); i++) {
+				threaded_importers.write[i]->import_threaded_begin();
 			}
 
-		} else {
-			pr.step(reimport_files[i].path.get_file(), i);
-			_reimport_file(reimport_files[i].path);
+			ImportThreadData data;
+			data.reimport_files = reimport_files.ptr();
+			data.threaded_files = threaded_files.ptr();
+			WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &EditorFileSystem::_reimport_thread, &data, threaded_files.size(), -1, false, TTR("Import resources"));
+			threaded_count += threaded_files.size();
+
+			uint32_t shown = 0;
+			do {
+				uint32_t imported = data.imported.get();
+				if (imported > shown) {
+					shown = imported;
+					pr.step(reimport_files[threaded_files[data.max_index.get()]].path.get_file(), from + serial_files.size() + imported);
+				}
+				OS::get_singleton()->delay_usec(1);
+			} while (!WorkerThreadPool::get_singleton()->is_group_task_completed(group_task));
+
+			WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+
+			for (int i = 0; i < threaded_importers.size(); i++) {
+				threaded_importers.write[i]->import_threaded_end();
+			}
 		}
+
+		from = to;
 	}
 
 	//reimport groups
@@ -2176,6 +2343,8 @@ void EditorFileSystem::reimport_files(const Vector<String> &p_files) {
 		}
 	}
 
+	print_verbose(vformat("EditorFileSystem: Reimported %d files in %d ms (%d imported, %d from the artifact cache, %d on worker threads).", p_files.size(), (OS::get_singleton()->get_ticks_usec() - start_time) / 1000, import_stats.imported.get(), import_stats.from_cache.get(), threaded_count));
+
 	ResourceUID::get_singleton()->update_cache(); //after reimporting, update the cache
 
 	_save_filesystem_cache();
@@ -2420,6 +2589,7 @@ EditorFileSystem::EditorFileSystem() {
 	ResourceLoader::import = _resource_import;
 	reimport_on_missing_imported_files = GLOBAL_DEF("editor/import/reimport_missing_imported_files", true);
 	GLOBAL_DEF("editor/import/use_multiple_threads", true);
+	GLOBAL_DEF("editor/import/use_artifact_cache", false);
 	singleton = this;
 	filesystem = memnew(EditorFileSystemDirectory); //like, empty
 	filesystem->parent = nullptr;
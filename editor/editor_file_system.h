@@ -32,6 +32,7 @@
 #define EDITOR_FILE_SYSTEM_H
 
 #include "core/io/dir_access.h"
+#include "core/io/resource_importer.h"
 #include "core/os/thread.h"
 #include "core/os/thread_safe.h"
 #include "core/templates/hash_set.h"
@@ -275,13 +276,27 @@ class EditorFileSystem : public Node {
 	HashSet<String> group_file_cache;
 
 	struct ImportThreadData {
-		const ImportFile *reimport_files;
-		int reimport_from;
-		int max_index = 0;
+		const ImportFile *reimport_files = nullptr;
+		const int *threaded_files = nullptr;
+		SafeNumeric<uint32_t> max_index;
+		SafeNumeric<uint32_t> imported;
 	};
 
 	void _reimport_thread(uint32_t p_index, ImportThreadData *p_import_data);
 
+	// Counted by `_reimport_file`, which runs on several threads.
+	struct ImportStats {
+		SafeNumeric<uint32_t> imported;
+		SafeNumeric<uint32_t> from_cache;
+	};
+
+	ImportStats import_stats;
+
+	String _get_import_cache_path(const String &p_key) const;
+	String _get_import_cache_key(const String &p_file, const String &p_source_md5, const Ref<ResourceImporter> &p_importer, const List<ResourceImporter::ImportOption> &p_options, const HashMap<StringName, Variant> &p_params) const;
+	bool _load_import_from_cache(const String &p_key, const String &p_base_path, List<String> &r_import_variants, Variant &r_metadata) const;
+	void _store_import_in_cache(const String &p_key, const Vector<String> &p_dest_paths, const List<String> &p_import_variants, const Variant &p_metadata) const;
+
 	static ResourceUID::ID _resource_saver_get_resource_id_for_path(const String &p_path, bool p_generate);
 
 	bool _scan_extensions();
@@ -280,9 +280,11 @@ Error SceneReplicationInterface::_make_spawn_packet(Node *p_node, int &r_len) {
 	bool is_custom = scene_id == MultiplayerSpawner::INVALID_ID;
 	Variant spawn_arg = spawner->get_spawn_argument(oid);
 	int spawn_arg_size = 0;
+	encode_cache.clear();
 	if (is_custom) {
-		Error err = MultiplayerAPI::encode_and_compress_variant(spawn_arg, nullptr, spawn_arg_size, false);
+		Error err = MultiplayerAPI::encode_and_compress_variant(spawn_arg, encode_cache, false);
 		ERR_FAIL_COND_V(err, err);
+		spawn_arg_size = encode_cache.size();
 	}
 
 	// Prepare spawn state.
@@ -295,8 +297,9 @@ Error SceneReplicationInterface::_make_spawn_packet(Node *p_node, int &r_len) {
 		const List<NodePath> props = synchronizer->get_replication_config()->get_spawn_properties();
 		Error err = MultiplayerSynchronizer::get_state(props, p_node, state_vars, state_varp);
 		ERR_FAIL_COND_V_MSG(err != OK, err, "Unable to retrieve spawn state.");
-		err = MultiplayerAPI::encode_and_compress_variants(state_varp.ptrw(), state_varp.size(), nullptr, state_size);
+		err = MultiplayerAPI::encode_and_compress_variants(state_varp.ptrw(), state_varp.size(), encode_cache);
 		ERR_FAIL_COND_V_MSG(err != OK, err, "Unable to encode spawn state.");
+		state_size = encode_cache.size() - spawn_arg_size;
 	}
 
 	// Encode scene ID, path ID, net ID, node name.
@@ -315,14 +318,12 @@ Error SceneReplicationInterface::_make_spawn_packet(Node *p_node, int &r_len) {
 	// Write args
 	if (is_custom) {
 		ofs += encode_uint32(spawn_arg_size, &ptr[ofs]);
-		Error err = MultiplayerAPI::encode_and_compress_variant(spawn_arg, &ptr[ofs], spawn_arg_size, false);
-		ERR_FAIL_COND_V(err, err);
+		memcpy(&ptr[ofs], encode_cache.ptr(), spawn_arg_size);
 		ofs += spawn_arg_size;
 	}
 	// Write state.
 	if (state_size) {
-		Error err = MultiplayerAPI::encode_and_compress_variants(state_varp.ptrw(), state_varp.size(), &ptr[ofs], state_size);
-		ERR_FAIL_COND_V(err, err);
+		memcpy(&ptr[ofs], encode_cache.ptr() + spawn_arg_size, state_size);
 		ofs += state_size;
 	}
 	r_len = ofs;
@@ -462,14 +463,15 @@ void SceneReplicationInterface::_send_sync(int p_peer, uint64_t p_msec) {
 				continue;
 			}
 		}
-		int size;
 		Vector<Variant> vars;
 		Vector<const Variant *> varp;
 		const List<NodePath> props = sync->get_replication_config()->get_sync_properties();
 		Error err = MultiplayerSynchronizer::get_state(props, node, vars, varp);
 		ERR_CONTINUE_MSG(err != OK, "Unable to retrieve sync state.");
-		err = MultiplayerAPI::encode_and_compress_variants(varp.ptrw(), varp.size(), nullptr, size);
+		encode_cache.clear();
+		err = MultiplayerAPI::encode_and_compress_variants(varp.ptrw(), varp.size(), encode_cache);
 		ERR_CONTINUE_MSG(err != OK, "Unable to encode sync state.");
+		int size = encode_cache.size();
 		// TODO Handle single state above MTU.
 		ERR_CONTINUE_MSG(size > 3 + 4 + 4 + sync_mtu, vformat("Node states bigger then MTU will not be sent (%d > %d): %s", size, sync_mtu, node->get_path()));
 		if (ofs + 4 + 4 + size > sync_mtu) {
@@ -480,7 +482,7 @@ void SceneReplicationInterface::_send_sync(int p_peer, uint64_t p_msec) {
 		if (size) {
 			ofs += encode_uint32(rep_state->get_net_id(oid), &ptr[ofs]);
 			ofs += encode_uint32(size, &ptr[ofs]);
-			MultiplayerAPI::encode_and_compress_variants(varp.ptrw(), varp.size(), &ptr[ofs], size);
+			memcpy(&ptr[ofs], encode_cache.ptr(), size);
 			ofs += size;
 		}
 	}
@@ -54,6 +54,7 @@ private:
 	Ref<SceneReplicationState> rep_state;
 	SceneMultiplayer *multiplayer = nullptr;
 	PackedByteArray packet_cache;
+	LocalVector<uint8_t> encode_cache;
 	int sync_mtu = 1350; // Highly dependent on underlying protocol.
 
 	// An hack to apply the initial state before ready.
@@ -304,7 +304,7 @@ void SceneRPCInterface::_send_rpc(Node *p_from, int p_to, uint16_t p_rpc_id, con
 	if (p_to != 0 && !multiplayer->get_connected_peers().has(ABS(p_to))) {
 		ERR_FAIL_COND_MSG(p_to == multiplayer->get_unique_id(), "Attempt to call RPC on yourself! Peer unique ID: " + itos(multiplayer->get_unique_id()) + ".");
 
-		ERR_FAIL_COND_MSG(true, Error::ERR_INVALID_PARAMETER,"Attempt to call RPC with unknown peer ID: " + itos(p_to) + ".");
+		ERR_FAIL_MSG("Attempt to call RPC with unknown peer ID: " + itos(p_to) + ".");
 	}
 
 	// See if all peers have cached path (if so, call can be fast).
@@ -375,8 +375,10 @@ void SceneRPCInterface::_send_rpc(Node *p_from, int p_to, uint16_t p_rpc_id, con
 		ofs += 2;
 	}
 
-	int len;
-	Error err = MultiplayerAPI::encode_and_compress_variants(p_arg, p_argcount, nullptr, len, &byte_only_or_no_args, multiplayer->is_object_decoding_allowed());
+	encode_cache.clear();
+	Error err = MultiplayerAPI::encode_and_compress_variants(p_arg, p_argcount, encode_cache, &byte_only_or_no_args, multiplayer->is_object_decoding_allowed());
+	ERR_FAIL_COND_MSG(err != OK, "Unable to encode RPC arguments.");
+	int len = encode_cache.size();
 	if (byte_only_or_no_args) {
 		MAKE_ROOM(ofs + len);
 	} else {
@@ -385,7 +387,7 @@ void SceneRPCInterface::_send_rpc(Node *p_from, int p_to, uint16_t p_rpc_id, con
 		ofs += 1;
 	}
 	if (len) {
-		MultiplayerAPI::encode_and_compress_variants(p_arg, p_argcount, &packet_cache.write[ofs], len, &byte_only_or_no_args, multiplayer->is_object_decoding_allowed());
+		memcpy(packet_cache.ptrw() + ofs, encode_cache.ptr(), len);
 		ofs += len;
 	}
 
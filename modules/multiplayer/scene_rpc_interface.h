@@ -78,6 +78,7 @@ private:
 
 	SceneMultiplayer *multiplayer = nullptr;
 	Vector<uint8_t> packet_cache;
+	LocalVector<uint8_t> encode_cache;
 
 	HashMap<ObjectID, RPCConfigCache> rpc_cache;
 
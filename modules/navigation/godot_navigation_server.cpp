@@ -113,6 +113,10 @@ GodotNavigationServer::GodotNavigationServer() {}
 
 GodotNavigationServer::~GodotNavigationServer() {
 	flush_queries();
+
+	for (uint32_t i = 0; i < path_query_scratches.size(); i++) {
+		memdelete(path_query_scratches[i]);
+	}
 }
 
 void GodotNavigationServer::add_command(SetCommand *command) const {
@@ -210,6 +214,34 @@ real_t GodotNavigationServer::map_get_edge_connection_margin(RID p_map) const {
 	return map->get_edge_connection_margin();
 }
 
+COMMAND_2(map_set_use_hierarchical_paths, RID, p_map, bool, p_enabled) {
+	NavMap *map = map_owner.get_or_null(p_map);
+	ERR_FAIL_COND(map == nullptr);
+
+	map->set_use_hierarchical_paths(p_enabled);
+}
+
+bool GodotNavigationServer::map_get_use_hierarchical_paths(RID p_map) const {
+	const NavMap *map = map_owner.get_or_null(p_map);
+	ERR_FAIL_COND_V(map == nullptr, false);
+
+	return map->get_use_hierarchical_paths();
+}
+
+COMMAND_2(map_set_hierarchical_cluster_size, RID, p_map, real_t, p_cluster_size) {
+	NavMap *map = map_owner.get_or_null(p_map);
+	ERR_FAIL_COND(map == nullptr);
+
+	map->set_hierarchical_cluster_size(p_cluster_size);
+}
+
+real_t GodotNavigationServer::map_get_hierarchical_cluster_size(RID p_map) const {
+	const NavMap *map = map_owner.get_or_null(p_map);
+	ERR_FAIL_COND_V(map == nullptr, 0);
+
+	return map->get_hierarchical_cluster_size();
+}
+
 Vector<Vector3> GodotNavigationServer::map_get_path(RID p_map, Vector3 p_origin, Vector3 p_destination, bool p_optimize, uint32_t p_navigation_layers) const {
 	const NavMap *map = map_owner.get_or_null(p_map);
 	ERR_FAIL_COND_V(map == nullptr, Vector<Vector3>());
@@ -217,6 +249,22 @@ Vector<Vector3> GodotNavigationServer::map_get_path(RID p_map, Vector3 p_origin,
 	return map->get_path(p_origin, p_destination, p_optimize, p_navigation_layers);
 }
 
+void GodotNavigationServer::map_query_path(RID p_map, Vector3 p_origin, Vector3 p_destination, bool p_optimize, const Callable &p_callback, uint32_t p_navigation_layers) const {
+	ERR_FAIL_COND(p_callback.is_null());
+
+	PathQuery query;
+	query.map = p_map;
+	query.origin = p_origin;
+	query.destination = p_destination;
+	query.optimize = p_optimize;
+	query.navigation_layers = p_navigation_layers;
+	query.callback = p_callback;
+
+	GodotNavigationServer *mut_this = const_cast<GodotNavigationServer *>(this);
+	MutexLock lock(mut_this->path_queries_mutex);
+	mut_this->pending_path_queries.push_back(query);
+}
+
 Vector3 GodotNavigationServer::map_get_closest_point_to_segment(RID p_map, const Vector3 &p_from, const Vector3 &p_to, const bool p_use_collision) const {
 	const NavMap *map = map_owner.get_or_null(p_map);
 	ERR_FAIL_COND_V(map == nullptr, Vector3());
@@ -538,6 +586,91 @@ COMMAND_4(agent_set_callback, RID, p_agent, Object *, p_receiver, StringName, p_
 	}
 }
 
+RID GodotNavigationServer::flow_field_create() const {
+	GodotNavigationServer *mut_this = const_cast<GodotNavigationServer *>(this);
+	MutexLock lock(mut_this->operations_mutex);
+	RID rid = flow_field_owner.make_rid();
+	NavFlowField *flow_field = flow_field_owner.get_or_null(rid);
+	flow_field->set_self(rid);
+	mut_this->flow_fields.push_back(flow_field);
+	return rid;
+}
+
+COMMAND_2(flow_field_set_map, RID, p_flow_field, RID, p_map) {
+	NavFlowField *flow_field = flow_field_owner.get_or_null(p_flow_field);
+	ERR_FAIL_COND(flow_field == nullptr);
+
+	NavMap *map = nullptr;
+	if (p_map.is_valid()) {
+		map = map_owner.get_or_null(p_map);
+		ERR_FAIL_COND(map == nullptr);
+	}
+
+	flow_field->set_map(map);
+}
+
+RID GodotNavigationServer::flow_field_get_map(RID p_flow_field) const {
+	NavFlowField *flow_field = flow_field_owner.get_or_null(p_flow_field);
+	ERR_FAIL_COND_V(flow_field == nullptr, RID());
+
+	if (flow_field->get_map()) {
+		return flow_field->get_map()->get_self();
+	}
+	return RID();
+}
+
+COMMAND_2(flow_field_set_goals, RID, p_flow_field, Vector<Vector3>, p_goals) {
+	NavFlowField *flow_field = flow_field_owner.get_or_null(p_flow_field);
+	ERR_FAIL_COND(flow_field == nullptr);
+
+	flow_field->set_goals(p_goals);
+}
+
+Vector<Vector3> GodotNavigationServer::flow_field_get_goals(RID p_flow_field) const {
+	NavFlowField *flow_field = flow_field_owner.get_or_null(p_flow_field);
+	ERR_FAIL_COND_V(flow_field == nullptr, Vector<Vector3>());
+
+	return flow_field->get_goals();
+}
+
+COMMAND_2(flow_field_set_navigation_layers, RID, p_flow_field, uint32_t, p_navigation_layers) {
+	NavFlowField *flow_field = flow_field_owner.get_or_null(p_flow_field);
+	ERR_FAIL_COND(flow_field == nullptr);
+
+	flow_field->set_navigation_layers(p_navigation_layers);
+}
+
+uint32_t GodotNavigationServer::flow_field_get_navigation_layers(RID p_flow_field) const {
+	NavFlowField *flow_field = flow_field_owner.get_or_null(p_flow_field);
+	ERR_FAIL_COND_V(flow_field == nullptr, 0);
+
+	return flow_field->get_navigation_layers();
+}
+
+Vector3 GodotNavigationServer::flow_field_get_direction(RID p_flow_field, Vector3 p_position) const {
+	const NavFlowField *flow_field = flow_field_owner.get_or_null(p_flow_field);
+	ERR_FAIL_COND_V(flow_field == nullptr, Vector3());
+
+	return flow_field->get_direction(p_position);
+}
+
+Vector<Vector3> GodotNavigationServer::flow_field_get_directions(RID p_flow_field, const Vector<Vector3> &p_positions) const {
+	const NavFlowField *flow_field = flow_field_owner.get_or_null(p_flow_field);
+	ERR_FAIL_COND_V(flow_field == nullptr, Vector<Vector3>());
+
+	Vector<Vector3> directions;
+	directions.resize(p_positions.size());
+	flow_field->get_directions(p_positions.ptr(), directions.ptrw(), p_positions.size());
+	return directions;
+}
+
+real_t GodotNavigationServer::flow_field_get_distance(RID p_flow_field, Vector3 p_position) const {
+	const NavFlowField *flow_field = flow_field_owner.get_or_null(p_flow_field);
+	ERR_FAIL_COND_V(flow_field == nullptr, NavFlowField::UNREACHABLE);
+
+	return flow_field->get_distance(p_position);
+}
+
 COMMAND_1(free, RID, p_object) {
 	if (map_owner.owns(p_object)) {
 		NavMap *map = map_owner.get_or_null(p_object);
@@ -556,6 +689,13 @@ COMMAND_1(free, RID, p_object) {
 			agents[i]->set_map(nullptr);
 		}
 
+		// Remove any assigned flow field
+		for (uint32_t i = 0; i < flow_fields.size(); i++) {
+			if (flow_fields[i]->get_map() == map) {
+				flow_fields[i]->set_map(nullptr);
+			}
+		}
+
 		int map_index = active_maps.find(map);
 		active_maps.remove_at(map_index);
 		active_maps_update_id.remove_at(map_index);
@@ -583,6 +723,11 @@ COMMAND_1(free, RID, p_object) {
 
 		agent_owner.free(p_object);
 
+	} else if (flow_field_owner.owns(p_object)) {
+		NavFlowField *flow_field = flow_field_owner.get_or_null(p_object);
+		flow_fields.erase(flow_field);
+		flow_field_owner.free(p_object);
+
 	} else {
 		ERR_FAIL_COND("Invalid ID.");
 	}
@@ -594,7 +739,94 @@ void GodotNavigationServer::set_active(bool p_active) const {
 	mut_this->active = p_active;
 }
 
+void GodotNavigationServer::_run_path_queries_chunk(uint32_t p_chunk, PathQuery *p_queries) {
+	gd::PathQueryScratch &scratch = *path_query_scratches[p_chunk];
+	const uint32_t from = uint64_t(running_path_queries.size()) * p_chunk / path_queries_chunk_count;
+	const uint32_t to = uint64_t(running_path_queries.size()) * (p_chunk + 1) / path_queries_chunk_count;
+
+	for (uint32_t i = from; i < to; i++) {
+		PathQuery &query = p_queries[i];
+		if (query.nav_map) {
+			query.path = query.nav_map->get_path(query.origin, query.destination, query.optimize, query.navigation_layers, scratch);
+		}
+	}
+}
+
+void GodotNavigationServer::_dispatch_path_queries() {
+	MutexLock lock(path_queries_mutex);
+	if (pending_path_queries.is_empty() || path_queries_group_task != -1 || !running_path_queries.is_empty()) {
+		return;
+	}
+
+	SWAP(pending_path_queries, running_path_queries);
+	for (uint32_t i = 0; i < running_path_queries.size(); i++) {
+		running_path_queries[i].nav_map = map_owner.get_or_null(running_path_queries[i].map);
+	}
+
+	const uint32_t thread_count = MAX(WorkerThreadPool::get_singleton()->get_thread_count(), 1);
+	while (path_query_scratches.size() < thread_count) {
+		path_query_scratches.push_back(memnew(gd::PathQueryScratch));
+	}
+
+	path_queries_chunk_count = MIN(running_path_queries.size(), thread_count);
+	path_queries_group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotNavigationServer::_run_path_queries_chunk, running_path_queries.ptr(), path_queries_chunk_count, -1, true, SNAME("NavigationPathQueries"));
+}
+
+void GodotNavigationServer::_wait_path_queries() {
+	MutexLock lock(path_queries_mutex);
+	if (path_queries_group_task != -1) {
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(path_queries_group_task);
+		path_queries_group_task = -1;
+	}
+}
+
+void GodotNavigationServer::_deliver_path_queries() {
+	LocalVector<PathQuery> done_queries;
+	{
+		MutexLock lock(path_queries_mutex);
+		if (path_queries_group_task != -1) {
+			return;
+		}
+		SWAP(done_queries, running_path_queries);
+	}
+
+	// The callbacks are called without any lock, so they can queue new queries.
+	for (uint32_t i = 0; i < done_queries.size(); i++) {
+		const Variant path = done_queries[i].path;
+		const Variant *args[1] = { &path };
+		Variant ret;
+		Callable::CallError ce;
+		done_queries[i].callback.callp(args, 1, ret, ce);
+		if (ce.error != Callable::CallError::CALL_OK) {
+			ERR_PRINT("Error calling the path query callback: " + Variant::get_callable_error_text(done_queries[i].callback, args, 1, ce));
+		}
+	}
+}
+
+void GodotNavigationServer::_update_flow_field(uint32_t p_index, NavFlowField **p_flow_fields) {
+	p_flow_fields[p_index]->update();
+}
+
+void GodotNavigationServer::_update_flow_fields() {
+	updating_flow_fields.clear();
+	for (uint32_t i = 0; i < flow_fields.size(); i++) {
+		if (flow_fields[i]->needs_update()) {
+			updating_flow_fields.push_back(flow_fields[i]);
+		}
+	}
+
+	if (updating_flow_fields.size() > 1) {
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotNavigationServer::_update_flow_field, updating_flow_fields.ptr(), updating_flow_fields.size(), -1, true, SNAME("NavigationFlowFields"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	} else if (updating_flow_fields.size() == 1) {
+		updating_flow_fields[0]->update();
+	}
+}
+
 void GodotNavigationServer::flush_queries() {
+	// The running path queries read the maps, so let them finish before changing anything.
+	_wait_path_queries();
+
 	// In c++ we can't be sure that this is performed in the main thread
 	// even with mutable functions.
 	MutexLock lock(commands_mutex);
@@ -613,12 +845,15 @@ void GodotNavigationServer::map_force_update(RID p_map) {
 	flush_queries();
 
 	map->sync();
+	_update_flow_fields();
 }
 
 void GodotNavigationServer::process(real_t p_delta_time) {
 	flush_queries();
+	_deliver_path_queries();
 
 	if (!active) {
+		_dispatch_path_queries();
 		return;
 	}
 
@@ -637,6 +872,10 @@ void GodotNavigationServer::process(real_t p_delta_time) {
 			active_maps_update_id[i] = new_map_update_id;
 		}
 	}
+
+	_update_flow_fields();
+
+	_dispatch_path_queries();
 }
 
 #undef COMMAND_1
@@ -31,11 +31,13 @@
 #ifndef GODOT_NAVIGATION_SERVER_H
 #define GODOT_NAVIGATION_SERVER_H
 
+#include "core/object/worker_thread_pool.h"
 #include "core/templates/local_vector.h"
 #include "core/templates/rid.h"
 #include "core/templates/rid_owner.h"
 #include "servers/navigation_server_3d.h"
 
+#include "nav_flow_field.h"
 #include "nav_map.h"
 #include "nav_region.h"
 #include "rvo_agent.h"
@@ -74,11 +76,45 @@ class GodotNavigationServer : public NavigationServer3D {
 	mutable RID_Owner<NavMap> map_owner;
 	mutable RID_Owner<NavRegion> region_owner;
 	mutable RID_Owner<RvoAgent> agent_owner;
+	mutable RID_Owner<NavFlowField> flow_field_owner;
 
 	bool active = true;
 	LocalVector<NavMap *> active_maps;
 	LocalVector<uint32_t> active_maps_update_id;
 
+	/// Updated on the worker threads after the sync.
+	LocalVector<NavFlowField *> flow_fields;
+	LocalVector<NavFlowField *> updating_flow_fields;
+
+	/// Run on the worker threads after the sync, called back on the next process.
+	struct PathQuery {
+		RID map;
+		Vector3 origin;
+		Vector3 destination;
+		bool optimize = false;
+		uint32_t navigation_layers = 1;
+		Callable callback;
+
+		const NavMap *nav_map = nullptr;
+		Vector<Vector3> path;
+	};
+
+	Mutex path_queries_mutex;
+	LocalVector<PathQuery> pending_path_queries;
+	LocalVector<PathQuery> running_path_queries;
+	WorkerThreadPool::GroupID path_queries_group_task = -1;
+	uint32_t path_queries_chunk_count = 0;
+	/// One per chunk.
+	LocalVector<gd::PathQueryScratch *> path_query_scratches;
+
+	void _run_path_queries_chunk(uint32_t p_chunk, PathQuery *p_queries);
+	void _dispatch_path_queries();
+	void _wait_path_queries();
+	void _deliver_path_queries();
+
+	void _update_flow_field(uint32_t p_index, NavFlowField **p_flow_fields);
+	void _update_flow_fields();
+
 public:
 	GodotNavigationServer();
 	virtual ~GodotNavigationServer();
@@ -100,7 +136,14 @@ public:
 	COMMAND_2(map_set_edge_connection_margin, RID, p_map, real_t, p_connection_margin);
 	virtual real_t map_get_edge_connection_margin(RID p_map) const override;
 
+	COMMAND_2(map_set_use_hierarchical_paths, RID, p_map, bool, p_enabled);
+	virtual bool map_get_use_hierarchical_paths(RID p_map) const override;
+
+	COMMAND_2(map_set_hierarchical_cluster_size, RID, p_map, real_t, p_cluster_size);
+	virtual real_t map_get_hierarchical_cluster_size(RID p_map) const override;
+
 	virtual Vector<Vector3> map_get_path(RID p_map, Vector3 p_origin, Vector3 p_destination, bool p_optimize, uint32_t p_navigation_layers = 1) const override;
+	virtual void map_query_path(RID p_map, Vector3 p_origin, Vector3 p_destination, bool p_optimize, const Callable &p_callback, uint32_t p_navigation_layers = 1) const override;
 
 	virtual Vector3 map_get_closest_point_to_segment(RID p_map, const Vector3 &p_from, const Vector3 &p_to, const bool p_use_collision = false) const override;
 	virtual Vector3 map_get_closest_point(RID p_map, const Vector3 &p_point) const override;
@@ -147,6 +190,17 @@ public:
 	virtual bool agent_is_map_changed(RID p_agent) const override;
 	COMMAND_4_DEF(agent_set_callback, RID, p_agent, Object *, p_receiver, StringName, p_method, Variant, p_udata, Variant());
 
+	virtual RID flow_field_create() const override;
+	COMMAND_2(flow_field_set_map, RID, p_flow_field, RID, p_map);
+	virtual RID flow_field_get_map(RID p_flow_field) const override;
+	COMMAND_2(flow_field_set_goals, RID, p_flow_field, Vector<Vector3>, p_goals);
+	virtual Vector<Vector3> flow_field_get_goals(RID p_flow_field) const override;
+	COMMAND_2(flow_field_set_navigation_layers, RID, p_flow_field, uint32_t, p_navigation_layers);
+	virtual uint32_t flow_field_get_navigation_layers(RID p_flow_field) const override;
+	virtual Vector3 flow_field_get_direction(RID p_flow_field, Vector3 p_position) const override;
+	virtual Vector<Vector3> flow_field_get_directions(RID p_flow_field, const Vector<Vector3> &p_positions) const override;
+	virtual real_t flow_field_get_distance(RID p_flow_field, Vector3 p_position) const override;
+
 	COMMAND_1(free, RID, p_object);
 
 	virtual void set_active(bool p_active) const override;
@@ -0,0 +1,224 @@
+/*************************************************************************/
+/*  nav_agent_grid.cpp                                                   */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2022 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2022 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "nav_agent_grid.h"
+
+#include "core/object/worker_thread_pool.h"
+#include "rvo_agent.h"
+
+void NavAgentGrid::_compute_agent_cell(uint32_t p_index, RVO::Agent **p_agents) {
+	const RVO::Vector3 &position = p_agents[p_index]->position_;
+	agent_cells_x[p_index] = _get_cell(position.x());
+	agent_cells_z[p_index] = _get_cell(position.z());
+	agent_buckets[p_index] = _get_bucket(agent_cells_x[p_index], agent_cells_z[p_index]);
+}
+
+void NavAgentGrid::_fill_sorted_agent(uint32_t p_index, RVO::Agent **p_agents) {
+	const uint32_t slot = agent_slots[p_index];
+	RVO::Agent *agent = p_agents[p_index];
+	sorted_agents[slot] = agent;
+	cells_x[slot] = agent_cells_x[p_index];
+	cells_z[slot] = agent_cells_z[p_index];
+	positions_x[slot] = agent->position_.x();
+	positions_y[slot] = agent->position_.y();
+	positions_z[slot] = agent->position_.z();
+}
+
+void NavAgentGrid::build(const LocalVector<RvoAgent *> &p_agents) {
+	const uint32_t agent_count = p_agents.size();
+
+	agents.resize(agent_count);
+	float max_neighbor_dist = 0.0;
+	float min_x = 0.0;
+	float min_z = 0.0;
+	float max_x = 0.0;
+	float max_z = 0.0;
+	for (uint32_t i = 0; i < agent_count; i++) {
+		agents[i] = p_agents[i]->get_agent();
+		max_neighbor_dist = MAX(max_neighbor_dist, agents[i]->neighborDist_);
+
+		const RVO::Vector3 &position = agents[i]->position_;
+		min_x = i == 0 ? position.x() : MIN(min_x, position.x());
+		min_z = i == 0 ? position.z() : MIN(min_z, position.z());
+		max_x = i == 0 ? position.x() : MAX(max_x, position.x());
+		max_z = i == 0 ? position.z() : MAX(max_z, position.z());
+	}
+
+	// Smaller cells than the neighbor distance let the queries skip most of the cells once they found their closest neighbors.
+	cell_size = max_neighbor_dist > 0.0 ? max_neighbor_dist / CELLS_PER_NEIGHBOR_DIST : 1.0;
+
+	// Cover the bounds of the agents without wrapping when there are enough agents for it, with at most two to four buckets per agent.
+	const uint32_t max_bits = nearest_shift(MAX(agent_count, 1u)) + 1;
+	const uint32_t needed_bits_x = nearest_shift((uint32_t)MIN((int64_t)_get_cell(max_x) - (int64_t)_get_cell(min_x), (int64_t)INT32_MAX));
+	const uint32_t needed_bits_z = nearest_shift((uint32_t)MIN((int64_t)_get_cell(max_z) - (int64_t)_get_cell(min_z), (int64_t)INT32_MAX));
+	bucket_bits_x = MIN(needed_bits_x, max_bits / 2);
+	bucket_bits_z = MIN(needed_bits_z, max_bits - bucket_bits_x);
+	bucket_bits_x = MIN(needed_bits_x, max_bits - bucket_bits_z);
+	bucket_count = 1u << (bucket_bits_x + bucket_bits_z);
+
+	agent_cells_x.resize(agent_count);
+	agent_cells_z.resize(agent_count);
+	agent_buckets.resize(agent_count);
+	agent_slots.resize(agent_count);
+	sorted_agents.resize(agent_count);
+	cells_x.resize(agent_count);
+	cells_z.resize(agent_count);
+	positions_x.resize(agent_count);
+	positions_y.resize(agent_count);
+	positions_z.resize(agent_count);
+
+	const bool parallel = agent_count >= PARALLEL_BUILD_MIN_AGENTS;
+
+	if (parallel) {
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &NavAgentGrid::_compute_agent_cell, agents.ptr(), agent_count, -1, true, SNAME("NavigationAgentGridCells"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	} else {
+		for (uint32_t i = 0; i < agent_count; i++) {
+			_compute_agent_cell(i, agents.ptr());
+		}
+	}
+
+	// Counting sort of the agents by bucket.
+	bucket_starts.resize(bucket_count + 1);
+	memset(bucket_starts.ptr(), 0, bucket_starts.size() * sizeof(uint32_t));
+	for (uint32_t i = 0; i < agent_count; i++) {
+		bucket_starts[agent_buckets[i] + 1]++;
+	}
+	for (uint32_t i = 1; i < bucket_starts.size(); i++) {
+		bucket_starts[i] += bucket_starts[i - 1];
+	}
+	// Use the end of each bucket as its cursor, which leaves the start of each bucket in the entry of the next one.
+	for (uint32_t i = agent_count; i > 0; i--) {
+		agent_slots[i - 1] = --bucket_starts[agent_buckets[i - 1] + 1];
+	}
+	for (uint32_t i = 0; i < bucket_count; i++) {
+		bucket_starts[i] = bucket_starts[i + 1];
+	}
+	bucket_starts[bucket_count] = agent_count;
+
+	if (parallel) {
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &NavAgentGrid::_fill_sorted_agent, agents.ptr(), agent_count, -1, true, SNAME("NavigationAgentGridSort"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	} else {
+		for (uint32_t i = 0; i < agent_count; i++) {
+			_fill_sorted_agent(i, agents.ptr());
+		}
+	}
+}
+
+void NavAgentGrid::_insert_neighbors(RVO::Agent *p_agent, uint32_t p_from, uint32_t p_to, int32_t p_cell_x, int32_t p_cell_z, bool p_check_cell, float &r_range_sq) const {
+	const float x = p_agent->position_.x();
+	const float y = p_agent->position_.y();
+	const float z = p_agent->position_.z();
+
+	for (uint32_t i = p_from; i < p_to; i++) {
+		// Different cells can share a bucket.
+		if (p_check_cell && (cells_x[i] != p_cell_x || cells_z[i] != p_cell_z)) {
+			continue;
+		}
+
+		const float dx = positions_x[i] - x;
+		const float dy = positions_y[i] - y;
+		const float dz = positions_z[i] - z;
+		const float dist_sq = dx * dx + dy * dy + dz * dz;
+		if (dist_sq >= r_range_sq || sorted_agents[i] == p_agent) {
+			continue;
+		}
+
+		// Same insertion as `RVO::Agent::insertAgentNeighbor()`, without reading the other agent again.
+		std::vector<std::pair<float, const RVO::Agent *>> &neighbors = p_agent->agentNeighbors_;
+		if (neighbors.size() < p_agent->maxNeighbors_) {
+			neighbors.push_back(std::make_pair(dist_sq, sorted_agents[i]));
+		}
+		size_t j = neighbors.size() - 1;
+		while (j != 0 && dist_sq < neighbors[j - 1].first) {
+			neighbors[j] = neighbors[j - 1];
+			j--;
+		}
+		neighbors[j] = std::make_pair(dist_sq, sorted_agents[i]);
+
+		// Shrink the range once the agent has all its neighbors.
+		if (neighbors.size() == p_agent->maxNeighbors_) {
+			r_range_sq = neighbors.back().first;
+		}
+	}
+}
+
+void NavAgentGrid::_insert_cell_neighbors(RVO::Agent *p_agent, int32_t p_cell_x, int32_t p_cell_z, float &r_range_sq) const {
+	// Skip the cells that are out of range, the range shrinks as the closest neighbors are found.
+	const float cell_min_x = p_cell_x * cell_size;
+	const float cell_min_z = p_cell_z * cell_size;
+	const float dx = MAX(0.0f, MAX(cell_min_x - p_agent->position_.x(), p_agent->position_.x() - (cell_min_x + cell_size)));
+	const float dz = MAX(0.0f, MAX(cell_min_z - p_agent->position_.z(), p_agent->position_.z() - (cell_min_z + cell_size)));
+	if (dx * dx + dz * dz >= r_range_sq) {
+		return;
+	}
+
+	const uint32_t bucket = _get_bucket(p_cell_x, p_cell_z);
+	_insert_neighbors(p_agent, bucket_starts[bucket], bucket_starts[bucket + 1], p_cell_x, p_cell_z, true, r_range_sq);
+}
+
+void NavAgentGrid::compute_neighbors(RVO::Agent *p_agent) const {
+	p_agent->agentNeighbors_.clear();
+	if (p_agent->maxNeighbors_ == 0 || sorted_agents.is_empty()) {
+		return;
+	}
+
+	const float range = p_agent->neighborDist_;
+	float range_sq = range * range;
+
+	const int32_t max_ring = (int32_t)Math::ceil(range / cell_size);
+	if ((int64_t)(max_ring * 2 + 1) * (int64_t)(max_ring * 2 + 1) > (int64_t)bucket_count) {
+		// The range covers more cells than there are buckets, so scanning all the agents is cheaper.
+		_insert_neighbors(p_agent, 0, sorted_agents.size(), 0, 0, false, range_sq);
+		return;
+	}
+
+	// Visit the cells in rings around the agent, so the closest agents are found first.
+	const int32_t center_x = _get_cell(p_agent->position_.x());
+	const int32_t center_z = _get_cell(p_agent->position_.z());
+	_insert_cell_neighbors(p_agent, center_x, center_z, range_sq);
+	for (int32_t ring = 1; ring <= max_ring; ring++) {
+		// All the cells of this ring are at least this far from the agent.
+		const float ring_distance = (ring - 1) * cell_size;
+		if (ring_distance * ring_distance >= range_sq) {
+			break;
+		}
+
+		for (int32_t cell_x = center_x - ring; cell_x <= center_x + ring; cell_x++) {
+			_insert_cell_neighbors(p_agent, cell_x, center_z - ring, range_sq);
+			_insert_cell_neighbors(p_agent, cell_x, center_z + ring, range_sq);
+		}
+		for (int32_t cell_z = center_z - ring + 1; cell_z < center_z + ring; cell_z++) {
+			_insert_cell_neighbors(p_agent, center_x - ring, cell_z, range_sq);
+			_insert_cell_neighbors(p_agent, center_x + ring, cell_z, range_sq);
+		}
+	}
+}
@@ -0,0 +1,91 @@
+/*************************************************************************/
+/*  nav_agent_grid.h                                                     */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2022 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2022 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef NAV_AGENT_GRID_H
+#define NAV_AGENT_GRID_H
+
+#include "core/math/math_funcs.h"
+#include "core/templates/local_vector.h"
+
+#include <Agent.h>
+
+class RvoAgent;
+
+// Spatial hash of the agents on the XZ plane, rebuilt at every step to find the RVO neighbors.
+// The agents are sorted by bucket, with their positions in separate arrays for the scans.
+class NavAgentGrid {
+	// Under this count, building on a single thread is cheaper than a group task.
+	static const uint32_t PARALLEL_BUILD_MIN_AGENTS = 1024;
+	static constexpr float CELLS_PER_NEIGHBOR_DIST = 2.0;
+
+	float cell_size = 1.0;
+	// The buckets form a wrapping grid, so neighboring cells stay close in memory.
+	uint32_t bucket_bits_x = 0;
+	uint32_t bucket_bits_z = 0;
+	uint32_t bucket_count = 1;
+
+	// Per agent, in the map order.
+	LocalVector<RVO::Agent *> agents;
+	LocalVector<int32_t> agent_cells_x;
+	LocalVector<int32_t> agent_cells_z;
+	LocalVector<uint32_t> agent_buckets;
+	LocalVector<uint32_t> agent_slots;
+
+	// First sorted agent of each bucket, plus the end of the last one.
+	LocalVector<uint32_t> bucket_starts;
+
+	// Agents sorted by bucket.
+	LocalVector<RVO::Agent *> sorted_agents;
+	LocalVector<int32_t> cells_x;
+	LocalVector<int32_t> cells_z;
+	LocalVector<float> positions_x;
+	LocalVector<float> positions_y;
+	LocalVector<float> positions_z;
+
+	_FORCE_INLINE_ int32_t _get_cell(float p_coordinate) const {
+		return (int32_t)Math::floor(p_coordinate / cell_size);
+	}
+	_FORCE_INLINE_ uint32_t _get_bucket(int32_t p_cell_x, int32_t p_cell_z) const {
+		return (((uint32_t)p_cell_z & ((1u << bucket_bits_z) - 1)) << bucket_bits_x) | ((uint32_t)p_cell_x & ((1u << bucket_bits_x) - 1));
+	}
+
+	void _compute_agent_cell(uint32_t p_index, RVO::Agent **p_agents);
+	void _fill_sorted_agent(uint32_t p_index, RVO::Agent **p_agents);
+	void _insert_neighbors(RVO::Agent *p_agent, uint32_t p_from, uint32_t p_to, int32_t p_cell_x, int32_t p_cell_z, bool p_check_cell, float &r_range_sq) const;
+	void _insert_cell_neighbors(RVO::Agent *p_agent, int32_t p_cell_x, int32_t p_cell_z, float &r_range_sq) const;
+
+public:
+	void build(const LocalVector<RvoAgent *> &p_agents);
+
+	// Same as RVO::Agent::computeNeighbors(). Safe to call from several threads, for different agents.
+	void compute_neighbors(RVO::Agent *p_agent) const;
+};
+
+#endif // NAV_AGENT_GRID_H
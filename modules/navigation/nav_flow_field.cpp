@@ -0,0 +1,528 @@
+/*************************************************************************/
+/*  nav_flow_field.cpp                                                   */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2022 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2022 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "nav_flow_field.h"
+
+#include "core/math/geometry_3d.h"
+#include "core/object/worker_thread_pool.h"
+#include "nav_map.h"
+#include "nav_region.h"
+
+NavFlowField::NavFlowField() :
+		to_visit(DistanceLessThan(&distances), HeapIndexer(&heap_indices)) {
+}
+
+void NavFlowField::set_map(NavMap *p_map) {
+	map = p_map;
+	dirty = true;
+}
+
+void NavFlowField::set_goals(const Vector<Vector3> &p_goals) {
+	goals = p_goals;
+	dirty = true;
+}
+
+void NavFlowField::set_navigation_layers(uint32_t p_navigation_layers) {
+	navigation_layers = p_navigation_layers;
+	dirty = true;
+}
+
+bool NavFlowField::_is_traversable(const gd::Polygon &p_polygon) const {
+	return p_polygon.owner != nullptr && (p_polygon.owner->get_navigation_layers() & navigation_layers) != 0;
+}
+
+void NavFlowField::_relax(const gd::Polygon &p_from, const gd::Edge::Connection &p_connection) {
+	// The search runs from the goals, so the connection is crossed backwards: from the polygon it leads to.
+	const gd::Polygon &polygon = *p_connection.polygon;
+	if (!_is_traversable(polygon)) {
+		return;
+	}
+
+	const Vector3 portal = (p_connection.pathway_start + p_connection.pathway_end) * 0.5;
+	float distance = distances[p_from.id] + polygon.center.distance_to(portal) * polygon.owner->get_travel_cost() + portal.distance_to(p_from.center) * p_from.owner->get_travel_cost();
+	if (polygon.owner != p_from.owner) {
+		distance += p_from.owner->get_enter_cost();
+	}
+	if (distance >= distances[polygon.id]) {
+		return;
+	}
+
+	distances[polygon.id] = distance;
+	next_polygons[polygon.id] = p_from.id;
+	portal_starts[polygon.id] = p_connection.pathway_start;
+	portal_ends[polygon.id] = p_connection.pathway_end;
+	if (heap_indices[polygon.id] == UINT32_MAX) {
+		to_visit.push(polygon.id);
+	} else {
+		to_visit.shift(heap_indices[polygon.id]);
+	}
+}
+
+uint32_t NavFlowField::_get_regions_hash() const {
+	uint32_t hash = hash_murmur3_one_32(navigation_layers);
+	const LocalVector<NavRegion *> &regions = map->get_regions();
+	for (uint32_t i = 0; i < regions.size(); i++) {
+		hash = hash_murmur3_one_64(uint64_t(regions[i]), hash);
+		hash = hash_murmur3_one_32(regions[i]->get_navigation_layers(), hash);
+		hash = hash_murmur3_one_float(regions[i]->get_travel_cost(), hash);
+		hash = hash_murmur3_one_float(regions[i]->get_enter_cost(), hash);
+	}
+	return hash_fmix32(hash);
+}
+
+void NavFlowField::_find_goal_polygons(LocalVector<uint32_t> &r_polygons, LocalVector<Vector3> &r_points) const {
+	r_polygons.clear();
+	r_points.clear();
+
+	LocalVector<float> costs;
+	for (int i = 0; i < goals.size(); i++) {
+		Vector3 point;
+		const gd::Polygon *polygon = map->get_closest_polygon(goals[i], navigation_layers, point);
+		if (!polygon) {
+			continue;
+		}
+
+		// Several goals in the same polygon keep the one closest to its center.
+		const float cost = polygon->center.distance_to(point) * polygon->owner->get_travel_cost();
+		uint32_t index = 0;
+		while (index < r_polygons.size() && r_polygons[index] < polygon->id) {
+			index++;
+		}
+		if (index < r_polygons.size() && r_polygons[index] == polygon->id) {
+			if (cost < costs[index]) {
+				costs[index] = cost;
+				r_points[index] = point;
+			}
+			continue;
+		}
+		r_polygons.insert(index, polygon->id);
+		r_points.insert(index, point);
+		costs.insert(index, cost);
+	}
+}
+
+void NavFlowField::_invalidate_changed_polygons(bool p_full, const HashSet<const NavRegion *> &p_changed_regions) {
+	const uint32_t polygon_count = distances.size();
+	if (p_full) {
+		for (uint32_t i = 0; i < polygon_count; i++) {
+			invalid_polygons[i] = 1;
+		}
+		return;
+	}
+
+	// The polygons stamped by the map sync, and the ones of the regions whose costs or layers changed.
+	const LocalVector<gd::Polygon> &polygons = map->get_polygons();
+	const LocalVector<uint64_t> &polygon_versions = map->get_polygon_versions();
+	LocalVector<uint32_t> stack;
+	for (uint32_t i = 0; i < polygon_count; i++) {
+		invalid_polygons[i] = polygon_versions[i] > polygons_version || (!p_changed_regions.is_empty() && p_changed_regions.has(polygons[i].owner));
+		if (invalid_polygons[i]) {
+			stack.push_back(i);
+		}
+	}
+	if (stack.is_empty()) {
+		return;
+	}
+
+	// The routes crossing a changed polygon are searched again too: they form the subtrees of the
+	// changed polygons in the tree of the next polygons, which is stored contiguously by parent.
+	child_offsets.resize(polygon_count + 1);
+	for (uint32_t i = 0; i <= polygon_count; i++) {
+		child_offsets[i] = 0;
+	}
+	for (uint32_t i = 0; i < polygon_count; i++) {
+		if (next_polygons[i] != NO_POLYGON) {
+			child_offsets[next_polygons[i] + 1]++;
+		}
+	}
+	for (uint32_t i = 0; i < polygon_count; i++) {
+		child_offsets[i + 1] += child_offsets[i];
+	}
+	children.resize(child_offsets[polygon_count]);
+	for (uint32_t i = 0; i < polygon_count; i++) {
+		if (next_polygons[i] != NO_POLYGON) {
+			children[child_offsets[next_polygons[i]]++] = i;
+		}
+	}
+	// Filling moved each offset to the start of the next parent.
+	for (uint32_t i = polygon_count; i > 0; i--) {
+		child_offsets[i] = child_offsets[i - 1];
+	}
+	child_offsets[0] = 0;
+
+	while (!stack.is_empty()) {
+		const uint32_t polygon = stack[stack.size() - 1];
+		stack.remove_at(stack.size() - 1);
+		for (uint32_t i = child_offsets[polygon]; i < child_offsets[polygon + 1]; i++) {
+			if (!invalid_polygons[children[i]]) {
+				invalid_polygons[children[i]] = 1;
+				stack.push_back(children[i]);
+			}
+		}
+	}
+}
+
+void NavFlowField::update() {
+	const LocalVector<gd::Polygon> &polygons = map->get_polygons();
+	const uint32_t polygon_count = polygons.size();
+
+	// Only the polygons of the regions with new costs are searched again, the removed regions are stamped by the map.
+	HashSet<const NavRegion *> changed_regions;
+	HashMap<const NavRegion *, RegionCosts> new_region_costs;
+	const LocalVector<NavRegion *> &regions = map->get_regions();
+	for (uint32_t i = 0; i < regions.size(); i++) {
+		RegionCosts costs;
+		costs.navigation_layers = regions[i]->get_navigation_layers();
+		costs.travel_cost = regions[i]->get_travel_cost();
+		costs.enter_cost = regions[i]->get_enter_cost();
+		const RegionCosts *old_costs = region_costs.getptr(regions[i]);
+		if (old_costs && *old_costs != costs) {
+			changed_regions.insert(regions[i]);
+		}
+		new_region_costs.insert(regions[i], costs);
+	}
+
+	LocalVector<uint32_t> new_goal_polygons;
+	LocalVector<Vector3> new_goal_points;
+	_find_goal_polygons(new_goal_polygons, new_goal_points);
+
+	// Any change of the goals may change all the routes.
+	bool full = dirty || polygons_version < map->get_polygons_reset_version() || polygon_count < distances.size();
+	if (!full && new_goal_polygons.size() == goal_polygons.size()) {
+		for (uint32_t i = 0; i < goal_polygons.size(); i++) {
+			if (new_goal_polygons[i] != goal_polygons[i] || new_goal_points[i] != goal_points[i]) {
+				full = true;
+				break;
+			}
+		}
+	} else {
+		full = true;
+	}
+
+	const bool polygons_changed = full || polygons_version != map->get_polygons_version() || !changed_regions.is_empty();
+
+	// The new polygons are all stamped by the map, so they are searched.
+	const uint32_t old_count = distances.size();
+	distances.resize(polygon_count);
+	next_polygons.resize(polygon_count);
+	portal_starts.resize(polygon_count);
+	portal_ends.resize(polygon_count);
+	heap_indices.resize(polygon_count);
+	invalid_polygons.resize(polygon_count);
+	for (uint32_t i = old_count; i < polygon_count; i++) {
+		distances[i] = UNREACHABLE;
+		next_polygons[i] = NO_POLYGON;
+		heap_indices[i] = UINT32_MAX;
+	}
+
+	_invalidate_changed_polygons(full, changed_regions);
+
+	goal_polygons = new_goal_polygons;
+	goal_points = new_goal_points;
+	region_costs = new_region_costs;
+	regions_hash = _get_regions_hash();
+	polygons_version = map->get_polygons_version();
+	dirty = false;
+
+	if (polygons_changed) {
+		_build_grid();
+	}
+
+	to_visit.clear();
+	for (uint32_t i = 0; i < polygon_count; i++) {
+		if (invalid_polygons[i]) {
+			distances[i] = UNREACHABLE;
+			next_polygons[i] = NO_POLYGON;
+		}
+	}
+
+	// Start from the goals, and from the polygons kept next to the ones searched again.
+	for (uint32_t i = 0; i < goal_polygons.size(); i++) {
+		const gd::Polygon &polygon = polygons[goal_polygons[i]];
+		if (invalid_polygons[polygon.id]) {
+			distances[polygon.id] = polygon.center.distance_to(goal_points[i]) * polygon.owner->get_travel_cost();
+			to_visit.push(polygon.id);
+		}
+	}
+	if (!full) {
+		for (uint32_t i = 0; i < polygon_count; i++) {
+			if (invalid_polygons[i] || distances[i] == UNREACHABLE) {
+				continue;
+			}
+			const gd::Polygon &polygon = polygons[i];
+			for (uint32_t e = 0; e < polygon.edges.size(); e++) {
+				const gd::Edge &edge = polygon.edges[e];
+				for (int c = 0; c < edge.connections.size(); c++) {
+					if (invalid_polygons[edge.connections[c].polygon->id]) {
+						_relax(polygon, edge.connections[c]);
+					}
+				}
+			}
+		}
+	}
+
+	// Dijkstra search, the kept polygons get a lower distance when a change opened a shorter route.
+	while (!to_visit.is_empty()) {
+		const gd::Polygon &polygon = polygons[to_visit.pop()];
+		for (uint32_t e = 0; e < polygon.edges.size(); e++) {
+			const gd::Edge &edge = polygon.edges[e];
+			for (int c = 0; c < edge.connections.size(); c++) {
+				_relax(polygon, edge.connections[c]);
+			}
+		}
+	}
+}
+
+bool NavFlowField::needs_update() const {
+	if (!map) {
+		return false;
+	}
+	return dirty || polygons_version != map->get_polygons_version() || regions_hash != _get_regions_hash();
+}
+
+void NavFlowField::_build_grid() {
+	const LocalVector<gd::Polygon> &polygons = map->get_polygons();
+
+	// Copy the outlines first, the next passes only read them.
+	Rect2 bounds;
+	uint32_t grid_polygon_count = 0;
+	outline_offsets.resize(polygons.size() + 1);
+	outline_points.clear();
+	for (uint32_t i = 0; i < polygons.size(); i++) {
+		outline_offsets[i] = outline_points.size();
+		if (!_is_traversable(polygons[i])) {
+			continue;
+		}
+		for (uint32_t p = 0; p < polygons[i].points.size(); p++) {
+			const Vector2 point(polygons[i].points[p].pos.x, polygons[i].points[p].pos.z);
+			if (outline_points.is_empty()) {
+				bounds.position = point;
+			} else {
+				bounds.expand_to(point);
+			}
+			outline_points.push_back(point);
+		}
+		grid_polygon_count++;
+	}
+	outline_offsets[polygons.size()] = outline_points.size();
+
+	grid_cell_offsets.clear();
+	grid_polygons.clear();
+	grid_width = 0;
+	grid_height = 0;
+	if (grid_polygon_count == 0) {
+		return;
+	}
+
+	// About one cell per polygon, so a cell lists a few polygons.
+	grid_origin = bounds.position;
+	grid_cell_size = MAX(Math::sqrt(bounds.get_area() / grid_polygon_count), (real_t)0.01);
+	while (true) {
+		grid_width = int(bounds.size.x / grid_cell_size) + 1;
+		grid_height = int(bounds.size.y / grid_cell_size) + 1;
+		if (uint64_t(grid_width) * grid_height <= uint64_t(grid_polygon_count) * 4) {
+			break;
+		}
+		grid_cell_size *= 2.0;
+	}
+
+	// Counting sort of the polygons by the cells their bounds overlap.
+	const uint32_t cell_count = grid_width * grid_height;
+	grid_cell_offsets.resize(cell_count + 1);
+	for (uint32_t i = 0; i <= cell_count; i++) {
+		grid_cell_offsets[i] = 0;
+	}
+	const Point2i last_cell(grid_width - 1, grid_height - 1);
+	LocalVector<Rect2i> polygon_cells;
+	polygon_cells.resize(polygons.size());
+	for (uint32_t i = 0; i < polygons.size(); i++) {
+		if (outline_offsets[i] == outline_offsets[i + 1]) {
+			continue;
+		}
+		Vector2 from = outline_points[outline_offsets[i]];
+		Vector2 to = from;
+		for (uint32_t p = outline_offsets[i] + 1; p < outline_offsets[i + 1]; p++) {
+			from = from.min(outline_points[p]);
+			to = to.max(outline_points[p]);
+		}
+		const Point2i cell_from = Point2i(((from - grid_origin) / grid_cell_size).floor()).min(last_cell);
+		const Point2i cell_to = Point2i(((to - grid_origin) / grid_cell_size).floor()).min(last_cell);
+		polygon_cells[i] = Rect2i(cell_from, cell_to - cell_from);
+		const Rect2i &cells = polygon_cells[i];
+		for (int z = cells.position.y; z <= cells.position.y + cells.size.y; z++) {
+			for (int x = cells.position.x; x <= cells.position.x + cells.size.x; x++) {
+				grid_cell_offsets[z * grid_width + x + 1]++;
+			}
+		}
+	}
+	for (uint32_t i = 0; i < cell_count; i++) {
+		grid_cell_offsets[i + 1] += grid_cell_offsets[i];
+	}
+	grid_polygons.resize(grid_cell_offsets[cell_count]);
+	for (uint32_t i = 0; i < polygons.size(); i++) {
+		if (outline_offsets[i] == outline_offsets[i + 1]) {
+			continue;
+		}
+		const Rect2i &cells = polygon_cells[i];
+		for (int z = cells.position.y; z <= cells.position.y + cells.size.y; z++) {
+			for (int x = cells.position.x; x <= cells.position.x + cells.size.x; x++) {
+				grid_polygons[grid_cell_offsets[z * grid_width + x]++] = i;
+			}
+		}
+	}
+	// Filling moved each offset to the start of the next cell.
+	for (uint32_t i = cell_count; i > 0; i--) {
+		grid_cell_offsets[i] = grid_cell_offsets[i - 1];
+	}
+	grid_cell_offsets[0] = 0;
+}
+
+uint32_t NavFlowField::_find_polygon(const Vector3 &p_position) const {
+	if (grid_width == 0) {
+		return NO_POLYGON;
+	}
+	const int x = int(Math::floor((p_position.x - grid_origin.x) / grid_cell_size));
+	const int z = int(Math::floor((p_position.z - grid_origin.y) / grid_cell_size));
+	if (x < 0 || z < 0 || x >= grid_width || z >= grid_height) {
+		return NO_POLYGON;
+	}
+
+	// The polygons are convex, the position is inside when it is on the same side of all the edges.
+	// When several floors overlap, the polygon closest vertically is used.
+	const uint32_t cell = z * grid_width + x;
+	uint32_t closest = NO_POLYGON;
+	real_t closest_height = 1e20;
+	for (uint32_t i = grid_cell_offsets[cell]; i < grid_cell_offsets[cell + 1]; i++) {
+		const uint32_t polygon = grid_polygons[i];
+		const Vector2 *points = &outline_points[outline_offsets[polygon]];
+		const uint32_t point_count = outline_offsets[polygon + 1] - outline_offsets[polygon];
+		bool positive = false;
+		bool negative = false;
+		Vector2 a = points[point_count - 1];
+		for (uint32_t p = 0; p < point_count; p++) {
+			const Vector2 &b = points[p];
+			const real_t side = (b.x - a.x) * (p_position.z - a.y) - (b.y - a.y) * (p_position.x - a.x);
+			positive = positive || side > 0.0;
+			negative = negative || side < 0.0;
+			a = b;
+		}
+		if (positive && negative) {
+			continue;
+		}
+		if (closest == NO_POLYGON) {
+			closest = polygon;
+			continue;
+		}
+		// Only read the polygons when several contain the position, like overlapping floors.
+		const LocalVector<gd::Polygon> &polygons = map->get_polygons();
+		if (closest_height == 1e20) {
+			closest_height = Math::abs(p_position.y - polygons[closest].center.y);
+		}
+		const real_t height = Math::abs(p_position.y - polygons[polygon].center.y);
+		if (height < closest_height) {
+			closest_height = height;
+			closest = polygon;
+		}
+	}
+	return closest;
+}
+
+Vector3 NavFlowField::get_direction(const Vector3 &p_position) const {
+	if (!map || polygons_version != map->get_polygons_version()) {
+		return Vector3();
+	}
+	uint32_t polygon = _find_polygon(p_position);
+	if (polygon == NO_POLYGON || distances[polygon] == UNREACHABLE) {
+		return Vector3();
+	}
+
+	// A position on a portal already reached it, so it aims at the next ones.
+	for (uint32_t i = 0; i < MAX_PORTAL_SKIPS; i++) {
+		Vector3 target;
+		if (next_polygons[polygon] == NO_POLYGON) {
+			// A goal polygon.
+			uint32_t goal = 0;
+			while (goal_polygons[goal] != polygon) {
+				goal++;
+			}
+			target = goal_points[goal];
+		} else {
+			// Aim inside the portal, so the agents don't graze the corners.
+			const Vector3 portal[2] = { portal_starts[polygon].lerp(portal_ends[polygon], 0.1), portal_starts[polygon].lerp(portal_ends[polygon], 0.9) };
+			target = Geometry3D::get_closest_point_to_segment(p_position, portal);
+		}
+
+		const Vector3 direction = target - p_position;
+		const real_t length = direction.length();
+		if (length > PORTAL_REACHED_DISTANCE) {
+			return direction / length;
+		}
+		if (next_polygons[polygon] == NO_POLYGON) {
+			break;
+		}
+		polygon = next_polygons[polygon];
+	}
+	return Vector3();
+}
+
+void NavFlowField::_sample_chunk(uint32_t p_chunk, SampleBatch *p_batch) const {
+	const uint32_t from = uint64_t(p_batch->count) * p_chunk / p_batch->chunk_count;
+	const uint32_t to = uint64_t(p_batch->count) * (p_chunk + 1) / p_batch->chunk_count;
+	for (uint32_t i = from; i < to; i++) {
+		p_batch->directions[i] = get_direction(p_batch->positions[i]);
+	}
+}
+
+void NavFlowField::get_directions(const Vector3 *p_positions, Vector3 *r_directions, uint32_t p_count) const {
+	SampleBatch batch;
+	batch.positions = p_positions;
+	batch.directions = r_directions;
+	batch.count = p_count;
+
+	if (p_count < PARALLEL_SAMPLE_MIN_POSITIONS) {
+		_sample_chunk(0, &batch);
+		return;
+	}
+
+	batch.chunk_count = MIN(p_count / PARALLEL_SAMPLE_MIN_POSITIONS, uint32_t(MAX(WorkerThreadPool::get_singleton()->get_thread_count(), 1)) * 4);
+	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &NavFlowField::_sample_chunk, &batch, batch.chunk_count, -1, true, SNAME("NavigationFlowFieldSamples"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+}
+
+float NavFlowField::get_distance(const Vector3 &p_position) const {
+	if (!map || polygons_version != map->get_polygons_version()) {
+		return UNREACHABLE;
+	}
+	const uint32_t polygon = _find_polygon(p_position);
+	if (polygon == NO_POLYGON) {
+		return UNREACHABLE;
+	}
+	return distances[polygon];
+}
@@ -0,0 +1,180 @@
+/*************************************************************************/
+/*  nav_flow_field.h                                                     */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2022 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2022 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef NAV_FLOW_FIELD_H
+#define NAV_FLOW_FIELD_H
+
+#include "nav_rid.h"
+
+#include "core/math/vector2.h"
+#include "core/templates/hash_set.h"
+#include "core/templates/vector.h"
+#include "nav_utils.h"
+
+class NavMap;
+
+// Travel cost from every polygon of a map to the closest goal, with the portal to cross next.
+// Computed by one Dijkstra search from all the goals, and repaired only where the map changed.
+class NavFlowField : public NavRid {
+public:
+	static constexpr float UNREACHABLE = INFINITY;
+	static const uint32_t NO_POLYGON = UINT32_MAX;
+
+private:
+	// Under this count, sampling on a single thread is cheaper than a group task.
+	static const uint32_t PARALLEL_SAMPLE_MIN_POSITIONS = 1024;
+	// Distance to the portal under which a position counts as through it.
+	static constexpr real_t PORTAL_REACHED_DISTANCE = 0.01;
+	static const uint32_t MAX_PORTAL_SKIPS = 4;
+
+	struct DistanceLessThan {
+		const LocalVector<float> *distances = nullptr;
+
+		DistanceLessThan(const LocalVector<float> *p_distances) :
+				distances(p_distances) {}
+
+		bool operator()(uint32_t p_a, uint32_t p_b) const {
+			const float a = (*distances)[p_a];
+			const float b = (*distances)[p_b];
+			if (a == b) {
+				return p_a < p_b;
+			}
+			return a < b;
+		}
+	};
+
+	struct HeapIndexer {
+		LocalVector<uint32_t> *heap_indices = nullptr;
+
+		HeapIndexer(LocalVector<uint32_t> *p_heap_indices) :
+				heap_indices(p_heap_indices) {}
+
+		void operator()(uint32_t p_id, uint32_t p_heap_index) const {
+			(*heap_indices)[p_id] = p_heap_index;
+		}
+	};
+
+	struct RegionCosts {
+		uint32_t navigation_layers = 0;
+		float travel_cost = 0.0;
+		float enter_cost = 0.0;
+
+		bool operator!=(const RegionCosts &p_other) const {
+			return navigation_layers != p_other.navigation_layers || travel_cost != p_other.travel_cost || enter_cost != p_other.enter_cost;
+		}
+	};
+
+	struct SampleBatch {
+		const Vector3 *positions = nullptr;
+		Vector3 *directions = nullptr;
+		uint32_t count = 0;
+		uint32_t chunk_count = 1;
+	};
+
+	NavMap *map = nullptr;
+	Vector<Vector3> goals;
+	uint32_t navigation_layers = 1;
+
+	// The goals or the layers changed, the field must be fully computed.
+	bool dirty = true;
+	// Version of the map polygons the field was computed from.
+	uint64_t polygons_version = 0;
+	// Region costs and layers the field was computed with.
+	HashMap<const NavRegion *, RegionCosts> region_costs;
+	uint32_t regions_hash = 0;
+
+	// Per polygon: cost to the closest goal, and the next polygon with the portal to it.
+	LocalVector<float> distances;
+	LocalVector<uint32_t> next_polygons;
+	LocalVector<Vector3> portal_starts;
+	LocalVector<Vector3> portal_ends;
+
+	// Sorted polygons containing a goal, and the goal point in each one.
+	LocalVector<uint32_t> goal_polygons;
+	LocalVector<Vector3> goal_points;
+
+	// Search buffers, kept between the updates.
+	LocalVector<uint32_t> heap_indices;
+	LocalVector<uint8_t> invalid_polygons;
+	LocalVector<uint32_t> child_offsets;
+	LocalVector<uint32_t> children;
+	gd::Heap<uint32_t, DistanceLessThan, HeapIndexer> to_visit;
+
+	// Grid on the XZ plane with the polygons overlapping each cell.
+	Vector2 grid_origin;
+	real_t grid_cell_size = 1.0;
+	int grid_width = 0;
+	int grid_height = 0;
+	LocalVector<uint32_t> grid_cell_offsets;
+	LocalVector<uint32_t> grid_polygons;
+	// Polygon outlines on the XZ plane, stored contiguously.
+	LocalVector<uint32_t> outline_offsets;
+	LocalVector<Vector2> outline_points;
+
+	_FORCE_INLINE_ bool _is_traversable(const gd::Polygon &p_polygon) const;
+	_FORCE_INLINE_ void _relax(const gd::Polygon &p_from, const gd::Edge::Connection &p_connection);
+
+	uint32_t _get_regions_hash() const;
+	void _find_goal_polygons(LocalVector<uint32_t> &r_polygons, LocalVector<Vector3> &r_points) const;
+	void _invalidate_changed_polygons(bool p_full, const HashSet<const NavRegion *> &p_changed_regions);
+	void _build_grid();
+	uint32_t _find_polygon(const Vector3 &p_position) const;
+	void _sample_chunk(uint32_t p_chunk, SampleBatch *p_batch) const;
+
+public:
+	void set_map(NavMap *p_map);
+	NavMap *get_map() const {
+		return map;
+	}
+
+	void set_goals(const Vector<Vector3> &p_goals);
+	const Vector<Vector3> &get_goals() const {
+		return goals;
+	}
+
+	void set_navigation_layers(uint32_t p_navigation_layers);
+	uint32_t get_navigation_layers() const {
+		return navigation_layers;
+	}
+
+	// True when the settings, the map or the region costs changed since the last update.
+	bool needs_update() const;
+	void update();
+
+	// Direction toward the closest goal, or a zero vector when none can be reached.
+	Vector3 get_direction(const Vector3 &p_position) const;
+	void get_directions(const Vector3 *p_positions, Vector3 *r_directions, uint32_t p_count) const;
+	// Travel cost to the closest goal, or UNREACHABLE.
+	float get_distance(const Vector3 &p_position) const;
+
+	NavFlowField();
+};
+
+#endif // NAV_FLOW_FIELD_H
@@ -37,6 +37,12 @@
 
 #define THREE_POINTS_CROSS_PRODUCT(m_a, m_b, m_c) (((m_c) - (m_a)).cross((m_b) - (m_a)))
 
+static _FORCE_INLINE_ real_t _get_point_aabb_distance_squared(const Vector3 &p_point, const AABB &p_aabb) {
+	const Vector3 end = p_aabb.position + p_aabb.size;
+	const Vector3 closest(CLAMP(p_point.x, p_aabb.position.x, end.x), CLAMP(p_point.y, p_aabb.position.y, end.y), CLAMP(p_point.z, p_aabb.position.z, end.z));
+	return closest.distance_squared_to(p_point);
+}
+
 void NavMap::set_up(Vector3 p_up) {
 	up = p_up;
 	regenerate_polygons = true;
@@ -52,6 +58,19 @@ void NavMap::set_edge_connection_margin(float p_edge_connection_margin) {
 	regenerate_links = true;
 }
 
+void NavMap::set_use_hierarchical_paths(bool p_enabled) {
+	use_hierarchical_paths = p_enabled;
+	if (!use_hierarchical_paths) {
+		hierarchy.clear();
+	}
+	regenerate_links = true;
+}
+
+void NavMap::set_hierarchical_cluster_size(real_t p_cluster_size) {
+	hierarchy.set_cluster_size(p_cluster_size);
+	regenerate_links = true;
+}
+
 gd::PointKey NavMap::get_point_key(const Vector3 &p_pos) const {
 	const int x = int(Math::floor(p_pos.x / cell_size));
 	const int y = int(Math::floor(p_pos.y / cell_size));
@@ -66,43 +85,31 @@ gd::PointKey NavMap::get_point_key(const Vector3 &p_pos) const {
 }
 
 Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p_optimize, uint32_t p_navigation_layers) const {
-	// Find the start poly and the end poly on this map.
-	const gd::Polygon *begin_poly = nullptr;
-	const gd::Polygon *end_poly = nullptr;
-	Vector3 begin_point;
-	Vector3 end_point;
-	float begin_d = 1e20;
-	float end_d = 1e20;
-	// Find the initial poly and the end poly on this map.
-	for (size_t i(0); i < polygons.size(); i++) {
-		const gd::Polygon &p = polygons[i];
-
-		// Only consider the polygon if it in a region with compatible layers.
-		if ((p_navigation_layers & p.owner->get_navigation_layers()) == 0) {
-			continue;
-		}
+	gd::PathQueryScratch *scratch = nullptr;
+	path_query_scratches_mutex.lock();
+	if (path_query_scratches.is_empty()) {
+		scratch = memnew(gd::PathQueryScratch);
+	} else {
+		scratch = path_query_scratches[path_query_scratches.size() - 1];
+		path_query_scratches.resize(path_query_scratches.size() - 1);
+	}
+	path_query_scratches_mutex.unlock();
 
-		// For each face check the distance between the origin/destination
-		for (size_t point_id = 2; point_id < p.points.size(); point_id++) {
-			const Face3 face(p.points[0].pos, p.points[point_id - 1].pos, p.points[point_id].pos);
+	Vector<Vector3> path = get_path(p_origin, p_destination, p_optimize, p_navigation_layers, *scratch);
 
-			Vector3 point = face.get_closest_point_to(p_origin);
-			float distance_to_point = point.distance_to(p_origin);
-			if (distance_to_point < begin_d) {
-				begin_d = distance_to_point;
-				begin_poly = &p;
-				begin_point = point;
-			}
+	path_query_scratches_mutex.lock();
+	path_query_scratches.push_back(scratch);
+	path_query_scratches_mutex.unlock();
+	return path;
+}
 
-			point = face.get_closest_point_to(p_destination);
-			distance_to_point = point.distance_to(p_destination);
-			if (distance_to_point < end_d) {
-				end_d = distance_to_point;
-				end_poly = &p;
-				end_point = point;
-			}
-		}
-	}
+Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p_optimize, uint32_t p_navigation_layers, gd::PathQueryScratch &r_scratch) const {
+	// Find the start poly and the end poly on this map.
+	// Only consider the polygons in a region with compatible layers.
+	Vector3 begin_point;
+	Vector3 end_point;
+	const gd::Polygon *begin_poly = _get_closest_polygon(p_origin, p_navigation_layers, true, begin_point);
+	const gd::Polygon *end_poly = _get_closest_polygon(p_destination, p_navigation_layers, true, end_point);
 
 	// Check for trivial cases
 	if (!begin_poly || !end_poly) {
@@ -116,24 +123,47 @@ Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p
 		return path;
 	}
 
+	if (use_hierarchical_paths && hierarchy.get_polygon_cluster(begin_poly->id) != hierarchy.get_polygon_cluster(end_poly->id) && hierarchy.get_cluster_count() > 0) {
+		// Search the cluster graph first, then only expand the polygons of the clusters it crosses.
+		if (hierarchy.find_corridor(polygons, begin_poly, end_poly, p_navigation_layers, r_scratch.corridor_search, r_scratch.corridor)) {
+			Vector<Vector3> path;
+			if (_find_path(begin_poly, begin_point, end_poly, end_point, p_destination, p_optimize, p_navigation_layers, true, r_scratch, path)) {
+				return path;
+			}
+		}
+	}
+
+	Vector<Vector3> path;
+	_find_path(begin_poly, begin_point, end_poly, end_point, p_destination, p_optimize, p_navigation_layers, false, r_scratch, path);
+	return path;
+}
+
+bool NavMap::_find_path(const gd::Polygon *p_begin_poly, const Vector3 &p_begin_point, const gd::Polygon *p_end_poly, Vector3 p_end_point, const Vector3 &p_destination, bool p_optimize, uint32_t p_navigation_layers, bool p_use_corridor, gd::PathQueryScratch &r_scratch, Vector<Vector3> &r_path) const {
+	// Heap of the navigation poly IDs to visit, by least total cost.
+	gd::Heap<uint32_t, gd::NavPolyTotalCostLessThan, gd::NavPolyHeapIndexer> &to_visit = r_scratch.to_visit;
+	to_visit.clear();
+
 	// List of all reachable navigation polys.
-	LocalVector<gd::NavigationPoly> navigation_polys;
+	LocalVector<gd::NavigationPoly> &navigation_polys = r_scratch.navigation_polys;
+	navigation_polys.clear();
 	navigation_polys.reserve(polygons.size() * 0.75);
 
 	// Add the start polygon to the reachable navigation polygons.
-	gd::NavigationPoly begin_navigation_poly = gd::NavigationPoly(begin_poly);
+	gd::NavigationPoly begin_navigation_poly = gd::NavigationPoly(p_begin_poly);
 	begin_navigation_poly.self_id = 0;
-	begin_navigation_poly.entry = begin_point;
-	begin_navigation_poly.back_navigation_edge_pathway_start = begin_point;
-	begin_navigation_poly.back_navigation_edge_pathway_end = begin_point;
+	begin_navigation_poly.entry = p_begin_point;
+	begin_navigation_poly.back_navigation_edge_pathway_start = p_begin_point;
+	begin_navigation_poly.back_navigation_edge_pathway_end = p_begin_point;
 	navigation_polys.push_back(begin_navigation_poly);
 
-	// List of polygon IDs to visit.
-	List<uint32_t> to_visit;
-	to_visit.push_back(0);
+	// Map from polygon IDs to their reachable navigation poly.
+	HashMap<uint32_t, uint32_t> &polygon_navigation_ids = r_scratch.polygon_navigation_ids;
+	polygon_navigation_ids.clear();
+	polygon_navigation_ids.insert(p_begin_poly->id, 0);
 
 	// This is an implementation of the A* algorithm.
 	int least_cost_id = 0;
+	float end_d = 1e20;
 	bool found_route = false;
 
 	const gd::Polygon *reachable_end = nullptr;
@@ -158,6 +188,11 @@ Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p
 					continue;
 				}
 
+				// Stay in the clusters found by the hierarchical search.
+				if (p_use_corridor && !r_scratch.corridor[hierarchy.get_polygon_cluster(connection.polygon->id)]) {
+					continue;
+				}
+
 				float region_enter_cost = 0.0;
 				float region_travel_cost = least_cost_poly->poly->owner->get_travel_cost();
 
@@ -170,11 +205,11 @@ Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p
 				const Vector3 new_entry = Geometry3D::get_closest_point_to_segment(least_cost_poly->entry, pathway);
 				const float new_distance = (least_cost_poly->entry.distance_to(new_entry) * region_travel_cost) + region_enter_cost + least_cost_poly->traveled_distance;
 
-				int64_t already_visited_polygon_index = navigation_polys.find(gd::NavigationPoly(connection.polygon));
+				const uint32_t *already_visited_polygon_index = polygon_navigation_ids.getptr(connection.polygon->id);
 
-				if (already_visited_polygon_index != -1) {
+				if (already_visited_polygon_index) {
 					// Polygon already visited, check if we can reduce the travel cost.
-					gd::NavigationPoly &avp = navigation_polys[already_visited_polygon_index];
+					gd::NavigationPoly &avp = navigation_polys[*already_visited_polygon_index];
 					if (new_distance < avp.traveled_distance) {
 						avp.back_navigation_poly_id = least_cost_id;
 						avp.back_navigation_edge = connection.edge;
@@ -182,6 +217,10 @@ Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p
 						avp.back_navigation_edge_pathway_end = connection.pathway_end;
 						avp.traveled_distance = new_distance;
 						avp.entry = new_entry;
+						avp.total_cost = new_distance + new_entry.distance_to(p_end_point) * avp.poly->owner->get_travel_cost();
+						if (avp.heap_index != UINT32_MAX) {
+							to_visit.shift(avp.heap_index);
+						}
 					}
 				} else {
 					// Add the neighbour polygon to the reachable ones.
@@ -193,19 +232,23 @@ Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p
 					new_navigation_poly.back_navigation_edge_pathway_end = connection.pathway_end;
 					new_navigation_poly.traveled_distance = new_distance;
 					new_navigation_poly.entry = new_entry;
+					new_navigation_poly.total_cost = new_distance + new_entry.distance_to(p_end_point) * connection.polygon->owner->get_travel_cost();
 					navigation_polys.push_back(new_navigation_poly);
+					polygon_navigation_ids.insert(connection.polygon->id, new_navigation_poly.self_id);
 
 					// Add the neighbour polygon to the polygons to visit.
-					to_visit.push_back(navigation_polys.size() - 1);
+					to_visit.push(new_navigation_poly.self_id);
 				}
 			}
 		}
 
-		// Removes the least cost polygon from the list of polygons to visit so we can advance.
-		to_visit.erase(least_cost_id);
-
 		// When the list of polygons to visit is empty at this point it means the End Polygon is not reachable
-		if (to_visit.size() == 0) {
+		if (to_visit.is_empty()) {
+			// The corridor may miss a path the layers allow, let the caller search the whole map.
+			if (p_use_corridor) {
+				return false;
+			}
+
 			// Thus use the further reachable polygon
 			ERR_BREAK_MSG(is_reachable == false, "It's not expect to not find the most reachable polygons");
 			is_reachable = false;
@@ -215,24 +258,25 @@ Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p
 			}
 
 			// Set as end point the furthest reachable point.
-			end_poly = reachable_end;
+			p_end_poly = reachable_end;
 			end_d = 1e20;
-			for (size_t point_id = 2; point_id < end_poly->points.size(); point_id++) {
-				Face3 f(end_poly->points[0].pos, end_poly->points[point_id - 1].pos, end_poly->points[point_id].pos);
+			for (size_t point_id = 2; point_id < p_end_poly->points.size(); point_id++) {
+				Face3 f(p_end_poly->points[0].pos, p_end_poly->points[point_id - 1].pos, p_end_poly->points[point_id].pos);
 				Vector3 spoint = f.get_closest_point_to(p_destination);
 				float dpoint = spoint.distance_to(p_destination);
 				if (dpoint < end_d) {
-					end_point = spoint;
+					p_end_point = spoint;
 					end_d = dpoint;
 				}
 			}
 
 			// Reset open and navigation_polys
+			to_visit.clear();
 			gd::NavigationPoly np = navigation_polys[0];
 			navigation_polys.clear();
 			navigation_polys.push_back(np);
-			to_visit.clear();
-			to_visit.push_back(0);
+			polygon_navigation_ids.clear();
+			polygon_navigation_ids.insert(np.poly->id, 0);
 			least_cost_id = 0;
 
 			reachable_end = nullptr;
@@ -240,20 +284,8 @@ Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p
 			continue;
 		}
 
-		// Find the polygon with the minimum cost from the list of polygons to visit.
-		least_cost_id = -1;
-		float least_cost = 1e30;
-		for (List<uint32_t>::Element *element = to_visit.front(); element != nullptr; element = element->next()) {
-			gd::NavigationPoly *np = &navigation_polys[element->get()];
-			float cost = np->traveled_distance;
-			cost += (np->entry.distance_to(end_point) * np->poly->owner->get_travel_cost());
-			if (cost < least_cost) {
-				least_cost_id = np->self_id;
-				least_cost = cost;
-			}
-		}
-
-		ERR_BREAK(least_cost_id == -1);
+		// Take the polygon with the minimum cost from the list of polygons to visit.
+		least_cost_id = to_visit.pop();
 
 		// Stores the further reachable end polygon, in case our goal is not reachable.
 		if (is_reachable) {
@@ -265,7 +297,7 @@ Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p
 		}
 
 		// Check if we reached the end
-		if (navigation_polys[least_cost_id].poly == end_poly) {
+		if (navigation_polys[least_cost_id].poly == p_end_poly) {
 			found_route = true;
 			break;
 		}
@@ -273,15 +305,14 @@ Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p
 
 	// If we did not find a route, return an empty path.
 	if (!found_route) {
-		return Vector<Vector3>();
+		return false;
 	}
 
-	Vector<Vector3> path;
 	// Optimize the path.
 	if (p_optimize) {
 		// Set the apex poly/point to the end point
 		gd::NavigationPoly *apex_poly = &navigation_polys[least_cost_id];
-		Vector3 apex_point = end_point;
+		Vector3 apex_point = p_end_point;
 
 		gd::NavigationPoly *left_poly = apex_poly;
 		Vector3 left_portal = apex_point;
@@ -290,7 +321,7 @@ Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p
 
 		gd::NavigationPoly *p = apex_poly;
 
-		path.push_back(end_point);
+		r_path.push_back(p_end_point);
 
 		while (p) {
 			// Set left and right points of the pathway between polygons.
@@ -307,7 +338,7 @@ Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p
 					left_poly = p;
 					left_portal = left;
 				} else {
-					clip_path(navigation_polys, path, apex_poly, right_portal, right_poly);
+					clip_path(navigation_polys, r_path, apex_poly, right_portal, right_poly);
 
 					apex_point = right_portal;
 					p = right_poly;
@@ -315,7 +346,7 @@ Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p
 					apex_poly = p;
 					left_portal = apex_point;
 					right_portal = apex_point;
-					path.push_back(apex_point);
+					r_path.push_back(apex_point);
 					skip = true;
 				}
 			}
@@ -326,7 +357,7 @@ Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p
 					right_poly = p;
 					right_portal = right;
 				} else {
-					clip_path(navigation_polys, path, apex_poly, left_portal, left_poly);
+					clip_path(navigation_polys, r_path, apex_poly, left_portal, left_poly);
 
 					apex_point = left_portal;
 					p = left_poly;
@@ -334,7 +365,7 @@ Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p
 					apex_poly = p;
 					right_portal = apex_point;
 					left_portal = apex_point;
-					path.push_back(apex_point);
+					r_path.push_back(apex_point);
 				}
 			}
 
@@ -348,14 +379,14 @@ Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p
 		}
 
 		// If the last point is not the begin point, add it to the list.
-		if (path[path.size() - 1] != begin_point) {
-			path.push_back(begin_point);
+		if (r_path[r_path.size() - 1] != p_begin_point) {
+			r_path.push_back(p_begin_point);
 		}
 
-		path.reverse();
+		r_path.reverse();
 
 	} else {
-		path.push_back(end_point);
+		r_path.push_back(p_end_point);
 
 		// Add mid points
 		int np_id = least_cost_id;
@@ -363,15 +394,15 @@ Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p
 			int prev = navigation_polys[np_id].back_navigation_edge;
 			int prev_n = (navigation_polys[np_id].back_navigation_edge + 1) % navigation_polys[np_id].poly->points.size();
 			Vector3 point = (navigation_polys[np_id].poly->points[prev].pos + navigation_polys[np_id].poly->points[prev_n].pos) * 0.5;
-			path.push_back(point);
+			r_path.push_back(point);
 			np_id = navigation_polys[np_id].back_navigation_poly_id;
 		}
 
-		path.push_back(begin_point);
-		path.reverse();
+		r_path.push_back(p_begin_point);
+		r_path.reverse();
 	}
 
-	return path;
+	return true;
 }
 
 Vector3 NavMap::get_closest_point_to_segment(const Vector3 &p_from, const Vector3 &p_to, const bool p_use_collision) const {
@@ -440,38 +471,169 @@ RID NavMap::get_closest_point_owner(const Vector3 &p_point) const {
 
 gd::ClosestPointQueryResult NavMap::get_closest_point_info(const Vector3 &p_point) const {
 	gd::ClosestPointQueryResult result;
+
+	const gd::Polygon *closest_poly = _get_closest_polygon(p_point, 0, false, result.point, &result.normal);
+	if (closest_poly) {
+		result.owner = closest_poly->owner->get_self();
+	}
+
+	return result;
+}
+
+const gd::Polygon *NavMap::_get_closest_polygon(const Vector3 &p_point, uint32_t p_navigation_layers, bool p_use_layers, Vector3 &r_point, Vector3 *r_normal) const {
+	if (polygon_bvh.is_empty()) {
+		return nullptr;
+	}
+
+	const gd::Polygon *closest_poly = nullptr;
 	real_t closest_point_ds = 1e20;
 
-	for (size_t i(0); i < polygons.size(); i++) {
+	// Best first traversal, the distance to a node bounds is a lower bound of the distance to its polygons.
+	// Nodes are only pruned when strictly further, so on ties the lowest polygon id wins like a linear scan would.
+	struct StackEntry {
+		uint32_t node;
+		real_t ds;
+	};
+	StackEntry stack[POLYGON_BVH_STACK_SIZE];
+	uint32_t stack_size = 0;
+	stack[stack_size++] = { 0, 0.0 };
+
+	while (stack_size > 0) {
+		const StackEntry entry = stack[--stack_size];
+		if (entry.ds > closest_point_ds) {
+			continue;
+		}
+
+		const PolygonBVHNode &node = polygon_bvh[entry.node];
+		if (node.count == 0) {
+			// Push the furthest child first so the closest one is visited next.
+			const uint32_t child_a = node.first;
+			const uint32_t child_b = node.first + 1;
+			const real_t ds_a = _get_point_aabb_distance_squared(p_point, polygon_bvh[child_a].aabb);
+			const real_t ds_b = _get_point_aabb_distance_squared(p_point, polygon_bvh[child_b].aabb);
+			ERR_FAIL_COND_V(stack_size + 2 > POLYGON_BVH_STACK_SIZE, closest_poly);
+			if (ds_a <= ds_b) {
+				stack[stack_size++] = { child_b, ds_b };
+				stack[stack_size++] = { child_a, ds_a };
+			} else {
+				stack[stack_size++] = { child_a, ds_a };
+				stack[stack_size++] = { child_b, ds_b };
+			}
+			continue;
+		}
+
+		for (uint32_t i = node.first; i < node.first + node.count; i++) {
+			const gd::Polygon &p = polygons[polygon_bvh_indices[i]];
+
+			// Only consider the polygon if it in a region with compatible layers.
+			if (p_use_layers && (p_navigation_layers & p.owner->get_navigation_layers()) == 0) {
+				continue;
+			}
+
+			// For each face check the distance to the point.
+			for (size_t point_id = 2; point_id < p.points.size(); point_id++) {
+				const Face3 f(p.points[0].pos, p.points[point_id - 1].pos, p.points[point_id].pos);
+				const Vector3 inters = f.get_closest_point_to(p_point);
+				const real_t ds = inters.distance_squared_to(p_point);
+				if (ds < closest_point_ds || (ds == closest_point_ds && closest_poly && closest_poly != &p && p.id < closest_poly->id)) {
+					closest_poly = &p;
+					closest_point_ds = ds;
+					r_point = inters;
+					if (r_normal) {
+						*r_normal = f.get_plane().normal;
+					}
+				}
+			}
+		}
+	}
+
+	return closest_poly;
+}
+
+void NavMap::_build_polygon_bvh() {
+	polygon_bvh.clear();
+	polygon_bvh_indices.clear();
+
+	LocalVector<AABB> polygon_aabbs;
+	polygon_aabbs.resize(polygons.size());
+	for (uint32_t i = 0; i < polygons.size(); i++) {
 		const gd::Polygon &p = polygons[i];
+		// Skip the free polygon slots.
+		if (p.owner == nullptr || p.points.is_empty()) {
+			continue;
+		}
+		AABB aabb(p.points[0].pos, Vector3());
+		for (uint32_t j = 1; j < p.points.size(); j++) {
+			aabb.expand_to(p.points[j].pos);
+		}
+		polygon_aabbs[i] = aabb;
+		polygon_bvh_indices.push_back(i);
+	}
 
-		// For each face check the distance to the point
-		for (size_t point_id = 2; point_id < p.points.size(); point_id += 1) {
-			const Face3 f(p.points[0].pos, p.points[point_id - 1].pos, p.points[point_id].pos);
-			const Vector3 inters = f.get_closest_point_to(p_point);
-			const real_t ds = inters.distance_squared_to(p_point);
-			if (ds < closest_point_ds) {
-				result.point = inters;
-				result.normal = f.get_plane().normal;
-				result.owner = p.owner->get_self();
-				closest_point_ds = ds;
+	if (polygon_bvh_indices.is_empty()) {
+		return;
+	}
+
+	polygon_bvh.reserve(polygon_bvh_indices.size() * 2);
+	polygon_bvh.push_back(PolygonBVHNode());
+	_build_polygon_bvh_node(polygon_aabbs, 0, 0, polygon_bvh_indices.size(), 0);
+}
+
+void NavMap::_build_polygon_bvh_node(const LocalVector<AABB> &p_polygon_aabbs, uint32_t p_node, uint32_t p_from, uint32_t p_to, uint32_t p_depth) {
+	AABB aabb = p_polygon_aabbs[polygon_bvh_indices[p_from]];
+	AABB centers(aabb.get_center(), Vector3());
+	for (uint32_t i = p_from + 1; i < p_to; i++) {
+		const AABB &polygon_aabb = p_polygon_aabbs[polygon_bvh_indices[i]];
+		aabb.merge_with(polygon_aabb);
+		centers.expand_to(polygon_aabb.get_center());
+	}
+	polygon_bvh[p_node].aabb = aabb;
+
+	if (p_to - p_from <= POLYGON_BVH_MAX_LEAF_POLYGONS) {
+		polygon_bvh[p_node].first = p_from;
+		polygon_bvh[p_node].count = p_to - p_from;
+		return;
+	}
+
+	// Split at the middle of the longest axis of the polygon centers.
+	uint32_t mid = p_from;
+	if (p_depth < POLYGON_BVH_MAX_MIDPOINT_DEPTH) {
+		const int axis = centers.get_longest_axis_index();
+		const real_t split = centers.get_center()[axis];
+		for (uint32_t i = p_from; i < p_to; i++) {
+			if (p_polygon_aabbs[polygon_bvh_indices[i]].get_center()[axis] < split) {
+				SWAP(polygon_bvh_indices[i], polygon_bvh_indices[mid]);
+				mid++;
 			}
 		}
 	}
+	if (mid == p_from || mid == p_to) {
+		// All the centers are on the same side, split in half.
+		mid = (p_from + p_to) / 2;
+	}
 
-	return result;
+	const uint32_t children = polygon_bvh.size();
+	polygon_bvh.push_back(PolygonBVHNode());
+	polygon_bvh.push_back(PolygonBVHNode());
+	polygon_bvh[p_node].first = children;
+	polygon_bvh[p_node].count = 0;
+
+	_build_polygon_bvh_node(p_polygon_aabbs, children, p_from, mid, p_depth + 1);
+	_build_polygon_bvh_node(p_polygon_aabbs, children + 1, mid, p_to, p_depth + 1);
 }
 
 void NavMap::add_region(NavRegion *p_region) {
+	// The region polygons are added during the sync.
 	regions.push_back(p_region);
-	regenerate_links = true;
 }
 
 void NavMap::remove_region(NavRegion *p_region) {
 	int64_t region_index = regions.find(p_region);
 	if (region_index != -1) {
 		regions.remove_at_unordered(region_index);
-		regenerate_links = true;
+		// The region polygons are removed during the sync.
+		removed_regions.push_back(p_region);
+		p_region->get_connections().clear();
 	}
 }
 
@@ -482,7 +644,6 @@ bool NavMap::has_agent(RvoAgent *agent) const {
 void NavMap::add_agent(RvoAgent *agent) {
 	if (!has_agent(agent)) {
 		agents.push_back(agent);
-		agents_dirty = true;
 	}
 }
 
@@ -491,7 +652,6 @@ void NavMap::remove_agent(RvoAgent *agent) {
 	int64_t agent_index = agents.find(agent);
 	if (agent_index != -1) {
 		agents.remove_at_unordered(agent_index);
-		agents_dirty = true;
 	}
 }
 
@@ -507,182 +667,518 @@ void NavMap::remove_agent_as_controlled(RvoAgent *agent) {
 	int64_t active_avoidance_agent_index = controlled_agents.find(agent);
 	if (active_avoidance_agent_index != -1) {
 		controlled_agents.remove_at_unordered(active_avoidance_agent_index);
-		agents_dirty = true;
 	}
 }
 
-void NavMap::sync() {
-	// Check if we need to update the links.
-	if (regenerate_polygons) {
-		for (uint32_t r = 0; r < regions.size(); r++) {
-			regions[r]->scratch_polygons();
+gd::EdgeKey NavMap::_get_edge_key(uint64_t p_edge_id) {
+	const gd::Polygon &poly = _get_edge_polygon(p_edge_id);
+	const uint32_t edge = _get_edge_index(p_edge_id);
+	return gd::EdgeKey(poly.points[edge].key, poly.points[(edge + 1) % poly.points.size()].key);
+}
+
+void NavMap::_get_free_edge_cells(uint64_t p_edge_id, Vector3i &r_from, Vector3i &r_to) {
+	const gd::Polygon &poly = _get_edge_polygon(p_edge_id);
+	const uint32_t edge = _get_edge_index(p_edge_id);
+	AABB aabb(poly.points[edge].pos, Vector3());
+	aabb.expand_to(poly.points[(edge + 1) % poly.points.size()].pos);
+	aabb = aabb.grow(edge_connection_margin);
+
+	const Vector3 end = aabb.position + aabb.size;
+	r_from = Vector3i(Math::floor(aabb.position.x / FREE_EDGE_CELL_SIZE), Math::floor(aabb.position.y / FREE_EDGE_CELL_SIZE), Math::floor(aabb.position.z / FREE_EDGE_CELL_SIZE));
+	r_to = Vector3i(Math::floor(end.x / FREE_EDGE_CELL_SIZE), Math::floor(end.y / FREE_EDGE_CELL_SIZE), Math::floor(end.z / FREE_EDGE_CELL_SIZE));
+}
+
+static void _erase_connection(Vector<gd::Edge::Connection> &r_connections, const gd::Edge::Connection &p_connection) {
+	for (int i = 0; i < r_connections.size(); i++) {
+		const gd::Edge::Connection &connection = r_connections[i];
+		if (connection.polygon == p_connection.polygon && connection.edge == p_connection.edge && connection.pathway_start == p_connection.pathway_start && connection.pathway_end == p_connection.pathway_end) {
+			r_connections.remove_at(i);
+			return;
 		}
-		regenerate_links = true;
 	}
+}
 
+void NavMap::_clear_links() {
+	polygons.clear();
+	polygon_versions.clear();
+	region_polygons.clear();
+	free_polygon_ranges.clear();
+	free_polygon_count = 0;
+	removed_regions.clear();
+	edge_key_users.clear();
+	free_edges.clear();
+	free_edge_cells.clear();
+
+	// Remove regions connections.
 	for (uint32_t r = 0; r < regions.size(); r++) {
-		if (regions[r]->sync()) {
-			regenerate_links = true;
+		regions[r]->get_connections().clear();
+	}
+}
+
+uint32_t NavMap::_allocate_polygons(uint32_t p_count) {
+	// Reuse the first free slots large enough.
+	for (uint32_t i = 0; i < free_polygon_ranges.size(); i++) {
+		PolygonRange &range = free_polygon_ranges[i];
+		if (range.count >= p_count) {
+			const uint32_t first = range.first;
+			range.first += p_count;
+			range.count -= p_count;
+			if (range.count == 0) {
+				free_polygon_ranges.remove_at(i);
+			}
+			free_polygon_count -= p_count;
+			return first;
 		}
 	}
 
-	if (regenerate_links) {
-		// Remove regions connections.
-		for (uint32_t r = 0; r < regions.size(); r++) {
-			regions[r]->get_connections().clear();
+	const gd::Polygon *old_polygons = polygons.ptr();
+	const uint32_t first = polygons.size();
+	polygons.resize(first + p_count);
+	polygon_versions.resize(first + p_count);
+	if (old_polygons != nullptr && old_polygons != polygons.ptr()) {
+		_rebase_polygon_pointers(old_polygons);
+	}
+	return first;
+}
+
+void NavMap::_release_polygons(const PolygonRange &p_range) {
+	if (p_range.count == 0) {
+		return;
+	}
+
+	for (uint32_t i = p_range.first; i < p_range.first + p_range.count; i++) {
+		polygons[i] = gd::Polygon();
+	}
+	free_polygon_count += p_range.count;
+
+	// Keep the free ranges sorted, and merge the adjacent ones.
+	uint32_t index = 0;
+	while (index < free_polygon_ranges.size() && free_polygon_ranges[index].first < p_range.first) {
+		index++;
+	}
+	free_polygon_ranges.insert(index, p_range);
+	if (index + 1 < free_polygon_ranges.size() && free_polygon_ranges[index].first + free_polygon_ranges[index].count == free_polygon_ranges[index + 1].first) {
+		free_polygon_ranges[index].count += free_polygon_ranges[index + 1].count;
+		free_polygon_ranges.remove_at(index + 1);
+	}
+	if (index > 0 && free_polygon_ranges[index - 1].first + free_polygon_ranges[index - 1].count == free_polygon_ranges[index].first) {
+		free_polygon_ranges[index - 1].count += free_polygon_ranges[index].count;
+		free_polygon_ranges.remove_at(index);
+	}
+}
+
+void NavMap::_rebase_polygon_pointers(const gd::Polygon *p_old_polygons) {
+	// The polygons were moved, the connections still point to the old buffer.
+	const uintptr_t old_address = uintptr_t(p_old_polygons);
+	for (uint32_t i = 0; i < polygons.size(); i++) {
+		gd::Polygon &poly = polygons[i];
+		for (uint32_t j = 0; j < poly.edges.size(); j++) {
+			gd::Edge::Connection *connections = poly.edges[j].connections.ptrw();
+			for (int k = 0; k < poly.edges[j].connections.size(); k++) {
+				connections[k].polygon = &polygons[(uintptr_t(connections[k].polygon) - old_address) / sizeof(gd::Polygon)];
+			}
+		}
+	}
+	for (uint32_t r = 0; r < regions.size(); r++) {
+		Vector<gd::Edge::Connection> &region_connections = regions[r]->get_connections();
+		gd::Edge::Connection *connections = region_connections.ptrw();
+		for (int k = 0; k < region_connections.size(); k++) {
+			connections[k].polygon = &polygons[(uintptr_t(connections[k].polygon) - old_address) / sizeof(gd::Polygon)];
 		}
+	}
+}
 
-		// Resize the polygon count.
-		int count = 0;
-		for (uint32_t r = 0; r < regions.size(); r++) {
-			count += regions[r]->get_polygons().size();
+void NavMap::_add_region_polygons(NavRegion *p_region, HashSet<uint64_t> &r_new_free_edges) {
+	const LocalVector<gd::Polygon> &polygons_source = p_region->get_polygons();
+
+	PolygonRange range;
+	range.count = polygons_source.size();
+	range.first = range.count > 0 ? _allocate_polygons(range.count) : 0;
+	region_polygons.insert(p_region, range);
+
+	// Copy the region polygons in the map.
+	for (uint32_t n = 0; n < range.count; n++) {
+		gd::Polygon &poly = polygons[range.first + n];
+		poly = polygons_source[n];
+		poly.id = range.first + n;
+		_touch_polygon(poly.id);
+		for (uint32_t e = 0; e < poly.edges.size(); e++) {
+			poly.edges[e].connections.clear();
 		}
-		polygons.resize(count);
+	}
 
-		// Copy all region polygons in the map.
-		count = 0;
-		for (uint32_t r = 0; r < regions.size(); r++) {
-			const LocalVector<gd::Polygon> &polygons_source = regions[r]->get_polygons();
-			for (uint32_t n = 0; n < polygons_source.size(); n++) {
-				polygons[count + n] = polygons_source[n];
+	// Connect the edges shared with other polygons, the others are free.
+	for (uint32_t n = 0; n < range.count; n++) {
+		gd::Polygon &poly = polygons[range.first + n];
+
+		for (uint32_t p = 0; p < poly.points.size(); p++) {
+			const uint64_t edge_id = _make_edge_id(poly.id, p);
+			const gd::EdgeKey ek = _get_edge_key(edge_id);
+
+			EdgeKeyUsers *users = edge_key_users.getptr(ek);
+			if (!users) {
+				EdgeKeyUsers new_users;
+				new_users.edges[0] = edge_id;
+				new_users.count = 1;
+				edge_key_users.insert(ek, new_users);
+				_add_free_edge(edge_id);
+				r_new_free_edges.insert(edge_id);
+				continue;
+			}
+
+			if (users->count > 1) {
+				// The edge is already connected with another edge, skip.
+				ERR_PRINT_ONCE("Attempted to merge a navigation mesh triangle edge with another already-merged edge. This happens when the current `cell_size` is different from the one used to generate the navigation mesh. This will cause navigation problems.");
+				continue;
 			}
-			count += regions[r]->get_polygons().size();
+
+			// The other edge is not free anymore.
+			const uint64_t other_edge_id = users->edges[0];
+			_remove_free_edge(other_edge_id);
+			users->edges[1] = edge_id;
+			users->count = 2;
+
+			// Connect edge that are shared in different polygons.
+			// Note: The pathway_start/end are full for those connection and do not need to be modified.
+			gd::Polygon &other_poly = _get_edge_polygon(other_edge_id);
+			const uint32_t other_edge = _get_edge_index(other_edge_id);
+
+			gd::Edge::Connection c1;
+			c1.polygon = &poly;
+			c1.edge = p;
+			c1.pathway_start = poly.points[p].pos;
+			c1.pathway_end = poly.points[(p + 1) % poly.points.size()].pos;
+
+			gd::Edge::Connection c2;
+			c2.polygon = &other_poly;
+			c2.edge = other_edge;
+			c2.pathway_start = other_poly.points[other_edge].pos;
+			c2.pathway_end = other_poly.points[(other_edge + 1) % other_poly.points.size()].pos;
+
+			poly.edges[p].connections.push_back(c2);
+			other_poly.edges[other_edge].connections.push_back(c1);
+			_touch_polygon(other_poly.id);
 		}
+	}
+}
 
-		// Group all edges per key.
-		HashMap<gd::EdgeKey, Vector<gd::Edge::Connection>, gd::EdgeKey> connections;
-		for (uint32_t poly_id = 0; poly_id < polygons.size(); poly_id++) {
-			gd::Polygon &poly(polygons[poly_id]);
+void NavMap::_remove_region_polygons(NavRegion *p_region, HashSet<uint64_t> &r_new_free_edges) {
+	const PolygonRange *range_ptr = region_polygons.getptr(p_region);
+	if (!range_ptr) {
+		return;
+	}
+	const PolygonRange range = *range_ptr;
+	region_polygons.erase(p_region);
 
-			for (uint32_t p = 0; p < poly.points.size(); p++) {
-				int next_point = (p + 1) % poly.points.size();
-				gd::EdgeKey ek(poly.points[p].key, poly.points[next_point].key);
+	// The region may be freed already, so its polygons lose their owner first.
+	for (uint32_t i = range.first; i < range.first + range.count; i++) {
+		polygons[i].owner = nullptr;
+		_touch_polygon(i);
+	}
 
-				HashMap<gd::EdgeKey, Vector<gd::Edge::Connection>, gd::EdgeKey>::Iterator connection = connections.find(ek);
-				if (!connection) {
-					connections[ek] = Vector<gd::Edge::Connection>();
-				}
-				if (connections[ek].size() <= 1) {
-					// Add the polygon/edge tuple to this key.
-					gd::Edge::Connection new_connection;
-					new_connection.polygon = &poly;
-					new_connection.edge = p;
-					new_connection.pathway_start = poly.points[p].pos;
-					new_connection.pathway_end = poly.points[next_point].pos;
-					connections[ek].push_back(new_connection);
-				} else {
-					// The edge is already connected with another edge, skip.
-					ERR_PRINT_ONCE("Attempted to merge a navigation mesh triangle edge with another already-merged edge. This happens when the current `cell_size` is different from the one used to generate the navigation mesh. This will cause navigation problems.");
+	for (uint32_t i = range.first; i < range.first + range.count; i++) {
+		gd::Polygon &poly = polygons[i];
+
+		for (uint32_t p = 0; p < poly.points.size(); p++) {
+			const uint64_t edge_id = _make_edge_id(i, p);
+			const gd::EdgeKey ek = _get_edge_key(edge_id);
+
+			EdgeKeyUsers *users = edge_key_users.getptr(ek);
+			if (!users || (users->edges[0] != edge_id && (users->count < 2 || users->edges[1] != edge_id))) {
+				// This edge was skipped when added.
+				continue;
+			}
+
+			if (users->count == 1) {
+				_remove_free_edge(edge_id);
+				edge_key_users.erase(ek);
+				continue;
+			}
+
+			// The other polygon loses its connection to this edge, which makes its edge free.
+			const uint64_t other_edge_id = users->edges[0] == edge_id ? users->edges[1] : users->edges[0];
+			gd::Polygon &other_poly = _get_edge_polygon(other_edge_id);
+			Vector<gd::Edge::Connection> &other_connections = other_poly.edges[_get_edge_index(other_edge_id)].connections;
+			for (int k = 0; k < other_connections.size(); k++) {
+				if (other_connections[k].polygon == &poly && other_connections[k].edge == int(p)) {
+					other_connections.remove_at(k);
+					break;
 				}
 			}
+			_touch_polygon(other_poly.id);
+			users->edges[0] = other_edge_id;
+			users->count = 1;
+			_add_free_edge(other_edge_id);
+			r_new_free_edges.insert(other_edge_id);
 		}
+	}
 
-		Vector<gd::Edge::Connection> free_edges;
-		for (KeyValue<gd::EdgeKey, Vector<gd::Edge::Connection>> &E : connections) {
-			if (E.value.size() == 2) {
-				// Connect edge that are shared in different polygons.
-				gd::Edge::Connection &c1 = E.value.write[0];
-				gd::Edge::Connection &c2 = E.value.write[1];
-				c1.polygon->edges[c1.edge].connections.push_back(c2);
-				c2.polygon->edges[c2.edge].connections.push_back(c1);
-				// Note: The pathway_start/end are full for those connection and do not need to be modified.
-			} else {
-				CRASH_COND_MSG(E.value.size() != 1, vformat("Number of connection != 1. Found: %d", E.value.size()));
-				free_edges.push_back(E.value[0]);
+	_release_polygons(range);
+}
+
+void NavMap::_add_free_edge(uint64_t p_edge_id) {
+	free_edges.insert(p_edge_id);
+
+	Vector3i from;
+	Vector3i to;
+	_get_free_edge_cells(p_edge_id, from, to);
+	for (int x = from.x; x <= to.x; x++) {
+		for (int y = from.y; y <= to.y; y++) {
+			for (int z = from.z; z <= to.z; z++) {
+				const Vector3i key(x, y, z);
+				LocalVector<uint64_t> *cell = free_edge_cells.getptr(key);
+				if (!cell) {
+					cell = &free_edge_cells.insert(key, LocalVector<uint64_t>())->value;
+				}
+				cell->push_back(p_edge_id);
 			}
 		}
+	}
+}
 
-		// Find the compatible near edges.
-		//
-		// Note:
-		// Considering that the edges must be compatible (for obvious reasons)
-		// to be connected, create new polygons to remove that small gap is
-		// not really useful and would result in wasteful computation during
-		// connection, integration and path finding.
-		for (int i = 0; i < free_edges.size(); i++) {
-			const gd::Edge::Connection &free_edge = free_edges[i];
-			Vector3 edge_p1 = free_edge.polygon->points[free_edge.edge].pos;
-			Vector3 edge_p2 = free_edge.polygon->points[(free_edge.edge + 1) % free_edge.polygon->points.size()].pos;
-
-			for (int j = 0; j < free_edges.size(); j++) {
-				const gd::Edge::Connection &other_edge = free_edges[j];
-				if (i == j || free_edge.polygon->owner == other_edge.polygon->owner) {
-					continue;
-				}
+void NavMap::_remove_free_edge(uint64_t p_edge_id) {
+	free_edges.erase(p_edge_id);
 
-				Vector3 other_edge_p1 = other_edge.polygon->points[other_edge.edge].pos;
-				Vector3 other_edge_p2 = other_edge.polygon->points[(other_edge.edge + 1) % other_edge.polygon->points.size()].pos;
+	gd::Polygon &poly = _get_edge_polygon(p_edge_id);
+	const uint32_t edge = _get_edge_index(p_edge_id);
 
-				// Compute the projection of the opposite edge on the current one
-				Vector3 edge_vector = edge_p2 - edge_p1;
-				float projected_p1_ratio = edge_vector.dot(other_edge_p1 - edge_p1) / (edge_vector.length_squared());
-				float projected_p2_ratio = edge_vector.dot(other_edge_p2 - edge_p1) / (edge_vector.length_squared());
-				if ((projected_p1_ratio < 0.0 && projected_p2_ratio < 0.0) || (projected_p1_ratio > 1.0 && projected_p2_ratio > 1.0)) {
-					continue;
+	// Remove the connections of this edge to the near edges.
+	Vector<gd::Edge::Connection> &connections = poly.edges[edge].connections;
+	if (!connections.is_empty()) {
+		_touch_polygon(poly.id);
+	}
+	if (poly.owner) {
+		for (int i = 0; i < connections.size(); i++) {
+			_erase_connection(poly.owner->get_connections(), connections[i]);
+		}
+	}
+	connections.clear();
+
+	Vector3i from;
+	Vector3i to;
+	_get_free_edge_cells(p_edge_id, from, to);
+	for (int x = from.x; x <= to.x; x++) {
+		for (int y = from.y; y <= to.y; y++) {
+			for (int z = from.z; z <= to.z; z++) {
+				const Vector3i key(x, y, z);
+				LocalVector<uint64_t> *cell = free_edge_cells.getptr(key);
+				ERR_CONTINUE(!cell);
+
+				// Remove the connections of the near edges to this edge.
+				for (uint32_t i = 0; i < cell->size(); i++) {
+					const uint64_t other_edge_id = (*cell)[i];
+					if (other_edge_id == p_edge_id) {
+						continue;
+					}
+					gd::Polygon &other_poly = _get_edge_polygon(other_edge_id);
+					Vector<gd::Edge::Connection> &other_connections = other_poly.edges[_get_edge_index(other_edge_id)].connections;
+					for (int k = other_connections.size() - 1; k >= 0; k--) {
+						if (other_connections[k].polygon == &poly && other_connections[k].edge == int(edge)) {
+							if (other_poly.owner) {
+								_erase_connection(other_poly.owner->get_connections(), other_connections[k]);
+							}
+							other_connections.remove_at(k);
+							_touch_polygon(other_poly.id);
+						}
+					}
 				}
 
-				// Check if the two edges are close to each other enough and compute a pathway between the two regions.
-				Vector3 self1 = edge_vector * CLAMP(projected_p1_ratio, 0.0, 1.0) + edge_p1;
-				Vector3 other1;
-				if (projected_p1_ratio >= 0.0 && projected_p1_ratio <= 1.0) {
-					other1 = other_edge_p1;
-				} else {
-					other1 = other_edge_p1.lerp(other_edge_p2, (1.0 - projected_p1_ratio) / (projected_p2_ratio - projected_p1_ratio));
-				}
-				if (other1.distance_to(self1) > edge_connection_margin) {
-					continue;
+				cell->erase(p_edge_id);
+				if (cell->is_empty()) {
+					free_edge_cells.erase(key);
 				}
+			}
+		}
+	}
+}
 
-				Vector3 self2 = edge_vector * CLAMP(projected_p2_ratio, 0.0, 1.0) + edge_p1;
-				Vector3 other2;
-				if (projected_p2_ratio >= 0.0 && projected_p2_ratio <= 1.0) {
-					other2 = other_edge_p2;
-				} else {
-					other2 = other_edge_p1.lerp(other_edge_p2, (0.0 - projected_p1_ratio) / (projected_p2_ratio - projected_p1_ratio));
-				}
-				if (other2.distance_to(self2) > edge_connection_margin) {
-					continue;
-				}
+void NavMap::_link_free_edges(uint64_t p_edge_id, uint64_t p_other_edge_id) {
+	gd::Polygon &poly = _get_edge_polygon(p_edge_id);
+	const uint32_t edge = _get_edge_index(p_edge_id);
+	gd::Polygon &other_poly = _get_edge_polygon(p_other_edge_id);
+	const uint32_t other_edge = _get_edge_index(p_other_edge_id);
+
+	Vector3 edge_p1 = poly.points[edge].pos;
+	Vector3 edge_p2 = poly.points[(edge + 1) % poly.points.size()].pos;
+	Vector3 other_edge_p1 = other_poly.points[other_edge].pos;
+	Vector3 other_edge_p2 = other_poly.points[(other_edge + 1) % other_poly.points.size()].pos;
+
+	// Compute the projection of the opposite edge on the current one
+	Vector3 edge_vector = edge_p2 - edge_p1;
+	float projected_p1_ratio = edge_vector.dot(other_edge_p1 - edge_p1) / (edge_vector.length_squared());
+	float projected_p2_ratio = edge_vector.dot(other_edge_p2 - edge_p1) / (edge_vector.length_squared());
+	if ((projected_p1_ratio < 0.0 && projected_p2_ratio < 0.0) || (projected_p1_ratio > 1.0 && projected_p2_ratio > 1.0)) {
+		return;
+	}
 
-				// The edges can now be connected.
-				gd::Edge::Connection new_connection = other_edge;
-				new_connection.pathway_start = (self1 + other1) / 2.0;
-				new_connection.pathway_end = (self2 + other2) / 2.0;
-				free_edge.polygon->edges[free_edge.edge].connections.push_back(new_connection);
+	// Check if the two edges are close to each other enough and compute a pathway between the two regions.
+	Vector3 self1 = edge_vector * CLAMP(projected_p1_ratio, 0.0, 1.0) + edge_p1;
+	Vector3 other1;
+	if (projected_p1_ratio >= 0.0 && projected_p1_ratio <= 1.0) {
+		other1 = other_edge_p1;
+	} else {
+		other1 = other_edge_p1.lerp(other_edge_p2, (1.0 - projected_p1_ratio) / (projected_p2_ratio - projected_p1_ratio));
+	}
+	if (other1.distance_to(self1) > edge_connection_margin) {
+		return;
+	}
 
-				// Add the connection to the region_connection map.
-				free_edge.polygon->owner->get_connections().push_back(new_connection);
+	Vector3 self2 = edge_vector * CLAMP(projected_p2_ratio, 0.0, 1.0) + edge_p1;
+	Vector3 other2;
+	if (projected_p2_ratio >= 0.0 && projected_p2_ratio <= 1.0) {
+		other2 = other_edge_p2;
+	} else {
+		other2 = other_edge_p1.lerp(other_edge_p2, (0.0 - projected_p1_ratio) / (projected_p2_ratio - projected_p1_ratio));
+	}
+	if (other2.distance_to(self2) > edge_connection_margin) {
+		return;
+	}
+
+	// The edges can now be connected.
+	gd::Edge::Connection new_connection;
+	new_connection.polygon = &other_poly;
+	new_connection.edge = other_edge;
+	new_connection.pathway_start = (self1 + other1) / 2.0;
+	new_connection.pathway_end = (self2 + other2) / 2.0;
+	poly.edges[edge].connections.push_back(new_connection);
+	_touch_polygon(poly.id);
+
+	// Add the connection to the region_connection map.
+	poly.owner->get_connections().push_back(new_connection);
+}
+
+void NavMap::_connect_free_edges(const HashSet<uint64_t> &p_new_free_edges) {
+	// Note:
+	// Considering that the edges must be compatible (for obvious reasons)
+	// to be connected, create new polygons to remove that small gap is
+	// not really useful and would result in wasteful computation during
+	// connection, integration and path finding.
+	LocalVector<uint64_t> new_edges;
+	HashMap<uint64_t, uint32_t> new_edge_indices;
+	for (const uint64_t &edge_id : p_new_free_edges) {
+		// Some of the new free edges were connected or removed afterwards.
+		if (free_edges.has(edge_id)) {
+			new_edge_indices.insert(edge_id, new_edges.size());
+			new_edges.push_back(edge_id);
+		}
+	}
+
+	HashSet<uint64_t> visited;
+	for (uint32_t i = 0; i < new_edges.size(); i++) {
+		const uint64_t edge_id = new_edges[i];
+		const NavRegion *owner = _get_edge_polygon(edge_id).owner;
+		visited.clear();
+
+		Vector3i from;
+		Vector3i to;
+		_get_free_edge_cells(edge_id, from, to);
+		for (int x = from.x; x <= to.x; x++) {
+			for (int y = from.y; y <= to.y; y++) {
+				for (int z = from.z; z <= to.z; z++) {
+					const LocalVector<uint64_t> *cell = free_edge_cells.getptr(Vector3i(x, y, z));
+					if (!cell) {
+						continue;
+					}
+					for (uint32_t j = 0; j < cell->size(); j++) {
+						const uint64_t other_edge_id = (*cell)[j];
+						if (other_edge_id == edge_id || visited.has(other_edge_id)) {
+							continue;
+						}
+						visited.insert(other_edge_id);
+
+						// Each pair of new edges is linked once.
+						const uint32_t *other_index = new_edge_indices.getptr(other_edge_id);
+						if ((other_index && *other_index < i) || _get_edge_polygon(other_edge_id).owner == owner) {
+							continue;
+						}
+
+						_link_free_edges(edge_id, other_edge_id);
+						_link_free_edges(other_edge_id, edge_id);
+					}
+				}
 			}
 		}
+	}
+}
 
-		// Update the update ID.
-		map_update_id = (map_update_id + 1) % 9999999;
+void NavMap::sync() {
+	// Check if we need to update the links.
+	if (regenerate_polygons) {
+		for (uint32_t r = 0; r < regions.size(); r++) {
+			regions[r]->scratch_polygons();
+		}
+		regenerate_links = true;
 	}
 
-	// Update agents tree.
-	if (agents_dirty) {
-		// cannot use LocalVector here as RVO library expects std::vector to build KdTree
-		std::vector<RVO::Agent *> raw_agents;
-		raw_agents.reserve(agents.size());
-		for (size_t i(0); i < agents.size(); i++) {
-			raw_agents.push_back(agents[i]->get_agent());
+	// Find the regions with new polygons.
+	LocalVector<NavRegion *> changed_regions;
+	for (uint32_t r = 0; r < regions.size(); r++) {
+		if (regions[r]->sync() || !region_polygons.has(regions[r])) {
+			changed_regions.push_back(regions[r]);
 		}
-		rvo.buildAgentTree(raw_agents);
+	}
+
+	// Rebuild everything when the connection settings changed, or to compact the polygons once most slots are free.
+	bool polygons_reset = false;
+	if (regenerate_links || free_polygon_count > polygons.size() / 2) {
+		_clear_links();
+		changed_regions = regions;
+		polygons_version++;
+		polygons_reset_version = polygons_version;
+		polygons_reset = true;
+	}
+
+	if (!changed_regions.is_empty() || !removed_regions.is_empty()) {
+		if (!polygons_reset) {
+			polygons_version++;
+		}
+
+		// Only the polygons of the removed and changed regions, and the edges they share, are updated.
+		HashSet<uint64_t> new_free_edges;
+		for (uint32_t r = 0; r < removed_regions.size(); r++) {
+			_remove_region_polygons(removed_regions[r], new_free_edges);
+		}
+		removed_regions.clear();
+
+		for (uint32_t r = 0; r < changed_regions.size(); r++) {
+			if (region_polygons.has(changed_regions[r])) {
+				_remove_region_polygons(changed_regions[r], new_free_edges);
+				changed_regions[r]->get_connections().clear();
+			}
+		}
+		for (uint32_t r = 0; r < changed_regions.size(); r++) {
+			_add_region_polygons(changed_regions[r], new_free_edges);
+		}
+
+		// Find the compatible near edges, only around the new free edges.
+		_connect_free_edges(new_free_edges);
+
+		// Rebuild the spatial index used by the closest polygon queries.
+		_build_polygon_bvh();
+
+		if (use_hierarchical_paths) {
+			hierarchy.build(polygons);
+		}
+
+		// Update the update ID.
+		map_update_id = (map_update_id + 1) % 9999999;
 	}
 
 	regenerate_polygons = false;
 	regenerate_links = false;
-	agents_dirty = false;
 }
 
 void NavMap::compute_single_step(uint32_t index, RvoAgent **agent) {
-	(*(agent + index))->get_agent()->computeNeighbors(&rvo);
+	agent_grid.compute_neighbors((*(agent + index))->get_agent());
 	(*(agent + index))->get_agent()->computeNewVelocity(deltatime);
 }
 
 void NavMap::step(real_t p_deltatime) {
 	deltatime = p_deltatime;
 	if (controlled_agents.size() > 0) {
+		// The agents moved since the last step.
+		agent_grid.build(agents);
+
 		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &NavMap::compute_single_step, controlled_agents.ptr(), controlled_agents.size(), -1, true, SNAME("NavigationMapAgents"));
 		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
 	}
@@ -730,4 +1226,7 @@ NavMap::NavMap() {
 }
 
 NavMap::~NavMap() {
+	for (uint32_t i = 0; i < path_query_scratches.size(); i++) {
+		memdelete(path_query_scratches[i]);
+	}
 }
@@ -35,11 +35,13 @@
 
 #include "core/math/math_defs.h"
 #include "core/object/worker_thread_pool.h"
+#include "core/os/mutex.h"
+#include "core/templates/hash_set.h"
 #include "core/templates/rb_map.h"
+#include "nav_agent_grid.h"
+#include "nav_map_hierarchy.h"
 #include "nav_utils.h"
 
-#include <KdTree.h>
-
 class NavRegion;
 class RvoAgent;
 class NavRegion;
@@ -60,14 +62,63 @@ class NavMap : public NavRid {
 
 	LocalVector<NavRegion *> regions;
 
-	/// Map polygons
+	/// Map polygons, stored contiguously by region.
 	LocalVector<gd::Polygon> polygons;
 
-	/// Rvo world
-	RVO::KdTree rvo;
-
-	/// Is agent array modified?
-	bool agents_dirty = false;
+	/// Stamps the polygons changed by each sync.
+	uint64_t polygons_version = 0;
+	uint64_t polygons_reset_version = 0;
+	LocalVector<uint64_t> polygon_versions;
+
+	struct PolygonRange {
+		uint32_t first = 0;
+		uint32_t count = 0;
+	};
+
+	/// Polygons of each synced region.
+	HashMap<NavRegion *, PolygonRange> region_polygons;
+	LocalVector<PolygonRange> free_polygon_ranges;
+	uint32_t free_polygon_count = 0;
+
+	/// Removed since the last sync, only used as keys.
+	LocalVector<NavRegion *> removed_regions;
+
+	/// Edges are identified by `(polygon id << 32) | edge`.
+	struct EdgeKeyUsers {
+		uint64_t edges[2] = {};
+		uint32_t count = 0;
+	};
+	HashMap<gd::EdgeKey, EdgeKeyUsers, gd::EdgeKey> edge_key_users;
+
+	/// Grid of the free edges.
+	static constexpr real_t FREE_EDGE_CELL_SIZE = 8.0;
+	HashSet<uint64_t> free_edges;
+	HashMap<Vector3i, LocalVector<uint64_t>> free_edge_cells;
+
+	/// BVH used to find the closest polygons.
+	struct PolygonBVHNode {
+		AABB aabb;
+		uint32_t first = 0; // First child for inner nodes, first index in polygon_bvh_indices for leaves.
+		uint32_t count = 0; // Polygon count for leaves, zero for inner nodes.
+	};
+
+	static const uint32_t POLYGON_BVH_MAX_LEAF_POLYGONS = 4;
+	static const uint32_t POLYGON_BVH_MAX_MIDPOINT_DEPTH = 32; // Deeper nodes are split in half, which bounds the traversal stack.
+	static const uint32_t POLYGON_BVH_STACK_SIZE = 128;
+
+	LocalVector<PolygonBVHNode> polygon_bvh;
+	LocalVector<uint32_t> polygon_bvh_indices;
+
+	/// Search long paths in the cluster graph first.
+	bool use_hierarchical_paths = false;
+	NavMapHierarchy hierarchy;
+
+	/// Used by the path queries run without their own.
+	mutable Mutex path_query_scratches_mutex;
+	mutable LocalVector<gd::PathQueryScratch *> path_query_scratches;
+
+	/// Rebuilt at each step.
+	NavAgentGrid agent_grid;
 
 	/// All the Agents (even the controlled one)
 	LocalVector<RvoAgent *> agents;
@@ -100,14 +151,44 @@ public:
 		return edge_connection_margin;
 	}
 
+	void set_use_hierarchical_paths(bool p_enabled);
+	bool get_use_hierarchical_paths() const {
+		return use_hierarchical_paths;
+	}
+
+	void set_hierarchical_cluster_size(real_t p_cluster_size);
+	real_t get_hierarchical_cluster_size() const {
+		return hierarchy.get_cluster_size();
+	}
+
 	gd::PointKey get_point_key(const Vector3 &p_pos) const;
 
+	const LocalVector<gd::Polygon> &get_polygons() const {
+		return polygons;
+	}
+	uint64_t get_polygons_version() const {
+		return polygons_version;
+	}
+	/// Last sync that changed the polygon ids.
+	uint64_t get_polygons_reset_version() const {
+		return polygons_reset_version;
+	}
+	/// Last sync that changed each polygon.
+	const LocalVector<uint64_t> &get_polygon_versions() const {
+		return polygon_versions;
+	}
+
 	Vector<Vector3> get_path(Vector3 p_origin, Vector3 p_destination, bool p_optimize, uint32_t p_navigation_layers = 1) const;
+	/// Thread safe between syncs.
+	Vector<Vector3> get_path(Vector3 p_origin, Vector3 p_destination, bool p_optimize, uint32_t p_navigation_layers, gd::PathQueryScratch &r_scratch) const;
 	Vector3 get_closest_point_to_segment(const Vector3 &p_from, const Vector3 &p_to, const bool p_use_collision) const;
 	Vector3 get_closest_point(const Vector3 &p_point) const;
 	Vector3 get_closest_point_normal(const Vector3 &p_point) const;
 	gd::ClosestPointQueryResult get_closest_point_info(const Vector3 &p_point) const;
 	RID get_closest_point_owner(const Vector3 &p_point) const;
+	const gd::Polygon *get_closest_polygon(const Vector3 &p_point, uint32_t p_navigation_layers, Vector3 &r_point) const {
+		return _get_closest_polygon(p_point, p_navigation_layers, true, r_point);
+	}
 
 	void add_region(NavRegion *p_region);
 	void remove_region(NavRegion *p_region);
@@ -134,6 +215,38 @@ public:
 	void dispatch_callbacks();
 
 private:
+	_FORCE_INLINE_ static uint64_t _make_edge_id(uint32_t p_polygon, uint32_t p_edge) {
+		return (uint64_t(p_polygon) << 32) | p_edge;
+	}
+	_FORCE_INLINE_ gd::Polygon &_get_edge_polygon(uint64_t p_edge_id) {
+		return polygons[p_edge_id >> 32];
+	}
+	_FORCE_INLINE_ static uint32_t _get_edge_index(uint64_t p_edge_id) {
+		return p_edge_id & 0xFFFFFFFF;
+	}
+	gd::EdgeKey _get_edge_key(uint64_t p_edge_id);
+	void _get_free_edge_cells(uint64_t p_edge_id, Vector3i &r_from, Vector3i &r_to);
+
+	_FORCE_INLINE_ void _touch_polygon(uint32_t p_polygon) {
+		polygon_versions[p_polygon] = polygons_version;
+	}
+
+	void _clear_links();
+	uint32_t _allocate_polygons(uint32_t p_count);
+	void _release_polygons(const PolygonRange &p_range);
+	void _rebase_polygon_pointers(const gd::Polygon *p_old_polygons);
+	void _add_region_polygons(NavRegion *p_region, HashSet<uint64_t> &r_new_free_edges);
+	void _remove_region_polygons(NavRegion *p_region, HashSet<uint64_t> &r_new_free_edges);
+	void _add_free_edge(uint64_t p_edge_id);
+	void _remove_free_edge(uint64_t p_edge_id);
+	void _link_free_edges(uint64_t p_edge_id, uint64_t p_other_edge_id);
+	void _connect_free_edges(const HashSet<uint64_t> &p_new_free_edges);
+
+	void _build_polygon_bvh();
+	void _build_polygon_bvh_node(const LocalVector<AABB> &p_polygon_aabbs, uint32_t p_node, uint32_t p_from, uint32_t p_to, uint32_t p_depth);
+	bool _find_path(const gd::Polygon *p_begin_poly, const Vector3 &p_begin_point, const gd::Polygon *p_end_poly, Vector3 p_end_point, const Vector3 &p_destination, bool p_optimize, uint32_t p_navigation_layers, bool p_use_corridor, gd::PathQueryScratch &r_scratch, Vector<Vector3> &r_path) const;
+	const gd::Polygon *_get_closest_polygon(const Vector3 &p_point, uint32_t p_navigation_layers, bool p_use_layers, Vector3 &r_point, Vector3 *r_normal = nullptr) const;
+
 	void compute_single_step(uint32_t index, RvoAgent **agent);
 	void clip_path(const LocalVector<gd::NavigationPoly> &p_navigation_polys, Vector<Vector3> &path, const gd::NavigationPoly *from_poly, const Vector3 &p_to_point, const gd::NavigationPoly *p_to_poly) const;
 };
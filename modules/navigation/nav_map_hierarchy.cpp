@@ -0,0 +1,387 @@
+/*************************************************************************/
+/*  nav_map_hierarchy.cpp                                                */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2022 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2022 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "nav_map_hierarchy.h"
+
+#include "core/templates/hashfuncs.h"
+#include "nav_region.h"
+
+#include <float.h>
+
+float NavMapHierarchy::get_connection_cost(const gd::Polygon &p_from, const gd::Polygon &p_to) {
+	float cost = p_from.center.distance_to(p_to.center) * (p_from.owner->get_travel_cost() + p_to.owner->get_travel_cost()) * 0.5;
+	if (p_from.owner != p_to.owner) {
+		cost += p_to.owner->get_enter_cost();
+	}
+	return cost;
+}
+
+Vector3i NavMapHierarchy::_get_cluster_key(const Vector3 &p_position) const {
+	return Vector3i(
+			int(Math::floor(p_position.x / cluster_size)),
+			int(Math::floor(p_position.y / cluster_size)),
+			int(Math::floor(p_position.z / cluster_size)));
+}
+
+uint32_t NavMapHierarchy::_hash_cluster(const LocalVector<gd::Polygon> &p_polygons, const Cluster &p_cluster) const {
+	const uint32_t cluster_index = polygon_clusters[p_cluster.polygons[0]];
+
+	uint32_t h = hash_murmur3_one_32(p_cluster.polygons.size());
+	for (uint32_t i = 0; i < p_cluster.polygons.size(); i++) {
+		const gd::Polygon &p = p_polygons[p_cluster.polygons[i]];
+
+		h = hash_murmur3_one_64(p.owner->get_self().get_id(), h);
+		h = hash_murmur3_one_float(p.owner->get_travel_cost(), h);
+		h = hash_murmur3_one_float(p.owner->get_enter_cost(), h);
+		for (uint32_t j = 0; j < p.points.size(); j++) {
+			h = hash_murmur3_one_real(p.points[j].pos.x, h);
+			h = hash_murmur3_one_real(p.points[j].pos.y, h);
+			h = hash_murmur3_one_real(p.points[j].pos.z, h);
+		}
+
+		// The connections leaving the cluster only matter to know which polygons are entrances.
+		for (uint32_t j = 0; j < p.edges.size(); j++) {
+			const gd::Edge &edge = p.edges[j];
+			h = hash_murmur3_one_32(edge.connections.size(), h);
+			for (int k = 0; k < edge.connections.size(); k++) {
+				const uint32_t other_id = edge.connections[k].polygon->id;
+				h = hash_murmur3_one_32(polygon_clusters[other_id] == cluster_index ? polygon_local_indices[other_id] : UINT32_MAX, h);
+			}
+		}
+	}
+
+	return hash_fmix32(h);
+}
+
+void NavMapHierarchy::_compute_cluster_costs(const LocalVector<gd::Polygon> &p_polygons, uint32_t p_polygon, bool p_reverse, gd::ClusterCostSearch &r_search) const {
+	const uint32_t cluster_index = polygon_clusters[p_polygon];
+	const Cluster &cluster = clusters[cluster_index];
+
+	LocalVector<float> &r_costs = r_search.costs;
+	r_costs.resize(cluster.polygons.size());
+	r_search.heap_indices.resize(cluster.polygons.size());
+	for (uint32_t i = 0; i < cluster.polygons.size(); i++) {
+		r_costs[i] = FLT_MAX;
+		r_search.heap_indices[i] = UINT32_MAX;
+	}
+
+	// Dijkstra over the polygons of the cluster.
+	gd::NavHierarchyHeap &to_visit = r_search.to_visit;
+	r_costs[polygon_local_indices[p_polygon]] = 0.0;
+	to_visit.push(polygon_local_indices[p_polygon]);
+
+	while (!to_visit.is_empty()) {
+		const uint32_t local_index = to_visit.pop();
+		const gd::Polygon &p = p_polygons[cluster.polygons[local_index]];
+
+		for (uint32_t i = 0; i < p.edges.size(); i++) {
+			const gd::Edge &edge = p.edges[i];
+			for (int j = 0; j < edge.connections.size(); j++) {
+				const gd::Polygon &other = *edge.connections[j].polygon;
+				if (polygon_clusters[other.id] != cluster_index) {
+					continue;
+				}
+
+				const uint32_t other_local_index = polygon_local_indices[other.id];
+				const float cost = r_costs[local_index] + (p_reverse ? get_connection_cost(other, p) : get_connection_cost(p, other));
+				if (cost < r_costs[other_local_index]) {
+					r_costs[other_local_index] = cost;
+					if (r_search.heap_indices[other_local_index] == UINT32_MAX) {
+						to_visit.push(other_local_index);
+					} else {
+						to_visit.shift(r_search.heap_indices[other_local_index]);
+					}
+				}
+			}
+		}
+	}
+}
+
+void NavMapHierarchy::set_cluster_size(real_t p_cluster_size) {
+	ERR_FAIL_COND(p_cluster_size <= 0.0);
+	cluster_size = p_cluster_size;
+	// The cluster keys changed, so none of the costs can be reused.
+	clear();
+}
+
+void NavMapHierarchy::clear() {
+	clusters.clear();
+	cluster_indices.clear();
+	polygon_clusters.clear();
+	polygon_local_indices.clear();
+	polygon_entrances.clear();
+	entrance_polygons.clear();
+}
+
+void NavMapHierarchy::build(const LocalVector<gd::Polygon> &p_polygons) {
+	LocalVector<Cluster> old_clusters;
+	HashMap<Vector3i, uint32_t> old_cluster_indices;
+	SWAP(clusters, old_clusters);
+	SWAP(cluster_indices, old_cluster_indices);
+	clusters.clear();
+	cluster_indices.clear();
+
+	// Group the polygons in clusters.
+	polygon_clusters.resize(p_polygons.size());
+	polygon_local_indices.resize(p_polygons.size());
+	polygon_entrances.resize(p_polygons.size());
+	min_travel_cost = FLT_MAX;
+	for (uint32_t i = 0; i < p_polygons.size(); i++) {
+		const gd::Polygon &p = p_polygons[i];
+		if (p.owner == nullptr) {
+			// A free polygon slot.
+			polygon_clusters[i] = UINT32_MAX;
+			polygon_entrances[i] = UINT32_MAX;
+			continue;
+		}
+		const Vector3i key = _get_cluster_key(p.center);
+
+		uint32_t cluster_index;
+		HashMap<Vector3i, uint32_t>::Iterator E = cluster_indices.find(key);
+		if (E) {
+			cluster_index = E->value;
+		} else {
+			cluster_index = clusters.size();
+			cluster_indices.insert(key, cluster_index);
+			clusters.push_back(Cluster());
+			clusters[cluster_index].key = key;
+		}
+
+		polygon_clusters[i] = cluster_index;
+		polygon_local_indices[i] = clusters[cluster_index].polygons.size();
+		clusters[cluster_index].polygons.push_back(i);
+		min_travel_cost = MIN(min_travel_cost, p.owner->get_travel_cost());
+	}
+	if (min_travel_cost == FLT_MAX) {
+		min_travel_cost = 1.0;
+	}
+
+	// Find the entrances, the polygons connected to another cluster.
+	for (uint32_t i = 0; i < p_polygons.size(); i++) {
+		const gd::Polygon &p = p_polygons[i];
+		polygon_entrances[i] = UINT32_MAX;
+		if (p.owner == nullptr) {
+			continue;
+		}
+		for (uint32_t j = 0; j < p.edges.size() && polygon_entrances[i] == UINT32_MAX; j++) {
+			const gd::Edge &edge = p.edges[j];
+			for (int k = 0; k < edge.connections.size(); k++) {
+				if (polygon_clusters[edge.connections[k].polygon->id] != polygon_clusters[i]) {
+					Cluster &cluster = clusters[polygon_clusters[i]];
+					polygon_entrances[i] = cluster.entrances.size();
+					cluster.entrances.push_back(i);
+					break;
+				}
+			}
+		}
+	}
+
+	entrance_polygons.clear();
+	for (uint32_t i = 0; i < clusters.size(); i++) {
+		Cluster &cluster = clusters[i];
+		cluster.first_entrance = entrance_polygons.size();
+		for (uint32_t j = 0; j < cluster.entrances.size(); j++) {
+			entrance_polygons.push_back(cluster.entrances[j]);
+		}
+	}
+
+	// Compute the costs between the entrances of each cluster, unless the cluster didn't change.
+	gd::ClusterCostSearch search;
+	for (uint32_t i = 0; i < clusters.size(); i++) {
+		Cluster &cluster = clusters[i];
+		cluster.hash = _hash_cluster(p_polygons, cluster);
+
+		HashMap<Vector3i, uint32_t>::Iterator E = old_cluster_indices.find(cluster.key);
+		if (E && old_clusters[E->value].hash == cluster.hash) {
+			SWAP(cluster.entrance_costs, old_clusters[E->value].entrance_costs);
+			continue;
+		}
+
+		const uint32_t entrances_count = cluster.entrances.size();
+		cluster.entrance_costs.resize(entrances_count * entrances_count);
+		for (uint32_t j = 0; j < entrances_count; j++) {
+			_compute_cluster_costs(p_polygons, cluster.entrances[j], false, search);
+			for (uint32_t k = 0; k < entrances_count; k++) {
+				cluster.entrance_costs[j * entrances_count + k] = search.costs[polygon_local_indices[cluster.entrances[k]]];
+			}
+		}
+	}
+}
+
+bool NavMapHierarchy::find_corridor(const LocalVector<gd::Polygon> &p_polygons, const gd::Polygon *p_begin_poly, const gd::Polygon *p_end_poly, uint32_t p_navigation_layers, gd::CorridorSearch &r_search, LocalVector<uint8_t> &r_corridor) const {
+	ERR_FAIL_COND_V(p_begin_poly->id >= polygon_clusters.size() || p_end_poly->id >= polygon_clusters.size(), false);
+
+	const uint32_t begin_cluster = polygon_clusters[p_begin_poly->id];
+	const uint32_t end_cluster = polygon_clusters[p_end_poly->id];
+
+	_compute_cluster_costs(p_polygons, p_begin_poly->id, false, r_search.begin_costs);
+	_compute_cluster_costs(p_polygons, p_end_poly->id, true, r_search.end_costs);
+	const LocalVector<float> &begin_costs = r_search.begin_costs.costs;
+	const LocalVector<float> &end_costs = r_search.end_costs.costs;
+
+	// The nodes are the entrances, followed by the begin and the end polygons.
+	const uint32_t entrance_count = entrance_polygons.size();
+	const uint32_t begin_node = entrance_count;
+	const uint32_t end_node = entrance_count + 1;
+	const uint32_t node_count = entrance_count + 2;
+
+	// The buffers are reused between the searches, only the nodes reached by this pass are reset.
+	LocalVector<float> &costs = r_search.costs;
+	LocalVector<float> &priorities = r_search.priorities;
+	LocalVector<uint32_t> &back_nodes = r_search.back_nodes;
+	LocalVector<uint32_t> &heap_indices = r_search.heap_indices;
+	LocalVector<uint32_t> &passes = r_search.passes;
+	gd::NavHierarchyHeap &to_visit = r_search.to_visit;
+	to_visit.clear();
+	if (passes.size() < node_count) {
+		const uint32_t old_count = passes.size();
+		costs.resize(node_count);
+		priorities.resize(node_count);
+		back_nodes.resize(node_count);
+		heap_indices.resize(node_count);
+		passes.resize(node_count);
+		for (uint32_t i = old_count; i < node_count; i++) {
+			heap_indices[i] = UINT32_MAX;
+			passes[i] = 0;
+		}
+	}
+	r_search.pass++;
+	if (r_search.pass == 0) {
+		// The stamps wrapped around, forget all of them.
+		for (uint32_t i = 0; i < passes.size(); i++) {
+			passes[i] = 0;
+		}
+		r_search.pass = 1;
+	}
+	const uint32_t pass = r_search.pass;
+
+	// A* over the entrance graph, the heuristic uses the lowest travel cost so it never overestimates.
+	auto visit = [&](uint32_t p_node, uint32_t p_from_node, float p_cost) {
+		if (passes[p_node] != pass) {
+			passes[p_node] = pass;
+			costs[p_node] = FLT_MAX;
+			heap_indices[p_node] = UINT32_MAX;
+		}
+		if (p_cost >= costs[p_node]) {
+			return;
+		}
+		costs[p_node] = p_cost;
+		back_nodes[p_node] = p_from_node;
+		const float heuristic = p_node == end_node ? 0.0 : p_polygons[entrance_polygons[p_node]].center.distance_to(p_end_poly->center) * min_travel_cost;
+		priorities[p_node] = p_cost + heuristic;
+		if (heap_indices[p_node] == UINT32_MAX) {
+			to_visit.push(p_node);
+		} else {
+			to_visit.shift(heap_indices[p_node]);
+		}
+	};
+
+	passes[begin_node] = pass;
+	costs[begin_node] = 0.0;
+	priorities[begin_node] = 0.0;
+	back_nodes[begin_node] = UINT32_MAX;
+	to_visit.push(begin_node);
+
+	bool found = false;
+	while (!to_visit.is_empty()) {
+		const uint32_t node = to_visit.pop();
+		if (node == end_node) {
+			found = true;
+			break;
+		}
+
+		if (node == begin_node) {
+			const Cluster &cluster = clusters[begin_cluster];
+			for (uint32_t i = 0; i < cluster.entrances.size(); i++) {
+				const gd::Polygon &entrance = p_polygons[cluster.entrances[i]];
+				const float cost = begin_costs[polygon_local_indices[entrance.id]];
+				if (cost < FLT_MAX && (p_navigation_layers & entrance.owner->get_navigation_layers()) != 0) {
+					visit(cluster.first_entrance + i, node, cost);
+				}
+			}
+			continue;
+		}
+
+		const gd::Polygon &p = p_polygons[entrance_polygons[node]];
+		const uint32_t cluster_index = polygon_clusters[p.id];
+		const Cluster &cluster = clusters[cluster_index];
+		const uint32_t entrance_index = polygon_entrances[p.id];
+		const uint32_t entrances_count = cluster.entrances.size();
+
+		// The other entrances of the cluster.
+		for (uint32_t i = 0; i < entrances_count; i++) {
+			const float cost = cluster.entrance_costs[entrance_index * entrances_count + i];
+			if (i == entrance_index || cost == FLT_MAX) {
+				continue;
+			}
+			if ((p_navigation_layers & p_polygons[cluster.entrances[i]].owner->get_navigation_layers()) == 0) {
+				continue;
+			}
+			visit(cluster.first_entrance + i, node, costs[node] + cost);
+		}
+
+		// The end polygon, when it's in this cluster.
+		if (cluster_index == end_cluster) {
+			const float cost = end_costs[polygon_local_indices[p.id]];
+			if (cost < FLT_MAX) {
+				visit(end_node, node, costs[node] + cost);
+			}
+		}
+
+		// The entrances of the neighbour clusters.
+		for (uint32_t i = 0; i < p.edges.size(); i++) {
+			const gd::Edge &edge = p.edges[i];
+			for (int j = 0; j < edge.connections.size(); j++) {
+				const gd::Polygon &other = *edge.connections[j].polygon;
+				const uint32_t other_cluster = polygon_clusters[other.id];
+				if (other_cluster == cluster_index || (p_navigation_layers & other.owner->get_navigation_layers()) == 0) {
+					continue;
+				}
+				visit(clusters[other_cluster].first_entrance + polygon_entrances[other.id], node, costs[node] + get_connection_cost(p, other));
+			}
+		}
+	}
+
+	if (!found) {
+		return false;
+	}
+
+	r_corridor.resize(clusters.size());
+	for (uint32_t i = 0; i < r_corridor.size(); i++) {
+		r_corridor[i] = 0;
+	}
+	r_corridor[begin_cluster] = 1;
+	r_corridor[end_cluster] = 1;
+	for (uint32_t node = back_nodes[end_node]; node != begin_node; node = back_nodes[node]) {
+		r_corridor[polygon_clusters[entrance_polygons[node]]] = 1;
+	}
+
+	return true;
+}
@@ -0,0 +1,100 @@
+/*************************************************************************/
+/*  nav_map_hierarchy.h                                                  */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2022 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2022 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef NAV_MAP_HIERARCHY_H
+#define NAV_MAP_HIERARCHY_H
+
+#include "core/math/vector3i.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/local_vector.h"
+#include "nav_utils.h"
+
+// Clusters of polygons, grouped by the grid cell of their center, with the costs between the
+// entrances of each cluster precomputed. Long paths search this graph first, then only expand
+// the polygons of the clusters it crosses.
+class NavMapHierarchy {
+	struct Cluster {
+		Vector3i key;
+		// Hash of the polygons and connections, to reuse the costs of unchanged clusters.
+		uint32_t hash = 0;
+		// Map polygon IDs, in ascending order.
+		LocalVector<uint32_t> polygons;
+		// Polygons connected to another cluster.
+		LocalVector<uint32_t> entrances;
+		// Cost between each pair of entrances, FLT_MAX when not connected.
+		LocalVector<float> entrance_costs;
+		// First entrance of this cluster in the entrance graph.
+		uint32_t first_entrance = 0;
+	};
+
+	real_t cluster_size = 32.0;
+
+	LocalVector<Cluster> clusters;
+	HashMap<Vector3i, uint32_t> cluster_indices;
+
+	// Per map polygon: cluster, index in the cluster and entrance index (UINT32_MAX if none).
+	LocalVector<uint32_t> polygon_clusters;
+	LocalVector<uint32_t> polygon_local_indices;
+	LocalVector<uint32_t> polygon_entrances;
+
+	// Polygon of each node of the entrance graph.
+	LocalVector<uint32_t> entrance_polygons;
+	// Lowest travel cost of the map, keeps the heuristic admissible.
+	float min_travel_cost = 1.0;
+
+	Vector3i _get_cluster_key(const Vector3 &p_position) const;
+	uint32_t _hash_cluster(const LocalVector<gd::Polygon> &p_polygons, const Cluster &p_cluster) const;
+	// Cost from a polygon to every polygon of its cluster, or to it when p_reverse is set.
+	void _compute_cluster_costs(const LocalVector<gd::Polygon> &p_polygons, uint32_t p_polygon, bool p_reverse, gd::ClusterCostSearch &r_search) const;
+
+public:
+	static float get_connection_cost(const gd::Polygon &p_from, const gd::Polygon &p_to);
+
+	void set_cluster_size(real_t p_cluster_size);
+	real_t get_cluster_size() const {
+		return cluster_size;
+	}
+
+	void build(const LocalVector<gd::Polygon> &p_polygons);
+	void clear();
+
+	uint32_t get_cluster_count() const {
+		return clusters.size();
+	}
+	uint32_t get_polygon_cluster(uint32_t p_polygon_id) const {
+		return p_polygon_id < polygon_clusters.size() ? polygon_clusters[p_polygon_id] : UINT32_MAX;
+	}
+
+	// Marks in r_corridor the clusters crossed by the abstract path. The costs ignore the layers,
+	// so the corridor may not contain a valid path.
+	bool find_corridor(const LocalVector<gd::Polygon> &p_polygons, const gd::Polygon *p_begin_poly, const gd::Polygon *p_end_poly, uint32_t p_navigation_layers, gd::CorridorSearch &r_search, LocalVector<uint8_t> &r_corridor) const;
+};
+
+#endif // NAV_MAP_HIERARCHY_H
@@ -106,6 +106,9 @@ struct Polygon {
 
 	/// The center of this `Polygon`
 	Vector3 center;
+
+	/// The index of this `Polygon` in the map.
+	uint32_t id = 0;
 };
 
 struct NavigationPoly {
@@ -123,6 +126,10 @@ struct NavigationPoly {
 	Vector3 entry;
 	/// The distance to the destination.
 	float traveled_distance = 0.0;
+	/// Traveled plus estimated distance.
+	float total_cost = 0.0;
+	/// Position in the open list heap, or UINT32_MAX.
+	uint32_t heap_index = UINT32_MAX;
 
 	NavigationPoly() { poly = nullptr; }
 
@@ -138,6 +145,188 @@ struct NavigationPoly {
 	}
 };
 
+/// Ties are broken by id, so the search is deterministic.
+struct NavPolyTotalCostLessThan {
+	const LocalVector<NavigationPoly> *navigation_polys = nullptr;
+
+	NavPolyTotalCostLessThan(const LocalVector<NavigationPoly> *p_navigation_polys = nullptr) :
+			navigation_polys(p_navigation_polys) {}
+
+	bool operator()(uint32_t p_a, uint32_t p_b) const {
+		const NavigationPoly &a = (*navigation_polys)[p_a];
+		const NavigationPoly &b = (*navigation_polys)[p_b];
+		if (a.total_cost == b.total_cost) {
+			return p_a < p_b;
+		}
+		return a.total_cost < b.total_cost;
+	}
+};
+
+struct NavPolyHeapIndexer {
+	LocalVector<NavigationPoly> *navigation_polys = nullptr;
+
+	NavPolyHeapIndexer(LocalVector<NavigationPoly> *p_navigation_polys = nullptr) :
+			navigation_polys(p_navigation_polys) {}
+
+	void operator()(uint32_t p_id, uint32_t p_heap_index) const {
+		(*navigation_polys)[p_id].heap_index = p_heap_index;
+	}
+};
+
+/// Binary min-heap whose priorities can be decreased in place.
+template <class T, class LessThan, class Indexer>
+class Heap {
+	LocalVector<T> buffer;
+
+	LessThan _less_than;
+	Indexer _indexer;
+
+	void _shift_up(uint32_t p_index) {
+		T value = buffer[p_index];
+		while (p_index > 0) {
+			uint32_t parent = (p_index - 1) / 2;
+			if (!_less_than(value, buffer[parent])) {
+				break;
+			}
+			buffer[p_index] = buffer[parent];
+			_indexer(buffer[p_index], p_index);
+			p_index = parent;
+		}
+		buffer[p_index] = value;
+		_indexer(value, p_index);
+	}
+
+	void _shift_down(uint32_t p_index) {
+		T value = buffer[p_index];
+		const uint32_t size = buffer.size();
+		while (true) {
+			uint32_t child = p_index * 2 + 1;
+			if (child >= size) {
+				break;
+			}
+			if (child + 1 < size && _less_than(buffer[child + 1], buffer[child])) {
+				child++;
+			}
+			if (!_less_than(buffer[child], value)) {
+				break;
+			}
+			buffer[p_index] = buffer[child];
+			_indexer(buffer[p_index], p_index);
+			p_index = child;
+		}
+		buffer[p_index] = value;
+		_indexer(value, p_index);
+	}
+
+public:
+	void push(const T &p_value) {
+		buffer.push_back(p_value);
+		_shift_up(buffer.size() - 1);
+	}
+
+	T pop() {
+		T value = buffer[0];
+		_indexer(value, UINT32_MAX);
+		const T last = buffer[buffer.size() - 1];
+		buffer.remove_at(buffer.size() - 1);
+		if (!buffer.is_empty()) {
+			buffer[0] = last;
+			_shift_down(0);
+		}
+		return value;
+	}
+
+	void shift(uint32_t p_heap_index) {
+		_shift_up(p_heap_index);
+	}
+
+	void clear() {
+		for (uint32_t i = 0; i < buffer.size(); i++) {
+			_indexer(buffer[i], UINT32_MAX);
+		}
+		buffer.clear();
+	}
+
+	uint32_t size() const {
+		return buffer.size();
+	}
+
+	bool is_empty() const {
+		return buffer.is_empty();
+	}
+
+	Heap(const LessThan &p_less_than, const Indexer &p_indexer) :
+			_less_than(p_less_than),
+			_indexer(p_indexer) {}
+};
+
+struct NavHierarchyCostLessThan {
+	const LocalVector<float> *costs = nullptr;
+
+	NavHierarchyCostLessThan(const LocalVector<float> *p_costs = nullptr) :
+			costs(p_costs) {}
+
+	bool operator()(uint32_t p_a, uint32_t p_b) const {
+		const float a = (*costs)[p_a];
+		const float b = (*costs)[p_b];
+		if (a == b) {
+			return p_a < p_b;
+		}
+		return a < b;
+	}
+};
+
+struct NavHierarchyHeapIndexer {
+	LocalVector<uint32_t> *heap_indices = nullptr;
+
+	NavHierarchyHeapIndexer(LocalVector<uint32_t> *p_heap_indices = nullptr) :
+			heap_indices(p_heap_indices) {}
+
+	void operator()(uint32_t p_id, uint32_t p_heap_index) const {
+		(*heap_indices)[p_id] = p_heap_index;
+	}
+};
+
+typedef Heap<uint32_t, NavHierarchyCostLessThan, NavHierarchyHeapIndexer> NavHierarchyHeap;
+
+/// Costs from a polygon to the others of its cluster.
+struct ClusterCostSearch {
+	LocalVector<float> costs;
+	LocalVector<uint32_t> heap_indices;
+	NavHierarchyHeap to_visit;
+
+	ClusterCostSearch() :
+			to_visit(NavHierarchyCostLessThan(&costs), NavHierarchyHeapIndexer(&heap_indices)) {}
+};
+
+/// The nodes are stamped with the pass that last reached them.
+struct CorridorSearch {
+	LocalVector<float> costs;
+	LocalVector<float> priorities;
+	LocalVector<uint32_t> back_nodes;
+	LocalVector<uint32_t> heap_indices;
+	LocalVector<uint32_t> passes;
+	uint32_t pass = 0;
+	NavHierarchyHeap to_visit;
+
+	ClusterCostSearch begin_costs;
+	ClusterCostSearch end_costs;
+
+	CorridorSearch() :
+			to_visit(NavHierarchyCostLessThan(&priorities), NavHierarchyHeapIndexer(&heap_indices)) {}
+};
+
+struct PathQueryScratch {
+	LocalVector<NavigationPoly> navigation_polys;
+	HashMap<uint32_t, uint32_t> polygon_navigation_ids;
+	Heap<uint32_t, NavPolyTotalCostLessThan, NavPolyHeapIndexer> to_visit;
+	LocalVector<uint8_t> corridor;
+	CorridorSearch corridor_search;
+
+	PathQueryScratch() :
+			to_visit(NavPolyTotalCostLessThan(&navigation_polys), NavPolyHeapIndexer(&navigation_polys)) {}
+};
+
 struct ClosestPointQueryResult {
 	Vector3 point;
 	Vector3 normal;
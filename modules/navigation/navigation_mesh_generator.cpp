@@ -33,6 +33,7 @@
 #include "navigation_mesh_generator.h"
 
 #include "core/math/convex_hull.h"
+#include "core/object/worker_thread_pool.h"
 #include "core/os/thread.h"
 #include "scene/3d/mesh_instance_3d.h"
 #include "scene/3d/multimesh_instance_3d.h"
@@ -467,14 +468,11 @@ void NavigationMeshGenerator::_parse_geometry(const Transform3D &p_navmesh_trans
 	}
 }
 
-void NavigationMeshGenerator::_convert_detail_mesh_to_native_navigation_mesh(const rcPolyMeshDetail *p_detail_mesh, Ref<NavigationMesh> p_nav_mesh) {
-	Vector<Vector3> nav_vertices;
-
+void NavigationMeshGenerator::_convert_detail_mesh(const rcPolyMeshDetail *p_detail_mesh, Vector<Vector3> &r_vertices, Vector<Vector<int>> &r_polygons) {
 	for (int i = 0; i < p_detail_mesh->nverts; i++) {
 		const float *v = &p_detail_mesh->verts[i * 3];
-		nav_vertices.push_back(Vector3(v[0], v[1], v[2]));
+		r_vertices.push_back(Vector3(v[0], v[1], v[2]));
 	}
-	p_nav_mesh->set_vertices(nav_vertices);
 
 	for (int i = 0; i < p_detail_mesh->nmeshes; i++) {
 		const unsigned int *m = &p_detail_mesh->meshes[i * 4];
@@ -489,40 +487,24 @@ void NavigationMeshGenerator::_convert_detail_mesh_to_native_navigation_mesh(con
 			nav_indices.write[0] = ((int)(bverts + tris[j * 4 + 0]));
 			nav_indices.write[1] = ((int)(bverts + tris[j * 4 + 2]));
 			nav_indices.write[2] = ((int)(bverts + tris[j * 4 + 1]));
-			p_nav_mesh->add_polygon(nav_indices);
+			r_polygons.push_back(nav_indices);
 		}
 	}
 }
 
-void NavigationMeshGenerator::_build_recast_navigation_mesh(
-		Ref<NavigationMesh> p_nav_mesh,
-#ifdef TOOLS_ENABLED
-		EditorProgress *ep,
-#endif
-		rcHeightfield *hf,
-		rcCompactHeightfield *chf,
-		rcContourSet *cset,
-		rcPolyMesh *poly_mesh,
-		rcPolyMeshDetail *detail_mesh,
-		Vector<float> &vertices,
-		Vector<int> &indices) {
-	rcContext ctx;
+void NavigationMeshGenerator::_convert_detail_mesh_to_native_navigation_mesh(const rcPolyMeshDetail *p_detail_mesh, Ref<NavigationMesh> p_nav_mesh) {
+	Vector<Vector3> nav_vertices;
+	Vector<Vector<int>> nav_polygons;
+	_convert_detail_mesh(p_detail_mesh, nav_vertices, nav_polygons);
 
-#ifdef TOOLS_ENABLED
-	if (ep) {
-		ep->step(TTR("Setting up Configuration..."), 1);
+	p_nav_mesh->set_vertices(nav_vertices);
+	for (int i = 0; i < nav_polygons.size(); i++) {
+		p_nav_mesh->add_polygon(nav_polygons[i]);
 	}
-#endif
-
-	const float *verts = vertices.ptr();
-	const int nverts = vertices.size() / 3;
-	const int *tris = indices.ptr();
-	const int ntris = indices.size() / 3;
-
-	float bmin[3], bmax[3];
-	rcCalcBounds(verts, nverts, bmin, bmax);
+}
 
-	rcConfig cfg;
+void NavigationMeshGenerator::_get_recast_config(Ref<NavigationMesh> p_nav_mesh, rcConfig &r_cfg) {
+	rcConfig &cfg = r_cfg;
 	memset(&cfg, 0, sizeof(cfg));
 
 	cfg.cs = p_nav_mesh->get_cell_size();
@@ -563,6 +545,38 @@ void NavigationMeshGenerator::_build_recast_navigation_mesh(
 	if (p_nav_mesh->get_cell_size() * p_nav_mesh->get_detail_sample_distance() < 0.1f) {
 		WARN_PRINT("Property detail_sample_distance is clamped to 0.1 world units as the resulting value from multiplying with cell_size is too low.");
 	}
+}
+
+void NavigationMeshGenerator::_build_recast_navigation_mesh(
+		Ref<NavigationMesh> p_nav_mesh,
+#ifdef TOOLS_ENABLED
+		EditorProgress *ep,
+#endif
+		rcHeightfield *hf,
+		rcCompactHeightfield *chf,
+		rcContourSet *cset,
+		rcPolyMesh *poly_mesh,
+		rcPolyMeshDetail *detail_mesh,
+		const Vector<float> &vertices,
+		const Vector<int> &indices) {
+	rcContext ctx;
+
+#ifdef TOOLS_ENABLED
+	if (ep) {
+		ep->step(TTR("Setting up Configuration..."), 1);
+	}
+#endif
+
+	const float *verts = vertices.ptr();
+	const int nverts = vertices.size() / 3;
+	const int *tris = indices.ptr();
+	const int ntris = indices.size() / 3;
+
+	float bmin[3], bmax[3];
+	rcCalcBounds(verts, nverts, bmin, bmax);
+
+	rcConfig cfg;
+	_get_recast_config(p_nav_mesh, cfg);
 
 	cfg.bmin[0] = bmin[0];
 	cfg.bmin[1] = bmin[1];
@@ -719,41 +733,307 @@ void NavigationMeshGenerator::_build_recast_navigation_mesh(
 	detail_mesh = nullptr;
 }
 
-NavigationMeshGenerator *NavigationMeshGenerator::get_singleton() {
-	return singleton;
+void NavigationMeshGenerator::_get_tile_settings(Ref<NavigationMesh> p_nav_mesh, const Vector<float> &p_vertices, TileCache &r_settings) {
+	rcConfig &cfg = r_settings.cfg;
+	_get_recast_config(p_nav_mesh, cfg);
+	cfg.tileSize = p_nav_mesh->get_tile_size();
+	cfg.borderSize = cfg.walkableRadius + 3;
+
+	r_settings.partition_type = p_nav_mesh->get_sample_partition_type();
+	r_settings.filter_low_hanging_obstacles = p_nav_mesh->get_filter_low_hanging_obstacles();
+	r_settings.filter_ledge_spans = p_nav_mesh->get_filter_ledge_spans();
+	r_settings.filter_walkable_low_height_spans = p_nav_mesh->get_filter_walkable_low_height_spans();
+
+	rcCalcBounds(p_vertices.ptr(), p_vertices.size() / 3, cfg.bmin, cfg.bmax);
+
+	AABB baking_aabb = p_nav_mesh->get_filter_baking_aabb();
+	if (!baking_aabb.has_no_volume()) {
+		baking_aabb.position += p_nav_mesh->get_filter_baking_aabb_offset();
+
+		cfg.bmin[0] = baking_aabb.position.x;
+		cfg.bmin[1] = baking_aabb.position.y;
+		cfg.bmin[2] = baking_aabb.position.z;
+		cfg.bmax[0] = baking_aabb.position.x + baking_aabb.size.x;
+		cfg.bmax[1] = baking_aabb.position.y + baking_aabb.size.y;
+		cfg.bmax[2] = baking_aabb.position.z + baking_aabb.size.z;
+	} else {
+		baking_aabb = AABB();
+	}
+	r_settings.filter_baking_aabb = baking_aabb;
+
+	// Snap the floor of the heightfields to the cell height, so tiles baked against different source geometry bounds still quantize heights the same way.
+	cfg.bmin[1] = Math::floor(cfg.bmin[1] / cfg.ch) * cfg.ch;
 }
 
-NavigationMeshGenerator::NavigationMeshGenerator() {
-	singleton = this;
+bool NavigationMeshGenerator::_has_same_tile_settings(const TileCache &p_a, const TileCache &p_b) {
+	// The bounds only tell which tiles exist, every other setting changes the output of all tiles.
+	rcConfig a = p_a.cfg;
+	rcConfig b = p_b.cfg;
+	for (int i = 0; i < 3; i++) {
+		a.bmin[i] = a.bmax[i] = 0.0f;
+		b.bmin[i] = b.bmax[i] = 0.0f;
+	}
+	return memcmp(&a, &b, sizeof(rcConfig)) == 0 &&
+			p_a.partition_type == p_b.partition_type &&
+			p_a.filter_low_hanging_obstacles == p_b.filter_low_hanging_obstacles &&
+			p_a.filter_ledge_spans == p_b.filter_ledge_spans &&
+			p_a.filter_walkable_low_height_spans == p_b.filter_walkable_low_height_spans &&
+			p_a.filter_baking_aabb == p_b.filter_baking_aabb;
 }
 
-NavigationMeshGenerator::~NavigationMeshGenerator() {
+void NavigationMeshGenerator::_build_recast_tile(TileBuildData *p_data, uint32_t p_index, rcHeightfield *&r_hf, rcCompactHeightfield *&r_chf, rcContourSet *&r_cset, rcPolyMesh *&r_poly_mesh, rcPolyMeshDetail *&r_detail_mesh) {
+	const LocalVector<int> &tile_indices = p_data->tile_indices[p_index];
+	if (tile_indices.is_empty()) {
+		return;
+	}
+
+	const TileCache *settings = p_data->settings;
+	rcConfig cfg = settings->cfg;
+
+	const Vector2i tile = p_data->tiles[p_index];
+	const float tile_world_size = cfg.tileSize * cfg.cs;
+	float tile_min_x = tile.x * tile_world_size;
+	float tile_min_z = tile.y * tile_world_size;
+	float tile_max_x = tile_min_x + tile_world_size;
+	float tile_max_z = tile_min_z + tile_world_size;
+
+	const AABB &baking_aabb = settings->filter_baking_aabb;
+	if (!baking_aabb.has_no_volume()) {
+		tile_min_x = MAX(tile_min_x, baking_aabb.position.x);
+		tile_min_z = MAX(tile_min_z, baking_aabb.position.z);
+		tile_max_x = MIN(tile_max_x, baking_aabb.position.x + baking_aabb.size.x);
+		tile_max_z = MIN(tile_max_z, baking_aabb.position.z + baking_aabb.size.z);
+		if (tile_min_x >= tile_max_x || tile_min_z >= tile_max_z) {
+			return;
+		}
+	}
+
+	// Rasterize a border around the tile so erosion and region building see the neighboring geometry.
+	// Recast strips the border again when building contours, so adjacent tiles meet exactly at the tile edge.
+	const float border_world_size = cfg.borderSize * cfg.cs;
+	cfg.bmin[0] = tile_min_x - border_world_size;
+	cfg.bmin[2] = tile_min_z - border_world_size;
+	cfg.bmax[0] = tile_max_x + border_world_size;
+	cfg.bmax[2] = tile_max_z + border_world_size;
+	rcCalcGridSize(cfg.bmin, cfg.bmax, cfg.cs, &cfg.width, &cfg.height);
+
+	rcContext ctx;
+
+	const float *verts = p_data->vertices;
+	const int nverts = p_data->vertex_count;
+	const int *tris = tile_indices.ptr();
+	const int ntris = tile_indices.size() / 3;
+
+	r_hf = rcAllocHeightfield();
+	ERR_FAIL_COND(!r_hf);
+	ERR_FAIL_COND(!rcCreateHeightfield(&ctx, *r_hf, cfg.width, cfg.height, cfg.bmin, cfg.bmax, cfg.cs, cfg.ch));
+
+	{
+		LocalVector<unsigned char> tri_areas;
+		tri_areas.resize(ntris);
+		memset(tri_areas.ptr(), 0, ntris * sizeof(unsigned char));
+		rcMarkWalkableTriangles(&ctx, cfg.walkableSlopeAngle, verts, nverts, tris, ntris, tri_areas.ptr());
+
+		ERR_FAIL_COND(!rcRasterizeTriangles(&ctx, verts, nverts, tris, tri_areas.ptr(), ntris, *r_hf, cfg.walkableClimb));
+	}
+
+	if (settings->filter_low_hanging_obstacles) {
+		rcFilterLowHangingWalkableObstacles(&ctx, cfg.walkableClimb, *r_hf);
+	}
+	if (settings->filter_ledge_spans) {
+		rcFilterLedgeSpans(&ctx, cfg.walkableHeight, cfg.walkableClimb, *r_hf);
+	}
+	if (settings->filter_walkable_low_height_spans) {
+		rcFilterWalkableLowHeightSpans(&ctx, cfg.walkableHeight, *r_hf);
+	}
+
+	r_chf = rcAllocCompactHeightfield();
+	ERR_FAIL_COND(!r_chf);
+	ERR_FAIL_COND(!rcBuildCompactHeightfield(&ctx, cfg.walkableHeight, cfg.walkableClimb, *r_hf, *r_chf));
+
+	rcFreeHeightField(r_hf);
+	r_hf = nullptr;
+
+	ERR_FAIL_COND(!rcErodeWalkableArea(&ctx, cfg.walkableRadius, *r_chf));
+
+	if (settings->partition_type == NavigationMesh::SAMPLE_PARTITION_WATERSHED) {
+		ERR_FAIL_COND(!rcBuildDistanceField(&ctx, *r_chf));
+		ERR_FAIL_COND(!rcBuildRegions(&ctx, *r_chf, cfg.borderSize, cfg.minRegionArea, cfg.mergeRegionArea));
+	} else if (settings->partition_type == NavigationMesh::SAMPLE_PARTITION_MONOTONE) {
+		ERR_FAIL_COND(!rcBuildRegionsMonotone(&ctx, *r_chf, cfg.borderSize, cfg.minRegionArea, cfg.mergeRegionArea));
+	} else {
+		ERR_FAIL_COND(!rcBuildLayerRegions(&ctx, *r_chf, cfg.borderSize, cfg.minRegionArea));
+	}
+
+	r_cset = rcAllocContourSet();
+	ERR_FAIL_COND(!r_cset);
+	ERR_FAIL_COND(!rcBuildContours(&ctx, *r_chf, cfg.maxSimplificationError, cfg.maxEdgeLen, *r_cset));
+	if (r_cset->nconts == 0) {
+		return;
+	}
+
+	r_poly_mesh = rcAllocPolyMesh();
+	ERR_FAIL_COND(!r_poly_mesh);
+	ERR_FAIL_COND(!rcBuildPolyMesh(&ctx, *r_cset, cfg.maxVertsPerPoly, *r_poly_mesh));
+
+	r_detail_mesh = rcAllocPolyMeshDetail();
+	ERR_FAIL_COND(!r_detail_mesh);
+	ERR_FAIL_COND(!rcBuildPolyMeshDetail(&ctx, *r_poly_mesh, *r_chf, cfg.detailSampleDist, cfg.detailSampleMaxError, *r_detail_mesh));
+
+	BakedTile &result = p_data->results[p_index];
+	_convert_detail_mesh(r_detail_mesh, result.vertices, result.polygons);
 }
 
-void NavigationMeshGenerator::bake(Ref<NavigationMesh> p_nav_mesh, Node *p_node) {
-	ERR_FAIL_COND_MSG(!p_nav_mesh.is_valid(), "Invalid navigation mesh.");
+void NavigationMeshGenerator::_build_tile_task(uint32_t p_index, TileBuildData *p_data) {
+	rcHeightfield *hf = nullptr;
+	rcCompactHeightfield *chf = nullptr;
+	rcContourSet *cset = nullptr;
+	rcPolyMesh *poly_mesh = nullptr;
+	rcPolyMeshDetail *detail_mesh = nullptr;
 
-#ifdef TOOLS_ENABLED
-	EditorProgress *ep(nullptr);
-	// FIXME
-#endif
-#if 0
-	// After discussion on devchat disabled EditorProgress for now as it is not thread-safe and uses hacks and Main::iteration() for steps.
-	// EditorProgress randomly crashes the Engine when the bake function is used with a thread e.g. inside Editor with a tool script and procedural navigation
-	// This was not a problem in older versions as previously Godot was unable to (re)bake NavigationMesh at runtime.
-	// If EditorProgress is fixed and made thread-safe this should be enabled again.
-	if (Engine::get_singleton()->is_editor_hint()) {
-		ep = memnew(EditorProgress("bake", TTR("Navigation Mesh Generator Setup:"), 11));
+	_build_recast_tile(p_data, p_index, hf, chf, cset, poly_mesh, detail_mesh);
+
+	rcFreeHeightField(hf);
+	rcFreeCompactHeightfield(chf);
+	rcFreeContourSet(cset);
+	rcFreePolyMesh(poly_mesh);
+	rcFreePolyMeshDetail(detail_mesh);
+}
+
+void NavigationMeshGenerator::_build_tiles(Ref<NavigationMesh> p_nav_mesh, const Vector<float> &p_vertices, const Vector<int> &p_indices, const AABB *p_rebake_aabb) {
+	TileCache settings;
+	_get_tile_settings(p_nav_mesh, p_vertices, settings);
+
+	const ObjectID nav_mesh_id = p_nav_mesh->get_instance_id();
+
+	bool rebake = false;
+	if (p_rebake_aabb) {
+		MutexLock lock(tile_caches_mutex);
+		const TileCache *previous = tile_caches.getptr(nav_mesh_id);
+		// Tiles can only be reused when the heightfield floor does not move down, otherwise their heights would no longer match new tiles.
+		if (previous && _has_same_tile_settings(*previous, settings) && settings.cfg.bmin[1] >= previous->cfg.bmin[1]) {
+			settings.cfg.bmin[1] = previous->cfg.bmin[1];
+			settings.cfg.bmax[1] = MAX(settings.cfg.bmax[1], previous->cfg.bmax[1]);
+			settings.tiles = previous->tiles;
+			rebake = true;
+		}
 	}
 
-	if (ep) {
-		ep->step(TTR("Parsing Geometry..."), 0);
+	const rcConfig &cfg = settings.cfg;
+	const float tile_world_size = cfg.tileSize * cfg.cs;
+	const float border_world_size = cfg.borderSize * cfg.cs;
+
+	Vector2i from(Math::floor(cfg.bmin[0] / tile_world_size), Math::floor(cfg.bmin[2] / tile_world_size));
+	Vector2i to(Math::floor(cfg.bmax[0] / tile_world_size), Math::floor(cfg.bmax[2] / tile_world_size));
+	if (rebake) {
+		// Geometry within the border of a tile affects it too, and tiles outside of the current bounds may have lost all their geometry.
+		from.x = Math::floor((p_rebake_aabb->position.x - border_world_size) / tile_world_size);
+		from.y = Math::floor((p_rebake_aabb->position.z - border_world_size) / tile_world_size);
+		to.x = Math::floor((p_rebake_aabb->position.x + p_rebake_aabb->size.x + border_world_size) / tile_world_size);
+		to.y = Math::floor((p_rebake_aabb->position.z + p_rebake_aabb->size.z + border_world_size) / tile_world_size);
 	}
-#endif
+	ERR_FAIL_COND_MSG((int64_t)(to.x - from.x + 1) * (int64_t)(to.y - from.y + 1) > 1 << 20, "NavigationMesh tile_size is too small for the size of the source geometry.");
 
-	Vector<float> vertices;
-	Vector<int> indices;
+	TileBuildData data;
+	data.settings = &settings;
+	data.vertices = p_vertices.ptr();
+	data.vertex_count = p_vertices.size() / 3;
 
+	const int tiles_width = to.x - from.x + 1;
+	for (int z = from.y; z <= to.y; z++) {
+		for (int x = from.x; x <= to.x; x++) {
+			data.tiles.push_back(Vector2i(x, z));
+		}
+	}
+	data.tile_indices.resize(data.tiles.size());
+	data.results.resize(data.tiles.size());
+
+	// Bucket the triangles by the tiles they overlap including their borders, so each tile only rasterizes its own geometry.
+	const float *verts = p_vertices.ptr();
+	const int *tris = p_indices.ptr();
+	for (int i = 0; i < p_indices.size(); i += 3) {
+		float min_x = verts[tris[i] * 3 + 0];
+		float min_z = verts[tris[i] * 3 + 2];
+		float max_x = min_x;
+		float max_z = min_z;
+		for (int j = 1; j < 3; j++) {
+			const float *v = &verts[tris[i + j] * 3];
+			min_x = MIN(min_x, v[0]);
+			min_z = MIN(min_z, v[2]);
+			max_x = MAX(max_x, v[0]);
+			max_z = MAX(max_z, v[2]);
+		}
+
+		const int tile_from_x = MAX(from.x, (int)Math::floor((min_x - border_world_size) / tile_world_size));
+		const int tile_from_z = MAX(from.y, (int)Math::floor((min_z - border_world_size) / tile_world_size));
+		const int tile_to_x = MIN(to.x, (int)Math::floor((max_x + border_world_size) / tile_world_size));
+		const int tile_to_z = MIN(to.y, (int)Math::floor((max_z + border_world_size) / tile_world_size));
+		for (int z = tile_from_z; z <= tile_to_z; z++) {
+			for (int x = tile_from_x; x <= tile_to_x; x++) {
+				LocalVector<int> &tile_indices = data.tile_indices[(z - from.y) * tiles_width + (x - from.x)];
+				tile_indices.push_back(tris[i + 0]);
+				tile_indices.push_back(tris[i + 1]);
+				tile_indices.push_back(tris[i + 2]);
+			}
+		}
+	}
+
+	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &NavigationMeshGenerator::_build_tile_task, &data, data.tiles.size(), -1, true, SNAME("NavigationMeshTiles"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+
+	if (!rebake) {
+		settings.tiles.clear();
+	}
+	for (uint32_t i = 0; i < data.tiles.size(); i++) {
+		if (data.results[i].polygons.is_empty()) {
+			settings.tiles.erase(data.tiles[i]);
+		} else {
+			settings.tiles[data.tiles[i]] = data.results[i];
+		}
+	}
+
+	// Tiles keep their own vertices, the vertices shared by neighboring tiles are merged when the map connects polygon edges.
+	Vector<Vector3> nav_vertices;
+	p_nav_mesh->clear_polygons();
+	for (const KeyValue<Vector2i, BakedTile> &E : settings.tiles) {
+		const int vertex_offset = nav_vertices.size();
+		nav_vertices.append_array(E.value.vertices);
+		for (int i = 0; i < E.value.polygons.size(); i++) {
+			Vector<int> nav_indices = E.value.polygons[i];
+			for (int j = 0; j < nav_indices.size(); j++) {
+				nav_indices.write[j] += vertex_offset;
+			}
+			p_nav_mesh->add_polygon(nav_indices);
+		}
+	}
+	p_nav_mesh->set_vertices(nav_vertices);
+
+	MutexLock lock(tile_caches_mutex);
+	// Drop the tiles of navigation meshes that were freed since their last bake.
+	LocalVector<ObjectID> freed_nav_meshes;
+	for (const KeyValue<ObjectID, TileCache> &E : tile_caches) {
+		if (!ObjectDB::get_instance(E.key)) {
+			freed_nav_meshes.push_back(E.key);
+		}
+	}
+	for (uint32_t i = 0; i < freed_nav_meshes.size(); i++) {
+		tile_caches.erase(freed_nav_meshes[i]);
+	}
+	tile_caches[nav_mesh_id] = settings;
+}
+
+NavigationMeshGenerator *NavigationMeshGenerator::get_singleton() {
+	return singleton;
+}
+
+NavigationMeshGenerator::NavigationMeshGenerator() {
+	singleton = this;
+}
+
+NavigationMeshGenerator::~NavigationMeshGenerator() {
+}
+
+void NavigationMeshGenerator::_parse_source_geometry(Ref<NavigationMesh> p_nav_mesh, Node *p_node, Vector<float> &r_vertices, Vector<int> &r_indices) {
 	List<Node *> parse_nodes;
 
 	if (p_nav_mesh->get_source_geometry_mode() == NavigationMesh::SOURCE_GEOMETRY_NAVMESH_CHILDREN) {
@@ -767,10 +1047,30 @@ void NavigationMeshGenerator::bake(Ref<NavigationMesh> p_nav_mesh, Node *p_node)
 		NavigationMesh::ParsedGeometryType geometry_type = p_nav_mesh->get_parsed_geometry_type();
 		uint32_t collision_mask = p_nav_mesh->get_collision_mask();
 		bool recurse_children = p_nav_mesh->get_source_geometry_mode() != NavigationMesh::SOURCE_GEOMETRY_GROUPS_EXPLICIT;
-		_parse_geometry(navmesh_xform, E, vertices, indices, geometry_type, collision_mask, recurse_children);
+		_parse_geometry(navmesh_xform, E, r_vertices, r_indices, geometry_type, collision_mask, recurse_children);
 	}
+}
 
-	if (vertices.size() > 0 && indices.size() > 0) {
+void NavigationMeshGenerator::_bake_from_source_geometry(
+		Ref<NavigationMesh> p_nav_mesh,
+#ifdef TOOLS_ENABLED
+		EditorProgress *ep,
+#endif
+		const Vector<float> &p_vertices,
+		const Vector<int> &p_indices) {
+	if (p_nav_mesh->get_tile_size() > 0) {
+		if (p_vertices.size() > 0 && p_indices.size() > 0) {
+			_build_tiles(p_nav_mesh, p_vertices, p_indices, nullptr);
+		}
+		return;
+	}
+
+	{
+		MutexLock lock(tile_caches_mutex);
+		tile_caches.erase(p_nav_mesh->get_instance_id());
+	}
+
+	if (p_vertices.size() > 0 && p_indices.size() > 0) {
 		rcHeightfield *hf = nullptr;
 		rcCompactHeightfield *chf = nullptr;
 		rcContourSet *cset = nullptr;
@@ -787,8 +1087,8 @@ void NavigationMeshGenerator::bake(Ref<NavigationMesh> p_nav_mesh, Node *p_node)
 				cset,
 				poly_mesh,
 				detail_mesh,
-				vertices,
-				indices);
+				p_vertices,
+				p_indices);
 
 		rcFreeHeightField(hf);
 		hf = nullptr;
@@ -805,6 +1105,40 @@ void NavigationMeshGenerator::bake(Ref<NavigationMesh> p_nav_mesh, Node *p_node)
 		rcFreePolyMeshDetail(detail_mesh);
 		detail_mesh = nullptr;
 	}
+}
+
+void NavigationMeshGenerator::bake(Ref<NavigationMesh> p_nav_mesh, Node *p_node) {
+	ERR_FAIL_COND_MSG(!p_nav_mesh.is_valid(), "Invalid navigation mesh.");
+
+#ifdef TOOLS_ENABLED
+	EditorProgress *ep(nullptr);
+	// FIXME
+#endif
+#if 0
+	// After discussion on devchat disabled EditorProgress for now as it is not thread-safe and uses hacks and Main::iteration() for steps.
+	// EditorProgress randomly crashes the Engine when the bake function is used with a thread e.g. inside Editor with a tool script and procedural navigation
+	// This was not a problem in older versions as previously Godot was unable to (re)bake NavigationMesh at runtime.
+	// If EditorProgress is fixed and made thread-safe this should be enabled again.
+	if (Engine::get_singleton()->is_editor_hint()) {
+		ep = memnew(EditorProgress("bake", TTR("Navigation Mesh Generator Setup:"), 11));
+	}
+
+	if (ep) {
+		ep->step(TTR("Parsing Geometry..."), 0);
+	}
+#endif
+
+	Vector<float> vertices;
+	Vector<int> indices;
+
+	_parse_source_geometry(p_nav_mesh, p_node, vertices, indices);
+	_bake_from_source_geometry(
+			p_nav_mesh,
+#ifdef TOOLS_ENABLED
+			ep,
+#endif
+			vertices,
+			indices);
 
 #ifdef TOOLS_ENABLED
 	if (ep) {
@@ -821,12 +1155,72 @@ void NavigationMeshGenerator::clear(Ref<NavigationMesh> p_nav_mesh) {
 	if (p_nav_mesh.is_valid()) {
 		p_nav_mesh->clear_polygons();
 		p_nav_mesh->set_vertices(Vector<Vector3>());
+
+		MutexLock lock(tile_caches_mutex);
+		tile_caches.erase(p_nav_mesh->get_instance_id());
 	}
 }
 
+PackedVector3Array NavigationMeshGenerator::parse_source_geometry(Ref<NavigationMesh> p_nav_mesh, Node *p_node) {
+	PackedVector3Array faces;
+	ERR_FAIL_COND_V_MSG(!p_nav_mesh.is_valid(), faces, "Invalid navigation mesh.");
+	ERR_FAIL_NULL_V(p_node, faces);
+
+	Vector<float> vertices;
+	Vector<int> indices;
+	_parse_source_geometry(p_nav_mesh, p_node, vertices, indices);
+
+	// Return the faces in Godot's winding order, _add_faces() flips them back for Recast.
+	faces.resize(indices.size());
+	Vector3 *faces_ptrw = faces.ptrw();
+	const float *vertices_ptr = vertices.ptr();
+	const int *indices_ptr = indices.ptr();
+	for (int i = 0; i < indices.size(); i += 3) {
+		for (int j = 0; j < 3; j++) {
+			const float *v = &vertices_ptr[indices_ptr[i + (3 - j) % 3] * 3];
+			faces_ptrw[i + j] = Vector3(v[0], v[1], v[2]);
+		}
+	}
+	return faces;
+}
+
+void NavigationMeshGenerator::bake_from_source_geometry(Ref<NavigationMesh> p_nav_mesh, const PackedVector3Array &p_faces) {
+	ERR_FAIL_COND_MSG(!p_nav_mesh.is_valid(), "Invalid navigation mesh.");
+
+	Vector<float> vertices;
+	Vector<int> indices;
+	_add_faces(p_faces, Transform3D(), vertices, indices);
+
+	_bake_from_source_geometry(
+			p_nav_mesh,
+#ifdef TOOLS_ENABLED
+			nullptr,
+#endif
+			vertices,
+			indices);
+}
+
+void NavigationMeshGenerator::rebake_tiles(Ref<NavigationMesh> p_nav_mesh, const PackedVector3Array &p_faces, const AABB &p_aabb) {
+	ERR_FAIL_COND_MSG(!p_nav_mesh.is_valid(), "Invalid navigation mesh.");
+
+	if (p_nav_mesh->get_tile_size() <= 0 || p_faces.is_empty()) {
+		bake_from_source_geometry(p_nav_mesh, p_faces);
+		return;
+	}
+
+	Vector<float> vertices;
+	Vector<int> indices;
+	_add_faces(p_faces, Transform3D(), vertices, indices);
+
+	_build_tiles(p_nav_mesh, vertices, indices, &p_aabb);
+}
+
 void NavigationMeshGenerator::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("bake", "nav_mesh", "root_node"), &NavigationMeshGenerator::bake);
 	ClassDB::bind_method(D_METHOD("clear", "nav_mesh"), &NavigationMeshGenerator::clear);
+	ClassDB::bind_method(D_METHOD("parse_source_geometry", "nav_mesh", "root_node"), &NavigationMeshGenerator::parse_source_geometry);
+	ClassDB::bind_method(D_METHOD("bake_from_source_geometry", "nav_mesh", "source_geometry"), &NavigationMeshGenerator::bake_from_source_geometry);
+	ClassDB::bind_method(D_METHOD("rebake_tiles", "nav_mesh", "source_geometry", "aabb"), &NavigationMeshGenerator::rebake_tiles);
 }
 
 #endif
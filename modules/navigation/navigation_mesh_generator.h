@@ -33,6 +33,9 @@
 
 #ifndef _3D_DISABLED
 
+#include "core/os/mutex.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/local_vector.h"
 #include "scene/3d/navigation_region_3d.h"
 
 #include <Recast.h>
@@ -46,6 +49,35 @@ class NavigationMeshGenerator : public Object {
 
 	static NavigationMeshGenerator *singleton;
 
+	// Kept so later rebakes can reuse it.
+	struct BakedTile {
+		Vector<Vector3> vertices;
+		Vector<Vector<int>> polygons;
+	};
+
+	// Baked tiles of a NavigationMesh and the settings they were built with.
+	struct TileCache {
+		rcConfig cfg;
+		NavigationMesh::SamplePartitionType partition_type = NavigationMesh::SAMPLE_PARTITION_WATERSHED;
+		bool filter_low_hanging_obstacles = false;
+		bool filter_ledge_spans = false;
+		bool filter_walkable_low_height_spans = false;
+		AABB filter_baking_aabb;
+		HashMap<Vector2i, BakedTile> tiles;
+	};
+
+	struct TileBuildData {
+		const TileCache *settings = nullptr;
+		const float *vertices = nullptr;
+		int vertex_count = 0;
+		LocalVector<Vector2i> tiles;
+		LocalVector<LocalVector<int>> tile_indices;
+		LocalVector<BakedTile> results;
+	};
+
+	Mutex tile_caches_mutex;
+	HashMap<ObjectID, TileCache> tile_caches;
+
 protected:
 	static void _bind_methods();
 
@@ -55,6 +87,7 @@ protected:
 	static void _add_faces(const PackedVector3Array &p_faces, const Transform3D &p_xform, Vector<float> &p_vertices, Vector<int> &p_indices);
 	static void _parse_geometry(const Transform3D &p_navmesh_transform, Node *p_node, Vector<float> &p_vertices, Vector<int> &p_indices, NavigationMesh::ParsedGeometryType p_generate_from, uint32_t p_collision_mask, bool p_recurse_children);
 
+	static void _convert_detail_mesh(const rcPolyMeshDetail *p_detail_mesh, Vector<Vector3> &r_vertices, Vector<Vector<int>> &r_polygons);
 	static void _convert_detail_mesh_to_native_navigation_mesh(const rcPolyMeshDetail *p_detail_mesh, Ref<NavigationMesh> p_nav_mesh);
 	static void _build_recast_navigation_mesh(
 			Ref<NavigationMesh> p_nav_mesh,
@@ -66,8 +99,24 @@ protected:
 			rcContourSet *cset,
 			rcPolyMesh *poly_mesh,
 			rcPolyMeshDetail *detail_mesh,
-			Vector<float> &vertices,
-			Vector<int> &indices);
+			const Vector<float> &vertices,
+			const Vector<int> &indices);
+
+	static void _get_recast_config(Ref<NavigationMesh> p_nav_mesh, rcConfig &r_cfg);
+	static void _get_tile_settings(Ref<NavigationMesh> p_nav_mesh, const Vector<float> &p_vertices, TileCache &r_settings);
+	static bool _has_same_tile_settings(const TileCache &p_a, const TileCache &p_b);
+	static void _build_recast_tile(TileBuildData *p_data, uint32_t p_index, rcHeightfield *&r_hf, rcCompactHeightfield *&r_chf, rcContourSet *&r_cset, rcPolyMesh *&r_poly_mesh, rcPolyMeshDetail *&r_detail_mesh);
+	void _build_tile_task(uint32_t p_index, TileBuildData *p_data);
+	void _build_tiles(Ref<NavigationMesh> p_nav_mesh, const Vector<float> &p_vertices, const Vector<int> &p_indices, const AABB *p_rebake_aabb);
+
+	void _parse_source_geometry(Ref<NavigationMesh> p_nav_mesh, Node *p_node, Vector<float> &r_vertices, Vector<int> &r_indices);
+	void _bake_from_source_geometry(
+			Ref<NavigationMesh> p_nav_mesh,
+#ifdef TOOLS_ENABLED
+			EditorProgress *ep,
+#endif
+			const Vector<float> &p_vertices,
+			const Vector<int> &p_indices);
 
 public:
 	static NavigationMeshGenerator *get_singleton();
@@ -77,6 +126,13 @@ public:
 
 	void bake(Ref<NavigationMesh> p_nav_mesh, Node *p_node);
 	void clear(Ref<NavigationMesh> p_nav_mesh);
+
+	// Touches the SceneTree, call it on the main thread.
+	PackedVector3Array parse_source_geometry(Ref<NavigationMesh> p_nav_mesh, Node *p_node);
+	// Doesn't access any node, can run on any thread.
+	void bake_from_source_geometry(Ref<NavigationMesh> p_nav_mesh, const PackedVector3Array &p_faces);
+	// Only rebakes the tiles touched by p_aabb.
+	void rebake_tiles(Ref<NavigationMesh> p_nav_mesh, const PackedVector3Array &p_faces, const AABB &p_aabb);
 };
 
 #endif
@@ -70,6 +70,124 @@ static Array _sanitize_node_pinned_properties(Node *p_node) {
 	return pinned;
 }
 
+StringName SceneState::_get_root_type() const {
+	if (nodes.is_empty()) {
+		return StringName();
+	}
+
+	int scene_idx = -1;
+	if (base_scene_idx >= 0) {
+		scene_idx = base_scene_idx;
+	} else if (nodes[0].instance >= 0 && !(nodes[0].instance & FLAG_INSTANCE_IS_PLACEHOLDER)) {
+		scene_idx = nodes[0].instance & FLAG_MASK;
+	} else if (nodes[0].instance < 0 && nodes[0].type != TYPE_INSTANCED && nodes[0].type < names.size()) {
+		return names[nodes[0].type];
+	}
+
+	if (scene_idx < 0 || scene_idx >= variants.size()) {
+		return StringName();
+	}
+	Ref<PackedScene> sdata = variants[scene_idx];
+	if (sdata.is_null()) {
+		return StringName();
+	}
+	return sdata->get_state()->_get_root_type();
+}
+
+void SceneState::_build_instantiation_plan() const {
+	InstantiationPlan &plan = instantiation_plan;
+	plan.nodes.resize(nodes.size());
+	plan.properties.clear();
+	plan.connection_binds.resize(connections.size());
+
+	ClassDB::lock.read_lock();
+
+	for (int i = 0; i < nodes.size(); i++) {
+		const NodeData &n = nodes[i];
+		InstantiationPlan::NodePlan &node_plan = plan.nodes[i];
+		node_plan.class_info = nullptr;
+		node_plan.setter_class = StringName();
+		node_plan.first_property = plan.properties.size();
+
+		if (i == 0 && base_scene_idx >= 0) {
+			node_plan.setter_class = _get_root_type();
+		} else if (n.instance >= 0) {
+			if (!(n.instance & FLAG_INSTANCE_IS_PLACEHOLDER) && (n.instance & FLAG_MASK) < variants.size()) {
+				Ref<PackedScene> sdata = variants[n.instance & FLAG_MASK];
+				if (sdata.is_valid()) {
+					node_plan.setter_class = sdata->get_state()->_get_root_type();
+				}
+			}
+		} else if (n.type != TYPE_INSTANCED && n.type < names.size()) {
+			// Other classes, or ones that can't be created right now, go through ClassDB::instantiate() to report why.
+			ClassDB::ClassInfo *ti = ClassDB::classes.getptr(names[n.type]);
+			if (ti && !ti->disabled && ti->creation_func && !ti->native_extension && ti->api != ClassDB::API_EDITOR) {
+				node_plan.class_info = ti;
+				node_plan.setter_class = names[n.type];
+			}
+		}
+
+		// Native classes only, extension instances may handle any property first.
+		if (node_plan.setter_class != StringName()) {
+			const ClassDB::ClassInfo *ti = ClassDB::classes.getptr(node_plan.setter_class);
+			for (const ClassDB::ClassInfo *check = ti; check; check = check->inherits_ptr) {
+				if (check->native_extension) {
+					node_plan.setter_class = StringName();
+					break;
+				}
+			}
+		}
+
+		for (int j = 0; j < n.properties.size(); j++) {
+			const NodeData::Property &prop = n.properties[j];
+			InstantiationPlan::PropertyPlan property_plan;
+
+			if (prop.value >= 0 && prop.value < variants.size()) {
+				const Variant &value = variants[prop.value];
+				property_plan.is_object = value.get_type() == Variant::OBJECT;
+				property_plan.is_missing_resource = property_plan.is_object && Object::cast_to<MissingResource>(value.get_validated_object()) != nullptr;
+			}
+
+			if (node_plan.setter_class != StringName() && !(prop.name & FLAG_PATH_PROPERTY_IS_NODE) && prop.name >= 0 && prop.name < names.size()) {
+				// Same lookup as ClassDB::set_property(), the properties without a setter bound directly are set by name.
+				const ClassDB::ClassInfo *check = ClassDB::classes.getptr(node_plan.setter_class);
+				while (check) {
+					const ClassDB::PropertySetGet *psg = check->property_setget.getptr(names[prop.name]);
+					if (psg) {
+						property_plan.setter = psg->_setptr;
+						property_plan.setter_index = psg->index;
+						break;
+					}
+					check = check->inherits_ptr;
+				}
+			}
+
+			plan.properties.push_back(property_plan);
+		}
+	}
+
+	ClassDB::lock.read_unlock();
+
+	for (int i = 0; i < connections.size(); i++) {
+		const ConnectionData &c = connections[i];
+		Vector<Variant> &binds = plan.connection_binds[i];
+		binds.clear();
+		if (c.unbinds > 0) {
+			continue;
+		}
+		for (int j = 0; j < c.binds.size(); j++) {
+			ERR_CONTINUE(c.binds[j] < 0 || c.binds[j] >= variants.size());
+			binds.push_back(variants[c.binds[j]]);
+		}
+	}
+}
+
+void SceneState::_clear_instantiation_plan() {
+	MutexLock lock(instantiation_plan_mutex);
+	instantiation_plan_ready.clear();
+	instantiation_plan = InstantiationPlan();
+}
+
 Node *SceneState::instantiate(GenEditState p_edit_state) const {
 	// nodes where instancing failed (because something is missing)
 	List<Node *> stray_instances;
@@ -87,6 +205,18 @@ Node *SceneState::instantiate(GenEditState p_edit_state) const {
 	int nc = nodes.size();
 	ERR_FAIL_COND_V(nc == 0, nullptr);
 
+	if (!instantiation_plan_ready.is_set()) {
+		MutexLock lock(instantiation_plan_mutex);
+		if (!instantiation_plan_ready.is_set()) {
+			_build_instantiation_plan();
+			instantiation_plan_ready.set();
+		}
+	}
+	const InstantiationPlan &plan = instantiation_plan;
+
+	// The setters are called directly at runtime only, Object::set() also keeps track of the edits for the editor.
+	const bool use_setters = p_edit_state == GEN_EDIT_STATE_DISABLED;
+
 	const StringName *snames = nullptr;
 	int sname_count = names.size();
 	if (sname_count) {
@@ -113,6 +243,7 @@ Node *SceneState::instantiate(GenEditState p_edit_state) const {
 
 	for (int i = 0; i < nc; i++) {
 		const NodeData &n = nd[i];
+		const InstantiationPlan::NodePlan &node_plan = plan.nodes[i];
 
 		Node *parent = nullptr;
 		String old_parent_path;
@@ -181,7 +312,12 @@ Node *SceneState::instantiate(GenEditState p_edit_state) const {
 			}
 		} else {
 			//node belongs to this scene and must be created
-			Object *obj = ClassDB::instantiate(snames[n.type]);
+			Object *obj = nullptr;
+			if (node_plan.class_info && !node_plan.class_info->disabled) {
+				obj = node_plan.class_info->creation_func();
+			} else {
+				obj = ClassDB::instantiate(snames[n.type]);
+			}
 
 			node = Object::cast_to<Node>(obj);
 
@@ -228,6 +364,8 @@ Node *SceneState::instantiate(GenEditState p_edit_state) const {
 			int nprop_count = n.properties.size();
 			if (nprop_count) {
 				const NodeData::Property *nprops = &n.properties[0];
+				const InstantiationPlan::PropertyPlan *nprop_plans = &plan.properties[node_plan.first_property];
+				const bool use_node_setters = use_setters && node_plan.setter_class != StringName() && node->get_class_name() == node_plan.setter_class;
 
 				Dictionary missing_resource_properties;
 
@@ -272,9 +410,14 @@ Node *SceneState::instantiate(GenEditState p_edit_state) const {
 							node->set(E.first, E.second);
 						}
 					} else {
-						Variant value = props[nprops[j].value];
-
-						if (value.get_type() == Variant::OBJECT) {
+						const InstantiationPlan::PropertyPlan &property_plan = nprop_plans[j];
+						// Most values are passed as they are stored, only the ones to replace are copied.
+						const Variant *value_ptr = &props[nprops[j].value];
+						Variant value;
+
+						if (property_plan.is_object) {
+							value = *value_ptr;
+							value_ptr = &value;
 							//handle resources that are local to scene by duplicating them if needed
 							Ref<Resource> res = value;
 							if (res.is_valid()) {
@@ -304,11 +447,12 @@ Node *SceneState::instantiate(GenEditState p_edit_state) const {
 								}
 							}
 						} else if (p_edit_state == GEN_EDIT_STATE_INSTANCE) {
-							value = value.duplicate(true); // Duplicate arrays and dictionaries for the editor
+							value = value_ptr->duplicate(true); // Duplicate arrays and dictionaries for the editor
+							value_ptr = &value;
 						}
 
 						bool set_valid = true;
-						if (ResourceLoader::is_creating_missing_resources_if_class_unavailable_enabled() && value.get_type() == Variant::OBJECT) {
+						if (property_plan.is_missing_resource && ResourceLoader::is_creating_missing_resources_if_class_unavailable_enabled()) {
 							Ref<MissingResource> mr = value;
 							if (mr.is_valid()) {
 								missing_resource_properties[snames[nprops[j].name]] = mr;
@@ -316,8 +460,22 @@ Node *SceneState::instantiate(GenEditState p_edit_state) const {
 							}
 						}
 
-						if (set_valid) {
-							node->set(snames[nprops[j].name], value, &valid);
+						if (!set_valid) {
+							continue;
+						}
+
+						if (use_node_setters && property_plan.setter && !node->get_script_instance()) {
+							// Same call as ClassDB::set_property(), a script could have handled the property first.
+							Callable::CallError ce;
+							if (property_plan.setter_index >= 0) {
+								Variant index = property_plan.setter_index;
+								const Variant *args[2] = { &index, value_ptr };
+								property_plan.setter->call(node, args, 2, ce);
+							} else {
+								property_plan.setter->call(node, &value_ptr, 1, ce);
+							}
+						} else {
+							node->set(snames[nprops[j].name], *value_ptr, &valid);
 						}
 					}
 				}
@@ -375,7 +533,7 @@ Node *SceneState::instantiate(GenEditState p_edit_state) const {
 			if (p_edit_state == GEN_EDIT_STATE_MAIN) {
 				_sanitize_node_pinned_properties(node);
 			} else {
-				node->remove_meta("_edit_pinned_properties_");
+				node->remove_meta(SNAME("_edit_pinned_properties_"));
 			}
 		}
 
@@ -422,13 +580,7 @@ Node *SceneState::instantiate(GenEditState p_edit_state) const {
 		if (c.unbinds > 0) {
 			callable = callable.unbind(c.unbinds);
 		} else if (!c.binds.is_empty()) {
-			Vector<Variant> binds;
-			if (c.binds.size()) {
-				binds.resize(c.binds.size());
-				for (int j = 0; j < c.binds.size(); j++) {
-					binds.write[j] = props[c.binds[j]];
-				}
-			}
+			const Vector<Variant> &binds = plan.connection_binds[i];
 
 			const Variant **argptrs = (const Variant **)alloca(sizeof(Variant *) * binds.size());
 			for (int j = 0; j < binds.size(); j++) {
@@ -982,6 +1134,7 @@ String SceneState::get_path() const {
 }
 
 void SceneState::clear() {
+	_clear_instantiation_plan();
 	names.clear();
 	variants.clear();
 	nodes.clear();
@@ -1147,6 +1300,8 @@ void SceneState::set_bundled_scene(const Dictionary &p_dictionary) {
 
 	ERR_FAIL_COND_MSG(version > PACKED_SCENE_VERSION, "Save format version too new.");
 
+	_clear_instantiation_plan();
+
 	const int node_count = p_dictionary["node_count"];
 	const Vector<int> snodes = p_dictionary["nodes"];
 	ERR_FAIL_COND(snodes.size() < node_count);
@@ -1601,6 +1756,7 @@ int SceneState::add_node(int p_parent, int p_owner, int p_type, int p_name, int
 	nd.instance = p_instance;
 	nd.index = p_index;
 
+	_clear_instantiation_plan();
 	nodes.push_back(nd);
 
 	return nodes.size() - 1;
@@ -1617,6 +1773,7 @@ void SceneState::add_node_property(int p_node, int p_name, int p_value, bool p_d
 		prop.name |= FLAG_PATH_PROPERTY_IS_NODE;
 	}
 	prop.value = p_value;
+	_clear_instantiation_plan();
 	nodes.write[p_node].properties.push_back(prop);
 }
 
@@ -1628,6 +1785,7 @@ void SceneState::add_node_group(int p_node, int p_group) {
 
 void SceneState::set_base_scene(int p_idx) {
 	ERR_FAIL_INDEX(p_idx, variants.size());
+	_clear_instantiation_plan();
 	base_scene_idx = p_idx;
 }
 
@@ -1646,6 +1804,7 @@ void SceneState::add_connection(int p_from, int p_to, int p_signal, int p_method
 	c.flags = p_flags;
 	c.unbinds = p_unbinds;
 	c.binds = p_binds;
+	_clear_instantiation_plan();
 	connections.push_back(c);
 }
 
@@ -32,6 +32,10 @@
 #define PACKED_SCENE_H
 
 #include "core/io/resource.h"
+#include "core/object/class_db.h"
+#include "core/os/mutex.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/safe_refcount.h"
 #include "scene/main/node.h"
 
 class SceneState : public RefCounted {
@@ -89,6 +93,36 @@ class SceneState : public RefCounted {
 
 	Vector<ConnectionData> connections;
 
+	// Resolved on the first instantiation and reused by the next ones.
+	struct InstantiationPlan {
+		struct NodePlan {
+			ClassDB::ClassInfo *class_info = nullptr;
+			// Class the setters were resolved for.
+			StringName setter_class;
+			uint32_t first_property = 0;
+		};
+
+		struct PropertyPlan {
+			// Null when set by name.
+			MethodBind *setter = nullptr;
+			int setter_index = -1;
+			bool is_object = false;
+			bool is_missing_resource = false;
+		};
+
+		LocalVector<NodePlan> nodes;
+		LocalVector<PropertyPlan> properties;
+		LocalVector<Vector<Variant>> connection_binds;
+	};
+
+	mutable InstantiationPlan instantiation_plan;
+	mutable SafeFlag instantiation_plan_ready;
+	mutable Mutex instantiation_plan_mutex;
+
+	StringName _get_root_type() const;
+	void _build_instantiation_plan() const;
+	void _clear_instantiation_plan();
+
 	Error _parse_node(Node *p_owner, Node *p_node, int p_parent_idx, HashMap<StringName, int> &name_map, HashMap<Variant, int, VariantHasher, VariantComparator> &variant_map, HashMap<Node *, int> &node_map, HashMap<Node *, int> &nodepath_map);
 	Error _parse_connections(Node *p_owner, Node *p_node, HashMap<StringName, int> &name_map, HashMap<Variant, int, VariantHasher, VariantComparator> &variant_map, HashMap<Node *, int> &node_map, HashMap<Node *, int> &nodepath_map);
 
@@ -156,8 +156,9 @@ Error ResourceLoaderText::_parse_ext_resource(VariantParser::Stream *p_stream, R
 
 		if (ext_resources[id].cache.is_valid()) {
 			r_res = ext_resources[id].cache;
-		} else if (use_sub_threads) {
+		} else if (ext_resources[id].requested) {
 			Ref<Resource> res = ResourceLoader::load_threaded_get(path);
+			ext_resources[id].requested = false;
 			if (res.is_null()) {
 				if (ResourceLoader::get_abort_on_missing_resources()) {
 					error = ERR_FILE_MISSING_DEPENDENCIES;
@@ -403,6 +404,16 @@ Ref<PackedScene> ResourceLoaderText::_parse_node_tag(VariantParser::ResourcePars
 	}
 }
 
+void ResourceLoaderText::_get_requested_ext_resources() {
+	// The dependencies nothing referenced were never retrieved, which they must be for their loads to be released.
+	for (KeyValue<String, ExtResource> &E : ext_resources) {
+		if (E.value.requested) {
+			E.value.cache = ResourceLoader::load_threaded_get(E.value.path);
+			E.value.requested = false;
+		}
+	}
+}
+
 Error ResourceLoaderText::load() {
 	if (error != OK) {
 		return error;
@@ -464,6 +475,7 @@ Error ResourceLoaderText::load() {
 
 		if (use_sub_threads) {
 			Error err = ResourceLoader::load_threaded_request(path, type, use_sub_threads, ResourceFormatLoader::CACHE_MODE_REUSE, local_path);
+			er.requested = err == OK;
 
 			if (err != OK) {
 				if (ResourceLoader::get_abort_on_missing_resources()) {
@@ -765,6 +777,8 @@ Error ResourceLoaderText::load() {
 			resource->set_meta(META_MISSING_RESOURCES, missing_resource_properties);
 		}
 
+		_get_requested_ext_resources();
+
 		error = OK;
 		if (progress && resources_total > 0) {
 			*progress = resource_current / float(resources_total);
@@ -789,6 +803,8 @@ Error ResourceLoaderText::load() {
 			return error;
 		}
 
+		_get_requested_ext_resources();
+
 		error = OK;
 		//get it here
 		resource = packed_scene;
@@ -891,7 +907,7 @@ Error ResourceLoaderText::rename_dependencies(Ref<FileAccess> p_f, const String
 
 	String base_path = local_path.get_base_dir();
 
-	uint64_t tag_end = f->get_position();
+	uint64_t tag_end = stream.get_position();
 
 	while (true) {
 		Error err = VariantParser::parse_tag(&stream, lines, error_text, next_tag, &rp);
@@ -961,7 +977,7 @@ Error ResourceLoaderText::rename_dependencies(Ref<FileAccess> p_f, const String
 			s += " path=\"" + path + "\" id=\"" + id + "\"]";
 			fw->store_line(s); // Bundled.
 
-			tag_end = f->get_position();
+			tag_end = stream.get_position();
 		}
 	}
 
@@ -51,6 +51,7 @@ class ResourceLoaderText {
 		Ref<Resource> cache;
 		String path;
 		String type;
+		bool requested = false; // Loading on another thread, not retrieved yet.
 	};
 
 	bool is_scene = false;
@@ -83,6 +84,7 @@ class ResourceLoaderText {
 
 	Error _parse_sub_resource(VariantParser::Stream *p_stream, Ref<Resource> &r_res, int &line, String &r_err_str);
 	Error _parse_ext_resource(VariantParser::Stream *p_stream, Ref<Resource> &r_res, int &line, String &r_err_str);
+	void _get_requested_ext_resources();
 
 	// for converter
 	class DummyResource : public Resource {
@@ -674,20 +674,33 @@ Ref<Image> CompressedTexture2D::load_image_from_file(Ref<FileAccess> f, int p_si
 				continue;
 			}
 
-			Vector<uint8_t> pv;
-			pv.resize(size);
-			{
-				uint8_t *wr = pv.ptrw();
-				f->get_buffer(wr, size);
-			}
-
 			Ref<Image> img;
-			if (data_format == DATA_FORMAT_BASIS_UNIVERSAL && Image::basis_universal_unpacker) {
-				img = Image::basis_universal_unpacker(pv);
-			} else if (data_format == DATA_FORMAT_PNG && Image::png_unpacker) {
-				img = Image::png_unpacker(pv);
-			} else if (data_format == DATA_FORMAT_WEBP && Image::webp_unpacker) {
-				img = Image::webp_unpacker(pv);
+
+			// When the file can be mapped, decode the mipmap in place instead of copying it first.
+			const uint8_t *view = f->get_buffer_view(size);
+			if (view) {
+				if (data_format == DATA_FORMAT_BASIS_UNIVERSAL && Image::basis_universal_unpacker_ptr) {
+					img = Image::basis_universal_unpacker_ptr(view, size);
+				} else if (data_format == DATA_FORMAT_PNG && Image::png_unpacker_ptr) {
+					img = Image::png_unpacker_ptr(view, size);
+				} else if (data_format == DATA_FORMAT_WEBP && Image::webp_unpacker_ptr) {
+					img = Image::webp_unpacker_ptr(view, size);
+				}
+			} else {
+				Vector<uint8_t> pv;
+				pv.resize(size);
+				{
+					uint8_t *wr = pv.ptrw();
+					f->get_buffer(wr, size);
+				}
+
+				if (data_format == DATA_FORMAT_BASIS_UNIVERSAL && Image::basis_universal_unpacker) {
+					img = Image::basis_universal_unpacker(pv);
+				} else if (data_format == DATA_FORMAT_PNG && Image::png_unpacker) {
+					img = Image::png_unpacker(pv);
+				} else if (data_format == DATA_FORMAT_WEBP && Image::webp_unpacker) {
+					img = Image::webp_unpacker(pv);
+				}
 			}
 
 			if (img.is_null() || img->is_empty()) {
@@ -85,9 +85,24 @@ public:
 	/// Returns the edge connection margin of this map.
 	virtual real_t map_get_edge_connection_margin(RID p_map) const = 0;
 
+	/// Set if the long paths are searched in a cluster graph first.
+	virtual void map_set_use_hierarchical_paths(RID p_map, bool p_enabled) const = 0;
+
+	/// Returns true if the map uses hierarchical path searches.
+	virtual bool map_get_use_hierarchical_paths(RID p_map) const = 0;
+
+	/// Set the size of the polygon clusters.
+	virtual void map_set_hierarchical_cluster_size(RID p_map, real_t p_cluster_size) const = 0;
+
+	/// Returns the size of the polygon clusters.
+	virtual real_t map_get_hierarchical_cluster_size(RID p_map) const = 0;
+
 	/// Returns the navigation path to reach the destination from the origin.
 	virtual Vector<Vector3> map_get_path(RID p_map, Vector3 p_origin, Vector3 p_destination, bool p_optimize, uint32_t p_navigation_layers = 1) const = 0;
 
+	/// Queues a path query, the callback is called after the next sync.
+	virtual void map_query_path(RID p_map, Vector3 p_origin, Vector3 p_destination, bool p_optimize, const Callable &p_callback, uint32_t p_navigation_layers = 1) const = 0;
+
 	virtual Vector3 map_get_closest_point_to_segment(RID p_map, const Vector3 &p_from, const Vector3 &p_to, const bool p_use_collision = false) const = 0;
 	virtual Vector3 map_get_closest_point(RID p_map, const Vector3 &p_point) const = 0;
 	virtual Vector3 map_get_closest_point_normal(RID p_map, const Vector3 &p_point) const = 0;
@@ -193,6 +208,28 @@ public:
 	/// Callback called at the end of the RVO process
 	virtual void agent_set_callback(RID p_agent, Object *p_receiver, StringName p_method, Variant p_udata = Variant()) const = 0;
 
+	/// Creates a flow field.
+	virtual RID flow_field_create() const = 0;
+
+	/// Put the flow field on the map.
+	virtual void flow_field_set_map(RID p_flow_field, RID p_map) const = 0;
+	virtual RID flow_field_get_map(RID p_flow_field) const = 0;
+
+	/// The positions the flow field leads to.
+	virtual void flow_field_set_goals(RID p_flow_field, Vector<Vector3> p_goals) const = 0;
+	virtual Vector<Vector3> flow_field_get_goals(RID p_flow_field) const = 0;
+
+	/// The navigation layers the flow field can cross.
+	virtual void flow_field_set_navigation_layers(RID p_flow_field, uint32_t p_navigation_layers) const = 0;
+	virtual uint32_t flow_field_get_navigation_layers(RID p_flow_field) const = 0;
+
+	/// Returns the direction to follow from the position toward the closest goal.
+	virtual Vector3 flow_field_get_direction(RID p_flow_field, Vector3 p_position) const = 0;
+	/// Returns the direction to follow from each of the positions.
+	virtual Vector<Vector3> flow_field_get_directions(RID p_flow_field, const Vector<Vector3> &p_positions) const = 0;
+	/// Returns the travel cost from the position to the closest goal.
+	virtual real_t flow_field_get_distance(RID p_flow_field, Vector3 p_position) const = 0;
+
 	/// Destroy the `RID`
 	virtual void free(RID p_object) const = 0;
 
@@ -608,6 +608,7 @@ void GodotBody3D::integrate_forces(real_t p_step) {
 	prev_angular_velocity = angular_velocity;
 
 	Vector3 motion;
+	real_t angular_motion = 0.0;
 	bool do_motion = false;
 
 	if (mode == PhysicsServer3D::BODY_MODE_KINEMATIC) {
@@ -625,9 +626,8 @@ void GodotBody3D::integrate_forces(real_t p_step) {
 		axis.normalize();
 		angular_velocity = constant_angular_velocity + axis * (angle / p_step);
 	} else {
-		if (!omit_force_integration) {
-			//overridden by direct state query
-
+		if (integration_index >= 0) {
+			// The velocities are integrated by the step with the ones of the other bodies, see set_integrated_velocities().
 			Vector3 force = gravity * mass + applied_force + constant_force;
 			Vector3 torque = applied_torque + constant_torque;
 
@@ -643,15 +643,10 @@ void GodotBody3D::integrate_forces(real_t p_step) {
 				angular_damp = 0;
 			}
 
-			linear_velocity *= damp;
-			angular_velocity *= angular_damp;
-
-			linear_velocity += _inv_mass * force * p_step;
-			angular_velocity += _inv_inertia_tensor.xform(torque) * p_step;
-		}
-
-		if (continuous_cd) {
+			get_space()->get_body_integration().set_forces(integration_index, linear_velocity, angular_velocity, force, torque, _inv_mass, _inv_inertia_tensor, damp, angular_damp);
+		} else if (continuous_cd) {
 			motion = linear_velocity * p_step;
+			angular_motion = angular_velocity.length() * p_step;
 			do_motion = true;
 		}
 	}
@@ -662,22 +657,41 @@ void GodotBody3D::integrate_forces(real_t p_step) {
 	biased_angular_velocity = Vector3();
 	biased_linear_velocity = Vector3();
 
-	if (do_motion) { //shapes temporarily extend for raycast
-		_update_shapes_with_motion(motion);
+	ccd_motion_fraction = 1.0;
+
+	if (do_motion) { //shapes temporarily extend for time of impact queries
+		pending_shape_motion = motion;
+		pending_shape_angular_motion = angular_motion;
+		pending_shape_motion_update = true;
 	}
 
 	contact_count = 0;
 }
 
+void GodotBody3D::set_integrated_velocities(const Vector3 &p_linear_velocity, const Vector3 &p_angular_velocity, real_t p_step) {
+	linear_velocity = p_linear_velocity;
+	angular_velocity = p_angular_velocity;
+
+	if (continuous_cd) { //shapes temporarily extend for time of impact queries
+		pending_shape_motion = linear_velocity * p_step;
+		pending_shape_angular_motion = angular_velocity.length() * p_step;
+		pending_shape_motion_update = true;
+	}
+}
+
+void GodotBody3D::update_integrated_motion() {
+	if (pending_shape_motion_update) {
+		_update_shapes_with_motion(pending_shape_motion, pending_shape_angular_motion, get_transform().origin + center_of_mass);
+		pending_shape_motion_update = false;
+		shapes_extended_by_motion = true;
+	}
+}
+
 void GodotBody3D::integrate_velocities(real_t p_step) {
 	if (mode == PhysicsServer3D::BODY_MODE_STATIC) {
 		return;
 	}
 
-	if (fi_callback_data || body_state_callback) {
-		get_space()->body_add_to_state_query_list(&direct_state_query_list);
-	}
-
 	//apply axis lock linear
 	for (int i = 0; i < 3; i++) {
 		if (is_axis_locked((PhysicsServer3D::BodyAxis)(1 << i))) {
@@ -698,39 +712,54 @@ void GodotBody3D::integrate_velocities(real_t p_step) {
 		_set_transform(new_transform, false);
 		_set_inv_transform(new_transform.affine_inverse());
 		if (contacts.size() == 0 && linear_velocity == Vector3() && angular_velocity == Vector3()) {
-			set_active(false); //stopped moving, deactivate
+			pending_deactivation = true; //stopped moving, deactivate
 		}
 
 		return;
 	}
 
-	Vector3 total_angular_velocity = angular_velocity + biased_angular_velocity;
+	// Continuous collision detection only lets the body move up to its earliest time of impact,
+	// the rest of the motion is left for the next step once regular contacts are generated.
+	real_t motion_step = p_step * ccd_motion_fraction;
 
-	real_t ang_vel = total_angular_velocity.length();
-	Transform3D transform = get_transform();
+	// The transform is integrated by the step with the ones of the other bodies, see set_integrated_transform().
+	get_space()->get_body_integration().set_motion(integration_index, get_transform(), linear_velocity + biased_linear_velocity, angular_velocity + biased_angular_velocity, center_of_mass_local, motion_step);
+}
 
-	if (!Math::is_zero_approx(ang_vel)) {
-		Vector3 ang_vel_axis = total_angular_velocity / ang_vel;
-		Basis rot(ang_vel_axis, ang_vel * p_step);
-		Basis identity3(1, 0, 0, 0, 1, 0, 0, 0, 1);
-		transform.origin += ((identity3 - rot) * transform.basis).xform(center_of_mass_local);
-		transform.basis = rot * transform.basis;
-		transform.orthonormalize();
+void GodotBody3D::set_integrated_transform(const Transform3D &p_transform) {
+	if (p_transform == get_transform()) {
+		// The swept bounds of a continuous collision step must still shrink back once the body stops.
+		pending_shape_update = shapes_extended_by_motion;
+		return;
 	}
 
-	Vector3 total_linear_velocity = linear_velocity + biased_linear_velocity;
-	/*for(int i=0;i<3;i++) {
-		if (axis_lock&(1<<i)) {
-			transform.origin[i]=0.0;
-		}
-	}*/
-
-	transform.origin += total_linear_velocity * p_step;
-
-	_set_transform(transform);
+	_set_transform(p_transform, false);
 	_set_inv_transform(get_transform().inverse());
 
 	_update_transform_dependent();
+
+	pending_shape_update = true;
+}
+
+void GodotBody3D::update_integrated_transform() {
+	if (mode == PhysicsServer3D::BODY_MODE_STATIC) {
+		return;
+	}
+
+	if (fi_callback_data || body_state_callback) {
+		get_space()->body_add_to_state_query_list(&direct_state_query_list);
+	}
+
+	if (pending_shape_update) {
+		_update_shapes();
+		pending_shape_update = false;
+		shapes_extended_by_motion = false;
+	}
+
+	if (pending_deactivation) {
+		set_active(false);
+		pending_deactivation = false;
+	}
 }
 
 void GodotBody3D::wakeup_neighbours() {
@@ -105,6 +105,17 @@ class GodotBody3D : public GodotCollisionObject3D {
 	bool active = true;
 
 	bool continuous_cd = false;
+	real_t ccd_motion_fraction = 1.0; // Part of the step the body can move before its earliest time of impact.
+
+	// Integration runs on worker threads, the changes to the broadphase and to the space lists
+	// are recorded here and applied afterwards by update_integrated_motion() and update_integrated_transform().
+	Vector3 pending_shape_motion;
+	real_t pending_shape_angular_motion = 0.0;
+	bool pending_shape_motion_update = false;
+	bool pending_shape_update = false;
+	bool shapes_extended_by_motion = false; // The broadphase still holds the swept bounds of the last motion update.
+	bool pending_deactivation = false;
+	int integration_index = -1; // Slot in the integration arrays of the space, -1 when the step doesn't integrate the body there.
 	bool can_sleep = true;
 	bool first_time_kinematic = false;
 
@@ -301,6 +312,9 @@ public:
 	_FORCE_INLINE_ void set_continuous_collision_detection(bool p_enable) { continuous_cd = p_enable; }
 	_FORCE_INLINE_ bool is_continuous_collision_detection_enabled() const { return continuous_cd; }
 
+	_FORCE_INLINE_ void limit_ccd_motion_fraction(real_t p_fraction) { ccd_motion_fraction = MIN(ccd_motion_fraction, p_fraction); }
+	_FORCE_INLINE_ real_t get_ccd_motion_fraction() const { return ccd_motion_fraction; }
+
 	void set_space(GodotSpace3D *p_space) override;
 
 	void update_mass_properties();
@@ -315,8 +329,15 @@ public:
 	void set_axis_lock(PhysicsServer3D::BodyAxis p_axis, bool lock);
 	bool is_axis_locked(PhysicsServer3D::BodyAxis p_axis) const;
 
+	// Thread-safe for different bodies, must be followed by a serial call to the matching update method.
+	// The bodies with an integration index fill their slot, and get the result from the matching set method.
+	_FORCE_INLINE_ void set_integration_index(int p_index) { integration_index = p_index; }
 	void integrate_forces(real_t p_step);
+	void set_integrated_velocities(const Vector3 &p_linear_velocity, const Vector3 &p_angular_velocity, real_t p_step);
+	void update_integrated_motion();
 	void integrate_velocities(real_t p_step);
+	void set_integrated_transform(const Transform3D &p_transform);
+	void update_integrated_transform();
 
 	_FORCE_INLINE_ Vector3 get_velocity_in_local_point(const Vector3 &rel_pos) const {
 		return linear_velocity + angular_velocity.cross(rel_pos - center_of_mass);
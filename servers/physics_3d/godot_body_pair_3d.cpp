@@ -162,49 +162,59 @@ void GodotBodyPair3D::validate_contacts() {
 }
 
 bool GodotBodyPair3D::_test_ccd(real_t p_step, GodotBody3D *p_A, int p_shape_A, const Transform3D &p_xform_A, GodotBody3D *p_B, int p_shape_B, const Transform3D &p_xform_B) {
-	Vector3 motion = p_A->get_linear_velocity() * p_step;
+	GodotShape3D *shape_A_ptr = p_A->get_shape(p_shape_A);
+	GodotShape3D *shape_B_ptr = p_B->get_shape(p_shape_B);
+
+	GodotCollisionSolver3D::ShapeMotion motion_A;
+	motion_A.linear_velocity = p_A->get_linear_velocity();
+	motion_A.angular_velocity = p_A->get_angular_velocity();
+
+	// Static bodies don't move, even when they have a constant velocity set.
+	GodotCollisionSolver3D::ShapeMotion motion_B;
+	if (p_B->get_mode() != PhysicsServer3D::BODY_MODE_STATIC) {
+		motion_B.linear_velocity = p_B->get_linear_velocity();
+		motion_B.angular_velocity = p_B->get_angular_velocity();
+	}
+
+	Vector3 motion = (motion_A.linear_velocity - motion_B.linear_velocity) * p_step;
 	real_t mlen = motion.length();
-	if (mlen < CMP_EPSILON) {
+
+	AABB aabb_A = p_xform_A.xform(shape_A_ptr->get_aabb());
+	real_t angular_sweep = motion_A.angular_velocity.length() * p_step * aabb_A.size.length() * 0.5;
+
+	if (mlen + angular_sweep < CMP_EPSILON) {
 		return false;
 	}
 
-	Vector3 mnormal = motion / mlen;
-
 	real_t min, max;
-	p_A->get_shape(p_shape_A)->project_range(mnormal, p_xform_A, min, max);
+	if (mlen > angular_sweep) {
+		shape_A_ptr->project_range(motion / mlen, p_xform_A, min, max);
+	} else {
+		min = 0.0;
+		max = aabb_A.size[aabb_A.get_shortest_axis_index()];
+	}
 
-	// Did it move enough in this direction to even attempt raycast?
-	// Let's say it should move more than 1/3 the size of the object in that axis.
-	bool fast_object = mlen > (max - min) * 0.3;
+	// Did it move enough to even attempt a time of impact query?
+	// Let's say it should move more than 1/3 the size of the object.
+	bool fast_object = (mlen + angular_sweep) > (max - min) * 0.3;
 	if (!fast_object) {
 		return false;
 	}
 
-	// Going too fast in that direction.
-
-	// Cast a segment from support in motion normal, in the same direction of motion by motion length.
-	// Support is the worst case collision point, so real collision happened before.
-	Vector3 s = p_A->get_shape(p_shape_A)->get_support(p_xform_A.basis.xform(mnormal).normalized());
-	Vector3 from = p_xform_A.xform(s);
-	Vector3 to = from + motion;
-
-	Transform3D from_inv = p_xform_B.affine_inverse();
+	// Transforms are relative to the origin of A, rotations happen around each center of mass.
+	const Vector3 &offset_A = A->get_transform().get_origin();
 
-	// Start from a little inside the bounding box.
-	Vector3 local_from = from_inv.xform(from - mnormal * mlen * 0.1);
-	Vector3 local_to = from_inv.xform(to);
+	motion_A.center = p_A->get_transform().get_origin() - offset_A + p_A->get_center_of_mass();
+	motion_B.center = p_B->get_transform().get_origin() - offset_A + p_B->get_center_of_mass();
 
-	Vector3 rpos, rnorm;
-	if (!p_B->get_shape(p_shape_B)->intersect_segment(local_from, local_to, rpos, rnorm, true)) {
+	real_t toi = 0.0;
+	if (!GodotCollisionSolver3D::solve_time_of_impact(shape_A_ptr, p_xform_A, motion_A, shape_B_ptr, p_xform_B, motion_B, p_step, space->get_contact_max_allowed_penetration(), toi)) {
 		return false;
 	}
 
-	// Shorten the linear velocity so it does not hit, but gets close enough,
-	// next frame will hit softly or soft enough.
-	Vector3 hitpos = p_xform_B.xform(rpos);
-
-	real_t newlen = hitpos.distance_to(from) - (max - min) * 0.01;
-	p_A->set_linear_velocity((mnormal * newlen) / p_step);
+	// Only move the body up to the time of impact during this step, keeping its velocity,
+	// next step the shapes touch and the contact solver handles the collision.
+	p_A->limit_ccd_motion_fraction(toi / p_step);
 
 	return true;
 }
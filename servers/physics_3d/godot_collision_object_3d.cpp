@@ -182,7 +182,7 @@ void GodotCollisionObject3D::_update_shapes() {
 	}
 }
 
-void GodotCollisionObject3D::_update_shapes_with_motion(const Vector3 &p_motion) {
+void GodotCollisionObject3D::_update_shapes_with_motion(const Vector3 &p_motion, real_t p_angular_motion, const Vector3 &p_center) {
 	if (!space) {
 		return;
 	}
@@ -197,6 +197,11 @@ void GodotCollisionObject3D::_update_shapes_with_motion(const Vector3 &p_motion)
 		AABB shape_aabb = s.shape->get_aabb();
 		Transform3D xform = transform * s.xform;
 		shape_aabb = xform.xform(shape_aabb);
+		if (p_angular_motion > 0.0) {
+			// A point rotating around the center can't travel farther than the chord of its arc.
+			real_t radius = shape_aabb.get_center().distance_to(p_center) + shape_aabb.size.length() * 0.5;
+			shape_aabb.grow_by(MIN(p_angular_motion, (real_t)2.0) * radius);
+		}
 		shape_aabb.merge_with(AABB(shape_aabb.position + p_motion, shape_aabb.size)); //use motion
 		s.aabb_cache = shape_aabb;
 
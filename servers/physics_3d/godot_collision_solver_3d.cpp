@@ -572,3 +572,176 @@ bool GodotCollisionSolver3D::solve_distance(const GodotShape3D *p_shape_A, const
 		return gjk_epa_calculate_distance(p_shape_A, p_transform_A, p_shape_B, p_transform_B, r_point_A, r_point_B); //should pass sepaxis..
 	}
 }
+
+#define TIME_OF_IMPACT_MAX_ITERATIONS 32
+
+Transform3D GodotCollisionSolver3D::integrate_motion(const Transform3D &p_transform, const ShapeMotion &p_motion, real_t p_time) {
+	Transform3D transform = p_transform;
+
+	real_t ang_vel = p_motion.angular_velocity.length();
+	if (!Math::is_zero_approx(ang_vel)) {
+		Basis rot(p_motion.angular_velocity / ang_vel, ang_vel * p_time);
+		transform.origin = p_motion.center + rot.xform(transform.origin - p_motion.center);
+		transform.basis = rot * transform.basis;
+	}
+
+	transform.origin += p_motion.linear_velocity * p_time;
+
+	return transform;
+}
+
+real_t GodotCollisionSolver3D::get_motion_radius(const GodotShape3D *p_shape, const Transform3D &p_transform, const Vector3 &p_center) {
+	// Farthest distance from the pivot to the shape bounds, no point of the shape can rotate faster than this.
+	const AABB aabb = p_shape->get_aabb();
+
+	real_t radius_squared = 0.0;
+	for (int i = 0; i < 8; i++) {
+		radius_squared = MAX(radius_squared, p_transform.xform(aabb.get_endpoint(i)).distance_squared_to(p_center));
+	}
+
+	return Math::sqrt(radius_squared);
+}
+
+bool GodotCollisionSolver3D::solve_time_of_impact_convex(const GodotShape3D *p_shape_A, const Transform3D &p_transform_A, const ShapeMotion &p_motion_A, const GodotShape3D *p_shape_B, const Transform3D &p_transform_B, const ShapeMotion &p_motion_B, real_t p_max_time, real_t p_margin, real_t &r_time) {
+	// Conservative advancement: the closest distance between both shapes can't shrink faster than
+	// the relative linear velocity along the separating direction plus the fastest rotating point,
+	// so advancing by distance / bound never steps over the first contact.
+	real_t angular_bound = 0.0;
+
+	real_t angular_speed_A = p_motion_A.angular_velocity.length();
+	if (!Math::is_zero_approx(angular_speed_A)) {
+		angular_bound += angular_speed_A * get_motion_radius(p_shape_A, p_transform_A, p_motion_A.center);
+	}
+
+	real_t angular_speed_B = p_motion_B.angular_velocity.length();
+	if (!Math::is_zero_approx(angular_speed_B)) {
+		angular_bound += angular_speed_B * get_motion_radius(p_shape_B, p_transform_B, p_motion_B.center);
+	}
+
+	const Vector3 relative_velocity = p_motion_A.linear_velocity - p_motion_B.linear_velocity;
+	const real_t motion_bound = relative_velocity.length() + angular_bound;
+	if (motion_bound <= CMP_EPSILON) {
+		return false;
+	}
+
+	const real_t tolerance = MAX(p_margin * 0.25, (real_t)CMP_EPSILON);
+
+	real_t time = 0.0;
+	bool converged = false;
+	for (int i = 0; i < TIME_OF_IMPACT_MAX_ITERATIONS; i++) {
+		Transform3D transform_A = integrate_motion(p_transform_A, p_motion_A, time);
+		Transform3D transform_B = integrate_motion(p_transform_B, p_motion_B, time);
+
+		Vector3 point_A, point_B;
+		if (!solve_distance(p_shape_A, transform_A, p_shape_B, transform_B, point_A, point_B, AABB())) {
+			// Already touching.
+			converged = true;
+			break;
+		}
+
+		Vector3 direction = point_B - point_A;
+		real_t distance = direction.length();
+		if (distance <= tolerance) {
+			converged = true;
+			break;
+		}
+		direction /= distance;
+
+		real_t approach_speed = relative_velocity.dot(direction) + angular_bound;
+		if (approach_speed <= CMP_EPSILON) {
+			// Moving apart.
+			return false;
+		}
+
+		time += distance / approach_speed;
+		if (time > p_max_time) {
+			return false;
+		}
+	}
+
+	if (!converged) {
+		// Still apart after all the iterations, which happens when the shapes only pass close to
+		// each other while rotating. Reporting an impact here would stall the body for no reason.
+		return false;
+	}
+
+	// Let the shapes overlap by at most the margin, so regular contacts can take over from there.
+	r_time = MIN(time + p_margin / motion_bound, p_max_time);
+	return true;
+}
+
+struct _TimeOfImpactInfo {
+	const GodotShape3D *shape_A = nullptr;
+	const Transform3D *transform_A = nullptr;
+	const GodotCollisionSolver3D::ShapeMotion *motion_A = nullptr;
+	const Transform3D *transform_B = nullptr;
+	const GodotCollisionSolver3D::ShapeMotion *motion_B = nullptr;
+	real_t margin = 0.0;
+	real_t time = 0.0;
+	bool hit = false;
+};
+
+bool GodotCollisionSolver3D::time_of_impact_concave_callback(void *p_userdata, GodotShape3D *p_convex) {
+	_TimeOfImpactInfo &tinfo = *(static_cast<_TimeOfImpactInfo *>(p_userdata));
+
+	// Only faces hit before the best time of impact so far are of interest.
+	real_t time = 0.0;
+	if (solve_time_of_impact_convex(tinfo.shape_A, *tinfo.transform_A, *tinfo.motion_A, p_convex, *tinfo.transform_B, *tinfo.motion_B, tinfo.time, tinfo.margin, time)) {
+		tinfo.time = MIN(tinfo.time, time);
+		tinfo.hit = true;
+	}
+
+	return false;
+}
+
+bool GodotCollisionSolver3D::solve_time_of_impact(const GodotShape3D *p_shape_A, const Transform3D &p_transform_A, const ShapeMotion &p_motion_A, const GodotShape3D *p_shape_B, const Transform3D &p_transform_B, const ShapeMotion &p_motion_B, real_t p_max_time, real_t p_margin, real_t &r_time) {
+	PhysicsServer3D::ShapeType type_A = p_shape_A->get_type();
+	PhysicsServer3D::ShapeType type_B = p_shape_B->get_type();
+
+	if (type_A == PhysicsServer3D::SHAPE_SEPARATION_RAY || type_B == PhysicsServer3D::SHAPE_SEPARATION_RAY) {
+		return false;
+	}
+	if (type_A == PhysicsServer3D::SHAPE_SOFT_BODY || type_B == PhysicsServer3D::SHAPE_SOFT_BODY) {
+		return false;
+	}
+
+	if (p_shape_A->is_concave() || type_A == PhysicsServer3D::SHAPE_WORLD_BOUNDARY) {
+		if (p_shape_B->is_concave() || type_B == PhysicsServer3D::SHAPE_WORLD_BOUNDARY) {
+			return false;
+		}
+		return solve_time_of_impact(p_shape_B, p_transform_B, p_motion_B, p_shape_A, p_transform_A, p_motion_A, p_max_time, p_margin, r_time);
+	}
+
+	if (!p_shape_B->is_concave()) {
+		return solve_time_of_impact_convex(p_shape_A, p_transform_A, p_motion_A, p_shape_B, p_transform_B, p_motion_B, p_max_time, p_margin, r_time);
+	}
+
+	// Sweep the bounding sphere of the convex shape along the relative motion, and only advance
+	// against the faces it touches. The rotation of the concave shape itself is not swept.
+	real_t radius = get_motion_radius(p_shape_A, p_transform_A, p_motion_A.center) + p_margin;
+	Vector3 relative_motion = (p_motion_A.linear_velocity - p_motion_B.linear_velocity) * p_max_time;
+
+	AABB sweep_aabb(p_motion_A.center - Vector3(radius, radius, radius), Vector3(radius, radius, radius) * 2.0);
+	sweep_aabb.merge_with(AABB(sweep_aabb.position + relative_motion, sweep_aabb.size));
+
+	AABB local_aabb = p_transform_B.affine_inverse().xform(sweep_aabb);
+
+	_TimeOfImpactInfo tinfo;
+	tinfo.shape_A = p_shape_A;
+	tinfo.transform_A = &p_transform_A;
+	tinfo.motion_A = &p_motion_A;
+	tinfo.transform_B = &p_transform_B;
+	tinfo.motion_B = &p_motion_B;
+	tinfo.margin = p_margin;
+	tinfo.time = p_max_time;
+
+	const GodotConcaveShape3D *concave_B = static_cast<const GodotConcaveShape3D *>(p_shape_B);
+	concave_B->cull(local_aabb, time_of_impact_concave_callback, &tinfo, false);
+
+	if (!tinfo.hit) {
+		return false;
+	}
+
+	r_time = tinfo.time;
+	return true;
+}
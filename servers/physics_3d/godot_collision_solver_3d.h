@@ -37,6 +37,13 @@ class GodotCollisionSolver3D {
 public:
 	typedef void (*CallbackResult)(const Vector3 &p_point_A, int p_index_A, const Vector3 &p_point_B, int p_index_B, void *p_userdata);
 
+	// Rigid motion of a shape during a time of impact query.
+	struct ShapeMotion {
+		Vector3 linear_velocity;
+		Vector3 angular_velocity;
+		Vector3 center; // Pivot of the rotation, in the same space as the shape transform.
+	};
+
 private:
 	static bool soft_body_query_callback(uint32_t p_node_index, void *p_userdata);
 	static void soft_body_contact_callback(const Vector3 &p_point_A, int p_index_A, const Vector3 &p_point_B, int p_index_B, void *p_userdata);
@@ -48,10 +55,16 @@ private:
 	static bool solve_concave(const GodotShape3D *p_shape_A, const Transform3D &p_transform_A, const GodotShape3D *p_shape_B, const Transform3D &p_transform_B, CallbackResult p_result_callback, void *p_userdata, bool p_swap_result, real_t p_margin_A = 0, real_t p_margin_B = 0);
 	static bool concave_distance_callback(void *p_userdata, GodotShape3D *p_convex);
 	static bool solve_distance_world_boundary(const GodotShape3D *p_shape_A, const Transform3D &p_transform_A, const GodotShape3D *p_shape_B, const Transform3D &p_transform_B, Vector3 &r_point_A, Vector3 &r_point_B);
+	static bool time_of_impact_concave_callback(void *p_userdata, GodotShape3D *p_convex);
+	static bool solve_time_of_impact_convex(const GodotShape3D *p_shape_A, const Transform3D &p_transform_A, const ShapeMotion &p_motion_A, const GodotShape3D *p_shape_B, const Transform3D &p_transform_B, const ShapeMotion &p_motion_B, real_t p_max_time, real_t p_margin, real_t &r_time);
 
 public:
 	static bool solve_static(const GodotShape3D *p_shape_A, const Transform3D &p_transform_A, const GodotShape3D *p_shape_B, const Transform3D &p_transform_B, CallbackResult p_result_callback, void *p_userdata, Vector3 *r_sep_axis = nullptr, real_t p_margin_A = 0, real_t p_margin_B = 0);
 	static bool solve_distance(const GodotShape3D *p_shape_A, const Transform3D &p_transform_A, const GodotShape3D *p_shape_B, const Transform3D &p_transform_B, Vector3 &r_point_A, Vector3 &r_point_B, const AABB &p_concave_hint, Vector3 *r_sep_axis = nullptr);
+	static bool solve_time_of_impact(const GodotShape3D *p_shape_A, const Transform3D &p_transform_A, const ShapeMotion &p_motion_A, const GodotShape3D *p_shape_B, const Transform3D &p_transform_B, const ShapeMotion &p_motion_B, real_t p_max_time, real_t p_margin, real_t &r_time);
+
+	static Transform3D integrate_motion(const Transform3D &p_transform, const ShapeMotion &p_motion, real_t p_time);
+	static real_t get_motion_radius(const GodotShape3D *p_shape, const Transform3D &p_transform, const Vector3 &p_center);
 };
 
 #endif // GODOT_COLLISION_SOLVER_3D_H
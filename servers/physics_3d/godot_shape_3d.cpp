@@ -1221,15 +1221,17 @@ GodotFaceShape3D::GodotFaceShape3D() {
 }
 
 Vector<Vector3> GodotConcavePolygonShape3D::get_faces() const {
+	// Return the faces in the order they were set, not in the order of the BVH leaves.
 	Vector<Vector3> rfaces;
-	rfaces.resize(faces.size() * 3);
+	rfaces.resize(vertices.size());
 
-	for (int i = 0; i < faces.size(); i++) {
-		Face f = faces.get(i);
-
-		for (int j = 0; j < 3; j++) {
-			rfaces.set(i * 3 + j, vertices.get(f.indices[j]));
-		}
+	const Vector3 *vptr = vertices.ptr();
+	Vector3 *wptr = rfaces.ptrw();
+	for (uint32_t i = 0; i < source_faces.size(); i++) {
+		uint32_t src_face = source_faces[i];
+		wptr[src_face * 3 + 0] = vptr[i * 3 + 0];
+		wptr[src_face * 3 + 1] = vptr[i * 3 + 1];
+		wptr[src_face * 3 + 2] = vptr[i * 3 + 2];
 	}
 
 	return rfaces;
@@ -1281,39 +1283,63 @@ Vector3 GodotConcavePolygonShape3D::get_support(const Vector3 &p_normal) const {
 	return vptr[vert_support_idx];
 }
 
-void GodotConcavePolygonShape3D::_cull_segment(int p_idx, _SegmentCullParams *p_params) const {
-	const BVH *bvh = &p_params->bvh[p_idx];
-
-	if (!bvh->aabb.intersects_segment(p_params->from, p_params->to)) {
-		return;
+void GodotConcavePolygonShape3D::_quantize_aabb(const AABB &p_aabb, uint16_t r_min[3], uint16_t r_max[3]) const {
+	for (int i = 0; i < 3; i++) {
+		real_t q_min = (p_aabb.position[i] - bvh_quantize_origin[i]) * bvh_quantize_scale[i];
+		real_t q_max = (p_aabb.position[i] + p_aabb.size[i] - bvh_quantize_origin[i]) * bvh_quantize_scale[i];
+		r_min[i] = (uint16_t)CLAMP(Math::floor(q_min), (real_t)0.0, (real_t)UINT16_MAX);
+		r_max[i] = (uint16_t)CLAMP(Math::ceil(q_max), (real_t)0.0, (real_t)UINT16_MAX);
 	}
+}
 
-	if (bvh->face_index >= 0) {
-		const Face *f = &p_params->faces[bvh->face_index];
-		GodotFaceShape3D *face = p_params->face;
-		face->normal = f->normal;
-		face->vertex[0] = p_params->vertices[f->indices[0]];
-		face->vertex[1] = p_params->vertices[f->indices[1]];
-		face->vertex[2] = p_params->vertices[f->indices[2]];
-
-		Vector3 res;
-		Vector3 normal;
-		if (face->intersect_segment(p_params->from, p_params->to, res, normal, true)) {
-			real_t d = p_params->dir.dot(res) - p_params->dir.dot(p_params->from);
-			if ((d > 0) && (d < p_params->min_d)) {
-				p_params->min_d = d;
-				p_params->result = res;
-				p_params->normal = normal;
-				p_params->collisions++;
-			}
-		}
-	} else {
-		if (bvh->left >= 0) {
-			_cull_segment(bvh->left, p_params);
+AABB GodotConcavePolygonShape3D::_dequantize_aabb(const BVH &p_node) const {
+	Vector3 min(p_node.min[0], p_node.min[1], p_node.min[2]);
+	Vector3 max(p_node.max[0], p_node.max[1], p_node.max[2]);
+	return AABB(bvh_quantize_origin + min * bvh_dequantize_scale, (max - min) * bvh_dequantize_scale);
+}
+
+void GodotConcavePolygonShape3D::_cull_segment(_SegmentCullParams *p_params) const {
+	const BVH *bvh_ptr = bvh.ptr();
+	const uint32_t node_count = bvh.size();
+
+	uint32_t idx = 0;
+	while (idx < node_count) {
+		const BVH &node = bvh_ptr[idx];
+
+		// The segment is shortened to the closest hit so far, which prunes farther nodes.
+		if (!_dequantize_aabb(node).intersects_segment(p_params->from, p_params->to)) {
+			idx = node.is_leaf() ? idx + 1 : node.get_skip_index();
+			continue;
 		}
-		if (bvh->right >= 0) {
-			_cull_segment(bvh->right, p_params);
+
+		if (node.is_leaf()) {
+			uint32_t face_begin = node.get_first_face();
+			uint32_t face_end = face_begin + node.get_face_count();
+			for (uint32_t face_index = face_begin; face_index < face_end; face_index++) {
+				const Vector3 *face_vertices = &p_params->vertices[face_index * 3];
+
+				GodotFaceShape3D *face = p_params->face;
+				face->normal = p_params->faces[face_index].normal;
+				face->vertex[0] = face_vertices[0];
+				face->vertex[1] = face_vertices[1];
+				face->vertex[2] = face_vertices[2];
+
+				Vector3 res;
+				Vector3 normal;
+				if (face->intersect_segment(p_params->from, p_params->to, res, normal, true)) {
+					real_t d = p_params->dir.dot(res) - p_params->dir.dot(p_params->from);
+					if ((d > 0) && (d < p_params->min_d)) {
+						p_params->min_d = d;
+						p_params->result = res;
+						p_params->normal = normal;
+						p_params->to = res;
+						p_params->collisions++;
+					}
+				}
+			}
 		}
+
+		idx++;
 	}
 }
 
@@ -1325,7 +1351,6 @@ bool GodotConcavePolygonShape3D::intersect_segment(const Vector3 &p_begin, const
 	// unlock data
 	const Face *fr = faces.ptr();
 	const Vector3 *vr = vertices.ptr();
-	const BVH *br = bvh.ptr();
 
 	GodotFaceShape3D face;
 	face.backface_collision = backface_collision && p_hit_back_faces;
@@ -1337,12 +1362,11 @@ bool GodotConcavePolygonShape3D::intersect_segment(const Vector3 &p_begin, const
 
 	params.faces = fr;
 	params.vertices = vr;
-	params.bvh = br;
 
 	params.face = &face;
 
 	// cull
-	_cull_segment(0, &params);
+	_cull_segment(&params);
 
 	if (params.collisions > 0) {
 		r_result = params.result;
@@ -1361,35 +1385,49 @@ Vector3 GodotConcavePolygonShape3D::get_closest_point_to(const Vector3 &p_point)
 	return Vector3();
 }
 
-bool GodotConcavePolygonShape3D::_cull(int p_idx, _CullParams *p_params) const {
-	const BVH *bvh = &p_params->bvh[p_idx];
+bool GodotConcavePolygonShape3D::_cull(_CullParams *p_params) const {
+	const BVH *bvh_ptr = bvh.ptr();
+	const uint32_t node_count = bvh.size();
 
-	if (!p_params->aabb.intersects(bvh->aabb)) {
-		return false;
-	}
+	uint32_t idx = 0;
+	while (idx < node_count) {
+		const BVH &node = bvh_ptr[idx];
 
-	if (bvh->face_index >= 0) {
-		const Face *f = &p_params->faces[bvh->face_index];
-		GodotFaceShape3D *face = p_params->face;
-		face->normal = f->normal;
-		face->vertex[0] = p_params->vertices[f->indices[0]];
-		face->vertex[1] = p_params->vertices[f->indices[1]];
-		face->vertex[2] = p_params->vertices[f->indices[2]];
-		if (p_params->callback(p_params->userdata, face)) {
-			return true;
-		}
-	} else {
-		if (bvh->left >= 0) {
-			if (_cull(bvh->left, p_params)) {
-				return true;
-			}
+		bool overlap = (node.min[0] <= p_params->max[0]) && (node.max[0] >= p_params->min[0]) &&
+				(node.min[1] <= p_params->max[1]) && (node.max[1] >= p_params->min[1]) &&
+				(node.min[2] <= p_params->max[2]) && (node.max[2] >= p_params->min[2]);
+
+		if (!overlap) {
+			idx = node.is_leaf() ? idx + 1 : node.get_skip_index();
+			continue;
 		}
 
-		if (bvh->right >= 0) {
-			if (_cull(bvh->right, p_params)) {
-				return true;
+		if (node.is_leaf()) {
+			uint32_t face_begin = node.get_first_face();
+			uint32_t face_end = face_begin + node.get_face_count();
+			for (uint32_t face_index = face_begin; face_index < face_end; face_index++) {
+				const Vector3 *face_vertices = &p_params->vertices[face_index * 3];
+
+				// Leaves hold several faces, reject the ones outside the query before the callback.
+				AABB face_aabb(face_vertices[0], Vector3());
+				face_aabb.expand_to(face_vertices[1]);
+				face_aabb.expand_to(face_vertices[2]);
+				if (!face_aabb.intersects(p_params->aabb)) {
+					continue;
+				}
+
+				GodotFaceShape3D *face = p_params->face;
+				face->normal = p_params->faces[face_index].normal;
+				face->vertex[0] = face_vertices[0];
+				face->vertex[1] = face_vertices[1];
+				face->vertex[2] = face_vertices[2];
+				if (p_params->callback(p_params->userdata, face)) {
+					return true;
+				}
 			}
 		}
+
+		idx++;
 	}
 
 	return false;
@@ -1401,28 +1439,29 @@ void GodotConcavePolygonShape3D::cull(const AABB &p_local_aabb, QueryCallback p_
 		return;
 	}
 
-	AABB local_aabb = p_local_aabb;
+	if (!p_local_aabb.intersects(get_aabb())) {
+		return;
+	}
 
 	// unlock data
 	const Face *fr = faces.ptr();
 	const Vector3 *vr = vertices.ptr();
-	const BVH *br = bvh.ptr();
 
 	GodotFaceShape3D face; // use this to send in the callback
 	face.backface_collision = backface_collision;
 	face.invert_backface_collision = p_invert_backface_collision;
 
 	_CullParams params;
-	params.aabb = local_aabb;
+	_quantize_aabb(p_local_aabb, params.min, params.max);
+	params.aabb = p_local_aabb;
 	params.face = &face;
 	params.faces = fr;
 	params.vertices = vr;
-	params.bvh = br;
 	params.callback = p_callback;
 	params.userdata = p_userdata;
 
 	// cull
-	_cull(0, &params);
+	_cull(&params);
 }
 
 Vector3 GodotConcavePolygonShape3D::get_moment_of_inertia(real_t p_mass) const {
@@ -1459,38 +1498,41 @@ struct _Volume_BVH_CompareZ {
 	}
 };
 
-struct _Volume_BVH {
-	AABB aabb;
-	_Volume_BVH *left = nullptr;
-	_Volume_BVH *right = nullptr;
-
-	int face_index = 0;
-};
-
-_Volume_BVH *_volume_build_bvh(_Volume_BVH_Element *p_elements, int p_size, int &count) {
-	_Volume_BVH *bvh = memnew(_Volume_BVH);
-
-	if (p_size == 1) {
-		//leaf
-		bvh->aabb = p_elements[0].aabb;
-		bvh->left = nullptr;
-		bvh->right = nullptr;
-		bvh->face_index = p_elements->face_index;
-		count++;
-		return bvh;
-	} else {
-		bvh->face_index = -1;
+void GodotConcavePolygonShape3D::_build_bvh(_Volume_BVH_Element *p_elements, int p_size, _BuildParams &p_params) {
+	AABB aabb = p_elements[0].aabb;
+	for (int i = 1; i < p_size; i++) {
+		aabb.merge_with(p_elements[i].aabb);
 	}
 
-	AABB aabb;
-	for (int i = 0; i < p_size; i++) {
-		if (i == 0) {
-			aabb = p_elements[i].aabb;
-		} else {
-			aabb.merge_with(p_elements[i].aabb);
+	uint32_t idx = bvh.size();
+	bvh.push_back(BVH());
+
+	// Grow by one step so float rounding during queries can't miss a face.
+	_quantize_aabb(aabb, bvh[idx].min, bvh[idx].max);
+	for (int i = 0; i < 3; i++) {
+		bvh[idx].min[i] = MAX(bvh[idx].min[i], 1) - 1;
+		bvh[idx].max[i] = MIN(bvh[idx].max[i], UINT16_MAX - 1) + 1;
+	}
+
+	if (p_size <= BVH_MAX_LEAF_FACES) {
+		// Leaf, copy its faces next to each other.
+		uint32_t first_face = p_params.face_count;
+		for (int i = 0; i < p_size; i++) {
+			int src_face = p_elements[i].face_index;
+			uint32_t dst_face = p_params.face_count++;
+
+			Face3 face(p_params.src_vertices[src_face * 3 + 0], p_params.src_vertices[src_face * 3 + 1], p_params.src_vertices[src_face * 3 + 2]);
+			p_params.faces[dst_face].normal = face.get_plane().normal;
+			p_params.source_faces[dst_face] = src_face;
+			p_params.vertices[dst_face * 3 + 0] = face.vertex[0];
+			p_params.vertices[dst_face * 3 + 1] = face.vertex[1];
+			p_params.vertices[dst_face * 3 + 2] = face.vertex[2];
 		}
+
+		bvh[idx].data = BVH_LEAF_FLAG | (first_face << BVH_LEAF_COUNT_BITS) | (p_size - 1);
+		return;
 	}
-	bvh->aabb = aabb;
+
 	switch (aabb.get_longest_axis_index()) {
 		case 0: {
 			SortArray<_Volume_BVH_Element, _Volume_BVH_CompareX> sort_x;
@@ -1508,41 +1550,18 @@ _Volume_BVH *_volume_build_bvh(_Volume_BVH_Element *p_elements, int p_size, int
 	}
 
 	int split = p_size / 2;
-	bvh->left = _volume_build_bvh(p_elements, split, count);
-	bvh->right = _volume_build_bvh(&p_elements[split], p_size - split, count);
-
-	//printf("branch at %p - %i: %i\n",bvh,count,bvh->face_index);
-	count++;
-	return bvh;
-}
-
-void GodotConcavePolygonShape3D::_fill_bvh(_Volume_BVH *p_bvh_tree, BVH *p_bvh_array, int &p_idx) {
-	int idx = p_idx;
-
-	p_bvh_array[idx].aabb = p_bvh_tree->aabb;
-	p_bvh_array[idx].face_index = p_bvh_tree->face_index;
-	//printf("%p - %i: %i(%p)  -- %p:%p\n",%p_bvh_array[idx],p_idx,p_bvh_array[i]->face_index,&p_bvh_tree->face_index,p_bvh_tree->left,p_bvh_tree->right);
-
-	if (p_bvh_tree->left) {
-		p_bvh_array[idx].left = ++p_idx;
-		_fill_bvh(p_bvh_tree->left, p_bvh_array, p_idx);
-
-	} else {
-		p_bvh_array[p_idx].left = -1;
-	}
-
-	if (p_bvh_tree->right) {
-		p_bvh_array[idx].right = ++p_idx;
-		_fill_bvh(p_bvh_tree->right, p_bvh_array, p_idx);
-
-	} else {
-		p_bvh_array[p_idx].right = -1;
-	}
+	_build_bvh(p_elements, split, p_params);
+	_build_bvh(&p_elements[split], p_size - split, p_params);
 
-	memdelete(p_bvh_tree);
+	bvh[idx].data = bvh.size();
 }
 
 void GodotConcavePolygonShape3D::_setup(const Vector<Vector3> &p_faces, bool p_backface_collision) {
+	faces.clear();
+	vertices.clear();
+	source_faces.clear();
+	bvh.clear();
+
 	int src_face_count = p_faces.size();
 	if (src_face_count == 0) {
 		configure(AABB());
@@ -1550,6 +1569,7 @@ void GodotConcavePolygonShape3D::_setup(const Vector<Vector3> &p_faces, bool p_b
 	}
 	ERR_FAIL_COND(src_face_count % 3);
 	src_face_count /= 3;
+	ERR_FAIL_COND_MSG((uint32_t)src_face_count >= (BVH_LEAF_FLAG >> BVH_LEAF_COUNT_BITS), "Too many faces in concave polygon shape.");
 
 	const Vector3 *facesr = p_faces.ptr();
 
@@ -1558,13 +1578,6 @@ void GodotConcavePolygonShape3D::_setup(const Vector<Vector3> &p_faces, bool p_b
 
 	_Volume_BVH_Element *bvh_arrayw = bvh_array.ptrw();
 
-	faces.resize(src_face_count);
-	Face *facesw = faces.ptrw();
-
-	vertices.resize(src_face_count * 3);
-
-	Vector3 *verticesw = vertices.ptrw();
-
 	AABB _aabb;
 
 	for (int i = 0; i < src_face_count; i++) {
@@ -1573,13 +1586,6 @@ void GodotConcavePolygonShape3D::_setup(const Vector<Vector3> &p_faces, bool p_b
 		bvh_arrayw[i].aabb = face.get_aabb();
 		bvh_arrayw[i].center = bvh_arrayw[i].aabb.get_center();
 		bvh_arrayw[i].face_index = i;
-		facesw[i].indices[0] = i * 3 + 0;
-		facesw[i].indices[1] = i * 3 + 1;
-		facesw[i].indices[2] = i * 3 + 2;
-		facesw[i].normal = face.get_plane().normal;
-		verticesw[i * 3 + 0] = face.vertex[0];
-		verticesw[i * 3 + 1] = face.vertex[1];
-		verticesw[i * 3 + 2] = face.vertex[2];
 		if (i == 0) {
 			_aabb = bvh_arrayw[i].aabb;
 		} else {
@@ -1587,15 +1593,31 @@ void GodotConcavePolygonShape3D::_setup(const Vector<Vector3> &p_faces, bool p_b
 		}
 	}
 
-	int count = 0;
-	_Volume_BVH *bvh_tree = _volume_build_bvh(bvh_arrayw, src_face_count, count);
+	bvh_quantize_origin = _aabb.position;
+	for (int i = 0; i < 3; i++) {
+		if (_aabb.size[i] > CMP_EPSILON) {
+			bvh_quantize_scale[i] = UINT16_MAX / _aabb.size[i];
+			bvh_dequantize_scale[i] = _aabb.size[i] / UINT16_MAX;
+		} else {
+			bvh_quantize_scale[i] = 0.0;
+			bvh_dequantize_scale[i] = 0.0;
+		}
+	}
+
+	faces.resize(src_face_count);
+	vertices.resize(src_face_count * 3);
+	source_faces.resize(src_face_count);
 
-	bvh.resize(count + 1);
+	// A median split tree with full leaves has less than two nodes per leaf.
+	bvh.reserve(2 * (src_face_count / BVH_MAX_LEAF_FACES + 1));
 
-	BVH *bvh_arrayw2 = bvh.ptrw();
+	_BuildParams params;
+	params.src_vertices = facesr;
+	params.faces = faces.ptrw();
+	params.vertices = vertices.ptrw();
+	params.source_faces = source_faces.ptr();
 
-	int idx = 0;
-	_fill_bvh(bvh_tree, bvh_arrayw2, idx);
+	_build_bvh(bvh_arrayw, src_face_count, params);
 
 	backface_collision = p_backface_collision;
 
@@ -1956,6 +1978,96 @@ void GodotHeightMapShape3D::_get_cell(const Vector3 &p_point, int &r_x, int &r_y
 	r_z = (clamped_point.z < 0.0) ? (clamped_point.z - 0.5) : (clamped_point.z + 0.5);
 }
 
+struct _HeightmapCullParams {
+	int start_x = 0;
+	int end_x = 0;
+	int start_z = 0;
+	int end_z = 0;
+	real_t min_y = 0.0;
+	real_t max_y = 0.0;
+
+	GodotConcaveShape3D::QueryCallback callback = nullptr;
+	void *userdata = nullptr;
+
+	const GodotHeightMapShape3D *heightmap = nullptr;
+	GodotFaceShape3D *face = nullptr;
+};
+
+static _FORCE_INLINE_ bool _heightmap_cell_cull(_HeightmapCullParams &p_params, int p_x, int p_z) {
+	const GodotHeightMapShape3D *heightmap = p_params.heightmap;
+	GodotFaceShape3D &face = *p_params.face;
+
+	real_t h00 = heightmap->_get_height(p_x, p_z);
+	real_t h10 = heightmap->_get_height(p_x + 1, p_z);
+	real_t h01 = heightmap->_get_height(p_x, p_z + 1);
+	real_t h11 = heightmap->_get_height(p_x + 1, p_z + 1);
+	if (MIN(MIN(h00, h10), MIN(h01, h11)) > p_params.max_y || MAX(MAX(h00, h10), MAX(h01, h11)) < p_params.min_y) {
+		return false;
+	}
+
+	// First triangle.
+	heightmap->_get_point(p_x, p_z, face.vertex[0]);
+	heightmap->_get_point(p_x + 1, p_z, face.vertex[1]);
+	heightmap->_get_point(p_x, p_z + 1, face.vertex[2]);
+	face.normal = Plane(face.vertex[0], face.vertex[1], face.vertex[2]).normal;
+	if (p_params.callback(p_params.userdata, &face)) {
+		return true;
+	}
+
+	// Second triangle.
+	face.vertex[0] = face.vertex[1];
+	heightmap->_get_point(p_x + 1, p_z + 1, face.vertex[1]);
+	face.normal = Plane(face.vertex[0], face.vertex[1], face.vertex[2]).normal;
+	if (p_params.callback(p_params.userdata, &face)) {
+		return true;
+	}
+
+	return false;
+}
+
+static bool _heightmap_pyramid_cull(_HeightmapCullParams &p_params, int p_level, int p_x, int p_z) {
+	const GodotHeightMapShape3D *heightmap = p_params.heightmap;
+	const GodotHeightMapShape3D::PyramidLevel &level = heightmap->pyramid_levels[p_level];
+	if (p_x >= level.width || p_z >= level.depth) {
+		return false;
+	}
+
+	int block_size = GodotHeightMapShape3D::PYRAMID_BLOCK_SIZE << p_level;
+	int x0 = p_x * block_size;
+	int z0 = p_z * block_size;
+	if (x0 >= p_params.end_x || x0 + block_size <= p_params.start_x || z0 >= p_params.end_z || z0 + block_size <= p_params.start_z) {
+		return false;
+	}
+
+	const GodotHeightMapShape3D::Range &range = heightmap->_get_pyramid_block(p_level, p_x, p_z);
+	if (range.min > p_params.max_y || range.max < p_params.min_y) {
+		return false;
+	}
+
+	if (p_level == 0) {
+		int x_end = MIN(x0 + block_size, p_params.end_x);
+		int z_end = MIN(z0 + block_size, p_params.end_z);
+		for (int z = MAX(z0, p_params.start_z); z < z_end; z++) {
+			for (int x = MAX(x0, p_params.start_x); x < x_end; x++) {
+				if (_heightmap_cell_cull(p_params, x, z)) {
+					return true;
+				}
+			}
+		}
+		return false;
+	}
+
+	for (int z = 0; z < 2; z++) {
+		for (int x = 0; x < 2; x++) {
+			if (_heightmap_pyramid_cull(p_params, p_level - 1, p_x * 2 + x, p_z * 2 + z)) {
+				return true;
+			}
+		}
+	}
+
+	return false;
+}
+
 void GodotHeightMapShape3D::cull(const AABB &p_local_aabb, QueryCallback p_callback, void *p_userdata, bool p_invert_backface_collision) const {
 	if (heights.is_empty()) {
 		return;
@@ -1977,35 +2089,35 @@ void GodotHeightMapShape3D::cull(const AABB &p_local_aabb, QueryCallback p_callb
 		aabb_max[i]++;
 	}
 
-	int start_x = MAX(0, aabb_min[0]);
-	int end_x = MIN(width - 1, aabb_max[0]);
-	int start_z = MAX(0, aabb_min[2]);
-	int end_z = MIN(depth - 1, aabb_max[2]);
-
 	GodotFaceShape3D face;
 	face.backface_collision = !p_invert_backface_collision;
 	face.invert_backface_collision = p_invert_backface_collision;
 
-	for (int z = start_z; z < end_z; z++) {
-		for (int x = start_x; x < end_x; x++) {
-			// First triangle.
-			_get_point(x, z, face.vertex[0]);
-			_get_point(x + 1, z, face.vertex[1]);
-			_get_point(x, z + 1, face.vertex[2]);
-			face.normal = Plane(face.vertex[0], face.vertex[1], face.vertex[2]).normal;
-			if (p_callback(p_userdata, &face)) {
-				return;
-			}
+	_HeightmapCullParams params;
+	params.start_x = MAX(0, aabb_min[0]);
+	params.end_x = MIN(width - 1, aabb_max[0]);
+	params.start_z = MAX(0, aabb_min[2]);
+	params.end_z = MIN(depth - 1, aabb_max[2]);
+	params.min_y = local_aabb.position.y;
+	params.max_y = local_aabb.position.y + local_aabb.size.y;
+	params.callback = p_callback;
+	params.userdata = p_userdata;
+	params.heightmap = this;
+	params.face = &face;
 
-			// Second triangle.
-			face.vertex[0] = face.vertex[1];
-			_get_point(x + 1, z + 1, face.vertex[1]);
-			face.normal = Plane(face.vertex[0], face.vertex[1], face.vertex[2]).normal;
-			if (p_callback(p_userdata, &face)) {
-				return;
+	if (pyramid_levels.is_empty()) {
+		for (int z = params.start_z; z < params.end_z; z++) {
+			for (int x = params.start_x; x < params.end_x; x++) {
+				if (_heightmap_cell_cull(params, x, z)) {
+					return;
+				}
 			}
 		}
+		return;
 	}
+
+	// Start from the single block at the top of the pyramid.
+	_heightmap_pyramid_cull(params, pyramid_levels.size() - 1, 0, 0);
 }
 
 Vector3 GodotHeightMapShape3D::get_moment_of_inertia(real_t p_mass) const {
@@ -2087,6 +2199,78 @@ void GodotHeightMapShape3D::_build_accelerator() {
 	}
 }
 
+void GodotHeightMapShape3D::_build_pyramid() {
+	pyramid.clear();
+	pyramid_levels.clear();
+
+	int cells_width = width - 1;
+	int cells_depth = depth - 1;
+	if (cells_width <= 0 || cells_depth <= 0) {
+		return;
+	}
+
+	PyramidLevel level;
+	level.width = (cells_width + PYRAMID_BLOCK_SIZE - 1) / PYRAMID_BLOCK_SIZE;
+	level.depth = (cells_depth + PYRAMID_BLOCK_SIZE - 1) / PYRAMID_BLOCK_SIZE;
+
+	// Reserve the whole pyramid, it's at most a third bigger than its base.
+	pyramid.reserve((level.width * level.depth * 4) / 3 + 32);
+
+	// Base level, blocks share their border vertices with their neighbors.
+	pyramid.resize(level.width * level.depth);
+	for (int bz = 0; bz < level.depth; ++bz) {
+		int z0 = bz * PYRAMID_BLOCK_SIZE;
+		int z_max = MIN(z0 + PYRAMID_BLOCK_SIZE + 1, depth);
+
+		for (int bx = 0; bx < level.width; ++bx) {
+			int x0 = bx * PYRAMID_BLOCK_SIZE;
+			int x_max = MIN(x0 + PYRAMID_BLOCK_SIZE + 1, width);
+
+			Range r;
+			r.min = _get_height(x0, z0);
+			r.max = r.min;
+
+			for (int z = z0; z < z_max; ++z) {
+				for (int x = x0; x < x_max; ++x) {
+					real_t height = _get_height(x, z);
+					r.min = MIN(r.min, height);
+					r.max = MAX(r.max, height);
+				}
+			}
+
+			pyramid[bz * level.width + bx] = r;
+		}
+	}
+	pyramid_levels.push_back(level);
+
+	// Each level merges 2x2 blocks of the previous one, up to a single block.
+	while (level.width > 1 || level.depth > 1) {
+		PyramidLevel prev_level = level;
+
+		level.offset = pyramid.size();
+		level.width = (prev_level.width + 1) / 2;
+		level.depth = (prev_level.depth + 1) / 2;
+		pyramid.resize(level.offset + level.width * level.depth);
+
+		for (int bz = 0; bz < level.depth; ++bz) {
+			for (int bx = 0; bx < level.width; ++bx) {
+				Range r = pyramid[prev_level.offset + (bz * 2) * prev_level.width + bx * 2];
+
+				for (int z = bz * 2; z < MIN(bz * 2 + 2, prev_level.depth); ++z) {
+					for (int x = bx * 2; x < MIN(bx * 2 + 2, prev_level.width); ++x) {
+						const Range &child = pyramid[prev_level.offset + z * prev_level.width + x];
+						r.min = MIN(r.min, child.min);
+						r.max = MAX(r.max, child.max);
+					}
+				}
+
+				pyramid[level.offset + bz * level.width + bx] = r;
+			}
+		}
+		pyramid_levels.push_back(level);
+	}
+}
+
 void GodotHeightMapShape3D::_setup(const Vector<real_t> &p_heights, int p_width, int p_depth, real_t p_min_height, real_t p_max_height) {
 	heights = p_heights;
 	width = p_width;
@@ -2104,6 +2288,7 @@ void GodotHeightMapShape3D::_setup(const Vector<real_t> &p_heights, int p_width,
 	aabb.position -= local_origin;
 
 	_build_accelerator();
+	_build_pyramid();
 
 	configure(aabb);
 }
@@ -300,37 +300,55 @@ public:
 	GodotConvexPolygonShape3D();
 };
 
-struct _Volume_BVH;
+struct _Volume_BVH_Element;
 struct GodotFaceShape3D;
 
 struct GodotConcavePolygonShape3D : public GodotConcaveShape3D {
 	// always a trimesh
 
+	// Faces and their vertices (three per face) are stored in the order of the BVH leaves.
 	struct Face {
 		Vector3 normal;
-		int indices[3] = {};
 	};
 
 	Vector<Face> faces;
 	Vector<Vector3> vertices;
+	LocalVector<uint32_t> source_faces; // Index each face had in the data the shape was set up with.
 
-	struct BVH {
-		AABB aabb;
-		int left = 0;
-		int right = 0;
+	static const int BVH_MAX_LEAF_FACES = 4;
+	static const uint32_t BVH_LEAF_FLAG = 1u << 31;
+	static const uint32_t BVH_LEAF_COUNT_BITS = 3;
+	static const uint32_t BVH_LEAF_COUNT_MASK = (1 << BVH_LEAF_COUNT_BITS) - 1;
 
-		int face_index = 0;
+	// Nodes are stored depth first with their bounds quantized to the shape AABB,
+	// so a query can walk the array linearly and skip subtrees it doesn't touch.
+	struct BVH {
+		uint16_t min[3] = {};
+		uint16_t max[3] = {};
+		// Leaf: BVH_LEAF_FLAG, first face and face count - 1.
+		// Branch: index of the node right after its subtree.
+		uint32_t data = 0;
+
+		_FORCE_INLINE_ bool is_leaf() const { return data & BVH_LEAF_FLAG; }
+		_FORCE_INLINE_ uint32_t get_skip_index() const { return data; }
+		_FORCE_INLINE_ uint32_t get_first_face() const { return (data & ~BVH_LEAF_FLAG) >> BVH_LEAF_COUNT_BITS; }
+		_FORCE_INLINE_ uint32_t get_face_count() const { return (data & BVH_LEAF_COUNT_MASK) + 1; }
 	};
 
-	Vector<BVH> bvh;
+	LocalVector<BVH> bvh;
+
+	Vector3 bvh_quantize_origin;
+	Vector3 bvh_quantize_scale;
+	Vector3 bvh_dequantize_scale;
 
 	struct _CullParams {
+		uint16_t min[3] = {};
+		uint16_t max[3] = {};
 		AABB aabb;
 		QueryCallback callback = nullptr;
 		void *userdata = nullptr;
 		const Face *faces = nullptr;
 		const Vector3 *vertices = nullptr;
-		const BVH *bvh = nullptr;
 		GodotFaceShape3D *face = nullptr;
 	};
 
@@ -340,7 +358,6 @@ struct GodotConcavePolygonShape3D : public GodotConcaveShape3D {
 		Vector3 dir;
 		const Face *faces = nullptr;
 		const Vector3 *vertices = nullptr;
-		const BVH *bvh = nullptr;
 		GodotFaceShape3D *face = nullptr;
 
 		Vector3 result;
@@ -349,12 +366,23 @@ struct GodotConcavePolygonShape3D : public GodotConcaveShape3D {
 		int collisions = 0;
 	};
 
+	struct _BuildParams {
+		const Vector3 *src_vertices = nullptr;
+		Face *faces = nullptr;
+		Vector3 *vertices = nullptr;
+		uint32_t *source_faces = nullptr;
+		uint32_t face_count = 0;
+	};
+
 	bool backface_collision = false;
 
-	void _cull_segment(int p_idx, _SegmentCullParams *p_params) const;
-	bool _cull(int p_idx, _CullParams *p_params) const;
+	void _quantize_aabb(const AABB &p_aabb, uint16_t r_min[3], uint16_t r_max[3]) const;
+	AABB _dequantize_aabb(const BVH &p_node) const;
 
-	void _fill_bvh(_Volume_BVH *p_bvh_tree, BVH *p_bvh_array, int &p_idx);
+	void _cull_segment(_SegmentCullParams *p_params) const;
+	bool _cull(_CullParams *p_params) const;
+
+	void _build_bvh(_Volume_BVH_Element *p_elements, int p_size, _BuildParams &p_params);
 
 	void _setup(const Vector<Vector3> &p_faces, bool p_backface_collision);
 
@@ -397,6 +425,23 @@ struct GodotHeightMapShape3D : public GodotConcaveShape3D {
 
 	static const int BOUNDS_CHUNK_SIZE = 16;
 
+	// Min/max pyramid over square blocks of cells, from PYRAMID_BLOCK_SIZE cells up to
+	// a single block for the whole map, so AABB queries can skip blocks out of their height range.
+	struct PyramidLevel {
+		uint32_t offset = 0;
+		int width = 0;
+		int depth = 0;
+	};
+	LocalVector<Range> pyramid;
+	LocalVector<PyramidLevel> pyramid_levels;
+
+	static const int PYRAMID_BLOCK_SIZE = 4;
+
+	_FORCE_INLINE_ const Range &_get_pyramid_block(int p_level, int p_x, int p_z) const {
+		const PyramidLevel &level = pyramid_levels[p_level];
+		return pyramid[level.offset + (p_z * level.width) + p_x];
+	}
+
 	_FORCE_INLINE_ const Range &_get_bounds_chunk(int p_x, int p_z) const {
 		return bounds_grid[(p_z * bounds_grid_width) + p_x];
 	}
@@ -414,6 +459,7 @@ struct GodotHeightMapShape3D : public GodotConcaveShape3D {
 	void _get_cell(const Vector3 &p_point, int &r_x, int &r_y, int &r_z) const;
 
 	void _build_accelerator();
+	void _build_pyramid();
 
 	template <typename ProcessFunction>
 	bool _intersect_grid_segment(ProcessFunction &p_process, const Vector3 &p_begin, const Vector3 &p_end, int p_width, int p_depth, const Vector3 &offset, Vector3 &r_point, Vector3 &r_normal) const;
@@ -33,6 +33,7 @@
 #include "godot_space_3d.h"
 
 #include "core/math/geometry_3d.h"
+#include "core/object/worker_thread_pool.h"
 #include "core/templates/rb_map.h"
 #include "servers/rendering_server.h"
 
@@ -194,17 +195,25 @@ void GodotSoftBody3D::update_normals_and_centroids() {
 }
 
 void GodotSoftBody3D::update_bounds() {
+	bool moved = compute_bounds();
+
+	if (nodes.is_empty()) {
+		deinitialize_shape();
+		return;
+	}
+
+	if (get_space()) {
+		initialize_shape(moved);
+	}
+}
+
+bool GodotSoftBody3D::compute_bounds() {
 	AABB prev_bounds = bounds;
 	prev_bounds.grow_by(collision_margin);
 
 	bounds = AABB();
 
 	const uint32_t nodes_count = nodes.size();
-	if (nodes_count == 0) {
-		deinitialize_shape();
-		return;
-	}
-
 	bool first = true;
 	bool moved = false;
 	for (uint32_t node_index = 0; node_index < nodes_count; ++node_index) {
@@ -220,9 +229,19 @@ void GodotSoftBody3D::update_bounds() {
 		}
 	}
 
+	return moved;
+}
+
+void GodotSoftBody3D::update_shape_bounds() {
+	if (nodes.is_empty()) {
+		deinitialize_shape();
+		return;
+	}
+
 	if (get_space()) {
-		initialize_shape(moved);
+		initialize_shape(bounds_moved);
 	}
+	bounds_moved = false;
 }
 
 void GodotSoftBody3D::update_constants() {
@@ -696,135 +715,92 @@ void GodotSoftBody3D::generate_bending_constraints(int p_distance) {
 	}
 }
 
-//===================================================================
-//
-//
-// This function takes in a list of interdependent Links and tries
-// to maximize the distance between calculation
-// of dependent links. This increases the amount of parallelism that can
-// be exploited by out-of-order instruction processors with large but
-// (inevitably) finite instruction windows.
-//
-//===================================================================
-
-// A small structure to track lists of dependent link calculations.
-class LinkDeps {
-public:
-	// A link calculation that is dependent on this one.
-	// Positive values = "input A" while negative values = "input B".
-	int value;
-	// Next dependence in the list.
-	LinkDeps *next;
-};
-typedef LinkDeps *LinkDepsPtr;
-
 void GodotSoftBody3D::reoptimize_link_order() {
-	const int reop_not_dependent = -1;
-	const int reop_node_complete = -2;
-
-	uint32_t i, link_count = links.size(), node_count = nodes.size();
-	Link *lr;
-	int ar, br;
-	Node *node0 = &(nodes[0]);
-	Node *node1 = &(nodes[1]);
-	LinkDepsPtr link_dep;
-	int ready_list_head, ready_list_tail, link_num, link_dep_frees, dep_link;
-
-	// Allocate temporary buffers.
-	int *node_written_at = memnew_arr(int, node_count + 1); // What link calculation produced this node's current values?
-	int *link_dep_A = memnew_arr(int, link_count); // Link calculation input is dependent upon prior calculation #N
-	int *link_dep_B = memnew_arr(int, link_count);
-	int *ready_list = memnew_arr(int, link_count); // List of ready-to-process link calculations (# of links, maximum)
-	LinkDeps *link_dep_free_list = memnew_arr(LinkDeps, 2 * link_count); // Dependent-on-me list elements (2x# of links, maximum)
-	LinkDepsPtr *link_dep_list_starts = memnew_arr(LinkDepsPtr, link_count); // Start nodes of dependent-on-me lists, one for each link
-
-	// Copy the original, unsorted links to a side buffer.
-	Link *link_buffer = memnew_arr(Link, link_count);
-	memcpy(link_buffer, &(links[0]), sizeof(Link) * link_count);
-
-	// Clear out the node setup and ready list.
-	for (i = 0; i < node_count + 1; i++) {
-		node_written_at[i] = reop_not_dependent;
-	}
-	for (i = 0; i < link_count; i++) {
-		link_dep_list_starts[i] = nullptr;
-	}
-	ready_list_head = ready_list_tail = link_dep_frees = 0;
-
-	// Initial link analysis to set up data structures.
-	for (i = 0; i < link_count; i++) {
-		// Note which prior link calculations we are dependent upon & build up dependence lists.
-		lr = &(links[i]);
-		ar = (lr->n[0] - node0) / (node1 - node0);
-		br = (lr->n[1] - node0) / (node1 - node0);
-		if (node_written_at[ar] > reop_not_dependent) {
-			link_dep_A[i] = node_written_at[ar];
-			link_dep = &link_dep_free_list[link_dep_frees++];
-			link_dep->value = i;
-			link_dep->next = link_dep_list_starts[node_written_at[ar]];
-			link_dep_list_starts[node_written_at[ar]] = link_dep;
-		} else {
-			link_dep_A[i] = reop_not_dependent;
-		}
-		if (node_written_at[br] > reop_not_dependent) {
-			link_dep_B[i] = node_written_at[br];
-			link_dep = &link_dep_free_list[link_dep_frees++];
-			link_dep->value = -(int)(i + 1);
-			link_dep->next = link_dep_list_starts[node_written_at[br]];
-			link_dep_list_starts[node_written_at[br]] = link_dep;
-		} else {
-			link_dep_B[i] = reop_not_dependent;
-		}
+	// Greedy graph coloring of the links: links of the same color share no node,
+	// so each color batch has no dependency between its link calculations.
+	// This lets out-of-order processors overlap them, and lets large batches
+	// be split across threads without changing the result.
+	const uint32_t link_count = links.size();
+	const uint32_t node_count = nodes.size();
+
+	link_batches.clear();
+	if (link_count == 0) {
+		return;
+	}
+
+	// Node to link adjacency, in compressed rows.
+	LocalVector<uint32_t> node_link_offsets;
+	node_link_offsets.resize(node_count + 1);
+	memset(node_link_offsets.ptr(), 0, node_link_offsets.size() * sizeof(uint32_t));
+	for (uint32_t i = 0; i < link_count; ++i) {
+		node_link_offsets[links[i].node_index[0] + 1]++;
+		node_link_offsets[links[i].node_index[1] + 1]++;
+	}
+	for (uint32_t i = 0; i < node_count; ++i) {
+		node_link_offsets[i + 1] += node_link_offsets[i];
+	}
 
-		// Add this link to the initial ready list, if it is not dependent on any other links.
-		if ((link_dep_A[i] == reop_not_dependent) && (link_dep_B[i] == reop_not_dependent)) {
-			ready_list[ready_list_tail++] = i;
-			link_dep_A[i] = link_dep_B[i] = reop_node_complete; // Probably not needed now.
+	LocalVector<uint32_t> node_links;
+	node_links.resize(link_count * 2);
+	{
+		LocalVector<uint32_t> fill = node_link_offsets;
+		for (uint32_t i = 0; i < link_count; ++i) {
+			node_links[fill[links[i].node_index[0]]++] = i;
+			node_links[fill[links[i].node_index[1]]++] = i;
 		}
+	}
 
-		// Update the nodes to mark which ones are calculated by this link.
-		node_written_at[ar] = node_written_at[br] = i;
-	}
-
-	// Process the ready list and create the sorted list of links:
-	// -- By treating the ready list as a queue, we maximize the distance between any
-	//    inter-dependent node calculations.
-	// -- All other (non-related) nodes in the ready list will automatically be inserted
-	//    in between each set of inter-dependent link calculations by this loop.
-	i = 0;
-	while (ready_list_head != ready_list_tail) {
-		// Use ready list to select the next link to process.
-		link_num = ready_list[ready_list_head++];
-		// Copy the next-to-calculate link back into the original link array.
-		links[i++] = link_buffer[link_num];
-
-		// Free up any link inputs that are dependent on this one.
-		link_dep = link_dep_list_starts[link_num];
-		while (link_dep) {
-			dep_link = link_dep->value;
-			if (dep_link >= 0) {
-				link_dep_A[dep_link] = reop_not_dependent;
-			} else {
-				dep_link = -dep_link - 1;
-				link_dep_B[dep_link] = reop_not_dependent;
-			}
-			// Add this dependent link calculation to the ready list if *both* inputs are clear.
-			if ((link_dep_A[dep_link] == reop_not_dependent) && (link_dep_B[dep_link] == reop_not_dependent)) {
-				ready_list[ready_list_tail++] = dep_link;
-				link_dep_A[dep_link] = link_dep_B[dep_link] = reop_node_complete; // Probably not needed now.
+	// Assign to each link the smallest color not used by a link sharing one of its nodes.
+	const uint32_t uncolored = UINT32_MAX;
+	LocalVector<uint32_t> link_colors;
+	link_colors.resize(link_count);
+	for (uint32_t i = 0; i < link_count; ++i) {
+		link_colors[i] = uncolored;
+	}
+
+	LocalVector<uint32_t> color_marks; // Last link which marked each color as used.
+	LocalVector<uint32_t> color_sizes;
+	for (uint32_t i = 0; i < link_count; ++i) {
+		for (int j = 0; j < 2; ++j) {
+			const uint32_t node_index = links[i].node_index[j];
+			for (uint32_t k = node_link_offsets[node_index]; k < node_link_offsets[node_index + 1]; ++k) {
+				const uint32_t color = link_colors[node_links[k]];
+				if (color != uncolored) {
+					color_marks[color] = i;
+				}
 			}
-			link_dep = link_dep->next;
 		}
+
+		uint32_t color = 0;
+		while (color < color_marks.size() && color_marks[color] == i) {
+			color++;
+		}
+		if (color == color_marks.size()) {
+			color_marks.push_back(i);
+			color_sizes.push_back(0);
+		}
+
+		link_colors[i] = color;
+		color_sizes[color]++;
+	}
+
+	// Sort the links by color, keeping their relative order within a batch.
+	const uint32_t color_count = color_sizes.size();
+	link_batches.resize(color_count + 1);
+	link_batches[0] = 0;
+	for (uint32_t i = 0; i < color_count; ++i) {
+		link_batches[i + 1] = link_batches[i] + color_sizes[i];
 	}
 
-	// Delete the temporary buffers.
-	memdelete_arr(node_written_at);
-	memdelete_arr(link_dep_A);
-	memdelete_arr(link_dep_B);
-	memdelete_arr(ready_list);
-	memdelete_arr(link_dep_free_list);
-	memdelete_arr(link_dep_list_starts);
-	memdelete_arr(link_buffer);
+	LocalVector<Link> sorted_links;
+	sorted_links.resize(link_count);
+	{
+		LocalVector<uint32_t> fill = link_batches;
+		for (uint32_t i = 0; i < link_count; ++i) {
+			sorted_links[fill[link_colors[i]]++] = links[i];
+		}
+	}
+	links = sorted_links;
 }
 
 void GodotSoftBody3D::append_link(uint32_t p_node1, uint32_t p_node2) {
@@ -838,6 +814,8 @@ void GodotSoftBody3D::append_link(uint32_t p_node1, uint32_t p_node2) {
 	Link link;
 	link.n[0] = node1;
 	link.n[1] = node2;
+	link.node_index[0] = p_node1;
+	link.node_index[1] = p_node2;
 	link.rl = (node1->x - node2->x).length();
 
 	links.push_back(link);
@@ -1055,8 +1033,9 @@ void GodotSoftBody3D::predict_motion(real_t p_delta) {
 		node.f = Vector3();
 	}
 
-	// Bounds and tree update.
-	update_bounds();
+	// Bounds update, the shape is updated later in update_shape_bounds()
+	// because it modifies the broadphase.
+	bounds_moved = compute_bounds() || bounds_moved;
 
 	// Node tree update.
 	for (i = 0, ni = nodes.size(); i < ni; ++i) {
@@ -1079,33 +1058,33 @@ void GodotSoftBody3D::predict_motion(real_t p_delta) {
 	face_tree.optimize_incremental(1);
 }
 
-void GodotSoftBody3D::solve_constraints(real_t p_delta) {
+void GodotSoftBody3D::solve_constraints(real_t p_delta, bool p_multithreaded) {
 	const real_t inv_delta = 1.0 / p_delta;
 
 	uint32_t i, ni;
 
-	for (i = 0, ni = links.size(); i < ni; ++i) {
-		Link &link = links[i];
-		link.c3 = link.n[1]->q - link.n[0]->q;
-		link.c2 = 1 / (link.c3.length_squared() * link.c0);
-	}
-
-	// Solve velocities.
-	for (i = 0, ni = nodes.size(); i < ni; ++i) {
-		Node &node = nodes[i];
-		node.x = node.q + node.v * p_delta;
+	// Solve velocities, and pack the data used by the link solver.
+	ni = nodes.size();
+	solver_positions.resize(ni);
+	solver_inv_masses.resize(ni);
+	Vector3 *positions = solver_positions.ptr();
+	real_t *inv_masses = solver_inv_masses.ptr();
+	for (i = 0; i < ni; ++i) {
+		const Node &node = nodes[i];
+		positions[i] = node.q + node.v * p_delta;
+		inv_masses[i] = node.im;
 	}
 
 	// Solve positions.
 	for (int isolve = 0; isolve < iteration_count; ++isolve) {
 		const real_t ti = isolve / (real_t)iteration_count;
-		solve_links(1.0, ti);
+		solve_links(1.0, ti, p_multithreaded);
 	}
 	const real_t vc = (1.0 - damping_coefficient) * inv_delta;
-	for (i = 0, ni = nodes.size(); i < ni; ++i) {
+	for (i = 0; i < ni; ++i) {
 		Node &node = nodes[i];
 
-		node.x += node.bv * p_delta;
+		node.x = positions[i] + node.bv * p_delta;
 		node.bv = Vector3();
 
 		node.v = (node.x - node.q) * vc;
@@ -1116,18 +1095,49 @@ void GodotSoftBody3D::solve_constraints(real_t p_delta) {
 	update_normals_and_centroids();
 }
 
-void GodotSoftBody3D::solve_links(real_t kst, real_t ti) {
-	for (uint32_t i = 0, ni = links.size(); i < ni; ++i) {
-		Link &link = links[i];
+void GodotSoftBody3D::solve_links(real_t kst, real_t ti, bool p_multithreaded) {
+	for (uint32_t batch_index = 0; batch_index + 1 < link_batches.size(); ++batch_index) {
+		const uint32_t begin = link_batches[batch_index];
+		const uint32_t end = link_batches[batch_index + 1];
+
+		if (!p_multithreaded || end - begin < LINK_BATCH_MULTITHREAD_THRESHOLD) {
+			solve_link_range(begin, end, kst);
+			continue;
+		}
+
+		LinkBatchParams params;
+		params.begin = begin;
+		params.end = end;
+		params.kst = kst;
+
+		const uint32_t chunk_count = (end - begin + LINK_BATCH_CHUNK_SIZE - 1) / LINK_BATCH_CHUNK_SIZE;
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotSoftBody3D::_solve_link_batch_chunk, &params, chunk_count, -1, true, SNAME("Physics3DSoftBodyLinks"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	}
+}
+
+void GodotSoftBody3D::_solve_link_batch_chunk(uint32_t p_chunk_index, LinkBatchParams *p_params) {
+	const uint32_t begin = p_params->begin + p_chunk_index * LINK_BATCH_CHUNK_SIZE;
+	const uint32_t end = MIN(begin + LINK_BATCH_CHUNK_SIZE, p_params->end);
+	solve_link_range(begin, end, p_params->kst);
+}
+
+void GodotSoftBody3D::solve_link_range(uint32_t p_begin, uint32_t p_end, real_t p_kst) {
+	const Link *link_ptr = links.ptr();
+	Vector3 *positions = solver_positions.ptr();
+	const real_t *inv_masses = solver_inv_masses.ptr();
+
+	for (uint32_t i = p_begin; i < p_end; ++i) {
+		const Link &link = link_ptr[i];
 		if (link.c0 > 0) {
-			Node &node_a = *link.n[0];
-			Node &node_b = *link.n[1];
-			const Vector3 del = node_b.x - node_a.x;
+			const uint32_t index_a = link.node_index[0];
+			const uint32_t index_b = link.node_index[1];
+			const Vector3 del = positions[index_b] - positions[index_a];
 			const real_t len = del.length_squared();
 			if (link.c1 + len > CMP_EPSILON) {
-				const real_t k = ((link.c1 - len) / (link.c0 * (link.c1 + len))) * kst;
-				node_a.x -= del * (k * node_a.im);
-				node_b.x += del * (k * node_b.im);
+				const real_t k = ((link.c1 - len) / (link.c0 * (link.c1 + len))) * p_kst;
+				positions[index_a] -= del * (k * inv_masses[index_a]);
+				positions[index_b] += del * (k * inv_masses[index_b]);
 			}
 		}
 	}
@@ -1244,6 +1254,7 @@ void GodotSoftBody3D::destroy() {
 
 	nodes.clear();
 	links.clear();
+	link_batches.clear();
 	faces.clear();
 
 	bounds = AABB();
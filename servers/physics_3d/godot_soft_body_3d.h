@@ -61,14 +61,18 @@ class GodotSoftBody3D : public GodotCollisionObject3D {
 	};
 
 	struct Link {
-		Vector3 c3; // gradient
 		Node *n[2] = { nullptr, nullptr }; // Node pointers
+		uint32_t node_index[2] = { 0, 0 }; // Node indices in the packed solver arrays
 		real_t rl = 0.0; // Rest length
 		real_t c0 = 0.0; // (ima+imb)*kLST
 		real_t c1 = 0.0; // rl^2
-		real_t c2 = 0.0; // |gradient|^2/c0
 	};
 
+	// Links of a batch share no node, so a batch can be solved in any order or in parallel.
+	// Large batches are split into chunks of this many links when solving on multiple threads.
+	static const uint32_t LINK_BATCH_CHUNK_SIZE = 1024;
+	static const uint32_t LINK_BATCH_MULTITHREAD_THRESHOLD = 4 * LINK_BATCH_CHUNK_SIZE;
+
 	struct Face {
 		Vector3 centroid;
 		Node *n[3] = { nullptr, nullptr, nullptr }; // Node pointers
@@ -80,14 +84,20 @@ class GodotSoftBody3D : public GodotCollisionObject3D {
 
 	LocalVector<Node> nodes;
 	LocalVector<Link> links;
+	LocalVector<uint32_t> link_batches; // Offsets of each color batch in links, plus the end.
 	LocalVector<Face> faces;
 
+	// Node data packed for the link solver, filled from nodes during solve_constraints.
+	LocalVector<Vector3> solver_positions;
+	LocalVector<real_t> solver_inv_masses;
+
 	DynamicBVH node_tree;
 	DynamicBVH face_tree;
 
 	LocalVector<uint32_t> map_visual_to_physics;
 
 	AABB bounds;
+	bool bounds_moved = false;
 
 	real_t collision_margin = 0.05;
 
@@ -201,8 +211,10 @@ public:
 	void set_drag_coefficient(real_t p_val);
 	_FORCE_INLINE_ real_t get_drag_coefficient() const { return drag_coefficient; }
 
+	// Thread-safe for different soft bodies, the broadphase is only updated in update_shape_bounds().
 	void predict_motion(real_t p_delta);
-	void solve_constraints(real_t p_delta);
+	void update_shape_bounds();
+	void solve_constraints(real_t p_delta, bool p_multithreaded = false);
 
 	_FORCE_INLINE_ uint32_t get_node_index(void *p_node) const { return static_cast<Node *>(p_node)->index; }
 	_FORCE_INLINE_ uint32_t get_face_index(void *p_face) const { return static_cast<Face *>(p_face)->index; }
@@ -220,6 +232,7 @@ protected:
 private:
 	void update_normals_and_centroids();
 	void update_bounds();
+	bool compute_bounds();
 	void update_constants();
 	void update_area();
 	void reset_link_rest_lengths();
@@ -237,7 +250,15 @@ private:
 	void append_link(uint32_t p_node1, uint32_t p_node2);
 	void append_face(uint32_t p_node1, uint32_t p_node2, uint32_t p_node3);
 
-	void solve_links(real_t kst, real_t ti);
+	void solve_links(real_t kst, real_t ti, bool p_multithreaded);
+	void solve_link_range(uint32_t p_begin, uint32_t p_end, real_t p_kst);
+
+	struct LinkBatchParams {
+		uint32_t begin = 0;
+		uint32_t end = 0;
+		real_t kst = 0.0;
+	};
+	void _solve_link_batch_chunk(uint32_t p_chunk_index, LinkBatchParams *p_params);
 
 	void initialize_face_tree();
 	void update_face_tree(real_t p_delta);
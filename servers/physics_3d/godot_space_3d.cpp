@@ -1064,6 +1064,34 @@ void GodotSpace3D::_broadphase_unpair(GodotCollisionObject3D *A, int p_subindex_
 	memdelete(c);
 }
 
+void GodotSpace3D::BodyIntegration::resize_for_forces() {
+	const uint32_t size = bodies.size();
+	for (int i = 0; i < 3; i++) {
+		linear_velocity[i].resize(size);
+		angular_velocity[i].resize(size);
+		force[i].resize(size);
+		torque[i].resize(size);
+	}
+	for (int i = 0; i < 9; i++) {
+		inv_inertia_tensor[i].resize(size);
+	}
+	inv_mass.resize(size);
+	linear_damp.resize(size);
+	angular_damp.resize(size);
+}
+
+void GodotSpace3D::BodyIntegration::resize_for_velocities() {
+	const uint32_t size = bodies.size();
+	for (int i = 0; i < 3; i++) {
+		origin[i].resize(size);
+		linear_velocity[i].resize(size);
+		angular_velocity[i].resize(size);
+	}
+	basis.resize(size);
+	center_of_mass_local.resize(size);
+	motion_step.resize(size);
+}
+
 const SelfList<GodotBody3D>::List &GodotSpace3D::get_active_body_list() const {
 	return active_list;
 }
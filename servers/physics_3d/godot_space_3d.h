@@ -41,6 +41,7 @@
 
 #include "core/config/project_settings.h"
 #include "core/templates/hash_map.h"
+#include "core/templates/local_vector.h"
 #include "core/typedefs.h"
 
 class GodotPhysicsDirectSpaceState3D : public PhysicsDirectSpaceState3D {
@@ -72,6 +73,62 @@ public:
 
 	};
 
+	// Integration state of the bodies moved by the step, mirrored one component per array
+	// so the step integrates them in tight loops. Filled by the bodies, each in its own slot.
+	struct BodyIntegration {
+		LocalVector<GodotBody3D *> bodies;
+
+		// Forces pass.
+		LocalVector<real_t> linear_velocity[3];
+		LocalVector<real_t> angular_velocity[3];
+		LocalVector<real_t> force[3];
+		LocalVector<real_t> torque[3];
+		LocalVector<real_t> inv_mass;
+		LocalVector<real_t> inv_inertia_tensor[9];
+		LocalVector<real_t> linear_damp;
+		LocalVector<real_t> angular_damp;
+
+		// Velocities pass, which uses the velocity arrays for the total velocities.
+		LocalVector<real_t> origin[3];
+		LocalVector<Basis> basis;
+		LocalVector<Vector3> center_of_mass_local;
+		LocalVector<real_t> motion_step;
+
+		void clear() { bodies.clear(); }
+		void resize_for_forces();
+		void resize_for_velocities();
+
+		_FORCE_INLINE_ void set_forces(uint32_t p_index, const Vector3 &p_linear_velocity, const Vector3 &p_angular_velocity, const Vector3 &p_force, const Vector3 &p_torque, real_t p_inv_mass, const Basis &p_inv_inertia_tensor, real_t p_linear_damp, real_t p_angular_damp) {
+			for (int i = 0; i < 3; i++) {
+				linear_velocity[i][p_index] = p_linear_velocity[i];
+				angular_velocity[i][p_index] = p_angular_velocity[i];
+				force[i][p_index] = p_force[i];
+				torque[i][p_index] = p_torque[i];
+				for (int j = 0; j < 3; j++) {
+					inv_inertia_tensor[i * 3 + j][p_index] = p_inv_inertia_tensor.rows[i][j];
+				}
+			}
+			inv_mass[p_index] = p_inv_mass;
+			linear_damp[p_index] = p_linear_damp;
+			angular_damp[p_index] = p_angular_damp;
+		}
+
+		_FORCE_INLINE_ void set_motion(uint32_t p_index, const Transform3D &p_transform, const Vector3 &p_linear_velocity, const Vector3 &p_angular_velocity, const Vector3 &p_center_of_mass_local, real_t p_motion_step) {
+			for (int i = 0; i < 3; i++) {
+				origin[i][p_index] = p_transform.origin[i];
+				linear_velocity[i][p_index] = p_linear_velocity[i];
+				angular_velocity[i][p_index] = p_angular_velocity[i];
+			}
+			basis[p_index] = p_transform.basis;
+			center_of_mass_local[p_index] = p_center_of_mass_local;
+			motion_step[p_index] = p_motion_step;
+		}
+
+		_FORCE_INLINE_ Vector3 get_linear_velocity(uint32_t p_index) const { return Vector3(linear_velocity[0][p_index], linear_velocity[1][p_index], linear_velocity[2][p_index]); }
+		_FORCE_INLINE_ Vector3 get_angular_velocity(uint32_t p_index) const { return Vector3(angular_velocity[0][p_index], angular_velocity[1][p_index], angular_velocity[2][p_index]); }
+		_FORCE_INLINE_ Transform3D get_transform(uint32_t p_index) const { return Transform3D(basis[p_index], Vector3(origin[0][p_index], origin[1][p_index], origin[2][p_index])); }
+	};
+
 private:
 	uint64_t elapsed_time[ELAPSED_TIME_MAX] = {};
 
@@ -91,6 +148,8 @@ private:
 
 	HashSet<GodotCollisionObject3D *> objects;
 
+	BodyIntegration body_integration;
+
 	GodotArea3D *area = nullptr;
 
 	int solver_iterations = 0;
@@ -154,6 +213,8 @@ public:
 	void soft_body_add_to_active_list(SelfList<GodotSoftBody3D> *p_soft_body);
 	void soft_body_remove_from_active_list(SelfList<GodotSoftBody3D> *p_soft_body);
 
+	_FORCE_INLINE_ BodyIntegration &get_body_integration() { return body_integration; }
+
 	GodotBroadPhase3D *get_broadphase();
 
 	void add_object(GodotCollisionObject3D *p_object);
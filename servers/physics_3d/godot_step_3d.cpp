@@ -39,6 +39,7 @@
 #define ISLAND_COUNT_RESERVE 128
 #define ISLAND_SIZE_RESERVE 512
 #define CONSTRAINT_COUNT_RESERVE 1024
+#define INTEGRATION_CHUNK_SIZE 256
 
 void GodotStep3D::_populate_island(GodotBody3D *p_body, LocalVector<GodotBody3D *> &p_body_island, LocalVector<GodotConstraint3D *> &p_constraint_island) {
 	p_body->set_island_step(_step);
@@ -181,6 +182,108 @@ void GodotStep3D::_check_suspend(const LocalVector<GodotBody3D *> &p_body_island
 	}
 }
 
+void GodotStep3D::_integrate_body_forces(uint32_t p_body_index, void *p_userdata) {
+	active_bodies[p_body_index]->integrate_forces(delta);
+}
+
+void GodotStep3D::_integrate_body_velocities(uint32_t p_body_index, void *p_userdata) {
+	active_bodies[p_body_index]->integrate_velocities(delta);
+}
+
+void GodotStep3D::_integrate_forces_chunk(uint32_t p_chunk_index, void *p_userdata) {
+	GodotSpace3D::BodyIntegration &bi = *body_integration;
+	const uint32_t from = p_chunk_index * INTEGRATION_CHUNK_SIZE;
+	const uint32_t to = MIN(from + INTEGRATION_CHUNK_SIZE, bi.bodies.size());
+
+	real_t *lv_x = bi.linear_velocity[0].ptr();
+	real_t *lv_y = bi.linear_velocity[1].ptr();
+	real_t *lv_z = bi.linear_velocity[2].ptr();
+	real_t *av_x = bi.angular_velocity[0].ptr();
+	real_t *av_y = bi.angular_velocity[1].ptr();
+	real_t *av_z = bi.angular_velocity[2].ptr();
+	const real_t *f_x = bi.force[0].ptr();
+	const real_t *f_y = bi.force[1].ptr();
+	const real_t *f_z = bi.force[2].ptr();
+	const real_t *t_x = bi.torque[0].ptr();
+	const real_t *t_y = bi.torque[1].ptr();
+	const real_t *t_z = bi.torque[2].ptr();
+	const real_t *inv_mass = bi.inv_mass.ptr();
+	const real_t *it[9]; // Inverse inertia tensor, by row.
+	for (int i = 0; i < 9; i++) {
+		it[i] = bi.inv_inertia_tensor[i].ptr();
+	}
+	const real_t *linear_damp = bi.linear_damp.ptr();
+	const real_t *angular_damp = bi.angular_damp.ptr();
+	const real_t step = delta;
+
+	// No branches nor calls, so the compiler can vectorize it.
+	for (uint32_t i = from; i < to; i++) {
+		const real_t linear_step = inv_mass[i] * step;
+		lv_x[i] = lv_x[i] * linear_damp[i] + f_x[i] * linear_step;
+		lv_y[i] = lv_y[i] * linear_damp[i] + f_y[i] * linear_step;
+		lv_z[i] = lv_z[i] * linear_damp[i] + f_z[i] * linear_step;
+
+		av_x[i] = av_x[i] * angular_damp[i] + (it[0][i] * t_x[i] + it[1][i] * t_y[i] + it[2][i] * t_z[i]) * step;
+		av_y[i] = av_y[i] * angular_damp[i] + (it[3][i] * t_x[i] + it[4][i] * t_y[i] + it[5][i] * t_z[i]) * step;
+		av_z[i] = av_z[i] * angular_damp[i] + (it[6][i] * t_x[i] + it[7][i] * t_y[i] + it[8][i] * t_z[i]) * step;
+	}
+
+	for (uint32_t i = from; i < to; i++) {
+		bi.bodies[i]->set_integrated_velocities(bi.get_linear_velocity(i), bi.get_angular_velocity(i), step);
+	}
+}
+
+void GodotStep3D::_integrate_velocities_chunk(uint32_t p_chunk_index, void *p_userdata) {
+	GodotSpace3D::BodyIntegration &bi = *body_integration;
+	const uint32_t from = p_chunk_index * INTEGRATION_CHUNK_SIZE;
+	const uint32_t to = MIN(from + INTEGRATION_CHUNK_SIZE, bi.bodies.size());
+
+	real_t *o_x = bi.origin[0].ptr();
+	real_t *o_y = bi.origin[1].ptr();
+	real_t *o_z = bi.origin[2].ptr();
+	const real_t *lv_x = bi.linear_velocity[0].ptr();
+	const real_t *lv_y = bi.linear_velocity[1].ptr();
+	const real_t *lv_z = bi.linear_velocity[2].ptr();
+	const real_t *motion_step = bi.motion_step.ptr();
+
+	// Rotations first, they move the origin around the center of mass.
+	const Basis identity3(1, 0, 0, 0, 1, 0, 0, 0, 1);
+	for (uint32_t i = from; i < to; i++) {
+		const Vector3 total_angular_velocity = bi.get_angular_velocity(i);
+		const real_t ang_vel = total_angular_velocity.length();
+		if (Math::is_zero_approx(ang_vel)) {
+			continue;
+		}
+
+		Basis &basis = bi.basis[i];
+		const Basis rot(total_angular_velocity / ang_vel, ang_vel * motion_step[i]);
+		const Vector3 offset = ((identity3 - rot) * basis).xform(bi.center_of_mass_local[i]);
+		o_x[i] += offset.x;
+		o_y[i] += offset.y;
+		o_z[i] += offset.z;
+		basis = rot * basis;
+		basis.orthonormalize();
+	}
+
+	for (uint32_t i = from; i < to; i++) {
+		o_x[i] += lv_x[i] * motion_step[i];
+		o_y[i] += lv_y[i] * motion_step[i];
+		o_z[i] += lv_z[i] * motion_step[i];
+	}
+
+	for (uint32_t i = from; i < to; i++) {
+		bi.bodies[i]->set_integrated_transform(bi.get_transform(i));
+	}
+}
+
+void GodotStep3D::_predict_soft_body_motion(uint32_t p_soft_body_index, void *p_userdata) {
+	active_soft_bodies[p_soft_body_index]->predict_motion(delta);
+}
+
+void GodotStep3D::_solve_soft_body_constraints(uint32_t p_soft_body_index, void *p_userdata) {
+	active_soft_bodies[p_soft_body_index]->solve_constraints(delta);
+}
+
 void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 	p_space->lock(); // can't access space during this
 
@@ -202,22 +305,58 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 
 	int active_count = 0;
 
+	body_integration = &p_space->get_body_integration();
+
+	// The dynamic bodies get a slot in the integration arrays, unless their forces are integrated by a callback.
+	active_bodies.clear();
+	body_integration->clear();
 	const SelfList<GodotBody3D> *b = body_list->first();
 	while (b) {
-		b->self()->integrate_forces(p_delta);
+		GodotBody3D *body = b->self();
+		if (body->get_mode() >= PhysicsServer3D::BODY_MODE_DYNAMIC && !body->get_omit_force_integration()) {
+			body->set_integration_index(body_integration->bodies.size());
+			body_integration->bodies.push_back(body);
+		} else {
+			body->set_integration_index(-1);
+		}
+		active_bodies.push_back(body);
 		b = b->next();
 		active_count++;
 	}
+	body_integration->resize_for_forces();
+
+	uint32_t body_count = active_bodies.size();
+	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep3D::_integrate_body_forces, nullptr, body_count, -1, true, SNAME("Physics3DIntegrateForces"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+
+	uint32_t chunk_count = (body_integration->bodies.size() + INTEGRATION_CHUNK_SIZE - 1) / INTEGRATION_CHUNK_SIZE;
+	group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep3D::_integrate_forces_chunk, nullptr, chunk_count, -1, true, SNAME("Physics3DIntegrateForcesSweep"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+
+	// Warning: This doesn't run on threads, because it updates the broadphase.
+	for (uint32_t body_index = 0; body_index < body_count; ++body_index) {
+		active_bodies[body_index]->update_integrated_motion();
+	}
 
 	/* UPDATE SOFT BODY MOTION */
 
+	active_soft_bodies.clear();
 	const SelfList<GodotSoftBody3D> *sb = soft_body_list->first();
 	while (sb) {
-		sb->self()->predict_motion(p_delta);
+		active_soft_bodies.push_back(sb->self());
 		sb = sb->next();
 		active_count++;
 	}
 
+	uint32_t soft_body_count = active_soft_bodies.size();
+	group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep3D::_predict_soft_body_motion, nullptr, soft_body_count, -1, true, SNAME("Physics3DSoftBodyPredictMotion"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+
+	// Warning: This doesn't run on threads, because it updates the broadphase.
+	for (uint32_t soft_body_index = 0; soft_body_index < soft_body_count; ++soft_body_index) {
+		active_soft_bodies[soft_body_index]->update_shape_bounds();
+	}
+
 	p_space->set_active_objects(active_count);
 
 	// Update the broadphase to register collision pairs.
@@ -343,7 +482,7 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 	/* SETUP CONSTRAINTS / PROCESS COLLISIONS */
 
 	uint32_t total_contraint_count = all_constraints.size();
-	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep3D::_setup_contraint, nullptr, total_contraint_count, -1, true, SNAME("Physics3DConstraintSetup"));
+	group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep3D::_setup_contraint, nullptr, total_contraint_count, -1, true, SNAME("Physics3DConstraintSetup"));
 	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
 
 	{ //profile
@@ -374,11 +513,34 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 
 	/* INTEGRATE VELOCITIES */
 
+	// Bodies can be woken up by the broadphase and the solver, gather them again.
+	active_bodies.clear();
+	body_integration->clear();
 	b = body_list->first();
 	while (b) {
-		const SelfList<GodotBody3D> *n = b->next();
-		b->self()->integrate_velocities(p_delta);
-		b = n;
+		GodotBody3D *body = b->self();
+		if (body->get_mode() >= PhysicsServer3D::BODY_MODE_DYNAMIC) {
+			body->set_integration_index(body_integration->bodies.size());
+			body_integration->bodies.push_back(body);
+		} else {
+			body->set_integration_index(-1);
+		}
+		active_bodies.push_back(body);
+		b = b->next();
+	}
+	body_integration->resize_for_velocities();
+
+	body_count = active_bodies.size();
+	group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep3D::_integrate_body_velocities, nullptr, body_count, -1, true, SNAME("Physics3DIntegrateVelocities"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+
+	chunk_count = (body_integration->bodies.size() + INTEGRATION_CHUNK_SIZE - 1) / INTEGRATION_CHUNK_SIZE;
+	group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep3D::_integrate_velocities_chunk, nullptr, chunk_count, -1, true, SNAME("Physics3DIntegrateVelocitiesSweep"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+
+	// Warning: This doesn't run on threads, because it updates the broadphase and the space lists.
+	for (uint32_t body_index = 0; body_index < body_count; ++body_index) {
+		active_bodies[body_index]->update_integrated_transform();
 	}
 
 	/* SLEEP / WAKE UP ISLANDS */
@@ -389,10 +551,12 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 
 	/* UPDATE SOFT BODY CONSTRAINTS */
 
-	sb = soft_body_list->first();
-	while (sb) {
-		sb->self()->solve_constraints(p_delta);
-		sb = sb->next();
+	if (soft_body_count == 1) {
+		// A single soft body can split its own link batches across threads instead.
+		active_soft_bodies[0]->solve_constraints(p_delta, true);
+	} else {
+		group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep3D::_solve_soft_body_constraints, nullptr, soft_body_count, -1, true, SNAME("Physics3DSoftBodyConstraints"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
 	}
 
 	{ //profile
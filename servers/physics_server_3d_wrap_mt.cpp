@@ -38,6 +38,7 @@ void PhysicsServer3DWrapMT::thread_exit() {
 
 void PhysicsServer3DWrapMT::thread_step(real_t p_delta) {
 	physics_server_3d->step(p_delta);
+	_snapshot_publish();
 	step_sem.post();
 }
 
@@ -64,10 +65,223 @@ void PhysicsServer3DWrapMT::thread_loop() {
 	physics_server_3d->finish();
 }
 
+/* STATE SNAPSHOTS */
+
+void PhysicsServer3DWrapMT::_snapshot_add_body(RID p_body) {
+	snapshot_bodies.insert(p_body);
+}
+
+void PhysicsServer3DWrapMT::_snapshot_remove_body(RID p_body) {
+	if (snapshot_bodies.erase(p_body)) {
+		snapshot_state_sync_callback_bodies.erase(p_body);
+		snapshot_force_integration_callback_bodies.erase(p_body);
+	}
+}
+
+void PhysicsServer3DWrapMT::_snapshot_publish() {
+	StateSnapshot &snapshot = state_snapshots[1 - state_snapshot_front];
+	snapshot.body_indices.clear();
+	snapshot.bodies.clear();
+
+	for (uint32_t i = 0; i < snapshot_published_bodies.size(); i++) {
+		const SnapshotQuery &query = snapshot_published_bodies[i];
+		if (!snapshot_bodies.has(query.body) || snapshot.body_indices.has(query.body)) {
+			continue; // Freed, or missed several times.
+		}
+		if (snapshot_state_sync_callback_bodies.has(query.body) || snapshot_force_integration_callback_bodies.has(query.body)) {
+			continue;
+		}
+
+		snapshot.body_indices.insert(query.body, snapshot.bodies.size());
+		snapshot.bodies.push_back(BodyStateSnapshot());
+		BodyStateSnapshot &body = snapshot.bodies[snapshot.bodies.size() - 1];
+		body.transform = physics_server_3d->body_get_state(query.body, BODY_STATE_TRANSFORM);
+		body.linear_velocity = physics_server_3d->body_get_state(query.body, BODY_STATE_LINEAR_VELOCITY);
+		body.angular_velocity = physics_server_3d->body_get_state(query.body, BODY_STATE_ANGULAR_VELOCITY);
+		body.sleeping = physics_server_3d->body_get_state(query.body, BODY_STATE_SLEEPING);
+		body.query_step = query.query_step;
+	}
+}
+
+void PhysicsServer3DWrapMT::_snapshot_swap() {
+	state_snapshot_front = 1 - state_snapshot_front;
+
+	// The step that was just waited for is the last one issued.
+	uint64_t step = steps_issued.get();
+	state_snapshots[state_snapshot_front].step = step;
+
+	// The next step publishes the bodies read recently from the retired snapshot, which
+	// holds the reads made since the previous swap, and the bodies that were missing.
+	const StateSnapshot &retired = state_snapshots[1 - state_snapshot_front];
+	snapshot_published_bodies.clear();
+	for (const KeyValue<RID, uint32_t> &E : retired.body_indices) {
+		const uint64_t query_step = retired.bodies[E.value].query_step;
+		if (query_step + SNAPSHOT_QUERY_KEEP_STEPS >= step) {
+			SnapshotQuery query;
+			query.body = E.key;
+			query.query_step = query_step;
+			snapshot_published_bodies.push_back(query);
+		}
+	}
+	for (uint32_t i = 0; i < snapshot_missed_bodies.size(); i++) {
+		SnapshotQuery query;
+		query.body = snapshot_missed_bodies[i];
+		query.query_step = step;
+		snapshot_published_bodies.push_back(query);
+	}
+	snapshot_missed_bodies.clear();
+
+	// Writes issued before that step are now part of the snapshot.
+	LocalVector<RID> published_writes;
+	for (const KeyValue<RID, uint64_t> &E : snapshot_written_bodies) {
+		if (E.value < step) {
+			published_writes.push_back(E.key);
+		}
+	}
+	for (uint32_t i = 0; i < published_writes.size(); i++) {
+		snapshot_written_bodies.erase(published_writes[i]);
+	}
+}
+
+void PhysicsServer3DWrapMT::_snapshot_body_written(RID p_body) {
+	if (!create_thread) {
+		return;
+	}
+
+	if (Thread::get_caller_id() == main_thread) {
+		snapshot_written_bodies[p_body] = steps_issued.get();
+	} else {
+		snapshot_foreign_write_step.set(steps_issued.get());
+	}
+}
+
+bool PhysicsServer3DWrapMT::_snapshot_get_body_state(RID p_body, BodyState p_state, Variant &r_value) const {
+	const StateSnapshot &snapshot = state_snapshots[state_snapshot_front];
+	const uint32_t *index = snapshot.body_indices.getptr(p_body);
+	if (!index) {
+		// Published from the next step on.
+		snapshot_missed_bodies.push_back(p_body);
+		return false;
+	}
+
+	BodyStateSnapshot &body = snapshot.bodies[*index];
+	body.query_step = snapshot.step;
+
+	if (snapshot.step <= snapshot_foreign_write_step.get()) {
+		return false;
+	}
+
+	const uint64_t *write_step = snapshot_written_bodies.getptr(p_body);
+	if (write_step && snapshot.step <= *write_step) {
+		return false;
+	}
+
+	switch (p_state) {
+		case BODY_STATE_TRANSFORM: {
+			r_value = body.transform;
+		} break;
+		case BODY_STATE_LINEAR_VELOCITY: {
+			r_value = body.linear_velocity;
+		} break;
+		case BODY_STATE_ANGULAR_VELOCITY: {
+			r_value = body.angular_velocity;
+		} break;
+		case BODY_STATE_SLEEPING: {
+			r_value = body.sleeping;
+		} break;
+		default: {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+/* BODY API */
+
+RID PhysicsServer3DWrapMT::body_create() {
+	RID body = physics_server_3d->body_create();
+
+	if (create_thread) {
+		command_queue.push(this, &PhysicsServer3DWrapMT::_snapshot_add_body, body);
+	}
+
+	return body;
+}
+
+Variant PhysicsServer3DWrapMT::body_get_state(RID p_body, BodyState p_state) const {
+	if (Thread::get_caller_id() != server_thread) {
+		Variant ret;
+		if (Thread::get_caller_id() == main_thread && _snapshot_get_body_state(p_body, p_state, ret)) {
+			return ret;
+		}
+		command_queue.push_and_ret(physics_server_3d, &PhysicsServer3D::body_get_state, p_body, p_state, &ret);
+		return ret;
+	} else {
+		command_queue.flush_if_pending();
+		return physics_server_3d->body_get_state(p_body, p_state);
+	}
+}
+
+void PhysicsServer3DWrapMT::_body_set_state_sync_callback(RID p_body, void *p_instance, BodyStateCallback p_callback) {
+	if (p_callback) {
+		snapshot_state_sync_callback_bodies.insert(p_body);
+	} else {
+		snapshot_state_sync_callback_bodies.erase(p_body);
+	}
+
+	physics_server_3d->body_set_state_sync_callback(p_body, p_instance, p_callback);
+}
+
+void PhysicsServer3DWrapMT::body_set_state_sync_callback(RID p_body, void *p_instance, BodyStateCallback p_callback) {
+	_snapshot_body_written(p_body);
+	if (Thread::get_caller_id() != server_thread) {
+		command_queue.push(this, &PhysicsServer3DWrapMT::_body_set_state_sync_callback, p_body, p_instance, p_callback);
+	} else {
+		command_queue.flush_if_pending();
+		_body_set_state_sync_callback(p_body, p_instance, p_callback);
+	}
+}
+
+void PhysicsServer3DWrapMT::_body_set_force_integration_callback(RID p_body, const Callable &p_callable, const Variant &p_udata) {
+	if (p_callable.is_valid()) {
+		snapshot_force_integration_callback_bodies.insert(p_body);
+	} else {
+		snapshot_force_integration_callback_bodies.erase(p_body);
+	}
+
+	physics_server_3d->body_set_force_integration_callback(p_body, p_callable, p_udata);
+}
+
+void PhysicsServer3DWrapMT::body_set_force_integration_callback(RID p_body, const Callable &p_callable, const Variant &p_udata) {
+	_snapshot_body_written(p_body);
+	if (Thread::get_caller_id() != server_thread) {
+		command_queue.push(this, &PhysicsServer3DWrapMT::_body_set_force_integration_callback, p_body, p_callable, p_udata);
+	} else {
+		command_queue.flush_if_pending();
+		_body_set_force_integration_callback(p_body, p_callable, p_udata);
+	}
+}
+
+/* MISC */
+
+void PhysicsServer3DWrapMT::free(RID p_rid) {
+	_snapshot_body_written(p_rid);
+	if (Thread::get_caller_id() != server_thread) {
+		command_queue.push(physics_server_3d, &PhysicsServer3D::free, p_rid);
+		command_queue.push(this, &PhysicsServer3DWrapMT::_snapshot_remove_body, p_rid);
+	} else {
+		command_queue.flush_if_pending();
+		physics_server_3d->free(p_rid);
+		_snapshot_remove_body(p_rid);
+	}
+}
+
 /* EVENT QUEUING */
 
 void PhysicsServer3DWrapMT::step(real_t p_step) {
 	if (create_thread) {
+		steps_issued.increment();
 		command_queue.push(this, &PhysicsServer3DWrapMT::thread_step, p_step);
 	} else {
 		command_queue.flush_all(); //flush all pending from other threads
@@ -81,6 +295,7 @@ void PhysicsServer3DWrapMT::sync() {
 			first_frame = false;
 		} else {
 			step_sem.wait(); //must not wait if a step was not issued
+			_snapshot_swap();
 		}
 	}
 	physics_server_3d->sync();
@@ -34,6 +34,10 @@
 #include "core/config/project_settings.h"
 #include "core/os/thread.h"
 #include "core/templates/command_queue_mt.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/hash_set.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/safe_refcount.h"
 #include "servers/physics_server_3d.h"
 
 #ifdef DEBUG_SYNC
@@ -67,6 +71,66 @@ class PhysicsServer3DWrapMT : public PhysicsServer3D {
 	Mutex alloc_mutex;
 	int pool_max_size = 0;
 
+	// Body state published by the physics thread at the end of each step, so getters called
+	// from the main thread don't have to wait for the command queue to be flushed.
+	// The physics thread only writes the back snapshot during the step, and the snapshots are
+	// swapped in sync() once the step is done, so readers never see a partial update.
+	// Only the bodies read from the main thread in the last steps are published, so the
+	// snapshots cost nothing to the bodies nobody reads.
+	struct BodyStateSnapshot {
+		Transform3D transform;
+		Vector3 linear_velocity;
+		Vector3 angular_velocity;
+		bool sleeping = false;
+		uint64_t query_step = 0; // Set by the main thread when the body is read.
+	};
+
+	struct StateSnapshot {
+		HashMap<RID, uint32_t> body_indices;
+		mutable LocalVector<BodyStateSnapshot> bodies;
+		uint64_t step = 0; // Number of steps issued when this snapshot was published.
+	};
+
+	struct SnapshotQuery {
+		RID body;
+		uint64_t query_step = 0;
+	};
+
+	// Bodies stop being published once they were not read for this many steps.
+	static const uint64_t SNAPSHOT_QUERY_KEEP_STEPS = 8;
+
+	StateSnapshot state_snapshots[2];
+	uint32_t state_snapshot_front = 0;
+	SafeNumeric<uint64_t> steps_issued;
+
+	// Written by the main thread in sync(), read by the physics thread during the next step.
+	LocalVector<SnapshotQuery> snapshot_published_bodies;
+	// Main thread only. Bodies read from the main thread that are not in the front snapshot.
+	mutable LocalVector<RID> snapshot_missed_bodies;
+
+	// Physics thread only. Bodies with callbacks can be modified while flushing queries,
+	// so they are left out of the snapshots.
+	HashSet<RID> snapshot_bodies;
+	HashSet<RID> snapshot_state_sync_callback_bodies;
+	HashSet<RID> snapshot_force_integration_callback_bodies;
+
+	// Main thread only. Bodies written since the front snapshot was published, along with
+	// the number of steps issued at the time. Their getters go through the command queue
+	// until a step issued after the write is published.
+	HashMap<RID, uint64_t> snapshot_written_bodies;
+	// Same, for writes from any other thread, which invalidate the whole snapshot.
+	SafeNumeric<uint64_t> snapshot_foreign_write_step;
+
+	void _snapshot_add_body(RID p_body);
+	void _snapshot_remove_body(RID p_body);
+	void _snapshot_publish();
+	void _snapshot_swap();
+	void _snapshot_body_written(RID p_body);
+	bool _snapshot_get_body_state(RID p_body, BodyState p_state, Variant &r_value) const;
+
+	void _body_set_state_sync_callback(RID p_body, void *p_instance, BodyStateCallback p_callback);
+	void _body_set_force_integration_callback(RID p_body, const Callable &p_callable, const Variant &p_udata);
+
 public:
 #define ServerName PhysicsServer3D
 #define ServerNameWrapMT PhysicsServer3DWrapMT
@@ -168,8 +232,12 @@ public:
 
 	/* BODY API */
 
+	// Writes to a body invalidate its published state snapshot.
+#undef WRITE_ACTION
+#define WRITE_ACTION _snapshot_body_written(p1);
+
 	//FUNC2RID(body,BodyMode,bool);
-	FUNCRID(body)
+	virtual RID body_create() override;
 
 	FUNC2(body_set_space, RID, RID);
 	FUNC1RC(RID, body_get_space, RID);
@@ -211,7 +279,7 @@ public:
 	FUNC1(body_reset_mass_properties, RID);
 
 	FUNC3(body_set_state, RID, BodyState, const Variant &);
-	FUNC2RC(Variant, body_get_state, RID, BodyState);
+	virtual Variant body_get_state(RID p_body, BodyState p_state) const override;
 
 	FUNC2(body_apply_torque_impulse, RID, const Vector3 &);
 	FUNC2(body_apply_central_impulse, RID, const Vector3 &);
@@ -249,11 +317,14 @@ public:
 	FUNC2(body_set_omit_force_integration, RID, bool);
 	FUNC1RC(bool, body_is_omitting_force_integration, RID);
 
-	FUNC3(body_set_state_sync_callback, RID, void *, BodyStateCallback);
-	FUNC3(body_set_force_integration_callback, RID, const Callable &, const Variant &);
+	virtual void body_set_state_sync_callback(RID p_body, void *p_instance, BodyStateCallback p_callback) override;
+	virtual void body_set_force_integration_callback(RID p_body, const Callable &p_callable, const Variant &p_udata) override;
 
 	FUNC2(body_set_ray_pickable, RID, bool);
 
+#undef WRITE_ACTION
+#define WRITE_ACTION
+
 	bool body_test_motion(RID p_body, const MotionParameters &p_parameters, MotionResult *r_result = nullptr) override {
 		ERR_FAIL_COND_V(main_thread != Thread::get_caller_id(), false);
 		return physics_server_3d->body_test_motion(p_body, p_parameters, r_result);
@@ -374,7 +445,7 @@ public:
 
 	/* MISC */
 
-	FUNC1(free, RID);
+	virtual void free(RID p_rid) override;
 	FUNC1(set_active, bool);
 
 	virtual void init() override;
@@ -0,0 +1,512 @@
+/*************************************************************************/
+/*  raster_occlusion_cull.cpp                                            */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2022 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2022 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "raster_occlusion_cull.h"
+
+#include "core/object/worker_thread_pool.h"
+
+RasterOcclusionCull *RasterOcclusionCull::raster_singleton = nullptr;
+
+void RasterOcclusionCull::RasterHZBuffer::clear() {
+	HZBuffer::clear();
+
+	triangles.clear();
+	tile_triangles.clear();
+	tile_grid_size = Size2i();
+}
+
+void RasterOcclusionCull::RasterHZBuffer::resize(const Size2i &p_size) {
+	if (p_size == Size2i()) {
+		clear();
+		return;
+	}
+
+	if (!sizes.is_empty() && p_size == sizes[0]) {
+		return; // Size didn't change
+	}
+
+	HZBuffer::resize(p_size);
+
+	tile_grid_size = Size2i((p_size.x + TILE_SIZE - 1) / TILE_SIZE, (p_size.y + TILE_SIZE - 1) / TILE_SIZE);
+	tile_triangles.resize(tile_grid_size.x * tile_grid_size.y);
+}
+
+void RasterOcclusionCull::RasterHZBuffer::add_triangle(const Vector3 *p_view, const Projection &p_cam_projection, bool p_orthogonal, real_t p_near) {
+	// Clip against the near plane, in view space.
+	Vector3 clipped[4];
+	int count = 0;
+	for (int i = 0; i < 3; i++) {
+		const Vector3 &a = p_view[i];
+		const Vector3 &b = p_view[(i + 1) % 3];
+		real_t da = -a.z - p_near;
+		real_t db = -b.z - p_near;
+		if (da >= 0) {
+			clipped[count++] = a;
+		}
+		if ((da >= 0) != (db >= 0)) {
+			clipped[count++] = a.lerp(b, da / (da - db));
+		}
+	}
+
+	if (count < 3) {
+		return;
+	}
+
+	const Size2i &size = sizes[0];
+	double x[4];
+	double y[4];
+	double depth[4];
+	for (int i = 0; i < count; i++) {
+		Plane projected = p_cam_projection.xform4(Plane(clipped[i], 1.0));
+		double w = projected.d;
+		x[i] = (projected.normal.x / w * 0.5 + 0.5) * size.x;
+		y[i] = (projected.normal.y / w * 0.5 + 0.5) * size.y;
+		// Both are linear in screen space.
+		depth[i] = p_orthogonal ? double(clipped[i].z) : 1.0 / w;
+	}
+
+	for (int i = 2; i < count; i++) {
+		const int v[3] = { 0, i - 1, i };
+
+		double area = (x[v[1]] - x[v[0]]) * (y[v[2]] - y[v[0]]) - (x[v[2]] - x[v[0]]) * (y[v[1]] - y[v[0]]);
+		if (area == 0.0) {
+			continue;
+		}
+
+		double min_x = MIN(x[v[0]], MIN(x[v[1]], x[v[2]]));
+		double max_x = MAX(x[v[0]], MAX(x[v[1]], x[v[2]]));
+		double min_y = MIN(y[v[0]], MIN(y[v[1]], y[v[2]]));
+		double max_y = MAX(y[v[0]], MAX(y[v[1]], y[v[2]]));
+
+		// Pixels are covered when their center is inside.
+		Triangle triangle;
+		triangle.rect[0] = MAX(0.0, Math::ceil(min_x - 0.5));
+		triangle.rect[1] = MAX(0.0, Math::ceil(min_y - 0.5));
+		triangle.rect[2] = MIN(double(size.x - 1), Math::floor(max_x - 0.5));
+		triangle.rect[3] = MIN(double(size.y - 1), Math::floor(max_y - 0.5));
+		if (triangle.rect[0] > triangle.rect[2] || triangle.rect[1] > triangle.rect[3]) {
+			continue;
+		}
+
+		double sign = area > 0.0 ? 1.0 : -1.0; // Occluders are double-sided.
+		for (int j = 0; j < 3; j++) {
+			int a = v[j];
+			int b = v[(j + 1) % 3];
+			triangle.edges[j][0] = (y[a] - y[b]) * sign;
+			triangle.edges[j][1] = (x[b] - x[a]) * sign;
+			triangle.edges[j][2] = (x[a] * y[b] - x[b] * y[a]) * sign;
+		}
+
+		double d1 = depth[v[1]] - depth[v[0]];
+		double d2 = depth[v[2]] - depth[v[0]];
+		triangle.depth[0] = (d1 * (y[v[2]] - y[v[0]]) - d2 * (y[v[1]] - y[v[0]])) / area;
+		triangle.depth[1] = ((x[v[1]] - x[v[0]]) * d2 - (x[v[2]] - x[v[0]]) * d1) / area;
+		triangle.depth[2] = depth[v[0]] - triangle.depth[0] * x[v[0]] - triangle.depth[1] * y[v[0]];
+
+		triangles.push_back(triangle);
+	}
+}
+
+void RasterOcclusionCull::RasterHZBuffer::raster(bool p_orthogonal, real_t p_far) {
+	ERR_FAIL_COND(is_empty());
+
+	for (uint32_t i = 0; i < tile_triangles.size(); i++) {
+		tile_triangles[i].clear();
+	}
+
+	for (uint32_t i = 0; i < triangles.size(); i++) {
+		const int32_t *rect = triangles[i].rect;
+		for (int ty = rect[1] / TILE_SIZE; ty <= rect[3] / TILE_SIZE; ty++) {
+			for (int tx = rect[0] / TILE_SIZE; tx <= rect[2] / TILE_SIZE; tx++) {
+				tile_triangles[ty * tile_grid_size.x + tx].push_back(i);
+			}
+		}
+	}
+
+	RasterThreadData td;
+	td.orthogonal = p_orthogonal;
+
+	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &RasterHZBuffer::_raster_tile, &td, tile_triangles.size(), -1, true, SNAME("RasterOcclusionCullRaster"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+
+	debug_tex_range = p_far;
+}
+
+void RasterOcclusionCull::RasterHZBuffer::_raster_tile(uint32_t p_tile, const RasterThreadData *p_data) {
+	const Size2i &size = sizes[0];
+	const int tile_x = (p_tile % tile_grid_size.x) * TILE_SIZE;
+	const int tile_y = (p_tile / tile_grid_size.x) * TILE_SIZE;
+	const int tile_end_x = MIN(tile_x + TILE_SIZE, size.x) - 1;
+	const int tile_end_y = MIN(tile_y + TILE_SIZE, size.y) - 1;
+
+	// The tile is rasterized in place, keeping the highest depth value (the nearest), and
+	// converted to the distances the buffer stores at the end.
+	float *buffer = mips[0];
+	const float empty = p_data->orthogonal ? -FLT_MAX : 0.0f;
+	for (int y = tile_y; y <= tile_end_y; y++) {
+		float *row = &buffer[y * size.x];
+		for (int x = tile_x; x <= tile_end_x; x++) {
+			row[x] = empty;
+		}
+	}
+
+	const LocalVector<uint32_t> &tile = tile_triangles[p_tile];
+	for (uint32_t i = 0; i < tile.size(); i++) {
+		const Triangle &triangle = triangles[tile[i]];
+		const int from_x = MAX(triangle.rect[0], tile_x);
+		const int to_x = MIN(triangle.rect[2], tile_end_x);
+		const int from_y = MAX(triangle.rect[1], tile_y);
+		const int to_y = MIN(triangle.rect[3], tile_end_y);
+
+		const float step_e0 = triangle.edges[0][0];
+		const float step_e1 = triangle.edges[1][0];
+		const float step_e2 = triangle.edges[2][0];
+		const float step_depth = triangle.depth[0];
+		const double px = from_x + 0.5;
+
+		for (int y = from_y; y <= to_y; y++) {
+			// Values at the first pixel center of the row, then stepped in float, which is exact enough
+			// this close. The loop has no branches, so it's turned into SIMD code.
+			const double py = y + 0.5;
+			const float e0 = triangle.edges[0][0] * px + triangle.edges[0][1] * py + triangle.edges[0][2];
+			const float e1 = triangle.edges[1][0] * px + triangle.edges[1][1] * py + triangle.edges[1][2];
+			const float e2 = triangle.edges[2][0] * px + triangle.edges[2][1] * py + triangle.edges[2][2];
+			const float depth = triangle.depth[0] * px + triangle.depth[1] * py + triangle.depth[2];
+
+			float *row = &buffer[y * size.x + from_x];
+			const int count = to_x - from_x + 1;
+			for (int x = 0; x < count; x++) {
+				const float fx = x;
+				const float value = depth + step_depth * fx;
+				const bool inside = (e0 + step_e0 * fx >= 0.0f) & (e1 + step_e1 * fx >= 0.0f) & (e2 + step_e2 * fx >= 0.0f);
+				row[x] = (inside & (value > row[x])) ? value : row[x];
+			}
+		}
+	}
+
+	for (int y = tile_y; y <= tile_end_y; y++) {
+		float *row = &buffer[y * size.x];
+		if (p_data->orthogonal) {
+			for (int x = tile_x; x <= tile_end_x; x++) {
+				row[x] = row[x] == empty ? FLT_MAX : -row[x];
+			}
+		} else {
+			for (int x = tile_x; x <= tile_end_x; x++) {
+				row[x] = row[x] > 0.0f ? 1.0f / row[x] : FLT_MAX;
+			}
+		}
+	}
+}
+
+////////////////////////////////////////////////////////
+
+bool RasterOcclusionCull::is_occluder(RID p_rid) {
+	return occluder_owner.owns(p_rid);
+}
+
+RID RasterOcclusionCull::occluder_allocate() {
+	return occluder_owner.allocate_rid();
+}
+
+void RasterOcclusionCull::occluder_initialize(RID p_occluder) {
+	Occluder *occluder = memnew(Occluder);
+	occluder_owner.initialize_rid(p_occluder, occluder);
+}
+
+void RasterOcclusionCull::occluder_set_mesh(RID p_occluder, const PackedVector3Array &p_vertices, const PackedInt32Array &p_indices) {
+	Occluder *occluder = occluder_owner.get_or_null(p_occluder);
+	ERR_FAIL_COND(!occluder);
+
+	occluder->vertices = p_vertices;
+	occluder->indices = p_indices;
+
+	for (const InstanceID &E : occluder->users) {
+		RID scenario_rid = E.scenario;
+		RID instance_rid = E.instance;
+		ERR_CONTINUE(!scenarios.has(scenario_rid));
+		Scenario &scenario = scenarios[scenario_rid];
+		ERR_CONTINUE(!scenario.instances.has(instance_rid));
+
+		if (!scenario.dirty_instances.has(instance_rid)) {
+			scenario.dirty_instances.insert(instance_rid);
+			scenario.dirty_instances_array.push_back(instance_rid);
+		}
+	}
+}
+
+void RasterOcclusionCull::free_occluder(RID p_occluder) {
+	Occluder *occluder = occluder_owner.get_or_null(p_occluder);
+	ERR_FAIL_COND(!occluder);
+	memdelete(occluder);
+	occluder_owner.free(p_occluder);
+}
+
+////////////////////////////////////////////////////////
+
+void RasterOcclusionCull::add_scenario(RID p_scenario) {
+	if (scenarios.has(p_scenario)) {
+		scenarios[p_scenario].removed = false;
+	} else {
+		scenarios[p_scenario] = Scenario();
+	}
+}
+
+void RasterOcclusionCull::remove_scenario(RID p_scenario) {
+	ERR_FAIL_COND(!scenarios.has(p_scenario));
+	Scenario &scenario = scenarios[p_scenario];
+	scenario.removed = true;
+}
+
+void RasterOcclusionCull::scenario_set_instance(RID p_scenario, RID p_instance, RID p_occluder, const Transform3D &p_xform, bool p_enabled) {
+	ERR_FAIL_COND(!scenarios.has(p_scenario));
+	Scenario &scenario = scenarios[p_scenario];
+
+	if (!scenario.instances.has(p_instance)) {
+		scenario.instances[p_instance] = OccluderInstance();
+	}
+
+	OccluderInstance &instance = scenario.instances[p_instance];
+
+	bool changed = false;
+
+	if (instance.removed) {
+		instance.removed = false;
+		scenario.removed_instances.erase(p_instance);
+		changed = true; // It was removed and re-added, we might have missed some changes
+	}
+
+	if (instance.occluder != p_occluder) {
+		Occluder *old_occluder = occluder_owner.get_or_null(instance.occluder);
+		if (old_occluder) {
+			old_occluder->users.erase(InstanceID(p_scenario, p_instance));
+		}
+
+		instance.occluder = p_occluder;
+
+		if (p_occluder.is_valid()) {
+			Occluder *occluder = occluder_owner.get_or_null(p_occluder);
+			ERR_FAIL_COND(!occluder);
+			occluder->users.insert(InstanceID(p_scenario, p_instance));
+		}
+		changed = true;
+	}
+
+	if (instance.xform != p_xform) {
+		instance.xform = p_xform;
+		changed = true;
+	}
+
+	instance.enabled = p_enabled; // Read when rasterizing, doesn't need an update.
+
+	if (changed && !scenario.dirty_instances.has(p_instance)) {
+		scenario.dirty_instances.insert(p_instance);
+		scenario.dirty_instances_array.push_back(p_instance);
+	}
+}
+
+void RasterOcclusionCull::scenario_remove_instance(RID p_scenario, RID p_instance) {
+	ERR_FAIL_COND(!scenarios.has(p_scenario));
+	Scenario &scenario = scenarios[p_scenario];
+
+	if (scenario.instances.has(p_instance)) {
+		OccluderInstance &instance = scenario.instances[p_instance];
+
+		if (!instance.removed) {
+			Occluder *occluder = occluder_owner.get_or_null(instance.occluder);
+			if (occluder) {
+				occluder->users.erase(InstanceID(p_scenario, p_instance));
+			}
+
+			scenario.removed_instances.push_back(p_instance);
+			instance.removed = true;
+		}
+	}
+}
+
+void RasterOcclusionCull::Scenario::_update_dirty_instance(OccluderInstance *p_instance) {
+	p_instance->xformed_vertices.clear();
+	p_instance->indices.clear();
+
+	Occluder *occ = raster_singleton->occluder_owner.get_or_null(p_instance->occluder);
+	if (!occ || occ->vertices.is_empty()) {
+		return;
+	}
+
+	int vertex_count = occ->vertices.size();
+	const Vector3 *read = occ->vertices.ptr();
+	p_instance->xformed_vertices.resize(vertex_count);
+	for (int i = 0; i < vertex_count; i++) {
+		p_instance->xformed_vertices[i] = p_instance->xform.xform(read[i]);
+		if (i == 0) {
+			p_instance->aabb = AABB(p_instance->xformed_vertices[i], Vector3());
+		} else {
+			p_instance->aabb.expand_to(p_instance->xformed_vertices[i]);
+		}
+	}
+
+	int index_count = occ->indices.size() - occ->indices.size() % 3;
+	const int32_t *indices = occ->indices.ptr();
+	for (int i = 0; i < index_count; i++) {
+		ERR_FAIL_INDEX_MSG(indices[i], vertex_count, "Occluder index out of range.");
+	}
+	p_instance->indices.resize(index_count);
+	memcpy(p_instance->indices.ptr(), indices, index_count * sizeof(int32_t));
+}
+
+bool RasterOcclusionCull::Scenario::update() {
+	if (removed) {
+		return true;
+	}
+
+	for (uint32_t i = 0; i < removed_instances.size(); i++) {
+		instances.erase(removed_instances[i]);
+	}
+
+	for (uint32_t i = 0; i < dirty_instances_array.size(); i++) {
+		OccluderInstance *occ_inst = instances.getptr(dirty_instances_array[i]);
+		if (occ_inst) {
+			_update_dirty_instance(occ_inst);
+		}
+	}
+
+	dirty_instances.clear();
+	dirty_instances_array.clear();
+	removed_instances.clear();
+	return false;
+}
+
+////////////////////////////////////////////////////////
+
+void RasterOcclusionCull::add_buffer(RID p_buffer) {
+	ERR_FAIL_COND(buffers.has(p_buffer));
+	buffers[p_buffer] = RasterHZBuffer();
+}
+
+void RasterOcclusionCull::remove_buffer(RID p_buffer) {
+	ERR_FAIL_COND(!buffers.has(p_buffer));
+	buffers.erase(p_buffer);
+}
+
+void RasterOcclusionCull::buffer_set_scenario(RID p_buffer, RID p_scenario) {
+	ERR_FAIL_COND(!buffers.has(p_buffer));
+	ERR_FAIL_COND(p_scenario.is_valid() && !scenarios.has(p_scenario));
+	buffers[p_buffer].scenario_rid = p_scenario;
+}
+
+void RasterOcclusionCull::buffer_set_size(RID p_buffer, const Vector2i &p_size) {
+	ERR_FAIL_COND(!buffers.has(p_buffer));
+	buffers[p_buffer].resize(p_size);
+}
+
+void RasterOcclusionCull::buffer_update(RID p_buffer, const Transform3D &p_cam_transform, const Projection &p_cam_projection, bool p_cam_orthogonal) {
+	if (!buffers.has(p_buffer)) {
+		return;
+	}
+
+	RasterHZBuffer &buffer = buffers[p_buffer];
+
+	if (buffer.is_empty() || !scenarios.has(buffer.scenario_rid)) {
+		return;
+	}
+
+	Scenario &scenario = scenarios[buffer.scenario_rid];
+
+	bool removed = scenario.update();
+
+	if (removed) {
+		scenarios.erase(buffer.scenario_rid);
+		return;
+	}
+
+	Transform3D inv_cam_transform = p_cam_transform.affine_inverse();
+	Vector<Plane> planes = p_cam_projection.get_projection_planes(p_cam_transform);
+	real_t z_near = p_cam_projection.get_z_near();
+
+	buffer.triangles.clear();
+
+	for (const KeyValue<RID, OccluderInstance> &E : scenario.instances) {
+		const OccluderInstance &occ_inst = E.value;
+		if (!occ_inst.enabled || occ_inst.indices.is_empty()) {
+			continue;
+		}
+
+		bool outside = false;
+		for (int i = 0; i < planes.size(); i++) {
+			const Plane &plane = planes[i];
+			Vector3 nearest = occ_inst.aabb.position;
+			nearest.x += plane.normal.x > 0 ? 0 : occ_inst.aabb.size.x;
+			nearest.y += plane.normal.y > 0 ? 0 : occ_inst.aabb.size.y;
+			nearest.z += plane.normal.z > 0 ? 0 : occ_inst.aabb.size.z;
+			if (plane.distance_to(nearest) > 0) {
+				outside = true;
+				break;
+			}
+		}
+		if (outside) {
+			continue;
+		}
+
+		uint32_t vertex_count = occ_inst.xformed_vertices.size();
+		view_vertices.resize(vertex_count);
+		for (uint32_t i = 0; i < vertex_count; i++) {
+			view_vertices[i] = inv_cam_transform.xform(occ_inst.xformed_vertices[i]);
+		}
+
+		for (uint32_t i = 0; i < occ_inst.indices.size(); i += 3) {
+			const Vector3 triangle[3] = { view_vertices[occ_inst.indices[i]], view_vertices[occ_inst.indices[i + 1]], view_vertices[occ_inst.indices[i + 2]] };
+			buffer.add_triangle(triangle, p_cam_projection, p_cam_orthogonal, z_near);
+		}
+	}
+
+	buffer.raster(p_cam_orthogonal, p_cam_projection.get_z_far());
+	buffer.update_mips();
+}
+
+RasterOcclusionCull::HZBuffer *RasterOcclusionCull::buffer_get_ptr(RID p_buffer) {
+	if (!buffers.has(p_buffer)) {
+		return nullptr;
+	}
+	return &buffers[p_buffer];
+}
+
+RID RasterOcclusionCull::buffer_get_debug_texture(RID p_buffer) {
+	ERR_FAIL_COND_V(!buffers.has(p_buffer), RID());
+	return buffers[p_buffer].get_debug_texture();
+}
+
+////////////////////////////////////////////////////////
+
+RasterOcclusionCull::RasterOcclusionCull() {
+	raster_singleton = this;
+}
+
+RasterOcclusionCull::~RasterOcclusionCull() {
+	raster_singleton = nullptr;
+}
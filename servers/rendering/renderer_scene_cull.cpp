@@ -32,6 +32,7 @@
 
 #include "core/config/project_settings.h"
 #include "core/os/os.h"
+#include "raster_occlusion_cull.h"
 #include "rendering_server_default.h"
 #include "rendering_server_globals.h"
 
@@ -831,7 +832,7 @@ void RendererSceneCull::instance_set_layer_mask(RID p_instance, uint32_t p_mask)
 
 	instance->layer_mask = p_mask;
 	if (instance->scenario && instance->array_index >= 0) {
-		instance->scenario->instance_data[instance->array_index].layer_mask = p_mask;
+		instance->scenario->instance_aabbs.set_layer_mask(instance->array_index, p_mask);
 	}
 
 	if ((1 << instance->base_type) & RS::INSTANCE_GEOMETRY_MASK && instance->base_data) {
@@ -1027,12 +1028,7 @@ void RendererSceneCull::instance_set_ignore_culling(RID p_instance, bool p_enabl
 	instance->ignore_all_culling = p_enabled;
 
 	if (instance->scenario && instance->array_index >= 0) {
-		InstanceData &idata = instance->scenario->instance_data[instance->array_index];
-		if (instance->ignore_all_culling) {
-			idata.flags |= InstanceData::FLAG_IGNORE_ALL_CULLING;
-		} else {
-			idata.flags &= ~uint32_t(InstanceData::FLAG_IGNORE_ALL_CULLING);
-		}
+		instance->scenario->instance_aabbs.set_ignore_culling(instance->array_index, instance->ignore_all_culling);
 	}
 }
 
@@ -1626,7 +1622,6 @@ void RendererSceneCull::_update_instance(Instance *p_instance) {
 		p_instance->array_index = p_instance->scenario->instance_data.size();
 		InstanceData idata;
 		idata.instance = p_instance;
-		idata.layer_mask = p_instance->layer_mask;
 		idata.flags = p_instance->base_type; //changing it means de-indexing, so this never needs to be changed later
 		idata.base_rid = p_instance->base;
 		idata.parent_array_index = p_instance->visibility_parent ? p_instance->visibility_parent->array_index : -1;
@@ -1698,12 +1693,9 @@ void RendererSceneCull::_update_instance(Instance *p_instance) {
 		if (p_instance->ignore_occlusion_culling) {
 			idata.flags |= InstanceData::FLAG_IGNORE_OCCLUSION_CULLING;
 		}
-		if (p_instance->ignore_all_culling) {
-			idata.flags |= InstanceData::FLAG_IGNORE_ALL_CULLING;
-		}
 
 		p_instance->scenario->instance_data.push_back(idata);
-		p_instance->scenario->instance_aabbs.push_back(InstanceBounds(p_instance->transformed_aabb));
+		p_instance->scenario->instance_aabbs.push_back(p_instance->transformed_aabb, p_instance->layer_mask, p_instance->ignore_all_culling);
 		_update_instance_visibility_dependencies(p_instance);
 	} else {
 		if ((1 << p_instance->base_type) & RS::INSTANCE_GEOMETRY_MASK) {
@@ -1711,7 +1703,7 @@ void RendererSceneCull::_update_instance(Instance *p_instance) {
 		} else {
 			p_instance->scenario->indexers[Scenario::INDEXER_VOLUMES].update(p_instance->indexer_id, bvh_aabb);
 		}
-		p_instance->scenario->instance_aabbs[p_instance->array_index] = InstanceBounds(p_instance->transformed_aabb);
+		p_instance->scenario->instance_aabbs.set_aabb(p_instance->array_index, p_instance->transformed_aabb);
 	}
 
 	if (p_instance->visibility_index != -1) {
@@ -1794,7 +1786,7 @@ void RendererSceneCull::_unpair_instance(Instance *p_instance) {
 		Instance *swapped_instance = p_instance->scenario->instance_data[swap_with_index].instance;
 		swapped_instance->array_index = p_instance->array_index; //swap
 		p_instance->scenario->instance_data[p_instance->array_index] = p_instance->scenario->instance_data[swap_with_index];
-		p_instance->scenario->instance_aabbs[p_instance->array_index] = p_instance->scenario->instance_aabbs[swap_with_index];
+		p_instance->scenario->instance_aabbs.copy(p_instance->array_index, swap_with_index);
 
 		if (swapped_instance->visibility_index != -1) {
 			swapped_instance->scenario->instance_visibility[swapped_instance->visibility_index].array_index = swapped_instance->array_index;
@@ -2640,8 +2632,33 @@ void RendererSceneCull::_scene_cull(CullData &cull_data, InstanceCullResult &cul
 
 	Transform3D inv_cam_transform = cull_data.cam_transform.inverse();
 	float z_near = cull_data.camera_matrix->get_z_near();
+	real_t instance_bounds[6];
+
+	// The frustums are tested against a whole block of instances at once, giving a bit per instance.
+	const InstanceBoundsBlock *block = nullptr;
+	uint32_t frustum_mask = 0;
+	uint32_t cascade_masks[RendererSceneRender::MAX_DIRECTIONAL_LIGHTS][RendererSceneRender::MAX_DIRECTIONAL_LIGHT_CASCADES];
+	uint32_t any_mask = 0;
 
 	for (uint64_t i = p_from; i < p_to; i++) {
+		uint32_t block_index = i % InstanceBoundsBlock::SIZE;
+		if (block_index == 0 || block == nullptr) {
+			block = &cull_data.scenario->instance_aabbs.get_block(i);
+			frustum_mask = block->cull<true>(cull_data.cull->frustum, cull_data.visible_layers);
+			any_mask = frustum_mask | block->ignore_culling_mask;
+			for (uint32_t j = 0; j < cull_data.cull->shadow_count; j++) {
+				for (uint32_t k = 0; k < cull_data.cull->shadows[j].cascade_count; k++) {
+					cascade_masks[j][k] = block->cull<false>(cull_data.cull->shadows[j].cascades[k].frustum);
+					any_mask |= cascade_masks[j][k];
+				}
+			}
+		}
+
+		uint32_t instance_bit = 1 << block_index;
+		if (!(any_mask & instance_bit) && cull_data.cull->sdfgi.region_count == 0) {
+			continue; // Outside of all the frustums, skip without touching the instance data.
+		}
+
 		bool mesh_visible = false;
 
 		InstanceData &idata = cull_data.scenario->instance_data[i];
@@ -2649,15 +2666,14 @@ void RendererSceneCull::_scene_cull(CullData &cull_data, InstanceCullResult &cul
 		int32_t visibility_check = -1;
 
 #define HIDDEN_BY_VISIBILITY_CHECKS (visibility_flags == InstanceData::FLAG_VISIBILITY_DEPENDENCY_HIDDEN_CLOSE_RANGE || visibility_flags == InstanceData::FLAG_VISIBILITY_DEPENDENCY_HIDDEN)
-#define LAYER_CHECK (cull_data.visible_layers & idata.layer_mask)
-#define IN_FRUSTUM(f) (cull_data.scenario->instance_aabbs[i].in_frustum(f))
+#define LAYER_AND_FRUSTUM_CHECK (frustum_mask & instance_bit)
 #define VIS_RANGE_CHECK ((idata.visibility_index == -1) || _visibility_range_check<false>(cull_data.scenario->instance_visibility[idata.visibility_index], cull_data.cam_transform.origin, cull_data.visibility_viewport_mask) == 0)
 #define VIS_PARENT_CHECK (_visibility_parent_check(cull_data, idata))
 #define VIS_CHECK (visibility_check < 0 ? (visibility_check = (visibility_flags != InstanceData::FLAG_VISIBILITY_DEPENDENCY_NEEDS_CHECK || (VIS_RANGE_CHECK && VIS_PARENT_CHECK))) : visibility_check)
-#define OCCLUSION_CULLED (cull_data.occlusion_buffer != nullptr && (cull_data.scenario->instance_data[i].flags & InstanceData::FLAG_IGNORE_OCCLUSION_CULLING) == 0 && cull_data.occlusion_buffer->is_occluded(cull_data.scenario->instance_aabbs[i].bounds, cull_data.cam_transform.origin, inv_cam_transform, *cull_data.camera_matrix, z_near))
+#define OCCLUSION_CULLED (cull_data.occlusion_buffer != nullptr && (cull_data.scenario->instance_data[i].flags & InstanceData::FLAG_IGNORE_OCCLUSION_CULLING) == 0 && (cull_data.scenario->instance_aabbs.get_bounds(i, instance_bounds), cull_data.occlusion_buffer->is_occluded(instance_bounds, cull_data.cam_transform.origin, inv_cam_transform, *cull_data.camera_matrix, z_near)))
 
 		if (!HIDDEN_BY_VISIBILITY_CHECKS) {
-			if ((LAYER_CHECK && IN_FRUSTUM(cull_data.cull->frustum) && VIS_CHECK && !OCCLUSION_CULLED) || (cull_data.scenario->instance_data[i].flags & InstanceData::FLAG_IGNORE_ALL_CULLING)) {
+			if ((LAYER_AND_FRUSTUM_CHECK && VIS_CHECK && !OCCLUSION_CULLED) || (block->ignore_culling_mask & instance_bit)) {
 				uint32_t base_type = idata.flags & InstanceData::FLAG_BASE_TYPE_MASK;
 				if (base_type == RS::INSTANCE_LIGHT) {
 					cull_result.lights.push_back(idata.instance);
@@ -2836,7 +2852,7 @@ void RendererSceneCull::_scene_cull(CullData &cull_data, InstanceCullResult &cul
 
 			for (uint32_t j = 0; j < cull_data.cull->shadow_count; j++) {
 				for (uint32_t k = 0; k < cull_data.cull->shadows[j].cascade_count; k++) {
-					if (IN_FRUSTUM(cull_data.cull->shadows[j].cascades[k].frustum) && VIS_CHECK) {
+					if ((cascade_masks[j][k] & instance_bit) && VIS_CHECK) {
 						uint32_t base_type = idata.flags & InstanceData::FLAG_BASE_TYPE_MASK;
 
 						if (((1 << base_type) & RS::INSTANCE_GEOMETRY_MASK) && idata.flags & InstanceData::FLAG_CAST_SHADOWS) {
@@ -2849,15 +2865,14 @@ void RendererSceneCull::_scene_cull(CullData &cull_data, InstanceCullResult &cul
 		}
 
 #undef HIDDEN_BY_VISIBILITY_CHECKS
-#undef LAYER_CHECK
-#undef IN_FRUSTUM
+#undef LAYER_AND_FRUSTUM_CHECK
 #undef VIS_RANGE_CHECK
 #undef VIS_PARENT_CHECK
 #undef VIS_CHECK
 #undef OCCLUSION_CULLED
 
 		for (uint32_t j = 0; j < cull_data.cull->sdfgi.region_count; j++) {
-			if (cull_data.scenario->instance_aabbs[i].in_aabb(cull_data.cull->sdfgi.region_aabb[j])) {
+			if (cull_data.scenario->instance_aabbs.in_aabb(i, cull_data.cull->sdfgi.region_aabb[j])) {
 				uint32_t base_type = idata.flags & InstanceData::FLAG_BASE_TYPE_MASK;
 
 				if (base_type == RS::INSTANCE_LIGHT) {
@@ -4021,6 +4036,8 @@ RendererSceneCull::RendererSceneCull() {
 	render_pass = 1;
 	singleton = this;
 
+	instance_aabb_page_pool.configure(4096 / InstanceBoundsBlock::SIZE); // Same number of instances per page as the other instance arrays.
+
 	instance_cull_result.set_page_pool(&instance_cull_page_pool);
 	instance_shadow_cull_result.set_page_pool(&instance_cull_page_pool);
 
@@ -4047,7 +4064,8 @@ RendererSceneCull::RendererSceneCull() {
 		taa_jitter_array[i].y = get_halton_value(i, 3);
 	}
 
-	dummy_occlusion_culling = memnew(RendererSceneOcclusionCull);
+	// Used when no module (such as raycast) provides its own implementation.
+	default_occlusion_culling = memnew(RasterOcclusionCull);
 }
 
 RendererSceneCull::~RendererSceneCull() {
@@ -4067,7 +4085,7 @@ RendererSceneCull::~RendererSceneCull() {
 	}
 	scene_cull_result_threads.clear();
 
-	if (dummy_occlusion_culling) {
-		memdelete(dummy_occlusion_culling);
+	if (default_occlusion_culling) {
+		memdelete(default_occlusion_culling);
 	}
 }
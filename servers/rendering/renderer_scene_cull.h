@@ -115,128 +115,186 @@ public:
 
 	/* VISIBILITY NOTIFIER API */
 
-	RendererSceneOcclusionCull *dummy_occlusion_culling = nullptr;
+	RendererSceneOcclusionCull *default_occlusion_culling = nullptr;
 
 	/* SCENARIO API */
 
 	struct Instance;
 
-	struct PlaneSign {
-		_ALWAYS_INLINE_ PlaneSign() {}
-		_ALWAYS_INLINE_ PlaneSign(const Plane &p_plane) {
-			if (p_plane.normal.x > 0) {
-				signs[0] = 0;
-			} else {
-				signs[0] = 3;
-			}
-			if (p_plane.normal.y > 0) {
-				signs[1] = 1;
-			} else {
-				signs[1] = 4;
-			}
-			if (p_plane.normal.z > 0) {
-				signs[2] = 2;
-			} else {
-				signs[2] = 5;
-			}
-		}
-
-		uint32_t signs[3];
-	};
-
 	struct Frustum {
 		Vector<Plane> planes;
-		Vector<PlaneSign> plane_signs;
 		const Plane *planes_ptr;
-		const PlaneSign *plane_signs_ptr;
 		uint32_t plane_count;
 
 		_ALWAYS_INLINE_ Frustum() {}
 		_ALWAYS_INLINE_ Frustum(const Frustum &p_frustum) {
 			planes = p_frustum.planes;
-			plane_signs = p_frustum.plane_signs;
 
 			planes_ptr = planes.ptr();
-			plane_signs_ptr = plane_signs.ptr();
 			plane_count = p_frustum.plane_count;
 		}
 		_ALWAYS_INLINE_ void operator=(const Frustum &p_frustum) {
 			planes = p_frustum.planes;
-			plane_signs = p_frustum.plane_signs;
 
 			planes_ptr = planes.ptr();
-			plane_signs_ptr = plane_signs.ptr();
 			plane_count = p_frustum.plane_count;
 		}
 		_ALWAYS_INLINE_ Frustum(const Vector<Plane> &p_planes) {
 			planes = p_planes;
-			planes_ptr = planes.ptrw();
+			planes_ptr = planes.ptr();
 			plane_count = planes.size();
-			for (int i = 0; i < planes.size(); i++) {
-				PlaneSign ps(p_planes[i]);
-				plane_signs.push_back(ps);
+		}
+	};
+
+	struct InstanceBoundsBlock {
+		// Bounds and layer masks of consecutive instances, stored by component so that culling
+		// tests every instance of the block against a plane at once. The loops over the block
+		// are written without branches so the compiler turns them into SIMD code.
+		// Because bounds checking is performed first, keep it separated from data.
+
+		enum {
+			SIZE = 16,
+		};
+
+		real_t min_x[SIZE] = {};
+		real_t min_y[SIZE] = {};
+		real_t min_z[SIZE] = {};
+		real_t max_x[SIZE] = {};
+		real_t max_y[SIZE] = {};
+		real_t max_z[SIZE] = {};
+		uint32_t layer_mask[SIZE] = {};
+		uint32_t ignore_culling_mask = 0; // One bit per instance, for the ones that are always visible.
+
+		// Returns one bit per instance of the block, set when the instance is inside `p_frustum`
+		// (and shares a layer with `p_layer_mask`, if used).
+		// This is not a full SAT check and the possibility of false positives exist,
+		// but the tradeoff vs performance is still very good.
+		template <bool p_use_layer_mask>
+		_FORCE_INLINE_ uint32_t cull(const Frustum &p_frustum, uint32_t p_layer_mask = 0) const {
+			uint32_t inside[SIZE];
+			for (uint32_t i = 0; i < SIZE; i++) {
+				inside[i] = p_use_layer_mask ? (layer_mask[i] & p_layer_mask) != 0 : 1;
+			}
+
+			for (uint32_t j = 0; j < p_frustum.plane_count; j++) {
+				// Test the corner of the boxes that is the furthest behind the plane.
+				const Plane &plane = p_frustum.planes_ptr[j];
+				const real_t *x = plane.normal.x > 0 ? min_x : max_x;
+				const real_t *y = plane.normal.y > 0 ? min_y : max_y;
+				const real_t *z = plane.normal.z > 0 ? min_z : max_z;
+
+				for (uint32_t i = 0; i < SIZE; i++) {
+					inside[i] &= !(plane.normal.x * x[i] + plane.normal.y * y[i] + plane.normal.z * z[i] - plane.d >= 0.0);
+				}
 			}
 
-			plane_signs_ptr = plane_signs.ptr();
+			uint32_t mask = 0;
+			for (uint32_t i = 0; i < SIZE; i++) {
+				mask |= inside[i] << i;
+			}
+			return mask;
 		}
 	};
 
-	struct InstanceBounds {
-		// Efficiently store instance bounds.
-		// Because bounds checking is performed first,
-		// keep it separated from data.
-
-		real_t bounds[6];
-		_ALWAYS_INLINE_ InstanceBounds() {}
-
-		_ALWAYS_INLINE_ InstanceBounds(const AABB &p_aabb) {
-			bounds[0] = p_aabb.position.x;
-			bounds[1] = p_aabb.position.y;
-			bounds[2] = p_aabb.position.z;
-			bounds[3] = p_aabb.position.x + p_aabb.size.x;
-			bounds[4] = p_aabb.position.y + p_aabb.size.y;
-			bounds[5] = p_aabb.position.z + p_aabb.size.z;
+	class InstanceBoundsArray {
+		PagedArray<InstanceBoundsBlock> blocks;
+		uint64_t count = 0;
+
+	public:
+		_FORCE_INLINE_ uint64_t size() const { return count; }
+
+		_FORCE_INLINE_ const InstanceBoundsBlock &get_block(uint64_t p_index) const {
+			return blocks[p_index / InstanceBoundsBlock::SIZE];
+		}
+
+		_FORCE_INLINE_ void set_aabb(uint64_t p_index, const AABB &p_aabb) {
+			InstanceBoundsBlock &block = blocks[p_index / InstanceBoundsBlock::SIZE];
+			uint32_t i = p_index % InstanceBoundsBlock::SIZE;
+			block.min_x[i] = p_aabb.position.x;
+			block.min_y[i] = p_aabb.position.y;
+			block.min_z[i] = p_aabb.position.z;
+			block.max_x[i] = p_aabb.position.x + p_aabb.size.x;
+			block.max_y[i] = p_aabb.position.y + p_aabb.size.y;
+			block.max_z[i] = p_aabb.position.z + p_aabb.size.z;
+		}
+
+		_FORCE_INLINE_ void set_layer_mask(uint64_t p_index, uint32_t p_layer_mask) {
+			blocks[p_index / InstanceBoundsBlock::SIZE].layer_mask[p_index % InstanceBoundsBlock::SIZE] = p_layer_mask;
+		}
+
+		_FORCE_INLINE_ void set_ignore_culling(uint64_t p_index, bool p_ignore) {
+			InstanceBoundsBlock &block = blocks[p_index / InstanceBoundsBlock::SIZE];
+			uint32_t bit = 1 << (p_index % InstanceBoundsBlock::SIZE);
+			block.ignore_culling_mask = p_ignore ? (block.ignore_culling_mask | bit) : (block.ignore_culling_mask & ~bit);
+		}
+
+		_FORCE_INLINE_ bool is_ignoring_culling(uint64_t p_index) const {
+			return get_block(p_index).ignore_culling_mask & (1 << (p_index % InstanceBoundsBlock::SIZE));
 		}
-		_ALWAYS_INLINE_ bool in_frustum(const Frustum &p_frustum) const {
-			// This is not a full SAT check and the possibility of false positives exist,
-			// but the tradeoff vs performance is still very good.
-
-			for (uint32_t i = 0; i < p_frustum.plane_count; i++) {
-				Vector3 min(
-						bounds[p_frustum.plane_signs_ptr[i].signs[0]],
-						bounds[p_frustum.plane_signs_ptr[i].signs[1]],
-						bounds[p_frustum.plane_signs_ptr[i].signs[2]]);
-
-				if (p_frustum.planes_ptr[i].distance_to(min) >= 0.0) {
-					return false;
-				}
-			}
 
-			return true;
+		// Same layout as the former per-instance bounds: position, then end.
+		_FORCE_INLINE_ void get_bounds(uint64_t p_index, real_t r_bounds[6]) const {
+			const InstanceBoundsBlock &block = get_block(p_index);
+			uint32_t i = p_index % InstanceBoundsBlock::SIZE;
+			r_bounds[0] = block.min_x[i];
+			r_bounds[1] = block.min_y[i];
+			r_bounds[2] = block.min_z[i];
+			r_bounds[3] = block.max_x[i];
+			r_bounds[4] = block.max_y[i];
+			r_bounds[5] = block.max_z[i];
 		}
-		_ALWAYS_INLINE_ bool in_aabb(const AABB &p_aabb) const {
+
+		_FORCE_INLINE_ bool in_aabb(uint64_t p_index, const AABB &p_aabb) const {
+			const InstanceBoundsBlock &block = get_block(p_index);
+			uint32_t i = p_index % InstanceBoundsBlock::SIZE;
 			Vector3 end = p_aabb.position + p_aabb.size;
 
-			if (bounds[0] >= end.x) {
-				return false;
-			}
-			if (bounds[3] <= p_aabb.position.x) {
-				return false;
-			}
-			if (bounds[1] >= end.y) {
-				return false;
-			}
-			if (bounds[4] <= p_aabb.position.y) {
-				return false;
-			}
-			if (bounds[2] >= end.z) {
-				return false;
+			return block.min_x[i] < end.x && block.max_x[i] > p_aabb.position.x &&
+					block.min_y[i] < end.y && block.max_y[i] > p_aabb.position.y &&
+					block.min_z[i] < end.z && block.max_z[i] > p_aabb.position.z;
+		}
+
+		void push_back(const AABB &p_aabb, uint32_t p_layer_mask, bool p_ignore_culling) {
+			if (count % InstanceBoundsBlock::SIZE == 0) {
+				blocks.push_back(InstanceBoundsBlock());
 			}
-			if (bounds[5] <= p_aabb.position.z) {
-				return false;
+			count++;
+			set_aabb(count - 1, p_aabb);
+			set_layer_mask(count - 1, p_layer_mask);
+			set_ignore_culling(count - 1, p_ignore_culling);
+		}
+
+		void copy(uint64_t p_to, uint64_t p_from) {
+			const InstanceBoundsBlock &from = get_block(p_from);
+			InstanceBoundsBlock &to = blocks[p_to / InstanceBoundsBlock::SIZE];
+			uint32_t i = p_from % InstanceBoundsBlock::SIZE;
+			uint32_t j = p_to % InstanceBoundsBlock::SIZE;
+			to.min_x[j] = from.min_x[i];
+			to.min_y[j] = from.min_y[i];
+			to.min_z[j] = from.min_z[i];
+			to.max_x[j] = from.max_x[i];
+			to.max_y[j] = from.max_y[i];
+			to.max_z[j] = from.max_z[i];
+			to.layer_mask[j] = from.layer_mask[i];
+			set_ignore_culling(p_to, is_ignoring_culling(p_from));
+		}
+
+		void pop_back() {
+			ERR_FAIL_COND(count == 0);
+			count--;
+			set_ignore_culling(count, false);
+			if (count % InstanceBoundsBlock::SIZE == 0) {
+				blocks.pop_back();
 			}
+		}
+
+		void reset() {
+			blocks.reset();
+			count = 0;
+		}
 
-			return true;
+		void set_page_pool(PagedArrayPool<InstanceBoundsBlock> *p_page_pool) {
+			blocks.set_page_pool(p_page_pool);
 		}
 	};
 
@@ -264,11 +322,9 @@ public:
 			FLAG_VISIBILITY_DEPENDENCY_HIDDEN = (1 << 21),
 			FLAG_VISIBILITY_DEPENDENCY_FADE_CHILDREN = (1 << 22),
 			FLAG_GEOM_PROJECTOR_SOFTSHADOW_DIRTY = (1 << 23),
-			FLAG_IGNORE_ALL_CULLING = (1 << 24),
 		};
 
 		uint32_t flags = 0;
-		uint32_t layer_mask = 0; //for fast layer-mask discard
 		RID base_rid;
 		union {
 			uint64_t instance_data_rid;
@@ -302,7 +358,7 @@ public:
 		}
 	};
 
-	PagedArrayPool<InstanceBounds> instance_aabb_page_pool;
+	PagedArrayPool<InstanceBoundsBlock> instance_aabb_page_pool;
 	PagedArrayPool<InstanceData> instance_data_page_pool;
 	PagedArrayPool<InstanceVisibilityData> instance_visibility_data_page_pool;
 
@@ -330,7 +386,7 @@ public:
 
 		LocalVector<RID> dynamic_lights;
 
-		PagedArray<InstanceBounds> instance_aabbs;
+		InstanceBoundsArray instance_aabbs;
 		PagedArray<InstanceData> instance_data;
 		VisibilityArray instance_visibility;
 
@@ -101,6 +101,29 @@ TEST_CASE("[FileAccess] Get as UTF-8 String") {
 	CHECK(s_cr == "Hello darkness\rMy old friend\rI've come to talk\rWith you again\r");
 	CHECK(s_cr_nocr == "Hello darknessMy old friendI've come to talkWith you again");
 }
+
+TEST_CASE("[FileAccess] Buffer view") {
+	Ref<FileAccess> f = FileAccess::open(TestUtils::get_data_path("line_endings_lf.test.txt"), FileAccess::READ);
+	f->seek(6);
+	const uint8_t *view = f->get_buffer_view(8);
+	if (view) {
+		// Mapping is optional, so this only checks the view when the platform provides it.
+		CHECK(memcmp(view, "darkness", 8) == 0);
+		CHECK(f->get_position() == 14);
+	} else {
+		CHECK(f->get_position() == 6);
+	}
+
+	CHECK_MESSAGE(f->get_buffer_view(f->get_length()) == nullptr, "Views past the end of the file should be rejected.");
+
+	f->seek(14);
+	CHECK(f->get_8() == '\n');
+
+	if (view) {
+		f->seek(6);
+		CHECK_MESSAGE(f->get_buffer_view(8) == view, "Views of the same range should reuse the mapping.");
+	}
+}
 } // namespace TestFileAccess
 
 #endif // TEST_FILE_ACCESS_H
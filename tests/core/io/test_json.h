@@ -32,6 +32,7 @@
 #define TEST_JSON_H
 
 #include "core/io/json.h"
+#include "core/os/os.h"
 
 #include "thirdparty/doctest/doctest.h"
 
@@ -146,6 +147,90 @@ TEST_CASE("[JSON] Parsing objects (dictionaries)") {
 			dictionary["empty_object"].hash() == Dictionary().hash(),
 			"The parsed JSON should contain the expected values.");
 }
+
+TEST_CASE("[JSON] Parsing UTF-8 buffers") {
+	const String text = String::utf8("{\"name\": \"Gödöt \\u00e9\\ud83d\\ude00 \\\"quoted\\\"\", \"lines\": \"a\nb\", \"values\": [1, -2.5, 1e3, true, null], \"日本\": {}}");
+
+	JSON json;
+	REQUIRE(json.parse(text) == OK);
+	const Variant from_string = json.get_data();
+
+	CharString utf8 = text.utf8();
+	Vector<uint8_t> buffer;
+	buffer.resize(utf8.length());
+	memcpy(buffer.ptrw(), utf8.get_data(), utf8.length());
+	CHECK_MESSAGE(
+			json.parse_utf8(buffer) == OK,
+			"Parsing a UTF-8 buffer as JSON should parse successfully.");
+	CHECK_MESSAGE(
+			json.get_data() == from_string,
+			"Parsing a UTF-8 buffer should return the same data as parsing the string.");
+
+	const Dictionary dictionary = json.get_data();
+	CHECK(dictionary["name"] == String::utf8("Gödöt é😀 \"quoted\""));
+	CHECK(dictionary["lines"] == "a\nb");
+	CHECK(dictionary.has(String::utf8("日本")));
+	CHECK((double)Array(dictionary["values"])[2] == 1000.0);
+
+	Vector<uint8_t> with_bom;
+	with_bom.push_back(0xef);
+	with_bom.push_back(0xbb);
+	with_bom.push_back(0xbf);
+	with_bom.append_array(buffer);
+	CHECK_MESSAGE(
+			json.parse_utf8(with_bom) == OK,
+			"A byte order mark should be skipped.");
+	CHECK(json.get_data() == from_string);
+
+	// Not null-terminated, the number ends with the buffer.
+	Vector<uint8_t> number;
+	number.push_back('4');
+	number.push_back('2');
+	CHECK(json.parse_utf8(number) == OK);
+	CHECK((int)json.get_data() == 42);
+
+	const String unterminated = "[\"a\",\n\"b";
+	utf8 = unterminated.utf8();
+	buffer.resize(utf8.length());
+	memcpy(buffer.ptrw(), utf8.get_data(), utf8.length());
+	ERR_PRINT_OFF;
+	CHECK(json.parse_utf8(buffer) == ERR_PARSE_ERROR);
+	ERR_PRINT_ON;
+	CHECK_MESSAGE(
+			json.get_error_line() == 1,
+			"The error line should be reported like when parsing a string.");
+}
+
+TEST_CASE("[JSON] Stringify") {
+	Dictionary dictionary;
+	dictionary["b"] = Array();
+	dictionary["a"] = 1;
+	Array array;
+	array.push_back("tab\there");
+	array.push_back(String::utf8("é"));
+	array.push_back(Variant());
+	array.push_back(false);
+	array.push_back(-12);
+	dictionary["c"] = array;
+
+	JSON json;
+	CHECK(json.stringify(dictionary) == String::utf8("{\"a\":1,\"b\":[],\"c\":[\"tab\\there\",\"é\",null,false,-12]}"));
+	CHECK(json.stringify(dictionary, "\t") == String::utf8("{\n\t\"a\": 1,\n\t\"b\": [\n\n\t],\n\t\"c\": [\n\t\t\"tab\\there\",\n\t\t\"é\",\n\t\tnull,\n\t\tfalse,\n\t\t-12\n\t]\n}"));
+
+	const String path = OS::get_singleton()->get_cache_path().plus_file("stringify.json");
+	{
+		Ref<FileAccess> f = FileAccess::open(path, FileAccess::WRITE);
+		REQUIRE(f.is_valid());
+		CHECK(JSON::stringify_to_file(f, dictionary, "\t") == OK);
+	}
+	CHECK_MESSAGE(
+			FileAccess::get_file_as_string(path) == json.stringify(dictionary, "\t"),
+			"Stringifying to a file should write the same text.");
+
+	REQUIRE(json.parse_utf8(FileAccess::get_file_as_array(path)) == OK);
+	const Dictionary parsed = json.get_data();
+	CHECK(Array(parsed["c"])[1] == String::utf8("é"));
+}
 } // namespace TestJSON
 
 #endif // TEST_JSON_H
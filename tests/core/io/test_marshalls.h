@@ -326,6 +326,104 @@ TEST_CASE("[Marshalls] FLOAT double precision Variant decoding") {
 	CHECK(r_len == 12);
 	CHECK(variant == Variant(0.33333333333333333));
 }
+
+TEST_CASE("[Marshalls] Single pass Variant encoding") {
+	Dictionary dictionary;
+	dictionary["name"] = String::utf8("Zoë");
+	dictionary[StringName("state")] = StringName("running");
+	dictionary["path"] = NodePath("/root/Level:position");
+	PackedFloat32Array floats;
+	floats.push_back(0.5);
+	floats.push_back(-2);
+	dictionary["floats"] = floats;
+	PackedByteArray bytes;
+	bytes.push_back(1);
+	bytes.push_back(2);
+	bytes.push_back(3);
+	dictionary["bytes"] = bytes;
+	PackedVector3Array vectors;
+	vectors.push_back(Vector3(1, 2, 3));
+	dictionary["vectors"] = vectors;
+	Array array;
+	array.push_back(dictionary);
+	array.push_back(int64_t(1) << 40);
+
+	int len;
+	CHECK(encode_variant(array, nullptr, len) == OK);
+	Vector<uint8_t> two_pass;
+	two_pass.resize(len);
+	CHECK(encode_variant(array, two_pass.ptrw(), len) == OK);
+
+	LocalVector<uint8_t> buffer;
+	buffer.push_back(0xff); // Appended after the existing data.
+	CHECK(encode_variant(array, buffer) == OK);
+	REQUIRE(buffer.size() == uint32_t(len + 1));
+	CHECK_MESSAGE(
+			memcmp(buffer.ptr() + 1, two_pass.ptr(), len) == 0,
+			"The single pass encoding should produce the same data as the two pass one.");
+
+	Variant decoded;
+	int r_len;
+	CHECK(decode_variant(decoded, buffer.ptr() + 1, len, &r_len) == OK);
+	CHECK(r_len == len);
+	CHECK(decoded == Variant(array));
+}
+
+TEST_CASE("[Marshalls] StringName table") {
+	Array array;
+	array.push_back(StringName("position"));
+	array.push_back(StringName("velocity"));
+	array.push_back(StringName("position"));
+
+	StringNameTable sent;
+	LocalVector<uint8_t> first;
+	CHECK(encode_variant(array, first, false, &sent) == OK);
+	CHECK_MESSAGE(sent.size() == 2, "Each name should be added to the table once.");
+
+	LocalVector<uint8_t> second;
+	CHECK(encode_variant(array, second, false, &sent) == OK);
+	CHECK_MESSAGE(
+			second.size() < first.size(),
+			"Names already in the table should be encoded as indices.");
+
+	StringNameTable received;
+	Variant decoded;
+	CHECK(decode_variant(decoded, first.ptr(), first.size(), nullptr, false, &received) == OK);
+	CHECK(decoded == Variant(array));
+	CHECK(received.size() == 2);
+	CHECK(decode_variant(decoded, second.ptr(), second.size(), nullptr, false, &received) == OK);
+	CHECK(decoded == Variant(array));
+
+	ERR_PRINT_OFF;
+	CHECK_MESSAGE(
+			decode_variant(decoded, second.ptr(), second.size()) == ERR_INVALID_DATA,
+			"Indices can't be decoded without the table.");
+	StringNameTable empty;
+	CHECK(decode_variant(decoded, second.ptr(), second.size(), nullptr, false, &empty) == ERR_INVALID_DATA);
+	ERR_PRINT_ON;
+}
+
+TEST_CASE("[Marshalls] Single pass Variant encoding size limit") {
+	PackedByteArray bytes;
+	bytes.resize(1 << 20);
+	Array array;
+	array.push_back(StringName("payload"));
+	array.push_back(bytes);
+	array.push_back(bytes);
+
+	StringNameTable names;
+	LocalVector<uint8_t> buffer;
+	buffer.push_back(0xff);
+	CHECK(encode_variant(array, buffer, false, &names, 1024) == ERR_OUT_OF_MEMORY);
+	CHECK_MESSAGE(buffer.size() == 1, "The buffer should be left as it was.");
+	CHECK_MESSAGE(buffer.get_capacity() < 4096, "The buffer should never grow past the limit.");
+	CHECK(names.size() == 0);
+
+	int len;
+	CHECK(encode_variant(array, nullptr, len) == OK);
+	CHECK(encode_variant(array, buffer, false, nullptr, len) == OK);
+	CHECK(buffer.size() == uint32_t(len + 1));
+}
 } // namespace TestMarshalls
 
 #endif // TEST_MARSHALLS_H
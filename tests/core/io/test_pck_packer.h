@@ -117,6 +117,84 @@ TEST_CASE("[PCKPacker] Pack a PCK file with some files and directories") {
 			f->get_length() <= 35000,
 			"The generated non-empty PCK file shouldn't be too large.");
 }
+
+TEST_CASE("[PCKPacker] Pack and read compressed files") {
+	const String cache_path = OS::get_singleton()->get_cache_path();
+
+	// A file spanning many frames, small files alike, which use the dictionary, and a file that can't be compressed.
+	const String large_path = cache_path.plus_file("compressed_large.txt");
+	Ref<FileAccess> f = FileAccess::open(large_path, FileAccess::WRITE);
+	for (int i = 0; i < 20000; i++) {
+		f->store_line("Line " + itos(i) + " of a file stored in compressed frames.");
+	}
+	f = Ref<FileAccess>();
+
+	for (int i = 0; i < 4; i++) {
+		f = FileAccess::open(cache_path.plus_file("compressed_small_" + itos(i) + ".tres"), FileAccess::WRITE);
+		f->store_string("[gd_resource type=\"Resource\" format=3]\n\n[resource]\nvalue = " + itos(i) + "\n");
+	}
+
+	const String random_path = cache_path.plus_file("compressed_random.bin");
+	f = FileAccess::open(random_path, FileAccess::WRITE);
+	for (int i = 0; i < 5000; i++) {
+		f->store_8(Math::rand() % 256);
+	}
+	f = Ref<FileAccess>();
+
+	PCKPacker pck_packer;
+	const String output_pck_path = cache_path.plus_file("output_compressed.pck");
+	CHECK(pck_packer.pck_start(output_pck_path) == OK);
+	ERR_PRINT_OFF;
+	CHECK_MESSAGE(
+			pck_packer.add_file("res://compressed/large.txt", large_path, true, true) != OK,
+			"Adding a file both encrypted and compressed should fail.");
+	ERR_PRINT_ON;
+	CHECK(pck_packer.add_file("res://compressed/large.txt", large_path, false, true) == OK);
+	for (int i = 0; i < 4; i++) {
+		CHECK(pck_packer.add_file("res://compressed/small_" + itos(i) + ".tres", cache_path.plus_file("compressed_small_" + itos(i) + ".tres"), false, true) == OK);
+	}
+	CHECK(pck_packer.add_file("res://compressed/random.bin", random_path, false, true) == OK);
+	CHECK(pck_packer.flush() == OK);
+
+	f = FileAccess::open(output_pck_path, FileAccess::READ);
+	REQUIRE(f.is_valid());
+	CHECK_MESSAGE(
+			f->get_length() < FileAccess::get_file_as_array(large_path).size() / 4,
+			"The compressed PCK file should be much smaller than its text contents.");
+	f = Ref<FileAccess>();
+
+	CHECK(PackedData::get_singleton()->add_pack(output_pck_path, true, 0) == OK);
+
+	const String paths[3] = { "large.txt", "small_2.tres", "random.bin" };
+	const String source_paths[3] = { large_path, cache_path.plus_file("compressed_small_2.tres"), random_path };
+	for (int i = 0; i < 3; i++) {
+		const Vector<uint8_t> source = FileAccess::get_file_as_array(source_paths[i]);
+		Ref<FileAccess> packed = PackedData::get_singleton()->try_open_path("res://compressed/" + paths[i]);
+		REQUIRE(packed.is_valid());
+		CHECK(packed->get_length() == (uint64_t)source.size());
+
+		Vector<uint8_t> contents;
+		contents.resize(source.size());
+		CHECK(packed->get_buffer(contents.ptrw(), contents.size()) == (uint64_t)source.size());
+		CHECK_MESSAGE(contents == source, "The file read from the PCK should be the same as its source.");
+		packed->get_8();
+		CHECK(packed->eof_reached());
+	}
+
+	// Reads at random positions, across the frames.
+	const Vector<uint8_t> source = FileAccess::get_file_as_array(large_path);
+	Ref<FileAccess> packed = PackedData::get_singleton()->try_open_path("res://compressed/large.txt");
+	REQUIRE(packed.is_valid());
+	bool same = true;
+	for (int i = 0; i < 100; i++) {
+		const uint64_t position = Math::rand() % (source.size() - 64);
+		packed->seek(position);
+		uint8_t bytes[64];
+		packed->get_buffer(bytes, 64);
+		same = same && memcmp(bytes, source.ptr() + position, 64) == 0;
+	}
+	CHECK_MESSAGE(same, "The bytes read at random positions should be the same as the source ones.");
+}
 } // namespace TestPCKPacker
 
 #endif // TEST_PCK_PACKER_H
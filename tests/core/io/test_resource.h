@@ -109,6 +109,171 @@ TEST_CASE("[Resource] Saving and loading") {
 			loaded_child_resource_text->get_name() == "I'm a child resource",
 			"The loaded child resource name should be equal to the expected value.");
 }
+
+TEST_CASE("[Resource] Binary round trip with subresources") {
+	const String save_path = OS::get_singleton()->get_cache_path().plus_file("resource_subresources.res");
+	uint32_t save_flags = 0;
+	SUBCASE("Uncompressed") {
+	}
+	SUBCASE("Compressed") {
+		// Compressed files can't be mapped, so they are read through the file.
+		save_flags = ResourceSaver::FLAG_COMPRESS;
+	}
+	{
+		Ref<Resource> resource = memnew(Resource);
+		resource->set_name("Root");
+
+		Ref<Resource> shared_resource = memnew(Resource);
+		shared_resource->set_name("Shared");
+		shared_resource->set_meta("transform", Transform3D(Basis(), Vector3(1, 2, 3)));
+
+		Array children;
+		for (int i = 0; i < 16; i++) {
+			Ref<Resource> child_resource = memnew(Resource);
+			child_resource->set_name("Child " + itos(i));
+			child_resource->set_meta("index", i);
+			child_resource->set_meta("shared", shared_resource);
+			children.push_back(child_resource);
+		}
+		resource->set_meta("children", children);
+
+		// Large enough to not fit in the buffer used when the file can't be mapped.
+		PackedInt32Array numbers;
+		numbers.resize(100000);
+		for (int i = 0; i < numbers.size(); i++) {
+			numbers.write[i] = i * 3;
+		}
+		Ref<Resource> big_resource = memnew(Resource);
+		big_resource->set_meta("numbers", numbers);
+		resource->set_meta("big", big_resource);
+
+		CHECK(ResourceSaver::save(resource, save_path, save_flags) == OK);
+	}
+
+	Error error = FAILED;
+	const Ref<Resource> loaded_resource = ResourceLoader::load(save_path, "", ResourceFormatLoader::CACHE_MODE_IGNORE, &error);
+	REQUIRE(error == OK);
+	REQUIRE(loaded_resource.is_valid());
+	CHECK(loaded_resource->get_name() == "Root");
+
+	const Array children = loaded_resource->get_meta("children");
+	REQUIRE(children.size() == 16);
+	const Ref<Resource> shared_resource = Ref<Resource>(children[0])->get_meta("shared");
+	REQUIRE(shared_resource.is_valid());
+	CHECK(shared_resource->get_name() == "Shared");
+	CHECK(Transform3D(shared_resource->get_meta("transform")) == Transform3D(Basis(), Vector3(1, 2, 3)));
+	for (int i = 0; i < children.size(); i++) {
+		const Ref<Resource> child_resource = children[i];
+		REQUIRE(child_resource.is_valid());
+		CHECK(child_resource->get_name() == "Child " + itos(i));
+		CHECK(int(child_resource->get_meta("index")) == i);
+		CHECK_MESSAGE(
+				Ref<Resource>(child_resource->get_meta("shared")) == shared_resource,
+				"Subresources referenced several times should be loaded once.");
+	}
+
+	const Ref<Resource> big_resource = loaded_resource->get_meta("big");
+	REQUIRE(big_resource.is_valid());
+	const PackedInt32Array numbers = big_resource->get_meta("numbers");
+	REQUIRE(numbers.size() == 100000);
+	bool numbers_match = true;
+	for (int i = 0; i < numbers.size(); i++) {
+		numbers_match = numbers_match && numbers[i] == i * 3;
+	}
+	CHECK(numbers_match);
+}
+
+TEST_CASE("[Resource] Threaded loading of dependencies") {
+	const String save_path_parent = OS::get_singleton()->get_cache_path().plus_file("resource_parent.res");
+	{
+		Ref<Resource> shared_resource = memnew(Resource);
+		shared_resource->set_name("Shared");
+		const String save_path_shared = OS::get_singleton()->get_cache_path().plus_file("resource_shared.tres");
+		ResourceSaver::save(shared_resource, save_path_shared);
+		shared_resource->set_path(save_path_shared);
+
+		Ref<Resource> resource = memnew(Resource);
+		for (int i = 0; i < 8; i++) {
+			Ref<Resource> child_resource = memnew(Resource);
+			child_resource->set_name("Child " + itos(i));
+			child_resource->set_meta("shared", shared_resource);
+			const String save_path_child = OS::get_singleton()->get_cache_path().plus_file("resource_child_" + itos(i) + ".tres");
+			ResourceSaver::save(child_resource, save_path_child);
+			child_resource->set_path(save_path_child);
+			resource->set_meta("child_" + itos(i), child_resource);
+		}
+		ResourceSaver::save(resource, save_path_parent);
+	}
+	// Nothing saved above is referenced anymore, so all of it is loaded again.
+
+	CHECK(ResourceLoader::load_threaded_request(save_path_parent, "", true) == OK);
+	Error error = FAILED;
+	const Ref<Resource> loaded_resource = ResourceLoader::load_threaded_get(save_path_parent, &error);
+	REQUIRE(error == OK);
+	REQUIRE(loaded_resource.is_valid());
+	CHECK_MESSAGE(
+			ResourceLoader::load_threaded_get_status(save_path_parent) == ResourceLoader::THREAD_LOAD_INVALID_RESOURCE,
+			"The load task should be released once retrieved.");
+
+	Ref<Resource> shared_resource;
+	for (int i = 0; i < 8; i++) {
+		const Ref<Resource> child_resource = loaded_resource->get_meta("child_" + itos(i));
+		REQUIRE(child_resource.is_valid());
+		CHECK(child_resource->get_name() == "Child " + itos(i));
+		if (i == 0) {
+			shared_resource = child_resource->get_meta("shared");
+		} else {
+			CHECK_MESSAGE(
+					Ref<Resource>(child_resource->get_meta("shared")) == shared_resource,
+					"All the children should share the same instance of their common dependency.");
+		}
+	}
+	REQUIRE(shared_resource.is_valid());
+	CHECK(shared_resource->get_name() == "Shared");
+}
+
+TEST_CASE("[Resource] Cache") {
+	const String path = OS::get_singleton()->get_cache_path().plus_file("resource_cached.tres");
+	const int count = ResourceCache::get_cached_resource_count();
+	{
+		Ref<Resource> resource = memnew(Resource);
+		resource->set_name("Cached");
+		ResourceSaver::save(resource, path);
+		resource->set_path(path);
+		CHECK(ResourceCache::has(path));
+		CHECK(ResourceCache::get_ref(path) == resource);
+		CHECK(ResourceCache::get_cached_resource_count() == count + 1);
+		CHECK_MESSAGE(
+				ResourceLoader::load(path) == resource,
+				"Loading a cached resource should return the cached instance.");
+
+		Ref<Resource> other = memnew(Resource);
+		ERR_PRINT_OFF;
+		other->set_path(path);
+		ERR_PRINT_ON;
+		CHECK_MESSAGE(
+				other->get_path().is_empty(),
+				"The path of a cached resource shouldn't be taken without taking it over.");
+
+		other->set_path(path, true);
+		CHECK(other->get_path() == path);
+		CHECK(resource->get_path().is_empty());
+		CHECK(ResourceCache::get_ref(path) == other);
+	}
+	CHECK_MESSAGE(
+			!ResourceCache::has(path),
+			"Freed resources should leave the cache.");
+	CHECK(ResourceCache::get_cached_resource_count() == count);
+
+	const Ref<Resource> loaded = ResourceLoader::load(path);
+	REQUIRE(loaded.is_valid());
+	CHECK(loaded->get_name() == "Cached");
+	CHECK(ResourceCache::get_ref(path) == loaded);
+	CHECK(ResourceLoader::load(path) == loaded);
+	CHECK_MESSAGE(
+			ResourceLoader::load(path, "", ResourceFormatLoader::CACHE_MODE_IGNORE) != loaded,
+			"Loads ignoring the cache should return a new instance.");
+}
 } // namespace TestResource
 
 #endif // TEST_RESOURCE_H
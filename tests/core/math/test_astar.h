@@ -32,6 +32,7 @@
 #define TEST_ASTAR_H
 
 #include "core/math/a_star.h"
+#include "core/math/a_star_grid_2d.h"
 
 #include "tests/test_macros.h"
 
@@ -357,6 +358,188 @@ TEST_CASE("[Stress][AStar3D] Find paths") {
 		CHECK_MESSAGE(match, "Found all paths.");
 	}
 }
+
+TEST_CASE("[AStar3D] Frozen graph") {
+	ABCX abcx;
+	abcx.freeze();
+	CHECK(abcx.is_frozen());
+
+	// The overridden costs are still used.
+	Vector<int64_t> path = abcx.get_id_path(ABCX::X, ABCX::C);
+	REQUIRE(path.size() == 4);
+	CHECK(path[0] == ABCX::X);
+	CHECK(path[1] == ABCX::A);
+	CHECK(path[2] == ABCX::B);
+	CHECK(path[3] == ABCX::C);
+
+	// Disabling a point keeps the frozen graph.
+	abcx.set_point_disabled(ABCX::B);
+	CHECK(abcx.is_frozen());
+	path = abcx.get_id_path(ABCX::X, ABCX::C);
+	REQUIRE(path.size() == 3);
+	CHECK(path[1] == ABCX::A);
+	CHECK(path[2] == ABCX::C);
+	abcx.set_point_disabled(ABCX::B, false);
+
+	// Changing the connections drops it.
+	abcx.disconnect_points(ABCX::A, ABCX::B);
+	CHECK_FALSE(abcx.is_frozen());
+	path = abcx.get_id_path(ABCX::X, ABCX::C);
+	REQUIRE(path.size() == 3);
+	CHECK(path[1] == ABCX::A);
+	CHECK(path[2] == ABCX::C);
+
+	// Random graphs give paths of the same cost frozen or not.
+	Math::seed(0);
+	const int N = 50;
+	bool match = true;
+	for (int test = 0; test < 100; test++) {
+		AStar3D a;
+		for (int u = 0; u < N; u++) {
+			a.add_point(u, Vector3(Math::rand() % 100, Math::rand() % 100, Math::rand() % 100), 1 + Math::rand() % 3);
+		}
+		for (int i = 0; i < N * 3; i++) {
+			int u = Math::rand() % N;
+			int v = Math::rand() % N;
+			if (u != v) {
+				a.connect_points(u, v, Math::rand() % 2);
+			}
+		}
+		for (int i = 0; i < N / 10; i++) {
+			a.set_point_disabled(Math::rand() % N);
+		}
+
+		for (int i = 0; i < 20; i++) {
+			int u = Math::rand() % N;
+			int v = Math::rand() % N;
+			Vector<int64_t> route = a.get_id_path(u, v);
+			a.freeze();
+			Vector<int64_t> frozen_route = a.get_id_path(u, v);
+			if (route.size() != frozen_route.size()) {
+				match = false;
+				break;
+			}
+			real_t cost = 0;
+			real_t frozen_cost = 0;
+			for (int j = 1; j < route.size(); j++) {
+				cost += a.get_point_position(route[j - 1]).distance_to(a.get_point_position(route[j])) * a.get_point_weight_scale(route[j]);
+				frozen_cost += a.get_point_position(frozen_route[j - 1]).distance_to(a.get_point_position(frozen_route[j])) * a.get_point_weight_scale(frozen_route[j]);
+			}
+			if (!Math::is_equal_approx(cost, frozen_cost)) {
+				match = false;
+				break;
+			}
+			if (Math::rand() % 2) {
+				a.set_point_disabled(Math::rand() % N, Math::rand() % 2);
+			}
+		}
+	}
+	CHECK_MESSAGE(match, "Frozen and unfrozen paths have the same cost.");
+}
+
+TEST_CASE("[AStarGrid2D] Paths") {
+	AStarGrid2D grid;
+	grid.set_size(Vector2i(5, 5));
+	CHECK(grid.is_dirty());
+	grid.update();
+	CHECK_FALSE(grid.is_dirty());
+	CHECK(grid.is_in_bounds(4, 4));
+	CHECK_FALSE(grid.is_in_bounds(5, 0));
+
+	// A wall on the middle column, with a gap at the bottom.
+	for (int y = 0; y < 4; y++) {
+		grid.set_point_solid(Vector2i(2, y));
+	}
+	CHECK(grid.is_point_solid(Vector2i(2, 0)));
+	CHECK_FALSE(grid.is_point_solid(Vector2i(2, 4)));
+
+	grid.set_diagonal_mode(AStarGrid2D::DIAGONAL_MODE_NEVER);
+	grid.set_default_heuristic(AStarGrid2D::HEURISTIC_MANHATTAN);
+	for (int jumping = 0; jumping < 2; jumping++) {
+		grid.set_jumping_enabled(jumping);
+		TypedArray<Vector2i> path = grid.get_id_path(Vector2i(0, 0), Vector2i(4, 0));
+		REQUIRE(path.size() == 13);
+		CHECK(path[0] == Vector2i(0, 0));
+		CHECK(path[6] == Vector2i(2, 4));
+		CHECK(path[12] == Vector2i(4, 0));
+	}
+
+	grid.set_offset(Vector2(10, 20));
+	grid.set_cell_size(Vector2(2, 4));
+	Vector<Vector2> point_path = grid.get_point_path(Vector2i(0, 0), Vector2i(0, 2));
+	REQUIRE(point_path.size() == 3);
+	CHECK(point_path[0] == Vector2(10, 20));
+	CHECK(point_path[2] == Vector2(10, 28));
+
+	// Closing the gap makes the other side unreachable.
+	grid.set_point_solid(Vector2i(2, 4));
+	CHECK(grid.get_id_path(Vector2i(0, 0), Vector2i(4, 0)).is_empty());
+
+	// Changing the size needs an update, which clears the solid points.
+	grid.set_size(Vector2i(6, 6));
+	CHECK(grid.is_dirty());
+	grid.update();
+	CHECK_FALSE(grid.is_point_solid(Vector2i(2, 0)));
+}
+
+TEST_CASE("[AStarGrid2D] Jump point search") {
+	// Random grids, where the paths found with and without jumping must be valid and have the same cost.
+	Math::seed(0);
+	AStarGrid2D grid;
+	bool match = true;
+
+	for (int mode = 0; mode < AStarGrid2D::DIAGONAL_MODE_MAX; mode++) {
+		grid.set_diagonal_mode((AStarGrid2D::DiagonalMode)mode);
+		for (int test = 0; test < 50 && match; test++) {
+			const Vector2i size(5 + Math::rand() % 60, 5 + Math::rand() % 60);
+			grid.set_size(size);
+			grid.update();
+			const int density = Math::rand() % 40;
+			for (int y = 0; y < size.y; y++) {
+				for (int x = 0; x < size.x; x++) {
+					if ((int)(Math::rand() % 100) < density) {
+						grid.set_point_solid(Vector2i(x, y));
+					}
+				}
+			}
+
+			for (int i = 0; i < 10; i++) {
+				const Vector2i from(Math::rand() % size.x, Math::rand() % size.y);
+				const Vector2i to(Math::rand() % size.x, Math::rand() % size.y);
+				real_t costs[2];
+				for (int jumping = 0; jumping < 2; jumping++) {
+					grid.set_jumping_enabled(jumping);
+					TypedArray<Vector2i> path = grid.get_id_path(from, to);
+					costs[jumping] = path.is_empty() ? -1 : 0;
+					for (int j = 1; j < path.size(); j++) {
+						const Vector2i a = path[j - 1];
+						const Vector2i b = path[j];
+						const Vector2i step = b - a;
+						if (grid.is_point_solid(b) || ABS(step.x) > 1 || ABS(step.y) > 1 || step == Vector2i()) {
+							match = false;
+						}
+						if (step.x != 0 && step.y != 0) {
+							const bool horizontal = !grid.is_point_solid(Vector2i(b.x, a.y));
+							const bool vertical = !grid.is_point_solid(Vector2i(a.x, b.y));
+							if (mode == AStarGrid2D::DIAGONAL_MODE_NEVER || (mode == AStarGrid2D::DIAGONAL_MODE_AT_LEAST_ONE_WALKABLE && !horizontal && !vertical) || (mode == AStarGrid2D::DIAGONAL_MODE_ONLY_IF_NO_OBSTACLES && !(horizontal && vertical))) {
+								match = false;
+							}
+							costs[jumping] += Math_SQRT2;
+						} else {
+							costs[jumping] += 1;
+						}
+					}
+				}
+				if (!Math::is_equal_approx(costs[0], costs[1])) {
+					print_verbose(vformat("Mode %d, from %s to %s: A* gives %.6f, jump point search gives %.6f\n", mode, from, to, costs[0], costs[1]));
+					match = false;
+				}
+			}
+		}
+	}
+	CHECK_MESSAGE(match, "Jump point search finds valid paths with the same cost.");
+}
+
 } // namespace TestAStar
 
 #endif // TEST_ASTAR_H
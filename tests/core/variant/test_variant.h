@@ -31,6 +31,9 @@
 #ifndef TEST_VARIANT_H
 #define TEST_VARIANT_H
 
+#include "core/io/dir_access.h"
+#include "core/io/file_access.h"
+#include "core/os/os.h"
 #include "core/variant/variant.h"
 #include "core/variant/variant_parser.h"
 
@@ -789,6 +792,99 @@ TEST_CASE("[Variant] Writer and parser dictionary") {
 	CHECK_MESSAGE(d_parsed == Variant(d), "Should parse back.");
 }
 
+TEST_CASE("[Variant] Parser numbers and packed arrays") {
+	VariantParser::StreamString ss;
+	String errs;
+	int line = 1;
+	Variant parsed;
+
+	ss.s = "[0, -7, 123456789012345678, 9223372036854775807, 1.5, -0.25, 1e-05, 2.5e+3, 0.1, 3.141592653589793238, inf, PackedFloat64Array(1, -2.5, 1e300, inf_neg, 0.3), PackedInt32Array(\n1,\n-2,\n3\n), PackedByteArray(), PackedVector3Array(1, 2, 3, 4.5, 5, 6)]";
+	REQUIRE(VariantParser::parse(&ss, parsed, errs, line) == OK);
+	Array a = parsed;
+	REQUIRE(a.size() == 15);
+
+	CHECK(a[0].get_type() == Variant::INT);
+	CHECK(int64_t(a[1]) == -7);
+	CHECK(int64_t(a[2]) == 123456789012345678);
+	CHECK(int64_t(a[3]) == INT64_MAX);
+	CHECK(a[4].get_type() == Variant::FLOAT);
+	CHECK(double(a[4]) == 1.5);
+	CHECK(double(a[5]) == -0.25);
+	CHECK(double(a[6]) == String::to_float("1e-05"));
+	CHECK(double(a[7]) == 2500.0);
+	CHECK(double(a[8]) == 0.1);
+	CHECK_MESSAGE(double(a[9]) == String::to_float("3.141592653589793238"), "Long numbers should be converted like strings.");
+	CHECK(Math::is_inf(double(a[10])));
+
+	PackedFloat64Array f64 = a[11];
+	REQUIRE(f64.size() == 5);
+	CHECK(f64[1] == -2.5);
+	CHECK(f64[2] == String::to_float("1e300"));
+	CHECK(f64[3] == -INFINITY);
+	CHECK(f64[4] == 0.3);
+
+	PackedInt32Array i32 = a[12];
+	CHECK(i32.size() == 3);
+	CHECK(i32[1] == -2);
+	CHECK_MESSAGE(line == 5, "Lines should be counted inside packed arrays.");
+	CHECK(PackedByteArray(a[13]).is_empty());
+	PackedVector3Array v3 = a[14];
+	REQUIRE(v3.size() == 2);
+	CHECK(v3[1] == Vector3(4.5, 5, 6));
+
+	VariantParser::StreamString bad;
+	bad.s = "PackedFloat32Array(1, 2, \"3\")";
+	CHECK(VariantParser::parse(&bad, parsed, errs, line) == ERR_PARSE_ERROR);
+	CHECK(errs == "Expected float in constructor");
+}
+
+TEST_CASE("[Variant] Parser file stream") {
+	// Longer than the readahead of the stream, so it is refilled in the middle of the values.
+	PackedFloat32Array values;
+	for (int i = 0; i < 2000; i++) {
+		values.push_back(i * 0.5 - 100);
+	}
+	Dictionary d;
+	d["values"] = values;
+	d["text"] = String::utf8("G\xC3\xA9ant \xE2\x9C\x93");
+	String d_str;
+	VariantWriter::write_to_string(d, d_str);
+
+	const String path = OS::get_singleton()->get_cache_path().plus_file("variant_parser.txt");
+	{
+		Ref<FileAccess> f = FileAccess::open(path, FileAccess::WRITE);
+		REQUIRE(f.is_valid());
+		f->store_string("[tag]\nvalue = " + d_str + "\n\"escaped\" = \"\\u00e9\\t\"\n");
+	}
+
+	VariantParser::StreamFile stream;
+	stream.f = FileAccess::open(path, FileAccess::READ);
+	REQUIRE(stream.f.is_valid());
+	String errs;
+	int line = 1;
+	VariantParser::Tag tag;
+	String assign;
+	Variant value;
+
+	CHECK(VariantParser::parse_tag(&stream, line, errs, tag) == OK);
+	CHECK(tag.name == "tag");
+	CHECK_MESSAGE(stream.get_position() == 5, "The position should account for the characters read ahead.");
+
+	CHECK(VariantParser::parse_tag_assign_eof(&stream, line, errs, tag, assign, value) == OK);
+	CHECK(assign == "value");
+	CHECK(value == Variant(d));
+
+	CHECK(VariantParser::parse_tag_assign_eof(&stream, line, errs, tag, assign, value) == OK);
+	CHECK(assign == "escaped");
+	CHECK_MESSAGE(value == Variant(String::chr(0xe9) + "\t"), "Escaped characters should be decoded with the UTF-8 ones.");
+
+	CHECK(VariantParser::parse_tag_assign_eof(&stream, line, errs, tag, assign, value) == ERR_FILE_EOF);
+	CHECK(stream.is_eof());
+
+	stream.f.unref();
+	DirAccess::remove_file_or_error(path);
+}
+
 TEST_CASE("[Variant] Writer recursive dictionary") {
 	// There is no way to accurately represent a recursive dictionary,
 	// the only thing we can do is make sure the writer doesn't blow up
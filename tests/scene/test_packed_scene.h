@@ -0,0 +1,127 @@
+/*************************************************************************/
+/*  test_packed_scene.h                                                  */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2022 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2022 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef TEST_PACKED_SCENE_H
+#define TEST_PACKED_SCENE_H
+
+#include "scene/2d/node_2d.h"
+#include "scene/gui/control.h"
+#include "scene/resources/packed_scene.h"
+
+#include "tests/test_macros.h"
+
+namespace TestPackedScene {
+
+static Ref<PackedScene> _pack_scene(const Vector2 &p_position) {
+	Node *root = memnew(Node);
+	root->set_name("Root");
+
+	Node2D *sprite = memnew(Node2D);
+	sprite->set_name("Sprite");
+	sprite->set_position(p_position);
+	sprite->set_rotation(0.5);
+	root->add_child(sprite);
+	sprite->set_owner(root);
+
+	Control *label = memnew(Control);
+	label->set_name("Label");
+	label->set_offset(SIDE_LEFT, 12);
+	sprite->add_child(label);
+	label->set_owner(root);
+
+	sprite->connect("ready", Callable(root, "set_meta").bind("spawned", 5), Object::CONNECT_PERSIST);
+
+	Ref<PackedScene> scene;
+	scene.instantiate();
+	CHECK(scene->pack(root) == OK);
+	memdelete(root);
+	return scene;
+}
+
+TEST_CASE("[PackedScene] Instantiating many times") {
+	Ref<PackedScene> scene = _pack_scene(Vector2(4, 8));
+
+	Node *first = scene->instantiate();
+	Node *second = scene->instantiate();
+	REQUIRE(first);
+	REQUIRE(second);
+
+	for (Node *root : { first, second }) {
+		CHECK(root->get_name() == "Root");
+		Node2D *sprite = Object::cast_to<Node2D>(root->get_node_or_null(NodePath("Sprite")));
+		REQUIRE(sprite);
+		CHECK(sprite->get_owner() == root);
+		CHECK(sprite->get_position().is_equal_approx(Vector2(4, 8)));
+		CHECK(sprite->get_rotation() == doctest::Approx(0.5));
+
+		Control *label = Object::cast_to<Control>(root->get_node_or_null(NodePath("Sprite/Label")));
+		REQUIRE(label);
+		CHECK(label->get_offset(SIDE_LEFT) == doctest::Approx(12));
+	}
+
+	// The connections are made to each instance, with their binds.
+	first->get_node(NodePath("Sprite"))->emit_signal("ready");
+	CHECK(first->get_meta("spawned", 0) == Variant(5));
+	CHECK_FALSE(second->has_meta("spawned"));
+
+	memdelete(first);
+	memdelete(second);
+}
+
+TEST_CASE("[PackedScene] Instantiating after packing again") {
+	Ref<PackedScene> scene = _pack_scene(Vector2(4, 8));
+	Node *first = scene->instantiate();
+	REQUIRE(first);
+	memdelete(first);
+
+	Ref<PackedScene> other = _pack_scene(Vector2(-1, 2));
+	scene->replace_state(other->get_state());
+	Node *second = scene->instantiate();
+	REQUIRE(second);
+	Node2D *sprite = Object::cast_to<Node2D>(second->get_node_or_null(NodePath("Sprite")));
+	REQUIRE(sprite);
+	CHECK(sprite->get_position().is_equal_approx(Vector2(-1, 2)));
+	memdelete(second);
+
+	// Packing clears the state, its next instance is created from the new nodes.
+	Node *root = memnew(Node2D);
+	root->set_name("Other");
+	CHECK(scene->pack(root) == OK);
+	memdelete(root);
+	Node *third = scene->instantiate();
+	REQUIRE(third);
+	CHECK(Object::cast_to<Node2D>(third));
+	CHECK(third->get_child_count() == 0);
+	memdelete(third);
+}
+
+} // namespace TestPackedScene
+
+#endif // TEST_PACKED_SCENE_H
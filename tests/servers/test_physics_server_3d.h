@@ -0,0 +1,136 @@
+/*************************************************************************/
+/*  test_physics_server_3d.h                                             */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2022 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2022 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef TEST_PHYSICS_SERVER_3D_H
+#define TEST_PHYSICS_SERVER_3D_H
+
+#include "servers/physics_3d/godot_physics_server_3d.h"
+
+#include "tests/test_macros.h"
+
+namespace TestPhysicsServer3D {
+
+// Steps a small spinning box with continuous collision detection once, moving along X
+// above a static 2x2x2 box, and returns its position.
+static Vector3 step_ccd_box(PhysicsServer3D *p_server, const Vector3 &p_position, const Vector3 &p_linear_velocity, const Vector3 &p_angular_velocity, real_t p_step) {
+	RID space = p_server->space_create();
+	p_server->space_set_active(space, true);
+
+	RID wall_shape = p_server->box_shape_create();
+	p_server->shape_set_data(wall_shape, Vector3(1, 1, 1));
+	RID wall = p_server->body_create();
+	p_server->body_set_mode(wall, PhysicsServer3D::BODY_MODE_STATIC);
+	p_server->body_add_shape(wall, wall_shape);
+	p_server->body_set_space(wall, space);
+
+	RID body_shape = p_server->box_shape_create();
+	p_server->shape_set_data(body_shape, Vector3(0.25, 0.25, 0.25));
+	RID body = p_server->body_create();
+	p_server->body_set_mode(body, PhysicsServer3D::BODY_MODE_DYNAMIC);
+	p_server->body_add_shape(body, body_shape);
+	p_server->body_set_enable_continuous_collision_detection(body, true);
+	p_server->body_set_param(body, PhysicsServer3D::BODY_PARAM_GRAVITY_SCALE, 0.0);
+	p_server->body_set_param(body, PhysicsServer3D::BODY_PARAM_LINEAR_DAMP_MODE, PhysicsServer3D::BODY_DAMP_MODE_REPLACE);
+	p_server->body_set_param(body, PhysicsServer3D::BODY_PARAM_ANGULAR_DAMP_MODE, PhysicsServer3D::BODY_DAMP_MODE_REPLACE);
+	p_server->body_set_state(body, PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(), p_position));
+	p_server->body_set_state(body, PhysicsServer3D::BODY_STATE_LINEAR_VELOCITY, p_linear_velocity);
+	p_server->body_set_state(body, PhysicsServer3D::BODY_STATE_ANGULAR_VELOCITY, p_angular_velocity);
+	p_server->body_set_space(body, space);
+
+	p_server->step(p_step);
+
+	Transform3D xform = p_server->body_get_state(body, PhysicsServer3D::BODY_STATE_TRANSFORM);
+
+	p_server->free(body);
+	p_server->free(body_shape);
+	p_server->free(wall);
+	p_server->free(wall_shape);
+	p_server->free(space);
+
+	return xform.origin;
+}
+
+TEST_CASE("[PhysicsServer3D] Continuous collision detection") {
+	PhysicsServer3D *server = memnew(GodotPhysicsServer3D(false));
+	server->init();
+
+	const real_t step = 1.0 / 60.0;
+
+	SUBCASE("Fast body passing close to a box is not stopped") {
+		// Spinning around Y keeps the body 0.02 above the box during the whole step.
+		Vector3 position(-1.0, 1.27, 0.0);
+		Vector3 velocity(60.0, 0.0, 0.0);
+		Vector3 new_position = step_ccd_box(server, position, velocity, Vector3(0.0, 100.0, 0.0), step);
+		CHECK(new_position.is_equal_approx(position + velocity * step));
+	}
+
+	SUBCASE("Fast body hitting a box stops at the time of impact") {
+		Vector3 position(-3.0, 0.75, 0.0);
+		Vector3 velocity(300.0, 0.0, 0.0);
+		Vector3 new_position = step_ccd_box(server, position, velocity, Vector3(0.0, 20.0, 0.0), step);
+		CHECK(new_position.x < -1.0);
+		CHECK(new_position.x > -1.5);
+	}
+
+	server->finish();
+	memdelete(server);
+}
+
+TEST_CASE("[PhysicsServer3D] Concave polygon shape data") {
+	PhysicsServer3D *server = memnew(GodotPhysicsServer3D(false));
+	server->init();
+
+	// Enough scattered faces for the BVH to store them in a different order.
+	PackedVector3Array faces;
+	for (int i = 0; i < 256; i++) {
+		Vector3 origin((i * 37) % 101, (i * 13) % 7, (i * 71) % 53);
+		faces.push_back(origin);
+		faces.push_back(origin + Vector3(1, 0, 0));
+		faces.push_back(origin + Vector3(0, 0, 1));
+	}
+
+	Dictionary data;
+	data["faces"] = faces;
+	data["backface_collision"] = true;
+
+	RID shape = server->concave_polygon_shape_create();
+	server->shape_set_data(shape, data);
+
+	Dictionary result = server->shape_get_data(shape);
+	CHECK_MESSAGE(PackedVector3Array(result["faces"]) == faces, "The faces should be returned in the order they were set.");
+	CHECK(bool(result["backface_collision"]));
+
+	server->free(shape);
+	server->finish();
+	memdelete(server);
+}
+} // namespace TestPhysicsServer3D
+
+#endif // TEST_PHYSICS_SERVER_3D_H
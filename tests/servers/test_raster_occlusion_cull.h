@@ -0,0 +1,111 @@
+/*************************************************************************/
+/*  test_raster_occlusion_cull.h                                         */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2022 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2022 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef TEST_RASTER_OCCLUSION_CULL_H
+#define TEST_RASTER_OCCLUSION_CULL_H
+
+#include "servers/rendering/raster_occlusion_cull.h"
+
+#include "tests/test_macros.h"
+
+namespace TestRasterOcclusionCull {
+
+// Adds the quad spanning p_min to p_max on the XY plane at p_z in view space as two triangles.
+static void add_quad(RasterOcclusionCull::RasterHZBuffer &r_buffer, const Vector2 &p_min, const Vector2 &p_max, real_t p_z, const Projection &p_projection, bool p_orthogonal) {
+	Vector3 a[3] = { Vector3(p_min.x, p_min.y, p_z), Vector3(p_max.x, p_min.y, p_z), Vector3(p_max.x, p_max.y, p_z) };
+	Vector3 b[3] = { Vector3(p_min.x, p_min.y, p_z), Vector3(p_max.x, p_max.y, p_z), Vector3(p_min.x, p_max.y, p_z) };
+	r_buffer.add_triangle(a, p_projection, p_orthogonal, 0.1);
+	r_buffer.add_triangle(b, p_projection, p_orthogonal, 0.1);
+}
+
+// The buffers below are never cleared, as clearing also frees the debug texture on the RenderingServer.
+TEST_CASE("[RasterOcclusionCull] Quad at a known depth") {
+	RasterOcclusionCull::RasterHZBuffer buffer;
+	buffer.resize(Size2i(64, 32));
+
+	Projection projection;
+	projection.set_perspective(90, 2.0, 0.1, 100);
+	// Covers the pixels 24 to 39 horizontally and 8 to 23 vertically.
+	add_quad(buffer, Vector2(-5, -5), Vector2(5, 5), -10, projection, false);
+	buffer.raster(false, 100);
+
+	CHECK(buffer.get_distance(32, 16) == doctest::Approx(10.0));
+	CHECK(buffer.get_distance(24, 8) == doctest::Approx(10.0));
+	CHECK(buffer.get_distance(39, 23) == doctest::Approx(10.0));
+	CHECK(buffer.get_distance(23, 16) == FLT_MAX);
+	CHECK(buffer.get_distance(40, 16) == FLT_MAX);
+	CHECK(buffer.get_distance(32, 7) == FLT_MAX);
+	CHECK(buffer.get_distance(32, 24) == FLT_MAX);
+	CHECK(buffer.get_distance(5, 16) == FLT_MAX);
+
+	buffer.update_mips();
+
+	real_t behind[6] = { -2, -2, -20, 2, 2, -15 };
+	real_t in_front[6] = { -2, -2, -8, 2, 2, -6 };
+	CHECK(buffer.is_occluded(behind, Vector3(), Transform3D(), projection, 0.1));
+	CHECK_FALSE(buffer.is_occluded(in_front, Vector3(), Transform3D(), projection, 0.1));
+}
+
+TEST_CASE("[RasterOcclusionCull] Triangle crossing the near plane") {
+	RasterOcclusionCull::RasterHZBuffer buffer;
+	buffer.resize(Size2i(64, 32));
+
+	Projection projection;
+	projection.set_perspective(90, 2.0, 0.1, 100);
+	// A floor triangle running from in front of the camera to behind it.
+	Vector3 floor[3] = { Vector3(-3, -1, -5), Vector3(3, -1, -5), Vector3(0, -1, 5) };
+	buffer.add_triangle(floor, projection, false, 0.1);
+	buffer.raster(false, 100);
+
+	// The clipped triangle reaches the bottom of the screen, with the distance growing towards the horizon.
+	CHECK(buffer.get_distance(32, 0) < buffer.get_distance(32, 5));
+	CHECK(buffer.get_distance(32, 5) == doctest::Approx(1.0 / 0.65625).epsilon(0.001));
+	CHECK(buffer.get_distance(32, 20) == FLT_MAX);
+}
+
+TEST_CASE("[RasterOcclusionCull] Orthographic camera") {
+	RasterOcclusionCull::RasterHZBuffer buffer;
+	buffer.resize(Size2i(64, 32));
+
+	Projection projection;
+	projection.set_orthogonal(-20, 20, -10, 10, 0.1, 100);
+	add_quad(buffer, Vector2(-5, -5), Vector2(5, 5), -10, projection, true);
+	// The nearer quad wins where both are rasterized.
+	add_quad(buffer, Vector2(-5, -5), Vector2(0, 5), -4, projection, true);
+	buffer.raster(true, 100);
+
+	CHECK(buffer.get_distance(28, 16) == doctest::Approx(4.0));
+	CHECK(buffer.get_distance(36, 16) == doctest::Approx(10.0));
+	CHECK(buffer.get_distance(10, 16) == FLT_MAX);
+}
+
+} // namespace TestRasterOcclusionCull
+
+#endif // TEST_RASTER_OCCLUSION_CULL_H
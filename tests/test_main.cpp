@@ -88,10 +88,13 @@
 #include "tests/scene/test_code_edit.h"
 #include "tests/scene/test_curve.h"
 #include "tests/scene/test_gradient.h"
+#include "tests/scene/test_packed_scene.h"
 #include "tests/scene/test_path_3d.h"
 #include "tests/scene/test_sprite_frames.h"
 #include "tests/scene/test_text_edit.h"
 #include "tests/scene/test_theme.h"
+#include "tests/servers/test_physics_server_3d.h"
+#include "tests/servers/test_raster_occlusion_cull.h"
 #include "tests/servers/test_text_server.h"
 #include "tests/test_validate_testing.h"
 